@@ -395,6 +395,9 @@ typedef struct _NMDevicePrivate {
     guint device_link_changed_id;
     guint device_ip_link_changed_id;
 
+    /* Subscriptions for link changes of the ifindex and the ip-ifindex. */
+    NMNetnsPlatformSubscription *link_subs[2];
+
     GSource *delay_activation_source;
 
     NMDeviceState       state;
@@ -760,10 +763,10 @@ typedef struct _NMDevicePrivate {
     guint sriov_reset_pending;
 
     struct {
-        GSource *timeout_source;
-        guint    refresh_rate_ms;
-        guint64  tx_bytes;
-        guint64  rx_bytes;
+        NMNetnsStatsHandle *handle;
+        guint               refresh_rate_ms;
+        guint64             tx_bytes;
+        guint64             rx_bytes;
     } stats;
 
     bool mtu_force_set_done : 1;
@@ -874,6 +877,12 @@ static void device_ifindex_changed_cb(NMManager *manager, NMDevice *device_chang
 static gboolean device_link_changed(gpointer user_data);
 static gboolean _get_maybe_ipv6_disabled(NMDevice *self);
 static void     deactivate_ready(NMDevice *self, NMDeviceStateReason reason);
+static void     link_changed_cb(NMNetns                   *netns,
+                                NMPObjectType              obj_type,
+                                int                        ifindex,
+                                const NMPObject           *obj,
+                                NMPlatformSignalChangeType change_type,
+                                gpointer                   user_data);
 
 /*****************************************************************************/
 
@@ -996,6 +1005,19 @@ update_prop_ip_iface(NMDevice *self)
 
 /*****************************************************************************/
 
+static void
+_manager_idx_update(NMDevice *self)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+
+    /* Keep the lookup indexes of NMManager in sync with ifindex, interface
+     * names and permanent MAC address. */
+    if (priv->manager)
+        nm_manager_device_idx_update(priv->manager, self);
+}
+
+/*****************************************************************************/
+
 static NMSettingIP6ConfigPrivacy
 _ip6_privacy_clamp(NMSettingIP6ConfigPrivacy use_tempaddr)
 {
@@ -1667,6 +1689,17 @@ _prop_get_ipv4_dad_timeout(NMDevice *self)
                                                        200);
 }
 
+static gboolean
+_prop_get_ipv4_dhcp_rapid_commit(NMDevice *self)
+{
+    const char *str;
+
+    str = nm_config_data_get_connection_default(NM_CONFIG_GET_DATA,
+                                                NM_CON_DEFAULT("ipv4.dhcp-rapid-commit"),
+                                                self);
+    return _nm_utils_ascii_str_to_bool(str, FALSE);
+}
+
 static guint32
 _prop_get_ipvx_dhcp_timeout(NMDevice *self, int addr_family)
 {
@@ -4750,6 +4783,33 @@ nm_device_get_iface(NMDevice *self)
     return NM_DEVICE_GET_PRIVATE(self)->iface;
 }
 
+static void
+_link_subs_sync(NMDevice *self)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+    int              ifindexes[2];
+    guint            i;
+
+    /* Only get notified about link changes of our own interfaces, instead
+     * of filtering the changes of all links. Usually the ip-ifindex is the
+     * same as the ifindex, then one subscription is enough. */
+    ifindexes[0] = priv->ifindex_;
+    ifindexes[1] = priv->ip_ifindex_ != priv->ifindex_ ? priv->ip_ifindex_ : 0;
+
+    for (i = 0; i < G_N_ELEMENTS(ifindexes); i++) {
+        if (!priv->link_subs[i]) {
+            if (ifindexes[i] > 0) {
+                priv->link_subs[i] = nm_netns_platform_subscribe(priv->netns,
+                                                                 NMP_OBJECT_TYPE_LINK,
+                                                                 ifindexes[i],
+                                                                 link_changed_cb,
+                                                                 self);
+            }
+        } else
+            nm_netns_platform_subscription_set_ifindex(priv->link_subs[i], ifindexes[i]);
+    }
+}
+
 static gboolean
 _set_ifindex(NMDevice *self, int ifindex, gboolean is_ip_ifindex)
 {
@@ -4772,6 +4832,8 @@ _set_ifindex(NMDevice *self, int ifindex, gboolean is_ip_ifindex)
 
     *p_ifindex = ifindex;
 
+    _link_subs_sync(self);
+
     ip_ifindex_new = nm_device_get_ip_ifindex(self);
 
     if (priv->l3cfg) {
@@ -4832,8 +4894,13 @@ _set_ifindex(NMDevice *self, int ifindex, gboolean is_ip_ifindex)
                               ")",
                               ""));
 
-    if (priv->manager)
+    if (priv->stats.handle)
+        nm_netns_stats_set_ifindex(priv->stats.handle, ip_ifindex_new);
+
+    if (priv->manager) {
+        nm_manager_device_idx_update(priv->manager, self);
         nm_manager_emit_device_ifindex_changed(priv->manager, self);
+    }
 
     if (!is_ip_ifindex)
         _notify(self, PROP_IFINDEX);
@@ -5042,6 +5109,7 @@ _set_ip_ifindex(NMDevice *self, int ifindex, const char *ifname)
     if (!eq_name) {
         g_free(priv->ip_iface_);
         priv->ip_iface_ = g_strdup(ifname);
+        _manager_idx_update(self);
         update_prop_ip_iface(self);
     }
     _set_ifindex(self, ifindex, TRUE);
@@ -5295,23 +5363,23 @@ _stats_update_counters(NMDevice *self, guint64 tx_bytes, guint64 rx_bytes)
 static void
 _stats_update_counters_from_pllink(NMDevice *self, const NMPlatformLink *pllink)
 {
+    /* While statistics are enabled, the counters come from the periodic
+     * refresh of NMNetns. The link in the platform cache is not updated
+     * by that and its counters may be stale. */
+    if (NM_DEVICE_GET_PRIVATE(self)->stats.handle)
+        return;
+
     _stats_update_counters(self, pllink->tx_bytes, pllink->rx_bytes);
 }
 
-static gboolean
-_stats_timeout_cb(gpointer user_data)
+static void
+_stats_refresh_cb(NMNetns *netns, const NMPlatformLinkStats *stats, gpointer user_data)
 {
     NMDevice *self = user_data;
-    int       ifindex;
-
-    ifindex = nm_device_get_ip_ifindex(self);
-
-    _LOGT(LOGD_DEVICE, "stats: refresh %d", ifindex);
 
-    if (ifindex > 0)
-        nm_platform_link_refresh(nm_device_get_platform(self), ifindex);
+    _LOGT(LOGD_DEVICE, "stats: refresh %d", stats->ifindex);
 
-    return G_SOURCE_CONTINUE;
+    _stats_update_counters(self, stats->tx_bytes, stats->rx_bytes);
 }
 
 static guint
@@ -5331,11 +5399,29 @@ _stats_refresh_rate_real(guint refresh_rate_ms)
     return refresh_rate_ms;
 }
 
+static void
+_stats_handle_setup(NMDevice *self)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+    guint            refresh_rate_ms;
+
+    nm_clear_pointer(&priv->stats.handle, nm_netns_stats_unregister);
+
+    refresh_rate_ms = _stats_refresh_rate_real(priv->stats.refresh_rate_ms);
+    if (refresh_rate_ms == 0)
+        return;
+
+    priv->stats.handle = nm_netns_stats_register(priv->netns,
+                                                 nm_device_get_ip_ifindex(self),
+                                                 refresh_rate_ms,
+                                                 _stats_refresh_cb,
+                                                 self);
+}
+
 static void
 _stats_set_refresh_rate(NMDevice *self, guint refresh_rate_ms)
 {
     NMDevicePrivate *priv;
-    int              ifindex;
     guint            old_rate;
 
     priv = NM_DEVICE_GET_PRIVATE(self);
@@ -5356,19 +5442,9 @@ _stats_set_refresh_rate(NMDevice *self, guint refresh_rate_ms)
     if (_stats_refresh_rate_real(old_rate) == refresh_rate_ms)
         return;
 
-    nm_clear_g_source_inst(&priv->stats.timeout_source);
-
-    if (!refresh_rate_ms)
-        return;
-
-    /* trigger an initial refresh of the data whenever the refresh-rate changes.
-     * As we process the result in an idle handler with device_link_changed(),
-     * we don't get the result right away. */
-    ifindex = nm_device_get_ip_ifindex(self);
-    if (ifindex > 0)
-        nm_platform_link_refresh(nm_device_get_platform(self), ifindex);
-
-    priv->stats.timeout_source = nm_g_timeout_add_source(refresh_rate_ms, _stats_timeout_cb, self);
+    /* A new handle gets refreshed right away, so we get the initial
+     * data whenever the refresh-rate changes. */
+    _stats_handle_setup(self);
 }
 
 /*****************************************************************************/
@@ -7362,6 +7438,7 @@ device_link_changed(gpointer user_data)
               pllink->name);
         g_free(priv->iface_);
         priv->iface_ = g_strdup(pllink->name);
+        _manager_idx_update(self);
 
         /* If the device has no explicit ip_iface, then changing iface changes ip_iface too. */
         ip_ifname_changed = !priv->ip_iface;
@@ -7499,6 +7576,7 @@ device_ip_link_changed(gpointer user_data)
               ip_iface);
         g_free(priv->ip_iface_);
         priv->ip_iface_ = g_strdup(ip_iface);
+        _manager_idx_update(self);
         update_prop_ip_iface(self);
 
         nm_device_update_dynamic_ip_setup(self, "interface renamed");
@@ -7508,20 +7586,22 @@ device_ip_link_changed(gpointer user_data)
 }
 
 static void
-link_changed_cb(NMPlatform     *platform,
-                int             obj_type_i,
-                int             ifindex,
-                NMPlatformLink *pllink,
-                int             change_type_i,
-                NMDevice       *self)
+link_changed_cb(NMNetns                   *netns,
+                NMPObjectType              obj_type,
+                int                        ifindex,
+                const NMPObject           *obj,
+                NMPlatformSignalChangeType change_type,
+                gpointer                   user_data)
 {
-    const NMPlatformSignalChangeType change_type = change_type_i;
-    NMDevicePrivate                 *priv;
+    NMDevice             *self = user_data;
+    NMDevicePrivate      *priv;
+    const NMPlatformLink *pllink;
 
     if (change_type != NM_PLATFORM_SIGNAL_CHANGED)
         return;
 
-    priv = NM_DEVICE_GET_PRIVATE(self);
+    priv   = NM_DEVICE_GET_PRIVATE(self);
+    pllink = NMP_OBJECT_CAST_LINK(obj);
 
     if (ifindex == nm_device_get_ifindex(self)) {
         if (!(pllink->n_ifi_flags & IFF_UP))
@@ -7747,8 +7827,10 @@ nm_device_update_from_platform_link(NMDevice *self, const NMPlatformLink *plink)
         _notify(self, PROP_PATH);
     }
 
-    if (plink && !nm_str_is_empty(plink->name) && nm_strdup_reset(&priv->iface_, plink->name))
+    if (plink && !nm_str_is_empty(plink->name) && nm_strdup_reset(&priv->iface_, plink->name)) {
+        _manager_idx_update(self);
         _notify(self, PROP_IFACE);
+    }
 
     str = plink ? plink->driver : NULL;
     if (!nm_streq0(str, priv->driver)) {
@@ -7987,7 +8069,6 @@ realize_start_setup(NMDevice             *self,
     NMPlatform          *platform;
     NMDeviceCapabilities capabilities = 0;
     NMConfig            *config;
-    guint                refresh_rate_ms;
     gboolean             unmanaged;
 
     /* plink is a NMPlatformLink type, however, we require it to come from the platform
@@ -8091,12 +8172,8 @@ realize_start_setup(NMDevice             *self,
 
     nm_device_set_carrier_from_platform(self);
 
-    nm_assert(!priv->stats.timeout_source);
-    refresh_rate_ms = _stats_refresh_rate_real(priv->stats.refresh_rate_ms);
-    if (refresh_rate_ms > 0) {
-        priv->stats.timeout_source =
-            nm_g_timeout_add_source(refresh_rate_ms, _stats_timeout_cb, self);
-    }
+    nm_assert(!priv->stats.handle);
+    _stats_handle_setup(self);
 
     klass->realize_start_notify(self, plink);
 
@@ -8243,8 +8320,10 @@ nm_device_unrealize(NMDevice *self, gboolean remove_resources, GError **error)
 
     _set_ifindex(self, 0, FALSE);
     _set_ifindex(self, 0, TRUE);
-    if (nm_clear_g_free(&priv->ip_iface_))
+    if (nm_clear_g_free(&priv->ip_iface_)) {
+        _manager_idx_update(self);
         update_prop_ip_iface(self);
+    }
 
     priv->controller_ifindex = 0;
 
@@ -8271,15 +8350,17 @@ nm_device_unrealize(NMDevice *self, gboolean remove_resources, GError **error)
         _notify(self, PROP_PHYSICAL_PORT_ID);
     }
 
-    nm_clear_g_source_inst(&priv->stats.timeout_source);
+    nm_clear_pointer(&priv->stats.handle, nm_netns_stats_unregister);
     _stats_update_counters(self, 0, 0);
 
     priv->hw_addr_len_ = 0;
     if (nm_clear_g_free(&priv->hw_addr))
         _notify(self, PROP_HW_ADDRESS);
     priv->hw_addr_type = HW_ADDR_TYPE_UNSET;
-    if (nm_clear_g_free(&priv->hw_addr_perm))
+    if (nm_clear_g_free(&priv->hw_addr_perm)) {
+        _manager_idx_update(self);
         _notify(self, PROP_PERM_HW_ADDRESS);
+    }
     nm_clear_g_free(&priv->hw_addr_initial);
 
     priv->capabilities = NM_DEVICE_CAP_NM_SUPPORTED;
@@ -11217,6 +11298,7 @@ _dev_ipdhcpx_start(NMDevice *self, int addr_family)
                     .send_client_id    = send_client_id,
                     .dscp              = dscp,
                     .dscp_explicit     = dscp_explicit,
+                    .rapid_commit      = _prop_get_ipv4_dhcp_rapid_commit(self),
                 },
             .previous_lease = priv->l3cds[L3_CONFIG_DATA_TYPE_DHCP_X(IS_IPv4)].d,
         };
@@ -17420,6 +17502,7 @@ nm_device_update_permanent_hw_address(NMDevice *self, gboolean force_freeze)
     priv->hw_addr_perm = g_strdup(priv->hw_addr);
 
 notify_and_out:
+    _manager_idx_update(self);
     _notify(self, PROP_PERM_HW_ADDRESS);
 }
 
@@ -18727,14 +18810,10 @@ constructed(GObject *object)
 {
     NMDevice        *self = NM_DEVICE(object);
     NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
-    NMPlatform      *platform;
 
     if (NM_DEVICE_GET_CLASS(self)->get_generic_capabilities)
         priv->capabilities |= NM_DEVICE_GET_CLASS(self)->get_generic_capabilities(self);
 
-    platform = nm_device_get_platform(self);
-    g_signal_connect(platform, NM_PLATFORM_SIGNAL_LINK_CHANGED, G_CALLBACK(link_changed_cb), self);
-
     priv->manager  = g_object_ref(NM_MANAGER_GET);
     priv->settings = g_object_ref(NM_SETTINGS_GET);
 
@@ -18761,7 +18840,6 @@ dispose(GObject *object)
 {
     NMDevice                   *self = NM_DEVICE(object);
     NMDevicePrivate            *priv = NM_DEVICE_GET_PRIVATE(self);
-    NMPlatform                 *platform;
     NMDeviceConnectivityHandle *con_handle;
     gs_free_error GError       *cancelled_error = NULL;
 
@@ -18786,8 +18864,8 @@ dispose(GObject *object)
 
     _parent_set_ifindex(self, 0, FALSE);
 
-    platform = nm_device_get_platform(self);
-    g_signal_handlers_disconnect_by_func(platform, G_CALLBACK(link_changed_cb), self);
+    nm_clear_pointer(&priv->link_subs[0], nm_netns_platform_unsubscribe);
+    nm_clear_pointer(&priv->link_subs[1], nm_netns_platform_unsubscribe);
 
     nm_clear_g_signal_handler(nm_config_get(), &priv->config_changed_id);
     nm_clear_g_signal_handler(priv->manager, &priv->ifindex_changed_id);
@@ -18814,7 +18892,7 @@ dispose(GObject *object)
 
     nm_clear_g_source(&priv->check_delete_unrealized_id);
 
-    nm_clear_g_source_inst(&priv->stats.timeout_source);
+    nm_clear_pointer(&priv->stats.handle, nm_netns_stats_unregister);
 
     carrier_disconnected_action_cancel(self);
 
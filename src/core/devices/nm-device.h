@@ -145,6 +145,9 @@ struct _NMDevice {
     CList                    devices_lst;
     CList                    devcon_dev_lst_head;
 
+    /* Owned by NMManager, see nm_manager_device_idx_update(). */
+    struct _NMManagerDeviceIdx *manager_idx;
+
     CList    policy_auto_activate_lst;
     GSource *policy_auto_activate_idle_source;
 };
@@ -0,0 +1,293 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nm-ovsdb-utils.h"
+
+/*****************************************************************************/
+
+/**
+ * nm_ovsdb_command_can_merge:
+ * @first: the command of the first call of a "transact".
+ * @command: the command of a following call.
+ *
+ * Returns: whether the operations of @command can be sent in the same
+ *   "transact" as those of @first.
+ */
+gboolean
+nm_ovsdb_command_can_merge(OvsdbCommand first, OvsdbCommand command)
+{
+    switch (first) {
+    case OVSDB_DEL_INTERFACE:
+        /* Several deletions are computed together from the same state. */
+        return command == OVSDB_DEL_INTERFACE;
+    case OVSDB_SET_INTERFACE_MTU:
+    case OVSDB_SET_REAPPLY:
+        return NM_IN_SET(command, OVSDB_SET_INTERFACE_MTU, OVSDB_SET_REAPPLY);
+    case OVSDB_MONITOR:
+    case OVSDB_MONITOR_COND_CHANGE:
+    case OVSDB_ADD_INTERFACE:
+        /* Additions use fixed named-uuids for the new rows and cannot be merged. */
+        return FALSE;
+    }
+    return nm_assert_unreachable_val(FALSE);
+}
+
+/**
+ * nm_ovsdb_result_find_error:
+ * @result: the result of a "transact".
+ *
+ * Returns: the index of the first failed operation in @result, or -1.
+ *   Note that OVSDB may append an error after the results of the
+ *   operations, for example if a constraint is violated on commit.
+ */
+gssize
+nm_ovsdb_result_find_error(json_t *result)
+{
+    size_t      index;
+    json_t     *value;
+    const char *err;
+    const char *err_details;
+
+    if (!json_is_array(result))
+        return -1;
+
+    json_array_foreach (result, index, value) {
+        if (json_unpack(value, "{s:s, s:s}", "error", &err, "details", &err_details) == 0)
+            return index;
+    }
+    return -1;
+}
+
+/**
+ * nm_ovsdb_result_owns_error:
+ * @command: the command of a call in a merged "transact".
+ * @err_idx: the index of the failed operation.
+ * @op_idx: the index of the first operation of the call.
+ * @op_len: the number of operations of the call.
+ *
+ * The deletions of a merged "transact" share their operations, so a
+ * failure can't be blamed on one of them.
+ *
+ * Returns: whether the call caused the failure at @err_idx.
+ */
+gboolean
+nm_ovsdb_result_owns_error(OvsdbCommand command, gssize err_idx, guint op_idx, guint op_len)
+{
+    return command != OVSDB_DEL_INTERFACE && err_idx >= (gssize) op_idx
+           && err_idx < (gssize) (op_idx + op_len);
+}
+
+/**
+ * nm_ovsdb_result_slice:
+ * @result: the result of a "transact".
+ * @op_idx: the index of the first operation of a call.
+ * @op_len: the number of operations of the call.
+ *
+ * Returns: (transfer full): the results of the operations of the call.
+ */
+json_t *
+nm_ovsdb_result_slice(json_t *result, guint op_idx, guint op_len)
+{
+    json_t *slice;
+    guint   i;
+
+    slice = json_array();
+    for (i = op_idx; i < op_idx + op_len; i++) {
+        json_t *value = json_array_get(result, i);
+
+        if (value)
+            json_array_append(slice, value);
+    }
+    return slice;
+}
+
+/*****************************************************************************/
+
+static json_t *
+_json_atoms(json_t *value)
+{
+    if (!value)
+        return json_array();
+    /* A set with one element can be sent as the plain atom. */
+    if (nm_streq0(json_string_value(json_array_get(value, 0)), "set"))
+        return json_incref(json_array_get(value, 1));
+    return json_pack("[O]", value);
+}
+
+/**
+ * nm_ovsdb_json_apply_diff:
+ * @column: the name of the column.
+ * @old: (allow-none): the old value of the column.
+ * @diff: the diff from the "modify" row-update2.
+ *
+ * Applies the diff of a "modify" row-update2 to the old value of a column.
+ * For sets the diff contains the elements to add or remove, for maps the
+ * pairs to add, remove (same value) or change (different value). Other
+ * columns just get the new value.
+ *
+ * Returns: (transfer full): the new value of the column.
+ */
+json_t *
+nm_ovsdb_json_apply_diff(const char *column, json_t *old, json_t *diff)
+{
+    nm_auto_decref_json json_t *old_items  = NULL;
+    nm_auto_decref_json json_t *diff_items = NULL;
+    json_t                     *items;
+    json_t                     *d;
+    json_t                     *o;
+    size_t                      di;
+    size_t                      oi;
+    gboolean                    is_map;
+
+    is_map = NM_IN_STRSET(column, "external_ids", "other_config");
+    if (!is_map && !NM_IN_STRSET(column, "ports", "interfaces", "error"))
+        return json_incref(diff);
+
+    if (is_map) {
+        old_items  = json_incref(json_array_get(old, 1));
+        diff_items = json_incref(json_array_get(diff, 1));
+    } else {
+        old_items  = _json_atoms(old);
+        diff_items = _json_atoms(diff);
+    }
+
+    items = json_array();
+    json_array_extend(items, old_items);
+
+    json_array_foreach (diff_items, di, d) {
+        json_t  *d_key = is_map ? json_array_get(d, 0) : d;
+        gboolean found = FALSE;
+
+        json_array_foreach (items, oi, o) {
+            json_t *o_key = is_map ? json_array_get(o, 0) : o;
+
+            if (!json_equal(o_key, d_key))
+                continue;
+
+            found = TRUE;
+            if (is_map && !json_equal(json_array_get(o, 1), json_array_get(d, 1)))
+                json_array_set(items, oi, d);
+            else
+                json_array_remove(items, oi);
+            break;
+        }
+        if (!found)
+            json_array_append(items, d);
+    }
+
+    if (!is_map && json_array_size(items) == 1) {
+        json_t *atom = json_incref(json_array_get(items, 0));
+
+        json_decref(items);
+        return atom;
+    }
+
+    return json_pack("[s, o]", is_map ? "map" : "set", items);
+}
+
+static json_t *
+_row_defaults(const char *table)
+{
+    /* Columns with default values are omitted in "initial" and "insert". */
+    if (nm_streq(table, "Interface"))
+        return json_pack("{s:s, s:[s, []], s:[s, []]}",
+                         "type",
+                         "",
+                         "external_ids",
+                         "map",
+                         "other_config",
+                         "map");
+    if (nm_streq(table, "Port"))
+        return json_pack("{s:[s, []], s:[s, []], s:[s, []]}",
+                         "interfaces",
+                         "set",
+                         "external_ids",
+                         "map",
+                         "other_config",
+                         "map");
+    if (nm_streq(table, "Bridge"))
+        return json_pack("{s:[s, []], s:[s, []], s:[s, []]}",
+                         "ports",
+                         "set",
+                         "external_ids",
+                         "map",
+                         "other_config",
+                         "map");
+    return json_object();
+}
+
+/**
+ * nm_ovsdb_table_updates2_convert:
+ * @updates2: the <table-updates2> from "monitor_cond_since" or "update3".
+ * @get_row: returns the cached columns of a row, or %NULL if it is unknown.
+ * @user_data: user data for @get_row.
+ *
+ * Converts the updates to the <table-updates> format of "monitor" and
+ * "update", that ovsdb_got_update() understands. Modified rows only contain
+ * the changed columns and are merged with the cached state.
+ *
+ * Returns: (transfer full): the <table-updates>.
+ */
+json_t *
+nm_ovsdb_table_updates2_convert(json_t *updates2, NMOvsdbRowGetFunc get_row, gpointer user_data)
+{
+    json_t     *updates;
+    json_t     *table_updates2;
+    const char *table;
+
+    updates = json_object();
+
+    json_object_foreach (updates2, table, table_updates2) {
+        json_t     *table_updates;
+        json_t     *row_update2;
+        const char *uuid;
+
+        table_updates = json_object();
+        json_object_set_new(updates, table, table_updates);
+
+        json_object_foreach (table_updates2, uuid, row_update2) {
+            json_t     *row;
+            json_t     *diff;
+            json_t     *value;
+            const char *column;
+
+            if ((row = json_object_get(row_update2, "initial"))
+                || (row = json_object_get(row_update2, "insert"))) {
+                json_t *new_row;
+
+                new_row = _row_defaults(table);
+                json_object_update(new_row, row);
+                json_object_set_new(table_updates, uuid, json_pack("{s:o}", "new", new_row));
+                continue;
+            }
+
+            if (json_object_get(row_update2, "delete")) {
+                json_object_set_new(table_updates, uuid, json_pack("{s:{}}", "old"));
+                continue;
+            }
+
+            diff = json_object_get(row_update2, "modify");
+            if (!diff)
+                continue;
+
+            row = get_row(table, uuid, user_data);
+            if (!row) {
+                nm_log_dbg(LOGD_DEVICE,
+                           "ovsdb: update3: modified row %s:%s is unknown",
+                           table,
+                           uuid);
+                continue;
+            }
+            json_object_foreach (diff, column, value) {
+                json_object_set_new(
+                    row,
+                    column,
+                    nm_ovsdb_json_apply_diff(column, json_object_get(row, column), value));
+            }
+            json_object_set_new(table_updates, uuid, json_pack("{s:o}", "new", row));
+        }
+    }
+
+    return updates;
+}
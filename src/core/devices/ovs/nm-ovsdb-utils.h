@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __NM_OVSDB_UTILS_H__
+#define __NM_OVSDB_UTILS_H__
+
+#include "libnm-glib-aux/nm-jansson.h"
+
+typedef enum {
+    OVSDB_MONITOR,
+    OVSDB_MONITOR_COND_CHANGE,
+    OVSDB_ADD_INTERFACE,
+    OVSDB_DEL_INTERFACE,
+    OVSDB_SET_INTERFACE_MTU,
+    OVSDB_SET_REAPPLY,
+} OvsdbCommand;
+
+gboolean nm_ovsdb_command_can_merge(OvsdbCommand first, OvsdbCommand command);
+
+gssize nm_ovsdb_result_find_error(json_t *result);
+
+gboolean
+nm_ovsdb_result_owns_error(OvsdbCommand command, gssize err_idx, guint op_idx, guint op_len);
+
+json_t *nm_ovsdb_result_slice(json_t *result, guint op_idx, guint op_len);
+
+json_t *nm_ovsdb_json_apply_diff(const char *column, json_t *old, json_t *diff);
+
+typedef json_t *(*NMOvsdbRowGetFunc)(const char *table, const char *uuid, gpointer user_data);
+
+json_t *
+nm_ovsdb_table_updates2_convert(json_t *updates2, NMOvsdbRowGetFunc get_row, gpointer user_data);
+
+#endif /* __NM_OVSDB_UTILS_H__ */
@@ -17,10 +17,12 @@
 #include "libnm-core-intern/nm-core-internal.h"
 #include "devices/nm-device.h"
 #include "nm-manager.h"
+#include "nm-config.h"
 #include "nm-setting-ovs-external-ids.h"
 #include "nm-setting-ovs-other-config.h"
 #include "nm-priv-helper-call.h"
 #include "libnm-platform/nm-platform.h"
+#include "nm-ovsdb-utils.h"
 
 /*****************************************************************************/
 
@@ -28,6 +30,11 @@
 
 #define OTHER_CONFIG_HWADDR "hwaddr"
 
+/* The id of our "monitor_cond_since" monitor, needed for "monitor_cond_change". */
+#define MONITOR_ID "NM"
+
+#define MONITOR_TXN_ID_NONE "00000000-0000-0000-0000-000000000000"
+
 /*****************************************************************************/
 
 #if JANSSON_VERSION_HEX < 0x020400
@@ -62,6 +69,7 @@ typedef struct {
     char   *name;
     char   *type;
     char   *connection_uuid;
+    char   *error;
     GArray *external_ids;
     GArray *other_config;
 } OpenvswitchInterface;
@@ -73,19 +81,16 @@ typedef void (*OvsdbMethodCallback)(NMOvsdb *self,
                                     GError  *error,
                                     gpointer user_data);
 
-typedef enum {
-    OVSDB_MONITOR,
-    OVSDB_ADD_INTERFACE,
-    OVSDB_DEL_INTERFACE,
-    OVSDB_SET_INTERFACE_MTU,
-    OVSDB_SET_REAPPLY,
-} OvsdbCommand;
-
 #define CALL_ID_UNSPEC G_MAXUINT64
 
+/* The maximum number of queued calls that get merged into one "transact". */
+#define MERGE_MAX_CALLS 64u
+
 typedef union {
     struct {
     } monitor;
+    struct {
+    } monitor_cond_change;
     struct {
         NMConnection *bridge;
         NMConnection *port;
@@ -120,6 +125,20 @@ typedef struct {
     gpointer            user_data;
     OvsdbMethodPayload  payload;
     GObject            *shutdown_wait_obj;
+
+    /* The operations of this call in the "transact" it was sent with, as
+     * index into the result array. Several calls can share one "transact"
+     * (and thus the same call_id). */
+    guint op_idx;
+    guint op_len;
+
+    /* The call was part of a merged transaction that failed due to another
+     * call. Retry it on its own. */
+    bool no_merge : 1;
+
+    /* The call was in flight when the connection got lost. The server might
+     * have committed it already. */
+    bool resend : 1;
 } OvsdbMethodCall;
 
 /*****************************************************************************/
@@ -156,6 +175,20 @@ typedef struct {
     char       *db_uuid;
     guint       num_failures;
     bool        ready : 1;
+
+    /* The last transaction we have seen with "monitor_cond_since". After
+     * reconnecting, ovsdb-server only sends the changes since then. */
+    char *monitor_txn_id;
+
+    /* With monitor_cond_active, only ports and interfaces with one of these
+     * connection UUIDs (in the external-ids) or names are monitored. */
+    GHashTable *monitor_cond_uuids;
+    GHashTable *monitor_cond_names;
+
+    bool monitor_cond_since_unsupported : 1;
+    bool monitor_cond_active : 1;
+    bool monitor_managed_only : 1;
+
     struct {
         GPtrArray *interfaces;      /* Interface names we are waiting to go away */
         GSource   *timeout_source;  /* After all deletions complete, wait this
@@ -189,6 +222,7 @@ static void     ovsdb_write_try(NMOvsdb *self);
 static gboolean ovsdb_write_cb(int fd, GIOCondition condition, gpointer user_data);
 static void     ovsdb_next_command(NMOvsdb *self);
 static void     cleanup_check_ready(NMOvsdb *self);
+static void     _monitor_cond_prune(NMOvsdb *self);
 
 /*****************************************************************************/
 
@@ -209,6 +243,11 @@ static void     cleanup_check_ready(NMOvsdb *self);
         .monitor = {},                 \
     }))
 
+#define OVSDB_METHOD_PAYLOAD_MONITOR_COND_CHANGE() \
+    (&((const OvsdbMethodPayload){                 \
+        .monitor_cond_change = {},                 \
+    }))
+
 #define OVSDB_METHOD_PAYLOAD_ADD_INTERFACE(xbridge,           \
                                            xport,             \
                                            xinterface,        \
@@ -300,6 +339,7 @@ _call_complete(OvsdbMethodCall *call, json_t *response, GError *error)
 
     switch (call->command) {
     case OVSDB_MONITOR:
+    case OVSDB_MONITOR_COND_CHANGE:
         break;
     case OVSDB_ADD_INTERFACE:
         g_clear_object(&call->payload.add_interface.bridge);
@@ -359,6 +399,7 @@ _free_interface(OpenvswitchInterface *ovs_interface)
     g_free(ovs_interface->interface_uuid);
     g_free(ovs_interface->name);
     g_free(ovs_interface->connection_uuid);
+    g_free(ovs_interface->error);
     g_free(ovs_interface->type);
     nm_g_array_unref(ovs_interface->external_ids);
     nm_g_array_unref(ovs_interface->other_config);
@@ -444,6 +485,9 @@ ovsdb_call_method(NMOvsdb                  *self,
     case OVSDB_MONITOR:
         _LOGT_call(call, "new: monitor");
         break;
+    case OVSDB_MONITOR_COND_CHANGE:
+        _LOGT_call(call, "new: monitor-cond-change");
+        break;
     case OVSDB_ADD_INTERFACE:
         /* FIXME(applied-connection-immutable): we should not modify the applied
          *   connection, consequently there is no need to clone the connections. */
@@ -1264,8 +1308,10 @@ _add_interface(NMOvsdb      *self,
             json_array_append_new(ports, json_pack("[s, s]", "uuid", port_uuid));
 
             if (!ovs_port) {
-                /* This would be a violation of ovsdb's reference integrity (a bug). */
-                _LOGW("Unknown port '%s' in bridge '%s'", port_uuid, ovs_bridge->bridge_uuid);
+                /* This would be a violation of ovsdb's reference integrity (a bug),
+                 * unless we don't monitor the port. */
+                if (!priv->monitor_cond_active)
+                    _LOGW("Unknown port '%s' in bridge '%s'", port_uuid, ovs_bridge->bridge_uuid);
                 continue;
             }
 
@@ -1280,8 +1326,10 @@ _add_interface(NMOvsdb      *self,
                 json_array_append_new(interfaces, json_pack("[s, s]", "uuid", interface_uuid));
 
                 if (!ovs_interface) {
-                    /* This would be a violation of ovsdb's reference integrity (a bug). */
-                    _LOGW("Unknown interface '%s' in port '%s'", interface_uuid, port_uuid);
+                    /* This would be a violation of ovsdb's reference integrity (a bug),
+                     * unless we don't monitor the interface. */
+                    if (!priv->monitor_cond_active)
+                        _LOGW("Unknown interface '%s' in port '%s'", interface_uuid, port_uuid);
                     continue;
                 }
                 if (nm_streq(ovs_interface->name, interface_name)
@@ -1332,13 +1380,13 @@ _add_interface(NMOvsdb      *self,
 }
 
 /**
- * _delete_interface:
+ * _delete_interfaces:
  *
- * Removes an interface of @ifname name, collecting empty ports and bridge
- * if last item is removed from them.
+ * Removes the interfaces with names in @ifnames, collecting empty ports and
+ * bridges if last item is removed from them.
  */
 static void
-_delete_interface(NMOvsdb *self, json_t *params, const char *ifname)
+_delete_interfaces(NMOvsdb *self, json_t *params, const char *const *ifnames)
 {
     NMOvsdbPrivate             *priv = NM_OVSDB_GET_PRIVATE(self);
     GHashTableIter              iter;
@@ -1384,8 +1432,11 @@ _delete_interface(NMOvsdb *self, json_t *params, const char *ifname)
             interfaces_changed = FALSE;
 
             if (!ovs_port) {
-                /* This would be a violation of ovsdb's reference integrity (a bug). */
-                _LOGW("Unknown port '%s' in bridge '%s'", port_uuid, ovs_bridge->bridge_uuid);
+                /* This would be a violation of ovsdb's reference integrity (a bug),
+                 * unless we don't monitor the port. */
+                if (!priv->monitor_cond_active)
+                    _LOGW("Unknown port '%s' in bridge '%s'", port_uuid, ovs_bridge->bridge_uuid);
+                json_array_append_new(new_ports, json_pack("[s,s]", "uuid", port_uuid));
                 continue;
             }
 
@@ -1396,12 +1447,12 @@ _delete_interface(NMOvsdb *self, json_t *params, const char *ifname)
                 json_array_append_new(interfaces, json_pack("[s,s]", "uuid", interface_uuid));
 
                 if (ovs_interface) {
-                    if (nm_streq(ovs_interface->name, ifname)) {
+                    if (nm_strv_find_first(ifnames, -1, ovs_interface->name) >= 0) {
                         /* skip the interface */
                         interfaces_changed = TRUE;
                         continue;
                     }
-                } else {
+                } else if (!priv->monitor_cond_active) {
                     /* This would be a violation of ovsdb's reference integrity (a bug). */
                     _LOGW("Unknown interface '%s' in port '%s'", interface_uuid, port_uuid);
                 }
@@ -1438,163 +1489,432 @@ _delete_interface(NMOvsdb *self, json_t *params, const char *ifname)
 }
 
 /**
- * ovsdb_next_command:
+ * _call_is_state_dependent:
  *
- * Translates a higher level operation (add/remove bridge/port) to a RFC 7047
- * command serialized into JSON ands sends it over to the database.
+ * Adding and removing interfaces include the current bridge, port and
+ * interface lists in their transactions to rule out races. So they can only
+ * be serialized after the previous add or remove completed and the "update"
+ * with its result was processed. The other operations only refer to rows by
+ * name and can be sent at any time.
+ */
+static gboolean
+_call_is_state_dependent(const OvsdbMethodCall *call)
+{
+    return NM_IN_SET(call->command, OVSDB_ADD_INTERFACE, OVSDB_DEL_INTERFACE);
+}
 
- * Only called when no command is waiting for a response, since the serialized
- * command might depend on result of a previous one (add and remove need to
- * include an up to date bridge list in their transactions to rule out races).
+/**
+ * _call_is_done:
+ *
+ * After reconnecting, we don't know whether the calls that were in flight
+ * got committed. Adding and removing interfaces can tell from the resynced
+ * state. Setting the MTU and reapplying only set values and are simply sent
+ * again.
  */
-static void
-ovsdb_next_command(NMOvsdb *self)
+static gboolean
+_call_is_done(NMOvsdb *self, const OvsdbMethodCall *call)
 {
-    NMOvsdbPrivate             *priv = NM_OVSDB_GET_PRIVATE(self);
-    OvsdbMethodCall            *call;
-    nm_auto_free char          *cmd = NULL;
-    nm_auto_decref_json json_t *msg = NULL;
+    NMOvsdbPrivate       *priv = NM_OVSDB_GET_PRIVATE(self);
+    GHashTableIter        iter;
+    OpenvswitchBridge    *ovs_bridge;
+    OpenvswitchPort      *ovs_port;
+    OpenvswitchInterface *ovs_interface;
+    NMConnection         *bridge;
+    NMConnection         *port;
+    NMConnection         *interface;
+    const char           *uuid;
+    guint                 pi;
+    guint                 ii;
 
-    if (priv->conn_fd < 0)
-        return;
+    switch (call->command) {
+    case OVSDB_ADD_INTERFACE:
+        bridge    = call->payload.add_interface.bridge;
+        port      = call->payload.add_interface.port;
+        interface = call->payload.add_interface.interface;
+
+        g_hash_table_iter_init(&iter, priv->bridges);
+        while (g_hash_table_iter_next(&iter, (gpointer) &ovs_bridge, NULL)) {
+            if (!nm_streq0(ovs_bridge->name, nm_connection_get_interface_name(bridge))
+                || !nm_streq0(ovs_bridge->connection_uuid, nm_connection_get_uuid(bridge)))
+                continue;
 
-    if (c_list_is_empty(&priv->calls_lst_head))
-        return;
+            for (pi = 0; pi < ovs_bridge->ports->len; pi++) {
+                uuid     = g_ptr_array_index(ovs_bridge->ports, pi);
+                ovs_port = g_hash_table_lookup(priv->ports, &uuid);
+                if (!ovs_port || !nm_streq0(ovs_port->name, nm_connection_get_interface_name(port))
+                    || !nm_streq0(ovs_port->connection_uuid, nm_connection_get_uuid(port)))
+                    continue;
 
-    call = c_list_first_entry(&priv->calls_lst_head, OvsdbMethodCall, calls_lst);
-    if (call->call_id != CALL_ID_UNSPEC)
-        return;
+                for (ii = 0; ii < ovs_port->interfaces->len; ii++) {
+                    uuid          = g_ptr_array_index(ovs_port->interfaces, ii);
+                    ovs_interface = g_hash_table_lookup(priv->interfaces, &uuid);
+                    if (ovs_interface
+                        && nm_streq0(ovs_interface->name,
+                                     nm_connection_get_interface_name(interface))
+                        && nm_streq0(ovs_interface->connection_uuid,
+                                     nm_connection_get_uuid(interface)))
+                        return TRUE;
+                }
+            }
+        }
+        return FALSE;
+    case OVSDB_DEL_INTERFACE:
+        g_hash_table_iter_init(&iter, priv->interfaces);
+        while (g_hash_table_iter_next(&iter, (gpointer) &ovs_interface, NULL)) {
+            if (nm_streq0(ovs_interface->name, call->payload.del_interface.ifname))
+                return FALSE;
+        }
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
 
-    call->call_id = ++priv->call_id_counter;
+static gboolean
+_call_can_merge(const OvsdbMethodCall *first, const OvsdbMethodCall *call)
+{
+    if (first->no_merge || call->no_merge)
+        return FALSE;
 
-    switch (call->command) {
-    case OVSDB_MONITOR:
-        msg = json_pack("{s:I, s:s, s:[s, n, {"
-                        "  s:[{s:[s, s, s, s]}],"
-                        "  s:[{s:[s, s, s, s]}],"
-                        "  s:[{s:[s, s, s, s, s]}],"
-                        "  s:[{s:[]}]"
-                        "}]}",
+    return nm_ovsdb_command_can_merge(first->command, call->command);
+}
+
+/**
+ * _monitor_cond_where:
+ *
+ * Returns: the "where" condition for the Port and Interface tables, or %NULL
+ *   if all rows are monitored. OVSDB can't select rows that merely have a
+ *   certain key in a map column, so we match the connection UUIDs and names
+ *   NetworkManager knows about. The clauses of the condition are or-ed.
+ */
+static json_t *
+_monitor_cond_where(NMOvsdb *self)
+{
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+    GHashTableIter  iter;
+    const char     *str;
+    json_t         *where;
+
+    if (!priv->monitor_cond_active)
+        return NULL;
+
+    where = json_array();
+
+    g_hash_table_iter_init(&iter, priv->monitor_cond_uuids);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &str, NULL)) {
+        json_array_append_new(where,
+                              json_pack("[s, s, [s, [[s, s]]]]",
+                                        "external_ids",
+                                        "includes",
+                                        "map",
+                                        NM_OVS_EXTERNAL_ID_NM_CONNECTION_UUID,
+                                        str));
+    }
+
+    g_hash_table_iter_init(&iter, priv->monitor_cond_names);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &str, NULL))
+        json_array_append_new(where, json_pack("[s, s, s]", "name", "==", str));
+
+    if (json_array_size(where) == 0)
+        json_array_append_new(where, json_false());
+
+    return where;
+}
+
+static json_t *
+_monitor_requests(NMOvsdb *self)
+{
+    nm_auto_decref_json json_t *where = NULL;
+    json_t                     *port;
+    json_t                     *interface;
+
+    port      = json_pack("{s:[s, s, s, s]}",
+                     "columns",
+                     "name",
+                     "interfaces",
+                     "external_ids",
+                     "other_config");
+    interface = json_pack("{s:[s, s, s, s, s]}",
+                          "columns",
+                          "name",
+                          "type",
+                          "external_ids",
+                          "other_config",
+                          "error");
+
+    where = _monitor_cond_where(self);
+    if (where) {
+        json_object_set(port, "where", where);
+        json_object_set(interface, "where", where);
+    }
+
+    return json_pack("{s:[{s:[s, s, s, s]}], s:[o], s:[o], s:[{s:[]}]}",
+                     "Bridge",
+                     "columns",
+                     "name",
+                     "ports",
+                     "external_ids",
+                     "other_config",
+                     "Port",
+                     port,
+                     "Interface",
+                     interface,
+                     "Open_vSwitch",
+                     "columns");
+}
+
+static gboolean
+_ovsdb_next_command_one(NMOvsdb *self)
+{
+    NMOvsdbPrivate              *priv          = NM_OVSDB_GET_PRIVATE(self);
+    OvsdbMethodCall             *call;
+    OvsdbMethodCall             *first         = NULL;
+    gboolean                     state_pending = FALSE;
+    nm_auto_free char           *cmd           = NULL;
+    nm_auto_decref_json json_t  *msg           = NULL;
+    gs_unref_ptrarray GPtrArray *del_ifnames   = NULL;
+    guint64                      prev_call_id  = CALL_ID_UNSPEC;
+    guint64                      call_id;
+    guint                        n_calls;
+
+    c_list_for_each_entry (call, &priv->calls_lst_head, calls_lst) {
+        if (call->call_id == CALL_ID_UNSPEC) {
+            if (!first)
+                first = call;
+            continue;
+        }
+        if (NM_IN_SET(call->command, OVSDB_MONITOR, OVSDB_MONITOR_COND_CHANGE)) {
+            /* Wait until we are in sync. */
+            return FALSE;
+        }
+        if (call->call_id == prev_call_id) {
+            /* A merged transaction is in flight. If it fails, its calls are
+             * sent again on their own (see _calls_complete_merged()). Later
+             * calls must not overtake them. */
+            return FALSE;
+        }
+        prev_call_id = call->call_id;
+        if (_call_is_state_dependent(call))
+            state_pending = TRUE;
+    }
+
+    if (!first)
+        return FALSE;
+
+    if (_call_is_state_dependent(first) && state_pending)
+        return FALSE;
+
+    if (first->resend) {
+        first->resend = FALSE;
+        if (_call_is_done(self, first)) {
+            nm_auto_decref_json json_t *result = json_array();
+
+            _LOGT_call(first, "already committed before reconnecting");
+            _call_complete(first, result, NULL);
+            return TRUE;
+        }
+    }
+
+    call_id = ++priv->call_id_counter;
+
+    if (first->command == OVSDB_MONITOR) {
+        first->call_id = call_id;
+        if (priv->monitor_cond_since_unsupported) {
+            msg = json_pack("{s:I, s:s, s:[s, n, o]}",
+                            "id",
+                            (json_int_t) call_id,
+                            "method",
+                            "monitor",
+                            "params",
+                            "Open_vSwitch",
+                            _monitor_requests(self));
+        } else {
+            msg = json_pack("{s:I, s:s, s:[s, s, o, s]}",
+                            "id",
+                            (json_int_t) call_id,
+                            "method",
+                            "monitor_cond_since",
+                            "params",
+                            "Open_vSwitch",
+                            MONITOR_ID,
+                            _monitor_requests(self),
+                            priv->monitor_txn_id ?: MONITOR_TXN_ID_NONE);
+        }
+        n_calls = 1;
+    } else if (first->command == OVSDB_MONITOR_COND_CHANGE) {
+        nm_auto_decref_json json_t *where = NULL;
+
+        first->call_id = call_id;
+        where          = _monitor_cond_where(self);
+        msg            = json_pack("{s:I, s:s, s:[s, s, {s:[{s:O}], s:[{s:O}]}]}",
                         "id",
-                        (json_int_t) call->call_id,
+                        (json_int_t) call_id,
                         "method",
-                        "monitor",
+                        "monitor_cond_change",
                         "params",
-                        "Open_vSwitch",
-                        "Bridge",
-                        "columns",
-                        "name",
-                        "ports",
-                        "external_ids",
-                        "other_config",
+                        MONITOR_ID,
+                        MONITOR_ID,
                         "Port",
-                        "columns",
-                        "name",
-                        "interfaces",
-                        "external_ids",
-                        "other_config",
+                        "where",
+                        where,
                         "Interface",
-                        "columns",
-                        "name",
-                        "type",
-                        "external_ids",
-                        "other_config",
-                        "error",
-                        "Open_vSwitch",
-                        "columns");
-        break;
-    default:
-    {
+                        "where",
+                        where);
+        n_calls = 1;
+    } else {
         json_t *params = NULL;
 
         params = json_array();
         json_array_append_new(params, json_string("Open_vSwitch"));
         json_array_append_new(params, _inc_next_cfg(priv->db_uuid));
 
-        switch (call->command) {
-        case OVSDB_ADD_INTERFACE:
-            _add_interface(self,
-                           params,
-                           call->payload.add_interface.bridge,
-                           call->payload.add_interface.port,
-                           call->payload.add_interface.interface,
-                           call->payload.add_interface.bridge_device,
-                           call->payload.add_interface.interface_device);
-            break;
-        case OVSDB_DEL_INTERFACE:
-            _delete_interface(self, params, call->payload.del_interface.ifname);
-            break;
-        case OVSDB_SET_INTERFACE_MTU:
-            json_array_append_new(params,
-                                  json_pack("{s:s, s:s, s:{s: I}, s:[[s, s, s]]}",
-                                            "op",
-                                            "update",
-                                            "table",
-                                            "Interface",
-                                            "row",
-                                            "mtu_request",
-                                            (json_int_t) call->payload.set_interface_mtu.mtu,
-                                            "where",
-                                            "name",
-                                            "==",
-                                            call->payload.set_interface_mtu.ifname));
-            break;
-        case OVSDB_SET_REAPPLY:
-        {
-            json_t *mutations;
-
-            mutations = json_array();
-
-            _j_create_strv_array_update(mutations,
-                                        STRDICT_TYPE_EXTERNAL_IDS,
-                                        call->payload.set_reapply.connection_uuid,
-                                        call->payload.set_reapply.external_ids_old,
-                                        call->payload.set_reapply.external_ids_new);
-            _j_create_strv_array_update(mutations,
-                                        STRDICT_TYPE_OTHER_CONFIG,
-                                        NULL,
-                                        call->payload.set_reapply.other_config_old,
-                                        call->payload.set_reapply.other_config_new);
+        n_calls = 0;
+        call    = first;
+        while (TRUE) {
+            call->call_id = call_id;
+            call->op_idx  = json_array_size(params) - 1u;
+            n_calls++;
+
+            switch (call->command) {
+            case OVSDB_ADD_INTERFACE:
+                _add_interface(self,
+                               params,
+                               call->payload.add_interface.bridge,
+                               call->payload.add_interface.port,
+                               call->payload.add_interface.interface,
+                               call->payload.add_interface.bridge_device,
+                               call->payload.add_interface.interface_device);
+                break;
+            case OVSDB_DEL_INTERFACE:
+                if (!del_ifnames)
+                    del_ifnames = g_ptr_array_new();
+                g_ptr_array_add(del_ifnames, call->payload.del_interface.ifname);
+                break;
+            case OVSDB_SET_INTERFACE_MTU:
+                json_array_append_new(params,
+                                      json_pack("{s:s, s:s, s:{s: I}, s:[[s, s, s]]}",
+                                                "op",
+                                                "update",
+                                                "table",
+                                                "Interface",
+                                                "row",
+                                                "mtu_request",
+                                                (json_int_t) call->payload.set_interface_mtu.mtu,
+                                                "where",
+                                                "name",
+                                                "==",
+                                                call->payload.set_interface_mtu.ifname));
+                break;
+            case OVSDB_SET_REAPPLY:
+            {
+                json_t *mutations;
+
+                mutations = json_array();
+
+                _j_create_strv_array_update(mutations,
+                                            STRDICT_TYPE_EXTERNAL_IDS,
+                                            call->payload.set_reapply.connection_uuid,
+                                            call->payload.set_reapply.external_ids_old,
+                                            call->payload.set_reapply.external_ids_new);
+                _j_create_strv_array_update(mutations,
+                                            STRDICT_TYPE_OTHER_CONFIG,
+                                            NULL,
+                                            call->payload.set_reapply.other_config_old,
+                                            call->payload.set_reapply.other_config_new);
+
+                json_array_append_new(
+                    params,
+                    json_pack("{s:s, s:s, s:o, s:[[s, s, s]]}",
+                              "op",
+                              "mutate",
+                              "table",
+                              _device_type_to_table(call->payload.set_reapply.device_type),
+                              "mutations",
+                              mutations,
+                              "where",
+                              "name",
+                              "==",
+                              call->payload.set_reapply.ifname));
+                break;
+            }
+            default:
+                nm_assert_not_reached();
+                break;
+            }
 
-            json_array_append_new(
-                params,
-                json_pack("{s:s, s:s, s:o, s:[[s, s, s]]}",
-                          "op",
-                          "mutate",
-                          "table",
-                          _device_type_to_table(call->payload.set_reapply.device_type),
-                          "mutations",
-                          mutations,
-                          "where",
-                          "name",
-                          "==",
-                          call->payload.set_reapply.ifname));
-            break;
+            call->op_len = (json_array_size(params) - 1u) - call->op_idx;
+
+            if (n_calls >= MERGE_MAX_CALLS)
+                break;
+            if (call->calls_lst.next == &priv->calls_lst_head)
+                break;
+            call = c_list_entry(call->calls_lst.next, OvsdbMethodCall, calls_lst);
+            if (call->call_id != CALL_ID_UNSPEC || !_call_can_merge(first, call))
+                break;
         }
 
-        default:
-            nm_assert_not_reached();
-            break;
+        if (del_ifnames) {
+            g_ptr_array_add(del_ifnames, NULL);
+            _delete_interfaces(self, params, (const char *const *) del_ifnames->pdata);
+            c_list_for_each_entry (call, &priv->calls_lst_head, calls_lst) {
+                if (call->call_id == call_id)
+                    call->op_len = (json_array_size(params) - 1u) - call->op_idx;
+            }
         }
 
         msg = json_pack("{s:I, s:s, s:o}",
                         "id",
-                        (json_int_t) call->call_id,
+                        (json_int_t) call_id,
                         "method",
                         "transact",
                         "params",
                         params);
-        break;
-    }
     }
 
-    g_return_if_fail(msg);
+    g_return_val_if_fail(msg, FALSE);
 
     cmd = json_dumps(msg, 0);
-    _LOGT_call(call, "send: call-id=%" G_GUINT64_FORMAT ", %s", call->call_id, cmd);
+    if (n_calls > 1) {
+        _LOGT_call(first,
+                   "send: call-id=%" G_GUINT64_FORMAT " (merged %u calls), %s",
+                   call_id,
+                   n_calls,
+                   cmd);
+    } else
+        _LOGT_call(first, "send: call-id=%" G_GUINT64_FORMAT ", %s", call_id, cmd);
     nm_str_buf_append(&priv->output_buf, cmd);
 
-    ovsdb_write_try(self);
+    return TRUE;
+}
+
+/**
+ * ovsdb_next_command:
+ *
+ * Translates a higher level operation (add/remove bridge/port) to a RFC 7047
+ * command serialized into JSON ands sends it over to the database.
+ *
+ * Queued calls are sent in order and without waiting for the replies of the
+ * previous ones, except that nothing is sent while the monitor call or a
+ * merged transaction is pending and that adding or removing interfaces waits
+ * for the previous add or remove to complete (see _call_is_state_dependent()).
+ * Consecutive calls that are compatible are merged into one "transact" with
+ * multiple operations.
+ */
+static void
+ovsdb_next_command(NMOvsdb *self)
+{
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+    gboolean        sent = FALSE;
+
+    if (priv->conn_fd < 0)
+        return;
+
+    /* Completing a call invokes its callback, which might disconnect us. */
+    while (priv->conn_fd >= 0 && _ovsdb_next_command_one(self))
+        sent = TRUE;
+
+    if (sent)
+        ovsdb_write_try(self);
 }
 
 /**
@@ -1935,6 +2255,8 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
                                       ovs_interface->type);
         }
 
+        nm_strdup_reset(&ovs_interface->error, json_string_value(error));
+
         /* The error is a string. No error is indicated by an empty set,
          * Why not: [ "set": [] ] ? */
         if (error && json_is_string(error)) {
@@ -2182,6 +2504,162 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
             _signal_emit_device_added(self, ovs_bridge->name, NM_DEVICE_TYPE_OVS_BRIDGE, NULL);
         }
     }
+
+    _monitor_cond_prune(self);
+}
+
+/*****************************************************************************/
+
+static json_t *
+_strdict_to_json(const GArray *arr)
+{
+    json_t *pairs;
+    guint   i;
+
+    pairs = json_array();
+    for (i = 0; i < nm_g_array_len(arr); i++) {
+        const NMUtilsNamedValue *n = &nm_g_array_index(arr, NMUtilsNamedValue, i);
+
+        json_array_append_new(pairs, json_pack("[s, s]", n->name, n->value_str));
+    }
+    return json_pack("[s, o]", "map", pairs);
+}
+
+static json_t *
+_uuids_to_json(const GPtrArray *arr)
+{
+    json_t *uuids;
+    guint   i;
+
+    uuids = json_array();
+    for (i = 0; i < arr->len; i++)
+        json_array_append_new(uuids, json_pack("[s, s]", "uuid", arr->pdata[i]));
+    return json_pack("[s, o]", "set", uuids);
+}
+
+static json_t *
+_row_to_json(const char *table, const char *uuid, gpointer user_data)
+{
+    NMOvsdb        *self = user_data;
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+
+    if (nm_streq(table, "Interface")) {
+        const OpenvswitchInterface *ovs_interface;
+
+        ovs_interface = g_hash_table_lookup(priv->interfaces, &uuid);
+        if (!ovs_interface)
+            return NULL;
+        return json_pack("{s:s, s:s, s:o, s:o, s:o}",
+                         "name",
+                         ovs_interface->name,
+                         "type",
+                         ovs_interface->type ?: "",
+                         "external_ids",
+                         _strdict_to_json(ovs_interface->external_ids),
+                         "other_config",
+                         _strdict_to_json(ovs_interface->other_config),
+                         "error",
+                         ovs_interface->error ? json_string(ovs_interface->error)
+                                              : json_pack("[s, []]", "set"));
+    }
+    if (nm_streq(table, "Port")) {
+        const OpenvswitchPort *ovs_port;
+
+        ovs_port = g_hash_table_lookup(priv->ports, &uuid);
+        if (!ovs_port)
+            return NULL;
+        return json_pack("{s:s, s:o, s:o, s:o}",
+                         "name",
+                         ovs_port->name,
+                         "interfaces",
+                         _uuids_to_json(ovs_port->interfaces),
+                         "external_ids",
+                         _strdict_to_json(ovs_port->external_ids),
+                         "other_config",
+                         _strdict_to_json(ovs_port->other_config));
+    }
+    if (nm_streq(table, "Bridge")) {
+        const OpenvswitchBridge *ovs_bridge;
+
+        ovs_bridge = g_hash_table_lookup(priv->bridges, &uuid);
+        if (!ovs_bridge)
+            return NULL;
+        return json_pack("{s:s, s:o, s:o, s:o}",
+                         "name",
+                         ovs_bridge->name,
+                         "ports",
+                         _uuids_to_json(ovs_bridge->ports),
+                         "external_ids",
+                         _strdict_to_json(ovs_bridge->external_ids),
+                         "other_config",
+                         _strdict_to_json(ovs_bridge->other_config));
+    }
+    return json_object();
+}
+
+/**
+ * _table_updates_add_stale:
+ *
+ * After (re)connecting, @updates has all the rows we monitor. Add an "old"
+ * entry for the cached rows that are no longer there.
+ */
+static void
+_table_updates_add_stale(NMOvsdb *self, json_t *updates)
+{
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+    const struct {
+        const char *table;
+        GHashTable *cache;
+    } tables[] = {
+        {"Interface", priv->interfaces},
+        {"Port", priv->ports},
+        {"Bridge", priv->bridges},
+    };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(tables); i++) {
+        json_t        *table_updates;
+        GHashTableIter iter;
+        const char   **p_uuid;
+
+        table_updates = json_object_get(updates, tables[i].table);
+        if (!table_updates) {
+            table_updates = json_object();
+            json_object_set_new(updates, tables[i].table, table_updates);
+        }
+
+        /* The uuid is the first field of the cached structs. */
+        g_hash_table_iter_init(&iter, tables[i].cache);
+        while (g_hash_table_iter_next(&iter, (gpointer *) &p_uuid, NULL)) {
+            if (!json_object_get(table_updates, *p_uuid))
+                json_object_set_new(table_updates, *p_uuid, json_pack("{s:{}}", "old"));
+        }
+    }
+}
+
+static void
+_monitor_set_txn_id(NMOvsdb *self, json_t *txn_id)
+{
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+
+    if (json_is_string(txn_id))
+        nm_strdup_reset(&priv->monitor_txn_id, json_string_value(txn_id));
+}
+
+/**
+ * ovsdb_got_update3:
+ *
+ * Called for the "update3" notifications of "monitor_cond_since", that
+ * only contain the changed columns of modified rows.
+ */
+static void
+ovsdb_got_update3(NMOvsdb *self, json_t *params)
+{
+    nm_auto_decref_json json_t *updates = NULL;
+
+    updates = nm_ovsdb_table_updates2_convert(json_array_get(params, 2), _row_to_json, self);
+    ovsdb_got_update(self, updates);
+    _monitor_set_txn_id(self, json_array_get(params, 1));
 }
 
 /**
@@ -2207,6 +2685,69 @@ ovsdb_got_echo(NMOvsdb *self, json_int_t id, json_t *data)
     ovsdb_write_try(self);
 }
 
+static OvsdbMethodCall *
+_call_find_by_id(NMOvsdb *self, guint64 call_id, guint *out_num)
+{
+    NMOvsdbPrivate  *priv  = NM_OVSDB_GET_PRIVATE(self);
+    OvsdbMethodCall *found = NULL;
+    OvsdbMethodCall *call;
+    guint            num   = 0;
+
+    c_list_for_each_entry (call, &priv->calls_lst_head, calls_lst) {
+        if (call->call_id != call_id)
+            continue;
+        if (!found)
+            found = call;
+        num++;
+        if (!out_num)
+            break;
+    }
+
+    NM_SET_OUT(out_num, num);
+    return found;
+}
+
+/**
+ * _calls_complete_merged:
+ *
+ * Completes the calls that were sent together in one transaction. Each call
+ * gets the results of its own operations. If an operation failed, OVSDB
+ * aborted the whole transaction: the call that owns the failing operation
+ * gets the error, the others are queued again and will be sent on their own.
+ */
+static void
+_calls_complete_merged(NMOvsdb *self, guint64 call_id, json_t *result, GError *error)
+{
+    NMOvsdbPrivate  *priv    = NM_OVSDB_GET_PRIVATE(self);
+    OvsdbMethodCall *call;
+    gssize           err_idx = -1;
+
+    if (!error)
+        err_idx = nm_ovsdb_result_find_error(result);
+
+    while ((call = _call_find_by_id(self, call_id, NULL))) {
+        nm_auto_decref_json json_t *slice = NULL;
+
+        if (error || !json_is_array(result)) {
+            _call_complete(call, result, error);
+        } else if (err_idx < 0
+                   || nm_ovsdb_result_owns_error(call->command,
+                                                 err_idx,
+                                                 call->op_idx,
+                                                 call->op_len)) {
+            slice = nm_ovsdb_result_slice(result, call->op_idx, call->op_len);
+            _call_complete(call, slice, NULL);
+        } else {
+            _LOGT_call(call, "requeue after the merged transaction failed");
+            call->call_id  = CALL_ID_UNSPEC;
+            call->no_merge = TRUE;
+        }
+
+        if (priv->conn_fd < 0)
+            return;
+    }
+}
+
 /**
  * ovsdb_got_msg::
  *
@@ -2261,6 +2802,9 @@ ovsdb_got_msg(NMOvsdb *self, json_t *msg)
         if (nm_streq0(method, "update")) {
             /* This is a update method call. */
             ovsdb_got_update(self, json_array_get(params, 1));
+        } else if (nm_streq0(method, "update3")) {
+            /* An update of our "monitor_cond_since" monitor. */
+            ovsdb_got_update3(self, params);
         } else if (nm_streq0(method, "echo")) {
             /* This is an echo request. */
             ovsdb_got_echo(self, id, params);
@@ -2274,21 +2818,16 @@ ovsdb_got_msg(NMOvsdb *self, json_t *msg)
         OvsdbMethodCall      *call;
         gs_free_error GError *local      = NULL;
         gs_free char         *msg_as_str = NULL;
+        guint                 num_calls;
 
-        /* This is a response to a method call. */
-        if (c_list_is_empty(&priv->calls_lst_head)) {
+        /* This is a response to a method call. Calls are pipelined, so it is
+         * not necessarily the first one in the queue. */
+        call = _call_find_by_id(self, id, &num_calls);
+        if (!call) {
             _LOGW("there are no queued calls expecting response %" G_GUINT64_FORMAT, (guint64) id);
             ovsdb_disconnect(self, FALSE, FALSE);
             return;
         }
-        call = c_list_first_entry(&priv->calls_lst_head, OvsdbMethodCall, calls_lst);
-        if (call->call_id != id) {
-            _LOGW("expected a response to call %" G_GUINT64_FORMAT ", not %" G_GUINT64_FORMAT,
-                  call->call_id,
-                  (guint64) id);
-            ovsdb_disconnect(self, FALSE, FALSE);
-            return;
-        }
         /* Cool, we found a corresponding call. Finish it. */
 
         _LOGT_call(call, "response: %s", (msg_as_str = json_dumps(msg, 0)));
@@ -2302,7 +2841,10 @@ ovsdb_got_msg(NMOvsdb *self, json_t *msg)
                         json_string_value(error));
         }
 
-        _call_complete(call, result, local);
+        if (num_calls == 1)
+            _call_complete(call, result, local);
+        else
+            _calls_complete_merged(self, id, result, local);
 
         priv->num_failures = 0;
 
@@ -2311,6 +2853,8 @@ ovsdb_got_msg(NMOvsdb *self, json_t *msg)
         if (priv->conn_fd < 0)
             return;
 
+        _monitor_cond_prune(self);
+
         /* Now we're free to serialize and send the next command, if any. */
         ovsdb_next_command(self);
 
@@ -2545,9 +3089,18 @@ ovsdb_disconnect(NMOvsdb *self, gboolean retry, gboolean is_disposing)
      * shutting down, and cancel the remaining calls after the timeout. */
 
     if (retry) {
-        if (!c_list_is_empty(&priv->calls_lst_head)) {
-            call          = c_list_first_entry(&priv->calls_lst_head, OvsdbMethodCall, calls_lst);
+        /* Pipelined calls might be in flight. Send them again after
+         * reconnecting, unless the resynced state shows that they were
+         * committed (see _call_is_done()). */
+        c_list_for_each_entry (call, &priv->calls_lst_head, calls_lst) {
+            if (call->call_id != CALL_ID_UNSPEC)
+                call->resend = TRUE;
             call->call_id = CALL_ID_UNSPEC;
+
+            /* The new monitor already uses the new condition. Rows that
+             * only match the new condition might be missing in our view. */
+            if (call->command == OVSDB_MONITOR_COND_CHANGE)
+                nm_clear_g_free(&priv->monitor_txn_id);
         }
     } else {
         gs_free_error GError *error = NULL;
@@ -2585,6 +3138,7 @@ cleanup_emit_ready(NMOvsdb *self, const char *reason)
     nm_clear_g_signal_handler(priv->platform, &priv->cleanup.link_changed_id);
 
     priv->ready = TRUE;
+    _monitor_cond_start(self);
     g_signal_emit(self, signals[READY], 0);
     nm_manager_unblock_failed_ovs_interfaces(nm_manager_get());
 }
@@ -2741,20 +3295,212 @@ ovsdb_cleanup_initial_interfaces(NMOvsdb *self)
     cleanup_check_ready(self);
 }
 
+static void
+_monitor_cond_change_cb(NMOvsdb *self, json_t *result, GError *error, gpointer user_data)
+{
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+
+    if (!error || !g_error_matches(error, G_IO_ERROR, G_IO_ERROR_FAILED))
+        return;
+
+    /* Our view might be incomplete now. Start over, monitoring everything. */
+    _LOGI("monitor_cond_change failed (%s), monitor all rows", error->message);
+    priv->monitor_cond_active = FALSE;
+    nm_clear_g_free(&priv->monitor_txn_id);
+    ovsdb_disconnect(self, TRUE, FALSE);
+}
+
+static void
+_monitor_cond_changed(NMOvsdb *self)
+{
+    NMOvsdbPrivate  *priv = NM_OVSDB_GET_PRIVATE(self);
+    OvsdbMethodCall *call;
+
+    c_list_for_each_entry (call, &priv->calls_lst_head, calls_lst) {
+        if (call->command == OVSDB_MONITOR_COND_CHANGE && call->call_id == CALL_ID_UNSPEC) {
+            /* The condition is only evaluated when sending it. */
+            return;
+        }
+    }
+
+    ovsdb_call_method(self,
+                      _monitor_cond_change_cb,
+                      NULL,
+                      FALSE,
+                      OVSDB_MONITOR_COND_CHANGE,
+                      OVSDB_METHOD_PAYLOAD_MONITOR_COND_CHANGE());
+}
+
+static void
+_monitor_cond_add(NMOvsdb *self, GHashTable *set, const char *str)
+{
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+
+    if (!priv->monitor_cond_active || !str || g_hash_table_contains(set, str))
+        return;
+
+    g_hash_table_add(set, g_strdup(str));
+    _monitor_cond_changed(self);
+}
+
+/**
+ * _monitor_cond_prune:
+ *
+ * Stop monitoring the connection UUIDs and names that are no longer needed:
+ * those of rows that were removed or are no longer managed by us, and that
+ * no queued call refers to.
+ */
+static void
+_monitor_cond_prune(NMOvsdb *self)
+{
+    NMOvsdbPrivate                *priv    = NM_OVSDB_GET_PRIVATE(self);
+    gs_unref_hashtable GHashTable *needed  = NULL;
+    const OpenvswitchPort         *ovs_port;
+    const OpenvswitchInterface    *ovs_interface;
+    const OvsdbMethodCall         *call;
+    GHashTableIter                 iter;
+    const char                    *str;
+    gboolean                       changed = FALSE;
+
+    if (!priv->monitor_cond_active)
+        return;
+
+    needed = g_hash_table_new(nm_str_hash, g_str_equal);
+
+    g_hash_table_iter_init(&iter, priv->ports);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &ovs_port, NULL)) {
+        if (ovs_port->connection_uuid)
+            g_hash_table_add(needed, ovs_port->connection_uuid);
+    }
+    g_hash_table_iter_init(&iter, priv->interfaces);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &ovs_interface, NULL)) {
+        if (ovs_interface->connection_uuid)
+            g_hash_table_add(needed, ovs_interface->connection_uuid);
+    }
+    c_list_for_each_entry (call, &priv->calls_lst_head, calls_lst) {
+        NMConnection *connections[3];
+        guint         i;
+
+        if (call->command != OVSDB_ADD_INTERFACE)
+            continue;
+
+        connections[0] = call->payload.add_interface.bridge;
+        connections[1] = call->payload.add_interface.port;
+        connections[2] = call->payload.add_interface.interface;
+        for (i = 0; i < G_N_ELEMENTS(connections); i++) {
+            str = nm_connection_get_uuid(connections[i]);
+            if (str)
+                g_hash_table_add(needed, (char *) str);
+        }
+    }
+
+    g_hash_table_iter_init(&iter, priv->monitor_cond_uuids);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &str, NULL)) {
+        if (!g_hash_table_contains(needed, str)) {
+            g_hash_table_iter_remove(&iter);
+            changed = TRUE;
+        }
+    }
+
+    g_hash_table_remove_all(needed);
+    c_list_for_each_entry (call, &priv->calls_lst_head, calls_lst) {
+        if (call->command == OVSDB_DEL_INTERFACE)
+            g_hash_table_add(needed, call->payload.del_interface.ifname);
+    }
+
+    g_hash_table_iter_init(&iter, priv->monitor_cond_names);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &str, NULL)) {
+        if (!g_hash_table_contains(needed, str)) {
+            g_hash_table_iter_remove(&iter);
+            changed = TRUE;
+        }
+    }
+
+    if (changed)
+        _monitor_cond_changed(self);
+}
+
+/**
+ * _monitor_cond_start:
+ *
+ * Once the initial cleanup is done, restrict the monitor to the ports and
+ * interfaces of NetworkManager, if configured. This matters on hosts with
+ * many OVS ports that are managed by somebody else.
+ */
+static void
+_monitor_cond_start(NMOvsdb *self)
+{
+    NMOvsdbPrivate             *priv = NM_OVSDB_GET_PRIVATE(self);
+    const OpenvswitchPort      *ovs_port;
+    const OpenvswitchInterface *ovs_interface;
+    GHashTableIter              iter;
+
+    if (!priv->monitor_managed_only || priv->monitor_cond_since_unsupported
+        || priv->monitor_cond_active)
+        return;
+
+    g_hash_table_iter_init(&iter, priv->ports);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &ovs_port, NULL)) {
+        if (ovs_port->connection_uuid)
+            g_hash_table_add(priv->monitor_cond_uuids, g_strdup(ovs_port->connection_uuid));
+    }
+    g_hash_table_iter_init(&iter, priv->interfaces);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &ovs_interface, NULL)) {
+        if (ovs_interface->connection_uuid)
+            g_hash_table_add(priv->monitor_cond_uuids, g_strdup(ovs_interface->connection_uuid));
+    }
+
+    _LOGD("monitor: only monitor ports and interfaces of NetworkManager");
+    priv->monitor_cond_active = TRUE;
+    _monitor_cond_changed(self);
+}
+
 static void
 _monitor_bridges_cb(NMOvsdb *self, json_t *result, GError *error, gpointer user_data)
 {
+    NMOvsdbPrivate             *priv    = NM_OVSDB_GET_PRIVATE(self);
+    nm_auto_decref_json json_t *updates = NULL;
+
     if (error) {
-        if (!nm_utils_error_is_cancelled_or_disposing(error)) {
-            _LOGI("%s", error->message);
-            ovsdb_disconnect(self, FALSE, FALSE);
+        if (nm_utils_error_is_cancelled_or_disposing(error))
+            return;
+        if (!priv->monitor_cond_since_unsupported
+            && g_error_matches(error, G_IO_ERROR, G_IO_ERROR_FAILED)) {
+            /* ovsdb-server before 2.12 doesn't know "monitor_cond_since". */
+            _LOGD("monitor_cond_since failed (%s), fall back to monitor", error->message);
+            priv->monitor_cond_since_unsupported = TRUE;
+            priv->monitor_cond_active            = FALSE;
+            ovsdb_call_method(self,
+                              _monitor_bridges_cb,
+                              NULL,
+                              TRUE,
+                              OVSDB_MONITOR,
+                              OVSDB_METHOD_PAYLOAD_MONITOR());
+            return;
         }
+        _LOGI("%s", error->message);
+        ovsdb_disconnect(self, FALSE, FALSE);
         return;
     }
 
+    if (priv->monitor_cond_since_unsupported) {
+        updates = json_incref(result);
+        _table_updates_add_stale(self, updates);
+    } else {
+        json_t *found = json_array_get(result, 0);
+
+        updates = nm_ovsdb_table_updates2_convert(json_array_get(result, 2), _row_to_json, self);
+        if (!json_is_true(found)) {
+            /* Not only the changes since monitor_txn_id, but all rows. */
+            _table_updates_add_stale(self, updates);
+        } else
+            _LOGT("monitor: resumed after transaction %s", priv->monitor_txn_id);
+        _monitor_set_txn_id(self, json_array_get(result, 1));
+    }
+
     /* Treat the first response the same as the subsequent "update"
      * messages we eventually get. */
-    ovsdb_got_update(self, result);
+    ovsdb_got_update(self, updates);
 
     ovsdb_cleanup_initial_interfaces(self);
 }
@@ -2930,6 +3676,13 @@ nm_ovsdb_add_interface(NMOvsdb        *self,
                        NMOvsdbCallback callback,
                        gpointer        user_data)
 {
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+
+    /* The rows must be monitored before they are created. */
+    _monitor_cond_add(self, priv->monitor_cond_uuids, nm_connection_get_uuid(bridge));
+    _monitor_cond_add(self, priv->monitor_cond_uuids, nm_connection_get_uuid(port));
+    _monitor_cond_add(self, priv->monitor_cond_uuids, nm_connection_get_uuid(interface));
+
     ovsdb_call_method(self,
                       _transact_cb,
                       ovsdb_call_new(callback, user_data),
@@ -2948,6 +3701,10 @@ nm_ovsdb_del_interface(NMOvsdb        *self,
                        NMOvsdbCallback callback,
                        gpointer        user_data)
 {
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+
+    _monitor_cond_add(self, priv->monitor_cond_names, ifname);
+
     ovsdb_call_method(self,
                       _transact_cb,
                       ovsdb_call_new(callback, user_data),
@@ -3041,6 +3798,14 @@ nm_ovsdb_init(NMOvsdb *self)
     priv->interfaces =
         g_hash_table_new_full(nm_pstr_hash, nm_pstr_equal, (GDestroyNotify) _free_interface, NULL);
 
+    priv->monitor_cond_uuids = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+    priv->monitor_cond_names = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+    priv->monitor_managed_only =
+        nm_config_data_get_value_boolean(NM_CONFIG_GET_DATA,
+                                         NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                         NM_CONFIG_KEYFILE_KEY_MAIN_OVS_MONITOR_MANAGED_ONLY,
+                                         FALSE);
+
     ovsdb_try_connect(self);
 }
 
@@ -3061,6 +3826,9 @@ dispose(GObject *object)
     nm_clear_pointer(&priv->bridges, g_hash_table_destroy);
     nm_clear_pointer(&priv->ports, g_hash_table_destroy);
     nm_clear_pointer(&priv->interfaces, g_hash_table_destroy);
+    nm_clear_pointer(&priv->monitor_cond_uuids, g_hash_table_destroy);
+    nm_clear_pointer(&priv->monitor_cond_names, g_hash_table_destroy);
+    nm_clear_g_free(&priv->monitor_txn_id);
 
     G_OBJECT_CLASS(nm_ovsdb_parent_class)->dispose(object);
 }
@@ -0,0 +1,252 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "devices/ovs/nm-ovsdb-utils.h"
+
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+static json_t *
+_json_parse(const char *str)
+{
+    json_error_t error;
+    json_t      *json;
+
+    json = json_loads(str, 0, &error);
+    g_assert(json);
+    return json;
+}
+
+#define _assert_json(json, expected)                                        \
+    G_STMT_START                                                            \
+    {                                                                       \
+        nm_auto_decref_json json_t *_expected = _json_parse(expected);      \
+                                                                            \
+        if (!json_equal((json), _expected)) {                               \
+            nm_auto_free char *_str = json_dumps((json), 0);                 \
+                                                                            \
+            g_error("unexpected json: %s (expected %s)", _str, (expected)); \
+        }                                                                   \
+    }                                                                       \
+    G_STMT_END
+
+/*****************************************************************************/
+
+static void
+test_command_can_merge(void)
+{
+    g_assert(nm_ovsdb_command_can_merge(OVSDB_DEL_INTERFACE, OVSDB_DEL_INTERFACE));
+    g_assert(!nm_ovsdb_command_can_merge(OVSDB_DEL_INTERFACE, OVSDB_SET_INTERFACE_MTU));
+    g_assert(!nm_ovsdb_command_can_merge(OVSDB_DEL_INTERFACE, OVSDB_ADD_INTERFACE));
+
+    g_assert(nm_ovsdb_command_can_merge(OVSDB_SET_INTERFACE_MTU, OVSDB_SET_INTERFACE_MTU));
+    g_assert(nm_ovsdb_command_can_merge(OVSDB_SET_INTERFACE_MTU, OVSDB_SET_REAPPLY));
+    g_assert(nm_ovsdb_command_can_merge(OVSDB_SET_REAPPLY, OVSDB_SET_INTERFACE_MTU));
+    g_assert(!nm_ovsdb_command_can_merge(OVSDB_SET_REAPPLY, OVSDB_DEL_INTERFACE));
+
+    g_assert(!nm_ovsdb_command_can_merge(OVSDB_ADD_INTERFACE, OVSDB_ADD_INTERFACE));
+    g_assert(!nm_ovsdb_command_can_merge(OVSDB_ADD_INTERFACE, OVSDB_SET_INTERFACE_MTU));
+    g_assert(!nm_ovsdb_command_can_merge(OVSDB_MONITOR, OVSDB_SET_INTERFACE_MTU));
+    g_assert(!nm_ovsdb_command_can_merge(OVSDB_MONITOR_COND_CHANGE, OVSDB_MONITOR_COND_CHANGE));
+}
+
+static void
+test_result_slice(void)
+{
+    nm_auto_decref_json json_t *result = NULL;
+    nm_auto_decref_json json_t *slice  = NULL;
+
+    /* A "transact" merged from an MTU change (op 1) and a reapply (ops 2
+     * and 3). Op 0 increments next_cfg. */
+    result = _json_parse("[{}, {\"count\": 1}, {\"count\": 2}, {\"count\": 0}]");
+    g_assert_cmpint(nm_ovsdb_result_find_error(result), ==, -1);
+
+    slice = nm_ovsdb_result_slice(result, 1, 1);
+    _assert_json(slice, "[{\"count\": 1}]");
+    nm_clear_pointer(&slice, json_decref);
+
+    slice = nm_ovsdb_result_slice(result, 2, 2);
+    _assert_json(slice, "[{\"count\": 2}, {\"count\": 0}]");
+    nm_clear_pointer(&slice, json_decref);
+
+    /* The result has fewer entries than operations when OVSDB aborted. */
+    slice = nm_ovsdb_result_slice(result, 3, 3);
+    _assert_json(slice, "[{\"count\": 0}]");
+    nm_clear_pointer(&slice, json_decref);
+
+    slice = nm_ovsdb_result_slice(result, 1, 0);
+    _assert_json(slice, "[]");
+}
+
+static void
+test_result_error(void)
+{
+    nm_auto_decref_json json_t *result = NULL;
+    nm_auto_decref_json json_t *slice  = NULL;
+    gssize                      err_idx;
+
+    /* The reapply (ops 2 and 3) fails at op 3. OVSDB stops there. */
+    result  = _json_parse("[{}, {\"count\": 1}, {\"count\": 1},"
+                          " {\"error\": \"constraint violation\", \"details\": \"bad\"}]");
+    err_idx = nm_ovsdb_result_find_error(result);
+    g_assert_cmpint(err_idx, ==, 3);
+
+    g_assert(!nm_ovsdb_result_owns_error(OVSDB_SET_INTERFACE_MTU, err_idx, 1, 1));
+    g_assert(nm_ovsdb_result_owns_error(OVSDB_SET_REAPPLY, err_idx, 2, 2));
+    g_assert(!nm_ovsdb_result_owns_error(OVSDB_SET_REAPPLY, err_idx, 4, 1));
+
+    /* The owner gets the error in its slice. */
+    slice = nm_ovsdb_result_slice(result, 2, 2);
+    _assert_json(slice,
+                 "[{\"count\": 1}, {\"error\": \"constraint violation\", \"details\": \"bad\"}]");
+
+    /* Merged deletions share their operations. None of them owns the error. */
+    g_assert(!nm_ovsdb_result_owns_error(OVSDB_DEL_INTERFACE, err_idx, 1, 3));
+
+    /* An error on commit is appended after the results of all operations. */
+    nm_clear_pointer(&result, json_decref);
+    result  = _json_parse("[{}, {\"count\": 1}, {\"count\": 1},"
+                          " {\"error\": \"referential integrity violation\", \"details\": \"x\"}]");
+    err_idx = nm_ovsdb_result_find_error(result);
+    g_assert_cmpint(err_idx, ==, 3);
+    g_assert(!nm_ovsdb_result_owns_error(OVSDB_SET_INTERFACE_MTU, err_idx, 1, 1));
+    g_assert(!nm_ovsdb_result_owns_error(OVSDB_SET_INTERFACE_MTU, err_idx, 2, 1));
+
+    nm_clear_pointer(&result, json_decref);
+    result = _json_parse("{}");
+    g_assert_cmpint(nm_ovsdb_result_find_error(result), ==, -1);
+}
+
+/*****************************************************************************/
+
+static void
+_check_apply_diff(const char *column, const char *old, const char *diff, const char *expected)
+{
+    nm_auto_decref_json json_t *j_old  = NULL;
+    nm_auto_decref_json json_t *j_diff = NULL;
+    nm_auto_decref_json json_t *j_new  = NULL;
+
+    j_old  = old ? _json_parse(old) : NULL;
+    j_diff = _json_parse(diff);
+    j_new  = nm_ovsdb_json_apply_diff(column, j_old, j_diff);
+    _assert_json(j_new, expected);
+}
+
+static void
+test_json_apply_diff(void)
+{
+    /* Other columns just get the new value. */
+    _check_apply_diff("name", "\"eth0\"", "\"eth1\"", "\"eth1\"");
+    _check_apply_diff("type", NULL, "\"internal\"", "\"internal\"");
+
+    /* Sets: the elements of the diff are added or removed. A set with one
+     * element can be a plain atom. */
+    _check_apply_diff("ports",
+                      "[\"set\", [[\"uuid\", \"a\"], [\"uuid\", \"b\"]]]",
+                      "[\"uuid\", \"b\"]",
+                      "[\"uuid\", \"a\"]");
+    _check_apply_diff("interfaces",
+                      "[\"uuid\", \"a\"]",
+                      "[\"uuid\", \"c\"]",
+                      "[\"set\", [[\"uuid\", \"a\"], [\"uuid\", \"c\"]]]");
+    _check_apply_diff("interfaces",
+                      "[\"uuid\", \"a\"]",
+                      "[\"set\", [[\"uuid\", \"a\"], [\"uuid\", \"c\"]]]",
+                      "[\"uuid\", \"c\"]");
+    _check_apply_diff("ports",
+                      "[\"uuid\", \"a\"]",
+                      "[\"uuid\", \"a\"]",
+                      "[\"set\", []]");
+    _check_apply_diff("ports",
+                      NULL,
+                      "[\"set\", [[\"uuid\", \"a\"], [\"uuid\", \"b\"]]]",
+                      "[\"set\", [[\"uuid\", \"a\"], [\"uuid\", \"b\"]]]");
+    _check_apply_diff("error", "[\"set\", []]", "\"failed\"", "\"failed\"");
+    _check_apply_diff("error", "\"failed\"", "\"failed\"", "[\"set\", []]");
+
+    /* Maps: pairs with the same value are removed, with a different value
+     * changed and new ones added. */
+    _check_apply_diff("external_ids",
+                      "[\"map\", [[\"a\", \"1\"], [\"b\", \"2\"]]]",
+                      "[\"map\", [[\"a\", \"1\"], [\"b\", \"3\"], [\"c\", \"4\"]]]",
+                      "[\"map\", [[\"b\", \"3\"], [\"c\", \"4\"]]]");
+    _check_apply_diff("other_config",
+                      "[\"map\", []]",
+                      "[\"map\", [[\"a\", \"1\"]]]",
+                      "[\"map\", [[\"a\", \"1\"]]]");
+}
+
+static json_t *
+_get_row(const char *table, const char *uuid, gpointer user_data)
+{
+    if (nm_streq(table, "Port") && nm_streq(uuid, "p1")) {
+        return _json_parse("{\"name\": \"p1\", \"interfaces\": [\"uuid\", \"i1\"],"
+                           " \"external_ids\": [\"map\", [[\"NM.connection.uuid\", \"u1\"]]],"
+                           " \"other_config\": [\"map\", []]}");
+    }
+    return NULL;
+}
+
+static void
+test_table_updates2_convert(void)
+{
+    nm_auto_decref_json json_t *updates2 = NULL;
+    nm_auto_decref_json json_t *updates  = NULL;
+
+    updates2 = _json_parse("{\"Port\": {"
+                           "  \"p1\": {\"modify\": {"
+                           "    \"interfaces\": [\"uuid\", \"i2\"],"
+                           "    \"external_ids\": [\"map\", [[\"k\", \"v\"]]]}},"
+                           "  \"p2\": {\"insert\": {\"name\": \"p2\"}},"
+                           "  \"p3\": {\"delete\": null},"
+                           "  \"p4\": {\"modify\": {\"name\": \"p4\"}}"
+                           " },"
+                           " \"Interface\": {"
+                           "  \"i2\": {\"initial\": {\"name\": \"i2\", \"type\": \"internal\"}}"
+                           " }}");
+
+    updates = nm_ovsdb_table_updates2_convert(updates2, _get_row, NULL);
+
+    /* "p4" is not known, so the modification is ignored. */
+    _assert_json(updates,
+                 "{\"Port\": {"
+                 "  \"p1\": {\"new\": {\"name\": \"p1\","
+                 "                    \"interfaces\": [\"set\", [[\"uuid\", \"i1\"],"
+                 "                                             [\"uuid\", \"i2\"]]],"
+                 "                    \"external_ids\": [\"map\","
+                 "                                     [[\"NM.connection.uuid\", \"u1\"],"
+                 "                                      [\"k\", \"v\"]]],"
+                 "                    \"other_config\": [\"map\", []]}},"
+                 "  \"p2\": {\"new\": {\"name\": \"p2\","
+                 "                    \"interfaces\": [\"set\", []],"
+                 "                    \"external_ids\": [\"map\", []],"
+                 "                    \"other_config\": [\"map\", []]}},"
+                 "  \"p3\": {\"old\": {}}"
+                 " },"
+                 " \"Interface\": {"
+                 "  \"i2\": {\"new\": {\"name\": \"i2\","
+                 "                    \"type\": \"internal\","
+                 "                    \"external_ids\": [\"map\", []],"
+                 "                    \"other_config\": [\"map\", []]}}"
+                 " }}");
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE();
+
+int
+main(int argc, char **argv)
+{
+    nmtst_init_with_logging(&argc, &argv, NULL, "ALL");
+
+    g_test_add_func("/ovsdb/command-can-merge", test_command_can_merge);
+    g_test_add_func("/ovsdb/result-slice", test_result_slice);
+    g_test_add_func("/ovsdb/result-error", test_result_error);
+    g_test_add_func("/ovsdb/json-apply-diff", test_json_apply_diff);
+    g_test_add_func("/ovsdb/table-updates2-convert", test_table_updates2_convert);
+
+    return g_test_run();
+}
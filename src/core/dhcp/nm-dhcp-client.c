@@ -42,6 +42,11 @@ G_STATIC_ASSERT(ACD_REGLIST_GRACE_PERIOD_MSEC > (NM_ACD_TIMEOUT_MAX_MSEC + 1000)
 
 #define ACD_REGLIST_MAX_ENTRIES 30
 
+/* With rapid-commit, ACD runs while the address is already in use. A long
+ * probe only prolongs the time a conflicting address might be configured,
+ * so the probe duration is capped. */
+#define ACD_PARALLEL_TIMEOUT_MAX_MSEC 200u
+
 /* To do ACD for an address (new lease), we will register a NML3ConfigData
  * with l3cfg. After ACD completes, we still continue having NML3Cfg
  * watch that address, for ACD_REGLIST_GRACE_PERIOD_MSEC. The reasons are:
@@ -115,6 +120,11 @@ typedef struct _NMDhcpClientPrivate {
 
                 in_addr_t    addr;
                 NMOptionBool state;
+
+                /* Whether the lease for "addr" was already exposed while
+                 * ACD is still running in parallel (rapid-commit). The lease
+                 * only gets accepted after ACD passes. */
+                bool parallel_exposed : 1;
             } acd;
         } v4;
         struct {
@@ -447,8 +457,9 @@ _acd_state_reset(NMDhcpClient *self, gboolean forget_addr, gboolean forget_regli
         l3_cfg_notify_check_connected(self);
         nm_clear_g_source_inst(&priv->v4.acd.done_source);
         if (forget_addr) {
-            priv->v4.acd.addr  = INADDR_ANY;
-            priv->v4.acd.state = NM_OPTION_BOOL_DEFAULT;
+            priv->v4.acd.addr             = INADDR_ANY;
+            priv->v4.acd.state            = NM_OPTION_BOOL_DEFAULT;
+            priv->v4.acd.parallel_exposed = FALSE;
         }
     } else
         nm_assert(priv->v4.acd.state == NM_OPTION_BOOL_DEFAULT);
@@ -466,6 +477,66 @@ _acd_state_reset(NMDhcpClient *self, gboolean forget_addr, gboolean forget_regli
               || !nm_l3cfg_remove_config_all(priv->config.l3cfg, L3CD_ACD_TAG(priv)));
 }
 
+static void
+_acd_parallel_complete(NMDhcpClient *self)
+{
+    NMDhcpClientPrivate  *priv = NM_DHCP_CLIENT_GET_PRIVATE(self);
+    char                  sbuf_addr[NM_INET_ADDRSTRLEN];
+    gs_free_error GError *error = NULL;
+
+    nm_assert(priv->v4.acd.state != NM_OPTION_BOOL_DEFAULT);
+    nm_assert(priv->l3cd_curr && priv->l3cd_curr == priv->l3cd_next);
+
+    if (priv->v4.acd.state) {
+        if (priv->l3cfg_notify.wait_dhcp_commit) {
+            /* The address is not yet committed. We will accept the lease
+             * once that happens. */
+            return;
+        }
+
+        _LOGD("acd: parallel check passed, accept lease");
+        if (!_dhcp_client_accept(self, priv->l3cd_curr, &error)) {
+            gs_free char *reason = g_strdup_printf("error accepting lease: %s", error->message);
+
+            _LOGD("accept failed: %s", error->message);
+            _emit_notify(self,
+                         NM_DHCP_CLIENT_NOTIFY_TYPE_IT_LOOKS_BAD,
+                         .it_looks_bad.reason = reason, );
+            return;
+        }
+
+        _emit_notify(self,
+                     NM_DHCP_CLIENT_NOTIFY_TYPE_LEASE_UPDATE,
+                     .lease_update = {
+                         .l3cd     = priv->l3cd_curr,
+                         .accepted = TRUE,
+                     });
+        return;
+    }
+
+    /* The address is already configured, but the parallel ACD check found it
+     * in use. Decline the lease and withdraw it. NML3Cfg already considers the
+     * address as not ready, so it will get removed with the next commit. Like
+     * for a regular ACD failure, we don't report a failure to the caller but
+     * wait for a better lease. */
+    _LOGI("acd: address %s is already in use, withdraw lease",
+          nm_inet4_ntop(priv->v4.acd.addr, sbuf_addr));
+
+    if (!_dhcp_client_decline(self, priv->l3cd_curr, "acd failed", &error))
+        _LOGD("decline failed: %s", error->message);
+
+    nm_clear_l3cd(&priv->l3cd_curr);
+    priv->l3cfg_notify.wait_dhcp_commit = FALSE;
+    l3_cfg_notify_check_connected(self);
+
+    _emit_notify(self,
+                 NM_DHCP_CLIENT_NOTIFY_TYPE_LEASE_UPDATE,
+                 .lease_update = {
+                     .l3cd     = NULL,
+                     .accepted = FALSE,
+                 });
+}
+
 static gboolean
 _acd_complete_on_idle_cb(gpointer user_data)
 {
@@ -479,6 +550,12 @@ _acd_complete_on_idle_cb(gpointer user_data)
 
     _acd_state_reset(self, FALSE, FALSE);
 
+    if (priv->v4.acd.parallel_exposed) {
+        priv->v4.acd.parallel_exposed = FALSE;
+        _acd_parallel_complete(self);
+        return G_SOURCE_CONTINUE;
+    }
+
     _nm_dhcp_client_notify(self, NM_DHCP_CLIENT_EVENT_TYPE_BOUND, priv->l3cd_next);
 
     return G_SOURCE_CONTINUE;
@@ -602,6 +679,8 @@ _acd_check_lease(NMDhcpClient *self, NMOptionBool *out_acd_state)
     gboolean             addr_changed = FALSE;
     guint                idx;
     gint64               now_msec;
+    guint32              acd_timeout_msec;
+    NML3CfgConfigFlags   config_flags;
 
     if (!NM_IS_IPv4(priv->config.addr_family))
         goto handle_no_acd;
@@ -634,10 +713,20 @@ _acd_check_lease(NMDhcpClient *self, NMOptionBool *out_acd_state)
         priv->v4.acd.addr = addr;
     }
 
-    _LOGD("acd: %s check for address %s (timeout %u msec, l3cd " NM_HASH_OBFUSCATE_PTR_FMT ")",
+    if (priv->config.v4.rapid_commit) {
+        acd_timeout_msec = NM_MIN(priv->config.v4.acd_timeout_msec, ACD_PARALLEL_TIMEOUT_MAX_MSEC);
+        config_flags     = NM_L3CFG_CONFIG_FLAGS_ONLY_FOR_ACD | NM_L3CFG_CONFIG_FLAGS_ACD_PARALLEL;
+    } else {
+        acd_timeout_msec = NM_MIN(priv->config.v4.acd_timeout_msec, NM_ACD_TIMEOUT_MAX_MSEC);
+        config_flags     = NM_L3CFG_CONFIG_FLAGS_ONLY_FOR_ACD;
+    }
+
+    _LOGD("acd: %s %scheck for address %s (timeout %u msec, l3cd " NM_HASH_OBFUSCATE_PTR_FMT
+          ")",
           addr_changed ? "add" : "update",
+          priv->config.v4.rapid_commit ? "parallel " : "",
           nm_inet4_ntop(addr, sbuf_addr),
-          priv->config.v4.acd_timeout_msec,
+          acd_timeout_msec,
           NM_HASH_OBFUSCATE_PTR(priv->l3cd_next));
 
     priv->v4.acd.state = NM_OPTION_BOOL_DEFAULT;
@@ -656,8 +745,8 @@ _acd_check_lease(NMDhcpClient *self, NMOptionBool *out_acd_state)
                             NM_DNS_PRIORITY_DEFAULT_NORMAL,
                             NM_DNS_PRIORITY_DEFAULT_NORMAL,
                             NM_L3_ACD_DEFEND_TYPE_ONCE,
-                            NM_MIN(priv->config.v4.acd_timeout_msec, NM_ACD_TIMEOUT_MAX_MSEC),
-                            NM_L3CFG_CONFIG_FLAGS_ONLY_FOR_ACD,
+                            acd_timeout_msec,
+                            config_flags,
                             NM_L3_CONFIG_MERGE_FLAGS_NONE))
         addr_changed = TRUE;
 
@@ -857,9 +946,17 @@ _nm_dhcp_client_notify(NMDhcpClient         *self,
     }
 
     if (acd_state == NM_OPTION_BOOL_DEFAULT) {
-        /* ACD is in progress... */
-        return;
-    }
+        if (!IS_IPv4 || !priv->config.v4.rapid_commit) {
+            /* ACD is in progress... */
+            return;
+        }
+
+        /* ACD runs in parallel. Expose the lease right away, so that the
+         * address gets configured. The lease only gets accepted (or declined)
+         * once ACD completes, see _acd_parallel_complete(). */
+        priv->v4.acd.parallel_exposed = TRUE;
+    } else if (IS_IPv4)
+        priv->v4.acd.parallel_exposed = FALSE;
 
     if (!acd_state) {
         gs_free_error GError *error = NULL;
@@ -887,7 +984,8 @@ _nm_dhcp_client_notify(NMDhcpClient         *self,
     else
         priv->l3cfg_notify.wait_dhcp_commit = FALSE;
 
-    if (!priv->l3cfg_notify.wait_dhcp_commit && priv->l3cd_curr) {
+    if (!priv->l3cfg_notify.wait_dhcp_commit && priv->l3cd_curr
+        && !(IS_IPv4 && priv->v4.acd.parallel_exposed)) {
         gs_free_error GError *error = NULL;
 
         _LOGD("accept lease right away");
@@ -909,7 +1007,8 @@ _nm_dhcp_client_notify(NMDhcpClient         *self,
                  NM_DHCP_CLIENT_NOTIFY_TYPE_LEASE_UPDATE,
                  .lease_update = {
                      .l3cd     = priv->l3cd_curr,
-                     .accepted = !priv->l3cfg_notify.wait_dhcp_commit,
+                     .accepted = !priv->l3cfg_notify.wait_dhcp_commit
+                                 && !(IS_IPv4 && priv->v4.acd.parallel_exposed),
                  });
 }
 
@@ -1264,6 +1363,11 @@ l3_cfg_notify_cb(NML3Cfg *l3cfg, const NML3ConfigNotifyData *notify_data, NMDhcp
 
         l3_cfg_notify_check_connected(self);
 
+        if (priv->config.addr_family == AF_INET && priv->v4.acd.parallel_exposed) {
+            _LOGD("address configured, wait for parallel ACD before accepting the lease");
+            goto wait_dhcp_commit_done;
+        }
+
         if (priv->config.addr_family == AF_INET || !priv->l3cfg_notify.wait_ipv6_dad) {
             _LOGD("accept lease");
 
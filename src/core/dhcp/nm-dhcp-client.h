@@ -172,6 +172,12 @@ typedef struct {
             /* Whether to send or not the client identifier */
             bool send_client_id : 1;
 
+            /* Whether to request Rapid Commit (RFC 4039). This also makes ACD
+             * run in parallel with configuring the address, instead of
+             * delaying the address until ACD completes. On conflict, the
+             * lease is declined and the address withdrawn again. */
+            bool rapid_commit : 1;
+
         } v4;
         struct {
             /* If set, the DUID from the connection is used; otherwise
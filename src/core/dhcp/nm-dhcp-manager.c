@@ -196,6 +196,15 @@ nm_dhcp_manager_start_client(NMDhcpManager *self, NMDhcpClientConfig *config, GE
           nm_utils_addr_family_to_char(config->addr_family),
           g_type_name(gtype));
 
+    if (config->addr_family == AF_INET && config->v4.rapid_commit
+        && gtype != nm_dhcp_nettools_get_type()) {
+        /* Only the internal client implements rapid-commit, and with it the
+         * parallel ACD. Other clients get the regular ACD before the address
+         * is configured. */
+        _LOGT(config->addr_family, "rapid-commit is not supported by %s", g_type_name(gtype));
+        config->v4.rapid_commit = FALSE;
+    }
+
     client = g_object_new(gtype, NM_DHCP_CLIENT_CONFIG, config, NULL);
 
     /* unfortunately, our implementations work differently per address-family regarding client-id/DUID.
@@ -1368,6 +1368,8 @@ ip4_start(NMDhcpClient *client, GError **error)
         n_dhcp4_client_probe_config_set_init_reboot(config, TRUE);
     }
 
+    n_dhcp4_client_probe_config_set_rapid_commit(config, client_config->v4.rapid_commit);
+
     /* Add requested options */
     for (i = 0; i < (int) G_N_ELEMENTS(_nm_dhcp_option_dhcp4_options); i++) {
         if (_nm_dhcp_option_dhcp4_options[i].include) {
@@ -25,6 +25,7 @@
 #endif
 
 #include "libnm-core-intern/nm-core-internal.h"
+#include "libnm-glib-aux/nm-io-utils.h"
 #include "libnm-glib-aux/nm-str-buf.h"
 
 #include "NetworkManagerUtils.h"
@@ -33,6 +34,7 @@
 #include "nm-dbus-object.h"
 #include "nm-dns-dnsmasq.h"
 #include "nm-dns-plugin.h"
+#include "nm-dns-stub.h"
 #include "nm-dns-systemd-resolved.h"
 #include "nm-ip-config.h"
 #include "nm-l3-config-data.h"
@@ -70,6 +72,26 @@ typedef struct {
     NMTernary   has_trust_ad;
 } NMResolvConfData;
 
+typedef enum {
+    RC_FILE_ETC,
+    RC_FILE_INTERNAL,
+    RC_FILE_NO_STUB,
+    _RC_FILE_NUM,
+} RcFileType;
+
+/* What we know about the content of a resolv.conf file that we wrote
+ * last. As long as the file is unchanged on disk (according to stat()),
+ * we can compare the digest instead of the file content. */
+typedef struct {
+    char           *path;
+    guint8          digest[NM_UTILS_CHECKSUM_LENGTH_SHA1];
+    dev_t           st_dev;
+    ino_t           st_ino;
+    off_t           st_size;
+    struct timespec st_mtim;
+    struct timespec st_ctim;
+} RcFileCache;
+
 /*****************************************************************************/
 
 enum {
@@ -109,12 +131,23 @@ typedef struct {
 
     bool update_pending : 1;
 
+    /* Whether "ip_data_hash" is up to date with "ip_data_lst_head". */
+    bool ip_data_hash_valid : 1;
+
+    /* Whether any ip_data had the wildcard domain heuristic enabled, the last
+     * time the domains were constructed. */
+    bool configs_data_has_wildcard : 1;
+
     char *hostdomain;
     guint updates_queue;
 
     guint8 hash[HASH_LEN];      /* SHA1 hash of current DNS config */
     guint8 prev_hash[HASH_LEN]; /* Hash when begin_updates() was called */
 
+    guint8 ip_data_hash[HASH_LEN]; /* Combined "dns_digest" of all ip_data */
+
+    RcFileCache rc_file_cache[_RC_FILE_NUM];
+
     NMDnsManagerResolvConfManager rc_manager;
     char                         *mode;
     NMDnsPlugin                  *sd_resolve_plugin;
@@ -387,6 +420,54 @@ _ASSERT_dns_config_ip_data(const NMDnsConfigIPData *ip_data)
 #endif
 }
 
+static void
+_dns_config_ip_data_set_ip_config_type(NMDnsConfigIPData *ip_data, NMDnsIPConfigType ip_config_type)
+{
+    nm_auto_free_checksum GChecksum *sum = NULL;
+    const NML3ConfigData            *l3cd;
+    int                              addr_family;
+    gboolean                         add_wildcard = FALSE;
+    guint                            num;
+
+    nm_assert(ip_config_type != NM_DNS_IP_CONFIG_TYPE_REMOVED);
+
+    ip_data->ip_config_type = ip_config_type;
+
+    /* The l3cd is sealed and the DNS digest only depends on it and the
+     * ip_config_type. Compute it once, so that compute_hash() does not
+     * need to rehash all configurations on every update. */
+    sum = g_checksum_new(G_CHECKSUM_SHA1);
+    ip_data->dns_digest_empty =
+        !nm_l3_config_data_hash_dns(ip_data->l3cd, sum, ip_data->addr_family, ip_config_type);
+    nm_utils_checksum_get_digest(sum, ip_data->dns_digest);
+
+    l3cd        = ip_data->l3cd;
+    addr_family = ip_data->addr_family;
+    nm_l3_config_data_get_nameservers(l3cd, addr_family, &num);
+    if (num > 0) {
+        if (nm_l3_config_data_get_best_default_route(l3cd, addr_family)) {
+            /* FIXME(l3cfg): the best-default route of a l3cd is not significant! */
+            add_wildcard = TRUE;
+        } else {
+            /* If a VPN has never-default=no but doesn't get a default
+             * route (this can happen for example when the server
+             * pushes routes with openconnect), and there are no
+             * search or routing domains, then the name servers pushed
+             * by the server would be unused. It is preferable in this
+             * case to use the VPN DNS server for all queries. */
+            if (ip_config_type == NM_DNS_IP_CONFIG_TYPE_VPN
+                && nm_l3_config_data_get_never_default(l3cd, addr_family) == NM_TERNARY_FALSE
+                && !nm_l3_config_data_get_searches(l3cd, addr_family, &num)
+                && !nm_l3_config_data_get_domains(l3cd, addr_family, &num))
+                add_wildcard = TRUE;
+        }
+    }
+    ip_data->dns_add_wildcard = add_wildcard;
+
+    ip_data->domains.valid = FALSE;
+    NM_DNS_MANAGER_GET_PRIVATE(ip_data->data->self)->ip_data_hash_valid = FALSE;
+}
+
 static NMDnsConfigIPData *
 _dns_config_ip_data_new(NMDnsConfigData      *data,
                         int                   addr_family,
@@ -405,13 +486,14 @@ _dns_config_ip_data_new(NMDnsConfigData      *data,
         .data           = data,
         .source_tag     = source_tag,
         .l3cd           = nm_l3_config_data_ref_and_seal(l3cd),
-        .ip_config_type = ip_config_type,
         .addr_family    = addr_family,
     };
     c_list_link_tail(&data->data_lst_head, &ip_data->data_lst);
     c_list_link_tail(&NM_DNS_MANAGER_GET_PRIVATE(data->self)->ip_data_lst_head,
                      &ip_data->ip_data_lst);
 
+    _dns_config_ip_data_set_ip_config_type(ip_data, ip_config_type);
+
     /* We also need to set priv->ip_data_lst_need_sort, but the caller will do that! */
 
     _ASSERT_dns_config_ip_data(ip_data);
@@ -423,6 +505,8 @@ _dns_config_ip_data_free(NMDnsConfigIPData *ip_data)
 {
     _ASSERT_dns_config_ip_data(ip_data);
 
+    NM_DNS_MANAGER_GET_PRIVATE(ip_data->data->self)->ip_data_hash_valid = FALSE;
+
     c_list_unlink_stale(&ip_data->data_lst);
     c_list_unlink_stale(&ip_data->ip_data_lst);
 
@@ -996,11 +1080,109 @@ _read_link_cached(const char *path, gboolean *is_cached, char **cached)
 }
 
 #define MY_RESOLV_CONF     NMRUNDIR "/resolv.conf"
-#define MY_RESOLV_CONF_TMP MY_RESOLV_CONF ".tmp"
 #define RESOLV_CONF_TMP    "/etc/.resolv.conf.NetworkManager"
 
 #define NO_STUB_RESOLV_CONF NMRUNDIR "/no-stub-resolv.conf"
 
+static gboolean
+_rc_file_cache_matches(const RcFileCache *cache, const char *path, const struct stat *st)
+{
+    return cache->path && nm_streq(cache->path, path) && cache->st_dev == st->st_dev
+           && cache->st_ino == st->st_ino && cache->st_size == st->st_size
+           && cache->st_mtim.tv_sec == st->st_mtim.tv_sec
+           && cache->st_mtim.tv_nsec == st->st_mtim.tv_nsec
+           && cache->st_ctim.tv_sec == st->st_ctim.tv_sec
+           && cache->st_ctim.tv_nsec == st->st_ctim.tv_nsec;
+}
+
+static void
+_rc_file_cache_set(RcFileCache *cache, const char *path, const guint8 *digest)
+{
+    struct stat st;
+
+    if (stat(path, &st) != 0) {
+        nm_clear_g_free(&cache->path);
+        return;
+    }
+
+    if (!nm_streq0(cache->path, path)) {
+        g_free(cache->path);
+        cache->path = g_strdup(path);
+    }
+    memcpy(cache->digest, digest, sizeof(cache->digest));
+    cache->st_dev  = st.st_dev;
+    cache->st_ino  = st.st_ino;
+    cache->st_size = st.st_size;
+    cache->st_mtim = st.st_mtim;
+    cache->st_ctim = st.st_ctim;
+}
+
+/* Atomically replace @path with @content, unless the file already has
+ * that content. In that case, the file is left untouched, so that we don't
+ * needlessly wake up inotify watchers and sync to disk. */
+static gboolean
+_rc_file_write(NMDnsManager *self,
+               RcFileType    rc_file_type,
+               const char   *path,
+               const char   *content,
+               gboolean     *out_written,
+               GError      **error)
+{
+    NMDnsManagerPrivate             *priv  = NM_DNS_MANAGER_GET_PRIVATE(self);
+    RcFileCache                     *cache = &priv->rc_file_cache[rc_file_type];
+    nm_auto_free_checksum GChecksum *sum   = NULL;
+    guint8                           digest[HASH_LEN];
+    struct stat                      st;
+    gsize                            len;
+
+    nm_assert(rc_file_type >= 0 && rc_file_type < _RC_FILE_NUM);
+
+    len = strlen(content);
+
+    sum = g_checksum_new(G_CHECKSUM_SHA1);
+    g_checksum_update(sum, (const guint8 *) content, len);
+    nm_utils_checksum_get_digest(sum, digest);
+
+    if (stat(path, &st) == 0 && S_ISREG(st.st_mode) && st.st_size == (off_t) len) {
+        if (_rc_file_cache_matches(cache, path, &st)) {
+            if (memcmp(cache->digest, digest, HASH_LEN) == 0) {
+                _LOGT("update-resolv-conf: %s is unchanged", path);
+                NM_SET_OUT(out_written, FALSE);
+                return TRUE;
+            }
+        } else {
+            gs_free char *old_content = NULL;
+            gsize         old_len;
+
+            /* We don't know the content of the file (for example, after
+             * restart, or somebody else wrote it). Compare it once. */
+            if (nm_utils_file_get_contents(-1,
+                                           path,
+                                           len + 1u,
+                                           NM_UTILS_FILE_GET_CONTENTS_FLAG_NONE,
+                                           &old_content,
+                                           &old_len,
+                                           NULL,
+                                           NULL)
+                && old_len == len && memcmp(old_content, content, len) == 0) {
+                _rc_file_cache_set(cache, path, digest);
+                _LOGT("update-resolv-conf: %s is unchanged", path);
+                NM_SET_OUT(out_written, FALSE);
+                return TRUE;
+            }
+        }
+    }
+
+    if (!nm_utils_file_set_contents(path, content, len, 0644, NULL, NULL, error)) {
+        nm_clear_g_free(&cache->path);
+        return FALSE;
+    }
+
+    _rc_file_cache_set(cache, path, digest);
+    NM_SET_OUT(out_written, TRUE);
+    return TRUE;
+}
+
 static void
 update_resolv_conf_no_stub(NMDnsManager      *self,
                            const char *const *searches,
@@ -1009,16 +1191,18 @@ update_resolv_conf_no_stub(NMDnsManager      *self,
 {
     gs_free char *content = NULL;
     GError       *local   = NULL;
+    gboolean      written;
 
     content = create_resolv_conf(searches, nameservers, options);
 
-    if (!g_file_set_contents(NO_STUB_RESOLV_CONF, content, -1, &local)) {
+    if (!_rc_file_write(self, RC_FILE_NO_STUB, NO_STUB_RESOLV_CONF, content, &written, &local)) {
         _LOGD("update-resolv-no-stub: failure to write file: %s", local->message);
         g_error_free(local);
         return;
     }
 
-    _LOGT("update-resolv-no-stub: '%s' successfully written", NO_STUB_RESOLV_CONF);
+    if (written)
+        _LOGT("update-resolv-no-stub: '%s' successfully written", NO_STUB_RESOLV_CONF);
 }
 
 static SpawnResult
@@ -1029,13 +1213,12 @@ update_resolv_conf(NMDnsManager                 *self,
                    GError                      **error,
                    NMDnsManagerResolvConfManager rc_manager)
 {
-    FILE         *f;
-    gboolean      success;
     gs_free char *content           = NULL;
     SpawnResult   write_file_result = SR_SUCCESS;
     int           errsv;
     gboolean      resconf_link_cached = FALSE;
     gs_free char *resconf_link        = NULL;
+    gboolean      written;
 
     content = create_resolv_conf(searches, nameservers, options);
 
@@ -1068,7 +1251,7 @@ update_resolv_conf(NMDnsManager                 *self,
         /* we first write to /etc/resolv.conf directly. If that fails,
          * we still continue to write to runstatedir but remember the
          * error. */
-        if (!g_file_set_contents(rc_path, content, -1, &local)) {
+        if (!_rc_file_write(self, RC_FILE_ETC, rc_path, content, NULL, &local)) {
             _LOGT("update-resolv-conf: write to %s failed (rc-manager=%s, %s)",
                   rc_path,
                   _rc_manager_to_string(rc_manager),
@@ -1085,61 +1268,15 @@ update_resolv_conf(NMDnsManager                 *self,
         }
     }
 
-    if ((f = fopen(MY_RESOLV_CONF_TMP, "we")) == NULL) {
-        errsv = errno;
-        g_set_error(error,
-                    NM_MANAGER_ERROR,
-                    NM_MANAGER_ERROR_FAILED,
-                    "Could not open %s: %s",
-                    MY_RESOLV_CONF_TMP,
-                    nm_strerror_native(errsv));
-        _LOGT("update-resolv-conf: open temporary file %s failed (%s)",
-              MY_RESOLV_CONF_TMP,
-              nm_strerror_native(errsv));
+    if (!_rc_file_write(self, RC_FILE_INTERNAL, MY_RESOLV_CONF, content, &written, error)) {
+        _LOGT("update-resolv-conf: write internal file %s failed", MY_RESOLV_CONF);
         return SR_ERROR;
     }
 
-    success = write_resolv_conf_contents(f, content, error);
-    if (!success) {
-        errsv = errno;
-        _LOGT("update-resolv-conf: write temporary file %s failed (%s)",
-              MY_RESOLV_CONF_TMP,
-              nm_strerror_native(errsv));
-    }
-
-    if (fclose(f) < 0) {
-        if (success) {
-            errsv = errno;
-            /* only set an error here if write_resolv_conf() was successful,
-             * since its error is more important.
-             */
-            g_set_error(error,
-                        NM_MANAGER_ERROR,
-                        NM_MANAGER_ERROR_FAILED,
-                        "Could not close %s: %s",
-                        MY_RESOLV_CONF_TMP,
-                        nm_strerror_native(errsv));
-            _LOGT("update-resolv-conf: close temporary file %s failed (%s)",
-                  MY_RESOLV_CONF_TMP,
-                  nm_strerror_native(errsv));
-        }
-        return SR_ERROR;
-    } else if (!success)
-        return SR_ERROR;
-
-    if (rename(MY_RESOLV_CONF_TMP, MY_RESOLV_CONF) < 0) {
-        errsv = errno;
-        g_set_error(error,
-                    NM_MANAGER_ERROR,
-                    NM_MANAGER_ERROR_FAILED,
-                    "Could not replace %s: %s",
-                    MY_RESOLV_CONF,
-                    nm_strerror_native(errsv));
-        _LOGT("update-resolv-conf: failed to rename temporary file %s to %s (%s)",
-              MY_RESOLV_CONF_TMP,
-              MY_RESOLV_CONF,
-              nm_strerror_native(errsv));
-        return SR_ERROR;
+    if (!written) {
+        /* The content is unchanged. There is also no need to touch the
+         * symlink, which we would only do to notify inotify watchers. */
+        return write_file_result;
     }
 
     if (rc_manager == NM_DNS_MANAGER_RESOLV_CONF_MAN_FILE) {
@@ -1225,11 +1362,41 @@ update_resolv_conf(NMDnsManager                 *self,
     return write_file_result;
 }
 
+static const guint8 *
+_mgr_get_ip_data_hash(NMDnsManager *self)
+{
+    NMDnsManagerPrivate             *priv = NM_DNS_MANAGER_GET_PRIVATE(self);
+    nm_auto_free_checksum GChecksum *sum  = NULL;
+    const NMDnsConfigIPData         *ip_data;
+    const CList                     *head;
+
+    /* The ip_data list only changes via _dns_config_ip_data_new(),
+     * _dns_config_ip_data_free() and _dns_config_ip_data_set_ip_config_type(),
+     * which invalidate the cached hash. As long as nothing changed, we
+     * don't need to touch the entries at all. */
+    head = _mgr_get_ip_data_lst_head(self);
+    if (priv->ip_data_hash_valid)
+        return priv->ip_data_hash;
+
+    sum = g_checksum_new(G_CHECKSUM_SHA1);
+
+    /* FIXME(ip-config-checksum): this relies on the fact that an IP
+     * configuration without DNS parameters gives a zero checksum. Such
+     * entries are skipped, so that they don't affect the result. */
+    c_list_for_each_entry (ip_data, head, ip_data_lst) {
+        if (!ip_data->dns_digest_empty)
+            g_checksum_update(sum, ip_data->dns_digest, sizeof(ip_data->dns_digest));
+    }
+
+    nm_utils_checksum_get_digest_len(sum, priv->ip_data_hash, HASH_LEN);
+    priv->ip_data_hash_valid = TRUE;
+    return priv->ip_data_hash;
+}
+
 static void
 compute_hash(NMDnsManager *self, const NMGlobalDnsConfig *global, guint8 buffer[static HASH_LEN])
 {
     nm_auto_free_checksum GChecksum *sum = NULL;
-    NMDnsConfigIPData               *ip_data;
 
     sum = g_checksum_new(G_CHECKSUM_SHA1);
     nm_assert(HASH_LEN == g_checksum_type_get_length(G_CHECKSUM_SHA1));
@@ -1237,19 +1404,8 @@ compute_hash(NMDnsManager *self, const NMGlobalDnsConfig *global, guint8 buffer[
     if (global)
         nm_global_dns_config_update_checksum(global, sum);
 
-    if (!global || !nm_global_dns_config_lookup_domain(global, "*")) {
-        const CList *head;
-
-        /* FIXME(ip-config-checksum): this relies on the fact that an IP
-         * configuration without DNS parameters gives a zero checksum. */
-        head = _mgr_get_ip_data_lst_head(self);
-        c_list_for_each_entry (ip_data, head, ip_data_lst) {
-            nm_l3_config_data_hash_dns(ip_data->l3cd,
-                                       sum,
-                                       ip_data->addr_family,
-                                       ip_data->ip_config_type);
-        }
-    }
+    if (!global || !nm_global_dns_config_lookup_domain(global, "*"))
+        g_checksum_update(sum, _mgr_get_ip_data_hash(self), HASH_LEN);
 
     nm_utils_checksum_get_digest_len(sum, buffer, HASH_LEN);
 }
@@ -1511,56 +1667,32 @@ _domain_track_is_shadowed(GHashTable  *ht,
 static void
 _mgr_configs_data_construct(NMDnsManager *self)
 {
+    NMDnsManagerPrivate           *priv = NM_DNS_MANAGER_GET_PRIVATE(self);
     NMDnsConfigIPData             *ip_data;
-    gs_unref_hashtable GHashTable *ht               = NULL;
-    gs_unref_hashtable GHashTable *wildcard_entries = NULL;
-    CList                         *head;
+    gs_unref_hashtable GHashTable *ht            = NULL;
+    const NMDnsConfigIPData       *prev_ip_data  = NULL;
+    gboolean                       has_wildcard  = FALSE;
+    gboolean                       rebuild       = FALSE;
     int                            prev_priority = G_MININT;
+    CList                         *head;
 
     head = _mgr_get_ip_data_lst_head(self);
 
-#if NM_MORE_ASSERTS
-    /* we call _mgr_configs_data_clear() at the end of update. We
-     * don't expect any domain settings here. */
     c_list_for_each_entry (ip_data, head, ip_data_lst) {
-        nm_assert(!ip_data->domains.search);
-        nm_assert(!ip_data->domains.reverse);
-        nm_assert(!ip_data->domains.has_default_route_explicit);
-        nm_assert(!ip_data->domains.has_default_route_exclusive);
-        nm_assert(!ip_data->domains.has_default_route);
-    }
-#endif
-
-    c_list_for_each_entry (ip_data, head, ip_data_lst) {
-        gboolean add_wildcard = FALSE;
-        guint    num;
-
-        nm_l3_config_data_get_nameservers(ip_data->l3cd, ip_data->addr_family, &num);
-        if (num == 0)
-            continue;
-        if (nm_l3_config_data_get_best_default_route(ip_data->l3cd, ip_data->addr_family)) {
-            /* FIXME(l3cfg): the best-default route of a l3cd is not significant! */
-            add_wildcard = TRUE;
-        } else {
-            /* If a VPN has never-default=no but doesn't get a default
-             * route (this can happen for example when the server
-             * pushes routes with openconnect), and there are no
-             * search or routing domains, then the name servers pushed
-             * by the server would be unused. It is preferable in this
-             * case to use the VPN DNS server for all queries. */
-            if (ip_data->ip_config_type == NM_DNS_IP_CONFIG_TYPE_VPN
-                && nm_l3_config_data_get_never_default(ip_data->l3cd, ip_data->addr_family)
-                       == NM_TERNARY_FALSE
-                && !nm_l3_config_data_get_searches(ip_data->l3cd, ip_data->addr_family, &num)
-                && !nm_l3_config_data_get_domains(ip_data->l3cd, ip_data->addr_family, &num))
-                add_wildcard = TRUE;
+        if (ip_data->dns_add_wildcard) {
+            has_wildcard = TRUE;
+            break;
         }
+    }
 
-        if (add_wildcard) {
-            if (!wildcard_entries)
-                wildcard_entries = g_hash_table_new(nm_direct_hash, NULL);
-            g_hash_table_add(wildcard_entries, ip_data);
-        }
+    /* The domains of an entry depend on the entry itself and on the entries
+     * with higher priority (the ones before it in the sorted list). We keep
+     * the result across updates and only rebuild starting with the first entry
+     * that changed. The l3cd is kept alive by ip_data, so the domains pointing
+     * to its strings stay valid. */
+    if (priv->configs_data_has_wildcard != has_wildcard) {
+        priv->configs_data_has_wildcard = has_wildcard;
+        rebuild                         = TRUE;
     }
 
     c_list_for_each_entry (ip_data, head, ip_data_lst) {
@@ -1583,26 +1715,50 @@ _mgr_configs_data_construct(NMDnsManager *self)
         if (num == 0)
             continue;
 
-        strv_searches =
-            nm_l3_config_data_get_searches(ip_data->l3cd, ip_data->addr_family, &n_searches);
-        strv_domains =
-            nm_l3_config_data_get_domains(ip_data->l3cd, ip_data->addr_family, &n_domains);
-
         priority = _dns_config_ip_data_get_dns_priority(ip_data);
 
         nm_assert(prev_priority <= priority);
         prev_priority = priority;
 
+        if (!rebuild && (!ip_data->domains.valid || ip_data->domains.prev != prev_ip_data))
+            rebuild = TRUE;
+
+        if (!rebuild) {
+            /* Unchanged. Only track the domains for the following entries. */
+            if (ip_data->domains.search) {
+                for (i = 0; ip_data->domains.search[i]; i++) {
+                    if (!ht)
+                        ht = g_hash_table_new(nm_str_hash, g_str_equal);
+                    g_hash_table_insert(
+                        ht,
+                        (gpointer) nm_utils_parse_dns_domain(ip_data->domains.search[i], NULL),
+                        GINT_TO_POINTER(priority));
+                }
+            }
+            if (ip_data->domains.has_default_route) {
+                if (!ht)
+                    ht = g_hash_table_new(nm_str_hash, g_str_equal);
+                g_hash_table_insert(ht, (gpointer) "", GINT_TO_POINTER(priority));
+            }
+            prev_ip_data = ip_data;
+            continue;
+        }
+
+        strv_searches =
+            nm_l3_config_data_get_searches(ip_data->l3cd, ip_data->addr_family, &n_searches);
+        strv_domains =
+            nm_l3_config_data_get_domains(ip_data->l3cd, ip_data->addr_family, &n_domains);
+
         /* Add wildcard lookup domain to connections with the default route.
          * If there is no default route, add the wildcard domain to all non-VPN
          * connections */
-        if (wildcard_entries) {
+        if (has_wildcard) {
             /* FIXME: this heuristic of which device has a default route does
              * not work with policy routing (as used by default with WireGuard).
              * We should have a more stable mechanism where an NMIPConfig indicates
              * whether it is suitable for certain operations (like having an automatically
              * added "~" domain). */
-            if (g_hash_table_contains(wildcard_entries, ip_data))
+            if (ip_data->dns_add_wildcard)
                 has_default_route_maybe = TRUE;
         } else {
             if (ip_data->ip_config_type != NM_DNS_IP_CONFIG_TYPE_VPN)
@@ -1706,10 +1862,14 @@ _mgr_configs_data_construct(NMDnsManager *self)
         nm_assert(num_dom2 < n_domains_allocated);
         domains[num_dom2] = NULL;
 
-        nm_assert(!ip_data->domains.search);
-        nm_assert(!ip_data->domains.reverse);
-        ip_data->domains.search  = domains;
-        ip_data->domains.reverse = get_ip_rdns_domains(ip_data->addr_family, ip_data->l3cd);
+        g_free(ip_data->domains.search);
+        ip_data->domains.search = domains;
+        if (!ip_data->domains.reverse_valid) {
+            ip_data->domains.reverse = get_ip_rdns_domains(ip_data->addr_family, ip_data->l3cd);
+            ip_data->domains.reverse_valid = TRUE;
+        }
+        ip_data->domains.prev                       = prev_ip_data;
+        ip_data->domains.valid                      = TRUE;
         ip_data->domains.has_default_route_explicit = has_default_route_explicit;
         ip_data->domains.has_default_route_exclusive =
             has_default_route_explicit || (priority < 0 && has_default_route_auto);
@@ -1732,22 +1892,8 @@ _mgr_configs_data_construct(NMDnsManager *self)
                   (ip_data->domains.reverse ? (str2 = g_strjoinv(",", ip_data->domains.reverse))
                                             : ""));
         }
-    }
-}
-
-static void
-_mgr_configs_data_clear(NMDnsManager *self)
-{
-    NMDnsConfigIPData *ip_data;
-    CList             *head;
 
-    head = _mgr_get_ip_data_lst_head(self);
-    c_list_for_each_entry (ip_data, head, ip_data_lst) {
-        nm_clear_g_free(&ip_data->domains.search);
-        nm_clear_pointer(&ip_data->domains.reverse, g_strfreev);
-        ip_data->domains.has_default_route_explicit  = FALSE;
-        ip_data->domains.has_default_route_exclusive = FALSE;
-        ip_data->domains.has_default_route           = FALSE;
+        prev_ip_data = ip_data;
     }
 }
 
@@ -1848,11 +1994,6 @@ update_dns(NMDnsManager *self, gboolean no_caching, gboolean force_emit, GError
 plugin_skip:;
     }
 
-    /* Clear the generated search list as it points to
-     * strings owned by IP configurations and we can't
-     * guarantee they stay alive. */
-    _mgr_configs_data_clear(self);
-
     update_resolv_conf_no_stub(self,
                                NM_CAST_STRV_CC(searches),
                                NM_CAST_STRV_CC(nameservers),
@@ -2131,8 +2272,8 @@ nm_dns_manager_set_ip_config(NMDnsManager         *self,
             changed = TRUE;
         }
     } else {
-        ip_data->ip_config_type = ip_config_type;
-        changed                 = TRUE;
+        _dns_config_ip_data_set_ip_config_type(ip_data, ip_config_type);
+        changed = TRUE;
     }
 
     p_best = NM_IS_IPv4(addr_family) ? &priv->best_ip_config_4 : &priv->best_ip_config_6;
@@ -2140,7 +2281,7 @@ nm_dns_manager_set_ip_config(NMDnsManager         *self,
         /* Only one best-device per IP version is allowed */
         if (*p_best != ip_data) {
             if (*p_best)
-                (*p_best)->ip_config_type = NM_DNS_IP_CONFIG_TYPE_DEFAULT;
+                _dns_config_ip_data_set_ip_config_type(*p_best, NM_DNS_IP_CONFIG_TYPE_DEFAULT);
             *p_best = ip_data;
         }
     } else {
@@ -2525,6 +2666,12 @@ again:
             priv->plugin   = nm_dns_dnsmasq_new();
             plugin_changed = TRUE;
         }
+    } else if (nm_streq0(mode, "nm-stub")) {
+        if (force_reload_plugin || !NM_IS_DNS_STUB(priv->plugin)) {
+            _clear_plugin(self);
+            priv->plugin   = nm_dns_stub_new();
+            plugin_changed = TRUE;
+        }
     } else {
         if (!NM_IN_STRSET(mode, "none", "default")) {
             if (mode) {
@@ -2895,10 +3042,14 @@ finalize(GObject *object)
 {
     NMDnsManager        *self = NM_DNS_MANAGER(object);
     NMDnsManagerPrivate *priv = NM_DNS_MANAGER_GET_PRIVATE(self);
+    guint                i;
 
     g_free(priv->hostdomain);
     g_free(priv->mode);
 
+    for (i = 0; i < _RC_FILE_NUM; i++)
+        g_free(priv->rc_file_cache[i].path);
+
     G_OBJECT_CLASS(nm_dns_manager_parent_class)->finalize(object);
 }
 
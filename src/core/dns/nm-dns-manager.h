@@ -23,10 +23,31 @@ typedef struct {
     CList                    ip_data_lst;
     NMDnsIPConfigType        ip_config_type;
     int                      addr_family;
+
+    /* The SHA1 digest of the DNS parameters of "l3cd" (see nm_l3_config_data_hash_dns()).
+     * It only depends on "l3cd" and "ip_config_type", so it gets computed once when
+     * those are set and NMDnsManager combines the digests of all entries. */
+    guint8 dns_digest[NM_UTILS_CHECKSUM_LENGTH_SHA1];
+    bool   dns_digest_empty : 1;
+
+    /* Whether this entry qualifies for the automatic "~" domain. Also only depends
+     * on "l3cd" and "ip_config_type". */
+    bool dns_add_wildcard : 1;
+
     struct {
         const char **search;
         char       **reverse;
 
+        /* The preceding entry (with name servers) at the time when the domains
+         * were constructed. If that changes, the domains must be rebuilt. */
+        gconstpointer prev;
+
+        /* Whether "search" and the flags below are up to date. */
+        bool valid : 1;
+
+        /* "reverse" only depends on "l3cd", it is computed once. */
+        bool reverse_valid : 1;
+
         /* Whether "search" explicitly contains a default route "~"
          * or "". It is redundant information, but for faster lookup. */
         bool has_default_route_explicit : 1;
@@ -0,0 +1,614 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nm-dns-stub.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "libnm-base/nm-dns-stub-base.h"
+#include "libnm-core-intern/nm-core-internal.h"
+#include "libnm-glib-aux/nm-io-utils.h"
+#include "nm-core-utils.h"
+#include "nm-l3-config-data.h"
+#include "nm-utils.h"
+
+#define HELPER_PATH LIBEXECDIR "/nm-dns-stub"
+
+#define RATELIMIT_INTERVAL_MSEC 30000
+#define RATELIMIT_BURST         5
+
+/* How long to wait for nm-dns-stub to acknowledge a configuration. */
+#define REPLY_TIMEOUT_MSEC 10000
+
+#define WAIT_MSEC_AFTER_SIGTERM 1000
+G_STATIC_ASSERT(WAIT_MSEC_AFTER_SIGTERM <= NM_SHUTDOWN_TIMEOUT_MAX_MSEC);
+
+#define _NMLOG_DOMAIN LOGD_DNS
+
+/*****************************************************************************/
+
+typedef struct {
+    /* The last configuration, without the generation. */
+    GVariant *servers;
+
+    GSource *child_watch_source;
+    GSource *control_source;
+    GSource *reply_timeout_source;
+    GSource *burst_retry_timeout_source;
+
+    gint64 burst_start_at;
+
+    GPid pid;
+
+    int control_fd;
+
+    guint32 generation;
+
+    guint8 burst_count;
+
+    bool is_stopped : 1;
+
+    /* the configuration changed and was not yet sent. */
+    bool servers_dirty : 1;
+
+    /* the configuration was sent, but not yet acknowledged. */
+    bool reply_pending : 1;
+
+    bool update_pending : 1;
+} NMDnsStubPrivate;
+
+struct _NMDnsStub {
+    NMDnsPlugin      parent;
+    NMDnsStubPrivate _priv;
+};
+
+struct _NMDnsStubClass {
+    NMDnsPluginClass parent;
+};
+
+G_DEFINE_TYPE(NMDnsStub, nm_dns_stub, NM_TYPE_DNS_PLUGIN)
+
+#define NM_DNS_STUB_GET_PRIVATE(self) _NM_GET_PRIVATE(self, NMDnsStub, NM_IS_DNS_STUB, NMDnsPlugin)
+
+/*****************************************************************************/
+
+#define _NMLOG(level, ...) __NMLOG_DEFAULT_WITH_ADDR(level, _NMLOG_DOMAIN, "nm-stub", __VA_ARGS__)
+
+/*****************************************************************************/
+
+static gboolean start_stub(NMDnsStub *self, gboolean force_start, GError **error);
+static void     send_config(NMDnsStub *self);
+
+/*****************************************************************************/
+
+static gboolean
+_update_pending_detect(NMDnsStub *self)
+{
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+
+    if (priv->is_stopped)
+        return FALSE;
+    if (priv->servers_dirty || priv->reply_pending)
+        return TRUE;
+    return FALSE;
+}
+
+static void
+_update_pending_maybe_changed(NMDnsStub *self)
+{
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+    gboolean          update_pending;
+
+    update_pending = _update_pending_detect(self);
+    if (priv->update_pending == update_pending)
+        return;
+
+    priv->update_pending = update_pending;
+    _nm_dns_plugin_update_pending_maybe_changed(NM_DNS_PLUGIN(self));
+}
+
+static gboolean
+get_update_pending(NMDnsPlugin *plugin)
+{
+    NMDnsStub        *self = NM_DNS_STUB(plugin);
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+
+    nm_assert(priv->update_pending == _update_pending_detect(self));
+    return priv->update_pending;
+}
+
+/*****************************************************************************/
+
+static void
+add_server(NMDnsStub       *self,
+           GVariantBuilder *servers,
+           const char      *address,
+           int              ifindex,
+           const char      *domain)
+{
+    _LOGD("adding nameserver '%s'%s%s%s",
+          address,
+          NM_PRINT_FMT_QUOTED(domain, " for domain \"", domain, "\"", ""));
+
+    g_variant_builder_add(servers, "(sis)", address, ifindex, domain ?: "");
+}
+
+static void
+add_global_config(NMDnsStub *self, GVariantBuilder *servers, const NMGlobalDnsConfig *config)
+{
+    guint i, j;
+
+    for (i = 0; i < nm_global_dns_config_get_num_domains(config); i++) {
+        NMGlobalDnsDomain *domain      = nm_global_dns_config_get_domain(config, i);
+        const char *const *domain_srvs = nm_global_dns_domain_get_servers(domain);
+        const char        *name        = nm_global_dns_domain_get_name(domain);
+
+        g_return_if_fail(name);
+
+        for (j = 0; domain_srvs && domain_srvs[j]; j++)
+            add_server(self, servers, domain_srvs[j], 0, nm_streq(name, "*") ? NULL : name);
+    }
+}
+
+static void
+add_ip_config(NMDnsStub *self, GVariantBuilder *servers, const NMDnsConfigIPData *ip_data)
+{
+    const char *const *strarr;
+    char               sbuf[NM_INET_ADDRSTRLEN];
+    guint              num;
+    guint              i;
+    guint              j;
+
+    strarr = nm_l3_config_data_get_nameservers(ip_data->l3cd, ip_data->addr_family, &num);
+    for (i = 0; i < num; i++) {
+        NMIPAddr a;
+        int      ifindex = 0;
+
+        if (!nm_utils_dnsname_parse_assert(ip_data->addr_family, strarr[i], NULL, &a, NULL))
+            continue;
+
+        nm_inet_ntop(ip_data->addr_family, &a, sbuf);
+        if (ip_data->addr_family == AF_INET6 && IN6_IS_ADDR_LINKLOCAL(&a.addr6))
+            ifindex = ip_data->data->ifindex;
+
+        if (!ip_data->domains.has_default_route_explicit && ip_data->domains.has_default_route)
+            add_server(self, servers, sbuf, ifindex, NULL);
+        if (ip_data->domains.search) {
+            for (j = 0; ip_data->domains.search[j]; j++) {
+                const char *domain;
+
+                domain = nm_utils_parse_dns_domain(ip_data->domains.search[j], NULL);
+                add_server(self, servers, sbuf, ifindex, domain[0] ? domain : NULL);
+            }
+        }
+        if (ip_data->domains.reverse) {
+            for (j = 0; ip_data->domains.reverse[j]; j++)
+                add_server(self, servers, sbuf, ifindex, ip_data->domains.reverse[j]);
+        }
+    }
+}
+
+static GVariant *
+create_servers(NMDnsStub               *self,
+               const NMGlobalDnsConfig *global_config,
+               const CList             *ip_data_lst_head)
+{
+    GVariantBuilder          servers;
+    const NMDnsConfigIPData *ip_data;
+
+    g_variant_builder_init(&servers, G_VARIANT_TYPE("a(sis)"));
+
+    if (global_config)
+        add_global_config(self, &servers, global_config);
+
+    if (!global_config || !nm_global_dns_config_lookup_domain(global_config, "*")) {
+        c_list_for_each_entry (ip_data, ip_data_lst_head, ip_data_lst)
+            add_ip_config(self, &servers, ip_data);
+    }
+
+    return g_variant_builder_end(&servers);
+}
+
+/*****************************************************************************/
+
+static void
+_process_cleanup(NMDnsStub *self)
+{
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->control_source);
+    nm_clear_g_source_inst(&priv->reply_timeout_source);
+    nm_clear_fd(&priv->control_fd);
+
+    if (priv->pid > 0) {
+        /* Closing the control socket lets nm-dns-stub exit. Still send SIGTERM
+         * and let nm_utils_kill_child_async() reap the process. */
+        nm_clear_g_source_inst(&priv->child_watch_source);
+        nm_utils_kill_child_async(nm_steal_int(&priv->pid),
+                                  SIGTERM,
+                                  _NMLOG_DOMAIN,
+                                  "nm-dns-stub",
+                                  WAIT_MSEC_AFTER_SIGTERM,
+                                  NULL,
+                                  NULL);
+    }
+
+    if (priv->reply_pending) {
+        /* the configuration needs to be sent again to the next instance. */
+        priv->reply_pending = FALSE;
+        priv->servers_dirty = !!priv->servers;
+    }
+}
+
+static void
+_process_restart(NMDnsStub *self)
+{
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+
+    _process_cleanup(self);
+
+    if (!priv->is_stopped) {
+        priv->servers_dirty = !!priv->servers;
+        start_stub(self, FALSE, NULL);
+        send_config(self);
+    }
+
+    _update_pending_maybe_changed(self);
+}
+
+static void
+_child_watch_cb(GPid pid, int status, gpointer user_data)
+{
+    NMDnsStub        *self       = user_data;
+    NMDnsStubPrivate *priv       = NM_DNS_STUB_GET_PRIVATE(self);
+    gs_free char     *status_str = NULL;
+
+    nm_assert(pid == priv->pid);
+
+    nm_clear_g_source_inst(&priv->child_watch_source);
+    priv->pid = 0;
+
+    _LOGW("nm-dns-stub process %" G_PID_FORMAT " exited unexpectedly (%s)",
+          pid,
+          (status_str = nm_utils_get_process_exit_status_desc(status)));
+
+    _process_restart(self);
+}
+
+static gboolean
+_reply_timeout_cb(gpointer user_data)
+{
+    NMDnsStub *self = user_data;
+
+    _LOGW("nm-dns-stub did not acknowledge the configuration. Restart it");
+    _process_restart(self);
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+_control_fd_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    NMDnsStub        *self = user_data;
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+
+    while (TRUE) {
+        gs_unref_variant GVariant *reply = NULL;
+        gs_free guint8            *buf   = NULL;
+        guint32                    generation;
+        gssize                     size;
+        gssize                     n;
+
+        size = nm_fd_next_datagram_size(fd);
+        if (size == -EAGAIN)
+            break;
+        if (size < 0)
+            goto fail;
+
+        buf = g_malloc(NM_MAX(size, 1));
+        n   = recv(fd, buf, size, MSG_DONTWAIT);
+        if (n < 0) {
+            if (NM_ERRNO_IS_TRANSIENT(errno))
+                break;
+            goto fail;
+        }
+        if (n == 0)
+            goto fail;
+
+        reply = g_variant_ref_sink(g_variant_new_from_data(G_VARIANT_TYPE(NM_DNS_STUB_CONFIG_TYPE),
+                                                           g_steal_pointer(&buf),
+                                                           n,
+                                                           FALSE,
+                                                           g_free,
+                                                           NULL));
+        if (!g_variant_is_normal_form(reply)
+            || !g_variant_lookup(reply, NM_DNS_STUB_CONFIG_GENERATION, "u", &generation)) {
+            _LOGW("invalid reply from nm-dns-stub");
+            continue;
+        }
+
+        if (priv->reply_pending && generation == priv->generation) {
+            _LOGT("configuration %u acknowledged", generation);
+            priv->reply_pending = FALSE;
+            nm_clear_g_source_inst(&priv->reply_timeout_source);
+            _update_pending_maybe_changed(self);
+        }
+    }
+
+    if (!(condition & (G_IO_HUP | G_IO_ERR)))
+        return G_SOURCE_CONTINUE;
+
+fail:
+    /* The process is about to exit. The child watch will restart it. */
+    _LOGD("control socket of nm-dns-stub closed");
+    nm_clear_g_source_inst(&priv->control_source);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+send_config(NMDnsStub *self)
+{
+    NMDnsStubPrivate          *priv = NM_DNS_STUB_GET_PRIVATE(self);
+    gs_unref_variant GVariant *msg  = NULL;
+    GVariantBuilder            builder;
+
+    if (!priv->servers_dirty || priv->control_fd < 0)
+        return;
+
+    priv->generation++;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE(NM_DNS_STUB_CONFIG_TYPE));
+    g_variant_builder_add(&builder,
+                          "{sv}",
+                          NM_DNS_STUB_CONFIG_GENERATION,
+                          g_variant_new_uint32(priv->generation));
+    g_variant_builder_add(&builder, "{sv}", NM_DNS_STUB_CONFIG_SERVERS, priv->servers);
+    g_variant_builder_add(&builder,
+                          "{sv}",
+                          NM_DNS_STUB_CONFIG_CACHE_SIZE,
+                          g_variant_new_uint32(NM_DNS_STUB_CACHE_SIZE_DEFAULT));
+    msg = g_variant_ref_sink(g_variant_builder_end(&builder));
+
+    if (send(priv->control_fd,
+             g_variant_get_data(msg),
+             g_variant_get_size(msg),
+             MSG_NOSIGNAL | MSG_DONTWAIT)
+        < 0) {
+        _LOGW("failed to send configuration to nm-dns-stub: %s", nm_strerror_native(errno));
+        _process_restart(self);
+        return;
+    }
+
+    _LOGT("configuration %u sent", priv->generation);
+
+    priv->servers_dirty = FALSE;
+    priv->reply_pending = TRUE;
+    nm_clear_g_source_inst(&priv->reply_timeout_source);
+    priv->reply_timeout_source = nm_g_timeout_add_source(REPLY_TIMEOUT_MSEC, _reply_timeout_cb, self);
+}
+
+/*****************************************************************************/
+
+static void
+_child_setup(gpointer user_data)
+{
+    int fd = GPOINTER_TO_INT(user_data);
+
+    nm_utils_setpgid(NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    /* dup2() clears FD_CLOEXEC on the target. If the socket already has
+     * the right number, we need to clear the flag ourselves. */
+    if (fd == NM_DNS_STUB_CONTROL_FD)
+        fcntl(fd, F_SETFD, 0);
+    else
+        dup2(fd, NM_DNS_STUB_CONTROL_FD);
+}
+
+static gboolean
+_spawn(NMDnsStub *self, GError **error)
+{
+    NMDnsStubPrivate *priv      = NM_DNS_STUB_GET_PRIVATE(self);
+    gs_strfreev char **envp      = NULL;
+    nm_auto_close int  fd_child  = -1;
+    nm_auto_close int  fd_parent = -1;
+    const char        *argv[]    = {HELPER_PATH, NULL};
+    int                fds[2];
+    GPid               pid;
+
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, fds) < 0) {
+        nm_utils_error_set_errno(error, errno, "failed to create control socket: %s");
+        return FALSE;
+    }
+    fd_parent = fds[0];
+    fd_child  = fds[1];
+
+    envp = g_get_environ();
+    if (_LOGT_ENABLED())
+        envp = g_environ_setenv(envp, "NM_DNS_STUB_LOG", "trace", TRUE);
+    else if (_LOGD_ENABLED())
+        envp = g_environ_setenv(envp, "NM_DNS_STUB_LOG", "debug", TRUE);
+
+    if (!g_spawn_async(NULL,
+                       (char **) argv,
+                       envp,
+                       G_SPAWN_DO_NOT_REAP_CHILD | G_SPAWN_LEAVE_DESCRIPTORS_OPEN,
+                       _child_setup,
+                       GINT_TO_POINTER(fd_child),
+                       &pid,
+                       error))
+        return FALSE;
+
+    _LOGD("nm-dns-stub started with pid %" G_PID_FORMAT, pid);
+
+    priv->pid                = pid;
+    priv->child_watch_source = nm_g_child_watch_add_source(pid, _child_watch_cb, self);
+    priv->control_fd         = nm_steal_fd(&fd_parent);
+    priv->control_source     = nm_g_unix_fd_add_source(priv->control_fd,
+                                                   G_IO_IN | G_IO_HUP | G_IO_ERR,
+                                                   _control_fd_cb,
+                                                   self);
+    return TRUE;
+}
+
+static gboolean
+_burst_retry_timeout_cb(gpointer user_data)
+{
+    NMDnsStub        *self = user_data;
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->burst_retry_timeout_source);
+
+    start_stub(self, TRUE, NULL);
+    send_config(self);
+    _update_pending_maybe_changed(self);
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+start_stub(NMDnsStub *self, gboolean force_start, GError **error)
+{
+    NMDnsStubPrivate     *priv  = NM_DNS_STUB_GET_PRIVATE(self);
+    gs_free_error GError *local = NULL;
+    gint64                now;
+
+    if (G_LIKELY(priv->pid > 0)) {
+        /* The process is already running. Nothing to do. */
+        return TRUE;
+    }
+
+    if (!g_file_test(HELPER_PATH, G_FILE_TEST_IS_EXECUTABLE)) {
+        /* Fail early, so that NMDnsManager can fallback to a non-caching
+         * implementation. */
+        nm_utils_error_set(error, NM_UTILS_ERROR_UNKNOWN, "could not find " HELPER_PATH);
+        return FALSE;
+    }
+
+    now = nm_utils_get_monotonic_timestamp_msec();
+    if (force_start || priv->burst_start_at == 0
+        || priv->burst_start_at + RATELIMIT_INTERVAL_MSEC <= now) {
+        priv->burst_start_at = now;
+        priv->burst_count    = 1;
+        nm_clear_g_source_inst(&priv->burst_retry_timeout_source);
+    } else if (priv->burst_count < RATELIMIT_BURST) {
+        nm_assert(!priv->burst_retry_timeout_source);
+        priv->burst_count++;
+    } else {
+        if (!priv->burst_retry_timeout_source) {
+            _LOGW("nm-dns-stub dies and gets respawned too quickly. Back off. Something is "
+                  "very wrong");
+            priv->burst_retry_timeout_source =
+                nm_g_timeout_add_seconds_source((2 * RATELIMIT_INTERVAL_MSEC) / 1000,
+                                                _burst_retry_timeout_cb,
+                                                self);
+        }
+        return TRUE;
+    }
+
+    if (!_spawn(self, &local)) {
+        _LOGW("failed to start nm-dns-stub: %s", local->message);
+        g_propagate_error(error, g_steal_pointer(&local));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+static gboolean
+update(NMDnsPlugin             *plugin,
+       const NMGlobalDnsConfig *global_config,
+       const CList             *ip_data_lst_head,
+       const char              *hostdomain,
+       GError                 **error)
+{
+    NMDnsStub                 *self    = NM_DNS_STUB(plugin);
+    NMDnsStubPrivate          *priv    = NM_DNS_STUB_GET_PRIVATE(self);
+    gs_unref_variant GVariant *servers = NULL;
+
+    if (!start_stub(self, TRUE, error))
+        return FALSE;
+
+    servers = g_variant_ref_sink(create_servers(self, global_config, ip_data_lst_head));
+
+    if (priv->servers && g_variant_equal(priv->servers, servers)) {
+        /* Nothing changed. Don't bother nm-dns-stub, which would also flush its cache. */
+        _LOGT("configuration unchanged");
+    } else {
+        NM_SWAP(&priv->servers, &servers);
+        priv->servers_dirty = TRUE;
+        send_config(self);
+    }
+
+    _update_pending_maybe_changed(self);
+    return TRUE;
+}
+
+static void
+stop(NMDnsPlugin *plugin)
+{
+    NMDnsStub        *self = NM_DNS_STUB(plugin);
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+
+    priv->is_stopped     = TRUE;
+    priv->burst_start_at = 0;
+    nm_clear_g_source_inst(&priv->burst_retry_timeout_source);
+
+    _process_cleanup(self);
+
+    nm_clear_pointer(&priv->servers, g_variant_unref);
+    priv->servers_dirty = FALSE;
+
+    _update_pending_maybe_changed(self);
+}
+
+/*****************************************************************************/
+
+static void
+nm_dns_stub_init(NMDnsStub *self)
+{
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+
+    priv->control_fd = -1;
+}
+
+NMDnsPlugin *
+nm_dns_stub_new(void)
+{
+    return g_object_new(NM_TYPE_DNS_STUB, NULL);
+}
+
+static void
+dispose(GObject *object)
+{
+    NMDnsStub        *self = NM_DNS_STUB(object);
+    NMDnsStubPrivate *priv = NM_DNS_STUB_GET_PRIVATE(self);
+
+    priv->is_stopped = TRUE;
+
+    nm_clear_g_source_inst(&priv->burst_retry_timeout_source);
+
+    _process_cleanup(self);
+
+    nm_clear_pointer(&priv->servers, g_variant_unref);
+
+    G_OBJECT_CLASS(nm_dns_stub_parent_class)->dispose(object);
+}
+
+static void
+nm_dns_stub_class_init(NMDnsStubClass *dns_class)
+{
+    NMDnsPluginClass *plugin_class = NM_DNS_PLUGIN_CLASS(dns_class);
+    GObjectClass     *object_class = G_OBJECT_CLASS(dns_class);
+
+    object_class->dispose = dispose;
+
+    plugin_class->plugin_name        = "nm-stub";
+    plugin_class->is_caching         = TRUE;
+    plugin_class->stop               = stop;
+    plugin_class->update             = update;
+    plugin_class->get_update_pending = get_update_pending;
+}
@@ -38,6 +38,10 @@ static const char *const DBUS_OP_SET_LINK_DEFAULT_ROUTE = "SetLinkDefaultRoute";
 static const char *const DBUS_OP_SET_LINK_DNS_OVER_TLS  = "SetLinkDNSOverTLS";
 static const char *const DBUS_OP_SET_LINK_DNS_EX        = "SetLinkDNSEx";
 
+/* The maximum number of D-Bus calls to systemd-resolved that we have in flight
+ * at the same time. The remaining ones are queued and sent as replies arrive. */
+#define SEND_UPDATES_MAX_PENDING 32u
+
 /*****************************************************************************/
 
 typedef struct {
@@ -47,6 +51,7 @@ typedef struct {
 
 typedef struct {
     CList                 request_queue_lst;
+    CList                 send_lst;
     const char           *operation;
     GVariant             *argument;
     NMDnsSystemdResolved *self;
@@ -54,6 +59,14 @@ typedef struct {
     int                   ref_count;
 } RequestItem;
 
+/* The argument of the last call of an operation for a link. We don't repeat
+ * calls that would not change anything in systemd-resolved. */
+typedef struct {
+    int         ifindex;
+    const char *operation;
+    GVariant   *argument;
+} LinkState;
+
 struct _NMDnsSystemdResolvedResolveHandle {
     CList                 handle_lst;
     NMDnsSystemdResolved *self;
@@ -81,6 +94,8 @@ typedef struct {
     GCancellable    *cancellable;
     GCancellable    *service_start_cancellable;
     CList            request_queue_lst_head;
+    CList            send_lst_head;
+    GHashTable      *link_state;
     char            *dbus_owner;
     CList            handle_lst_head;
     guint            name_owner_changed_id;
@@ -150,6 +165,8 @@ static void _resolve_start(NMDnsSystemdResolved *self, NMDnsSystemdResolvedResol
 
 static void send_updates(NMDnsSystemdResolved *self);
 
+static void _send_queue_dispatch(NMDnsSystemdResolved *self, guint n_completing);
+
 /*****************************************************************************/
 
 static gboolean
@@ -211,6 +228,86 @@ get_update_pending(NMDnsPlugin *plugin)
 
 /*****************************************************************************/
 
+static guint
+_link_state_hash(gconstpointer ptr)
+{
+    const LinkState *ls = ptr;
+    NMHashState      h;
+
+    nm_hash_init(&h, 1664377703u);
+    nm_hash_update_val(&h, ls->ifindex);
+    nm_hash_update_str(&h, ls->operation);
+    return nm_hash_complete(&h);
+}
+
+static gboolean
+_link_state_equal(gconstpointer a, gconstpointer b)
+{
+    const LinkState *ls_a = a;
+    const LinkState *ls_b = b;
+
+    return ls_a->ifindex == ls_b->ifindex && nm_streq(ls_a->operation, ls_b->operation);
+}
+
+static void
+_link_state_free(gpointer ptr)
+{
+    LinkState *ls = ptr;
+
+    g_variant_unref(ls->argument);
+    nm_g_slice_free(ls);
+}
+
+static gboolean
+_link_state_is_current(NMDnsSystemdResolved *self, const RequestItem *request_item)
+{
+    NMDnsSystemdResolvedPrivate *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
+    const LinkState             *ls;
+    LinkState                    needle = {
+                           .ifindex   = request_item->ifindex,
+                           .operation = request_item->operation,
+    };
+
+    ls = g_hash_table_lookup(priv->link_state, &needle);
+    return ls && g_variant_equal(ls->argument, request_item->argument);
+}
+
+static void
+_link_state_set(NMDnsSystemdResolved *self, const RequestItem *request_item)
+{
+    NMDnsSystemdResolvedPrivate *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
+    LinkState                   *ls;
+
+    ls  = g_slice_new(LinkState);
+    *ls = (LinkState){
+        .ifindex   = request_item->ifindex,
+        .operation = request_item->operation,
+        .argument  = g_variant_ref(request_item->argument),
+    };
+    g_hash_table_add(priv->link_state, ls);
+}
+
+static void
+_link_state_forget(NMDnsSystemdResolved *self,
+                   int                   ifindex,
+                   const char           *operation,
+                   GVariant             *argument)
+{
+    NMDnsSystemdResolvedPrivate *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
+    const LinkState             *ls;
+    LinkState                    needle = {
+                           .ifindex   = ifindex,
+                           .operation = operation,
+    };
+
+    /* Only forget the state, if it was not already replaced by a newer call. */
+    ls = g_hash_table_lookup(priv->link_state, &needle);
+    if (ls && g_variant_equal(ls->argument, argument))
+        g_hash_table_remove(priv->link_state, ls);
+}
+
+/*****************************************************************************/
+
 static RequestItem *
 _request_item_ref(RequestItem *request_item)
 {
@@ -233,6 +330,7 @@ _request_item_unref(RequestItem *request_item)
         return;
 
     nm_assert(c_list_is_empty(&request_item->request_queue_lst));
+    nm_assert(c_list_is_empty(&request_item->send_lst));
 
     g_variant_unref(request_item->argument);
     nm_g_slice_free(request_item);
@@ -250,6 +348,7 @@ _request_item_append(NMDnsSystemdResolved *self,
     request_item  = g_slice_new(RequestItem);
     *request_item = (RequestItem){
         .ref_count = 1,
+        .send_lst  = C_LIST_INIT(request_item->send_lst),
         .operation = operation,
         .argument  = g_variant_ref_sink(argument),
         .self      = self,
@@ -274,6 +373,7 @@ call_done(GObject *source, GAsyncResult *r, gpointer user_data)
     gs_free_error GError        *error = NULL;
     NMDnsSystemdResolved        *self;
     NMDnsSystemdResolvedPrivate *priv;
+    gs_unref_variant GVariant   *argument = NULL;
     RequestItem                 *request_item;
     NMLogLevel                   log_level;
     const char                  *operation;
@@ -284,13 +384,24 @@ call_done(GObject *source, GAsyncResult *r, gpointer user_data)
     self         = request_item->self;
     operation    = request_item->operation;
     ifindex      = request_item->ifindex;
+    argument     = g_variant_ref(request_item->argument);
     _request_item_unref(request_item);
 
     priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
 
     v = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), r, &error);
-    if (nm_utils_error_is_cancelled(error))
+    if (nm_utils_error_is_cancelled(error)) {
+        /* The request was already sent, we only don't care about the
+         * reply. Keep the link state. */
         goto out_dec_pending;
+    }
+
+    if (!v) {
+        /* We don't know whether the call had any effect. Make sure we
+         * send it again with the next update. */
+        if (priv->link_state)
+            _link_state_forget(self, ifindex, operation, argument);
+    }
 
     if (v) {
         if (operation == DBUS_OP_SET_LINK_DEFAULT_ROUTE) {
@@ -352,6 +463,11 @@ call_done(GObject *source, GAsyncResult *r, gpointer user_data)
 
 out_dec_pending:
     nm_assert(priv->n_pending > 0);
+
+    /* Our request is done. Start the next queued requests while we are still
+     * counted as pending (and keep @self alive). */
+    _send_queue_dispatch(self, 1);
+
     if (--priv->n_pending <= 0) {
         _update_pending_maybe_changed(self);
         /* We keep @self alive while pending operations are in progress. It's simpler
@@ -455,6 +571,7 @@ free_pending_updates(NMDnsSystemdResolved *self)
         (request_item =
              c_list_first_entry(&priv->request_queue_lst_head, RequestItem, request_queue_lst))) {
         c_list_unlink(&request_item->request_queue_lst);
+        c_list_unlink(&request_item->send_lst);
         _request_item_unref(request_item);
     }
 }
@@ -683,12 +800,64 @@ ensure_resolved_running(NMDnsSystemdResolved *self)
     return NM_TERNARY_TRUE;
 }
 
+static void
+_send_queue_dispatch(NMDnsSystemdResolved *self, guint n_completing)
+{
+    NMDnsSystemdResolvedPrivate *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
+    RequestItem                 *request_item;
+
+    /* @n_completing are the requests, which are still counted in "n_pending"
+     * but whose reply we are currently handling. They don't count against
+     * the limit. */
+    nm_assert(priv->n_pending >= n_completing);
+
+    if (!priv->dbus_owner || !priv->cancellable)
+        return;
+
+    while (priv->n_pending - n_completing < SEND_UPDATES_MAX_PENDING
+           && (request_item =
+                   c_list_first_entry(&priv->send_lst_head, RequestItem, send_lst))) {
+        gs_free char *ss = NULL;
+
+        c_list_unlink(&request_item->send_lst);
+
+        _LOGT("send-updates: %s ( %s )",
+              request_item->operation,
+              (ss = g_variant_print(request_item->argument, FALSE)));
+
+        if (priv->n_pending++ == 0) {
+            /* We are inside send_updates() (call_done() always has a pending
+             * request). All callers are already calling
+             * _update_pending_maybe_changed() afterwards. */
+            g_object_ref(self);
+        }
+
+        _link_state_set(self, request_item);
+
+        g_dbus_connection_call(priv->dbus_connection,
+                               priv->dbus_owner,
+                               SYSTEMD_RESOLVED_DBUS_PATH,
+                               SYSTEMD_RESOLVED_MANAGER_IFACE,
+                               request_item->operation,
+                               request_item->argument,
+                               NULL,
+                               G_DBUS_CALL_FLAGS_NONE,
+                               -1,
+                               priv->cancellable,
+                               call_done,
+                               _request_item_ref(request_item));
+    }
+}
+
 static void
 send_updates(NMDnsSystemdResolved *self)
 {
     NMDnsSystemdResolvedPrivate       *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
     RequestItem                       *request_item;
+    RequestItem                       *request_item_safe;
     NMDnsSystemdResolvedResolveHandle *handle;
+    guint                              n_send      = 0;
+    guint                              n_unchanged = 0;
 
     if (!priv->send_updates_waiting) {
         /* nothing to do. */
@@ -700,21 +869,17 @@ send_updates(NMDnsSystemdResolved *self)
 
     nm_clear_g_cancellable(&priv->cancellable);
 
-    if (c_list_is_empty(&priv->request_queue_lst_head)) {
-        _LOGT("send-updates: no requests to send");
-        priv->send_updates_waiting = FALSE;
-        goto start_resolve;
-    }
-
-    priv->cancellable = g_cancellable_new();
+    /* Requests that we didn't start yet are obsolete. We compute anew
+     * what needs sending. */
+    c_list_for_each_entry_safe (request_item,
+                                request_item_safe,
+                                &priv->send_lst_head,
+                                send_lst)
+        c_list_unlink(&request_item->send_lst);
 
     priv->send_updates_waiting = FALSE;
 
-    _LOGT("send-updates: start %zu requests", c_list_length(&priv->request_queue_lst_head));
-
     c_list_for_each_entry (request_item, &priv->request_queue_lst_head, request_queue_lst) {
-        gs_free char *ss = NULL;
-
         if ((request_item->operation == DBUS_OP_SET_LINK_DEFAULT_ROUTE
              && priv->has_set_link_default_route == NM_TERNARY_FALSE)
             || (request_item->operation == DBUS_OP_SET_LINK_DNS_OVER_TLS
@@ -727,30 +892,27 @@ send_updates(NMDnsSystemdResolved *self)
             continue;
         }
 
-        _LOGT("send-updates: %s ( %s )",
-              request_item->operation,
-              (ss = g_variant_print(request_item->argument, FALSE)));
-
-        if (priv->n_pending++ == 0) {
-            /* We are inside send_updates(). All callers are already calling
-             * _update_pending_maybe_changed() afterwards. */
-            g_object_ref(self);
+        if (_link_state_is_current(self, request_item)) {
+            /* We already sent this very argument for the link. Skip. */
+            n_unchanged++;
+            continue;
         }
 
-        g_dbus_connection_call(priv->dbus_connection,
-                               priv->dbus_owner,
-                               SYSTEMD_RESOLVED_DBUS_PATH,
-                               SYSTEMD_RESOLVED_MANAGER_IFACE,
-                               request_item->operation,
-                               request_item->argument,
-                               NULL,
-                               G_DBUS_CALL_FLAGS_NONE,
-                               -1,
-                               priv->cancellable,
-                               call_done,
-                               _request_item_ref(request_item));
+        c_list_link_tail(&priv->send_lst_head, &request_item->send_lst);
+        n_send++;
     }
 
+    if (n_send == 0) {
+        _LOGT("send-updates: no requests to send (%u unchanged)", n_unchanged);
+        goto start_resolve;
+    }
+
+    priv->cancellable = g_cancellable_new();
+
+    _LOGT("send-updates: start %u requests (%u unchanged)", n_send, n_unchanged);
+
+    _send_queue_dispatch(self, 0);
+
 start_resolve:
     c_list_for_each_entry (handle, &priv->handle_lst_head, handle_lst) {
         if (handle->handle_cancellable)
@@ -863,6 +1025,25 @@ update(NMDnsPlugin             *plugin,
         }
     }
 
+    /* Forget the state of links that we no longer configure. If the ifindex
+     * shows up again, we configure it from scratch. */
+    g_hash_table_iter_init(&iter, priv->link_state);
+    while (g_hash_table_iter_next(&iter, &pointer, NULL)) {
+        const LinkState *ls      = pointer;
+        gboolean         cleared = FALSE;
+
+        if (g_hash_table_contains(interfaces, GINT_TO_POINTER(ls->ifindex)))
+            continue;
+        for (i = 0; dirty_array && i < dirty_array->len; i++) {
+            if (nm_g_array_index(dirty_array, int, i) == ls->ifindex) {
+                cleared = TRUE;
+                break;
+            }
+        }
+        if (!cleared)
+            g_hash_table_iter_remove(&iter);
+    }
+
     priv->send_updates_waiting = TRUE;
     send_updates(self);
     _update_pending_maybe_changed(self);
@@ -886,6 +1067,10 @@ name_owner_changed(NMDnsSystemdResolved *self, const char *owner)
     nm_clear_g_cancellable(&priv->service_start_cancellable);
     nm_strdup_reset(&priv->dbus_owner, owner);
 
+    /* A new (or no) instance of systemd-resolved does not know about
+     * our previous calls. */
+    g_hash_table_remove_all(priv->link_state);
+
     if (owner) {
         priv->try_start_blocked    = FALSE;
         priv->send_updates_waiting = TRUE;
@@ -1256,8 +1441,11 @@ nm_dns_systemd_resolved_init(NMDnsSystemdResolved *self)
     priv->has_set_link_dns_ex        = NM_TERNARY_DEFAULT;
 
     c_list_init(&priv->request_queue_lst_head);
+    c_list_init(&priv->send_lst_head);
     c_list_init(&priv->handle_lst_head);
     priv->dirty_interfaces = g_hash_table_new(nm_direct_hash, NULL);
+    priv->link_state =
+        g_hash_table_new_full(_link_state_hash, _link_state_equal, _link_state_free, NULL);
 
     priv->dbus_connection = nm_g_object_ref(NM_MAIN_DBUS_CONNECTION_GET);
     if (!priv->dbus_connection) {
@@ -1298,6 +1486,7 @@ dispose(GObject *object)
 
     g_clear_object(&priv->dbus_connection);
     nm_clear_pointer(&priv->dirty_interfaces, g_hash_table_destroy);
+    nm_clear_pointer(&priv->link_state, g_hash_table_destroy);
 
     G_OBJECT_CLASS(nm_dns_systemd_resolved_parent_class)->dispose(object);
 }
@@ -529,6 +529,8 @@ done:
 
     nm_manager_stop(manager);
 
+    nm_dispatcher_flush_pending();
+
     nm_config_state_set(config, TRUE, TRUE);
 
     nm_dns_manager_stop(nm_dns_manager_get());
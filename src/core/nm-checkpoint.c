@@ -23,10 +23,19 @@
 /*****************************************************************************/
 
 typedef struct {
-    char              *original_dev_path;
-    char              *original_dev_name;
-    NMDeviceType       dev_type;
-    NMDevice          *device;
+    char         *original_dev_path;
+    char         *original_dev_name;
+    NMDeviceType  dev_type;
+    NMDevice     *device;
+
+    /* The connection of a NMSettingsConnection never changes, it only gets
+     * replaced. So we don't copy it, but keep a reference. If the profile
+     * still has the same connection instance at rollback, it is unchanged.
+     *
+     * The applied connection may be modified in place (e.g. on reapply).
+     * If it was identical to the profile when creating the checkpoint, we
+     * also only reference @settings_connection (in which case both pointers
+     * are the same) and clone it when we need it during rollback. */
     NMConnection      *applied_connection;
     NMConnection      *settings_connection;
     guint64            ac_version_id;
@@ -172,21 +181,34 @@ find_settings_connection(NMCheckpoint     *self,
         return NULL;
 
     /* Now check if the connection changed, ... */
-    if (!nm_connection_compare(dev_checkpoint->settings_connection,
-                               nm_settings_connection_get_connection(sett_conn),
-                               NM_SETTING_COMPARE_FLAG_EXACT)) {
+    if (nm_settings_connection_get_connection(sett_conn) != dev_checkpoint->settings_connection
+        && !nm_connection_compare(dev_checkpoint->settings_connection,
+                                  nm_settings_connection_get_connection(sett_conn),
+                                  NM_SETTING_COMPARE_FLAG_EXACT)) {
         _LOGT("rollback: settings connection %s changed", uuid);
         *need_update     = TRUE;
         *need_activation = TRUE;
     }
 
     /* ... is active, ... */
-    nm_manager_for_each_active_connection (priv->manager, active, tmp_clist) {
-        ac_uuid =
-            nm_settings_connection_get_uuid(nm_active_connection_get_settings_connection(active));
-        if (nm_streq(uuid, ac_uuid)) {
-            _LOGT("rollback: connection %s is active", uuid);
-            break;
+    active = NULL;
+    if (dev_checkpoint->device) {
+        /* Usually, the connection is still active on our device. Check that first,
+         * to not iterate over all active connections for each device. */
+        active = (NMActiveConnection *) nm_device_get_act_request(dev_checkpoint->device);
+        if (active) {
+            ac_uuid = nm_settings_connection_get_uuid(
+                nm_active_connection_get_settings_connection(active));
+            if (!nm_streq(uuid, ac_uuid))
+                active = NULL;
+        }
+    }
+    if (!active) {
+        nm_manager_for_each_active_connection (priv->manager, active, tmp_clist) {
+            ac_uuid = nm_settings_connection_get_uuid(
+                nm_active_connection_get_settings_connection(active));
+            if (nm_streq(uuid, ac_uuid))
+                break;
         }
     }
 
@@ -196,6 +218,8 @@ find_settings_connection(NMCheckpoint     *self,
         return sett_conn;
     }
 
+    _LOGT("rollback: connection %s is active", uuid);
+
     /* ... or if the connection was reactivated/reapplied */
     if (nm_active_connection_version_id_get(active) != dev_checkpoint->ac_version_id) {
         _LOGT("rollback: active connection version id of %s changed", uuid);
@@ -210,8 +234,9 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
 {
     NMCheckpointPrivate            *priv = NM_CHECKPOINT_GET_PRIVATE(self);
     NMSettingsConnection           *connection;
-    gs_unref_object NMAuthSubject  *subject     = NULL;
-    GError                         *local_error = NULL;
+    gs_unref_object NMAuthSubject  *subject            = NULL;
+    gs_unref_object NMConnection   *applied_connection = NULL;
+    GError                         *local_error        = NULL;
     gboolean                        need_update, need_activation;
     NMSettingsConnectionPersistMode persist_mode;
     NMSettingsConnectionIntFlags    sett_flags;
@@ -299,10 +324,17 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
                                     NM_DEVICE_STATE_REASON_NEW_ACTIVATION);
         }
 
+        /* The new active connection takes the applied connection and modifies it.
+         * If we share it with the (immutable) settings connection, clone it now. */
+        if (dev_checkpoint->applied_connection == dev_checkpoint->settings_connection)
+            applied_connection = nm_simple_connection_new_clone(dev_checkpoint->applied_connection);
+        else
+            applied_connection = g_object_ref(dev_checkpoint->applied_connection);
+
         if (!nm_manager_activate_connection(
                 priv->manager,
                 connection,
-                dev_checkpoint->applied_connection,
+                applied_connection,
                 NULL,
                 dev_checkpoint->device,
                 subject,
@@ -559,6 +591,7 @@ device_checkpoint_create(NMCheckpoint *checkpoint, NMDevice *device)
 {
     DeviceCheckpoint     *dev_checkpoint;
     NMConnection         *applied_connection;
+    NMConnection         *connection;
     NMSettingsConnection *settings_connection;
     const char           *path;
     NMActRequest         *act_request;
@@ -591,10 +624,13 @@ device_checkpoint_create(NMCheckpoint *checkpoint, NMDevice *device)
     if (act_request) {
         settings_connection = nm_act_request_get_settings_connection(act_request);
         applied_connection  = nm_act_request_get_applied_connection(act_request);
+        connection          = nm_settings_connection_get_connection(settings_connection);
 
-        dev_checkpoint->applied_connection  = nm_simple_connection_new_clone(applied_connection);
-        dev_checkpoint->settings_connection = nm_simple_connection_new_clone(
-            nm_settings_connection_get_connection(settings_connection));
+        dev_checkpoint->settings_connection = g_object_ref(connection);
+        if (nm_connection_compare(applied_connection, connection, NM_SETTING_COMPARE_FLAG_EXACT))
+            dev_checkpoint->applied_connection = g_object_ref(connection);
+        else
+            dev_checkpoint->applied_connection = nm_simple_connection_new_clone(applied_connection);
         dev_checkpoint->ac_version_id =
             nm_active_connection_version_id_get(NM_ACTIVE_CONNECTION(act_request));
         dev_checkpoint->activation_reason =
@@ -25,6 +25,10 @@
 
 #define HEADER_STATUS_ONLINE "X-NetworkManager-Status: online\r\n"
 
+/* How long to keep an unused ConEngine, and with it the connections
+ * in its cache. */
+#define ENGINE_IDLE_TIMEOUT_SEC 120
+
 /*****************************************************************************/
 
 static NM_UTILS_LOOKUP_STR_DEFINE(_state_to_string,
@@ -58,6 +62,28 @@ typedef struct {
     char *response;
 } ConConfig;
 
+#if WITH_CONCHECK
+/* The cURL multi handle for the checks on one interface and address family.
+ * It is shared by all checks, so that they can reuse the connections and
+ * the DNS cache of cURL. A kept-alive connection only tests the path that
+ * existed when it was opened, so the engine is also bound to the gateway of
+ * the default route, and replaced when that changes. */
+typedef struct _NMConnectivityEngine {
+    CList           engines_lst;
+    CList           socks_lst_head;
+    NMConnectivity *self;
+    char           *ifspec;
+    CURLM          *curl_mhandle;
+    GSource        *curl_timer;
+    GSource        *idle_source;
+    NMIPAddr        gateway;
+    guint           n_handles;
+    int             addr_family;
+    bool            destroying : 1;
+    bool            stale : 1;
+} ConEngine;
+#endif
+
 struct _NMConnectivityCheckHandle {
     CList                       handles_lst;
     NMConnectivity             *self;
@@ -74,14 +100,17 @@ struct _NMConnectivityCheckHandle {
         ConConfig *con_config;
 
         GCancellable      *resolve_cancellable;
-        CURLM             *curl_mhandle;
+        ConEngine         *engine;
         CURL              *curl_ehandle;
-        struct curl_slist *request_headers;
         struct curl_slist *hosts;
 
-        GSource *curl_timer;
-
         gsize response_good_cnt;
+
+        /* Checks that leave through the same route share the result of one
+         * probe. The followers are linked to the leader that runs the probe. */
+        NMConnectivityProbeShare share;
+        NMIPAddr                 gateway;
+        int                      ifindex;
     } concheck;
 #endif
 
@@ -106,6 +135,7 @@ static guint signals[LAST_SIGNAL] = {0};
 typedef struct {
     CList      handles_lst_head;
     CList      completed_handles_lst_head;
+    CList      engines_lst_head;
     NMConfig  *config;
     ConConfig *con_config;
     guint      interval;
@@ -197,6 +227,109 @@ _con_config_get_response(const ConConfig *con_config)
 
 /*****************************************************************************/
 
+void
+_nm_connectivity_probe_share_init(NMConnectivityProbeShare *share)
+{
+    *share = (NMConnectivityProbeShare){
+        .leader = NULL,
+    };
+    c_list_init(&share->followers_lst_head);
+    c_list_init(&share->followers_lst);
+}
+
+void
+_nm_connectivity_probe_share_follow(NMConnectivityProbeShare *share,
+                                    NMConnectivityProbeShare *leader)
+{
+    nm_assert(!share->leader);
+    nm_assert(!leader->leader);
+    nm_assert(c_list_is_empty(&share->followers_lst_head));
+
+    share->leader = leader;
+    c_list_link_tail(&leader->followers_lst_head, &share->followers_lst);
+}
+
+void
+_nm_connectivity_probe_share_leave(NMConnectivityProbeShare *share)
+{
+    if (!share->leader)
+        return;
+
+    c_list_unlink(&share->followers_lst);
+    share->leader = NULL;
+}
+
+/**
+ * _nm_connectivity_probe_share_pop:
+ * @leader: the leader
+ *
+ * Returns: the first follower of @leader, which no longer follows it.
+ *   Or %NULL, if there are no followers left.
+ */
+NMConnectivityProbeShare *
+_nm_connectivity_probe_share_pop(NMConnectivityProbeShare *leader)
+{
+    NMConnectivityProbeShare *follower;
+
+    follower = c_list_first_entry(&leader->followers_lst_head,
+                                  NMConnectivityProbeShare,
+                                  followers_lst);
+    if (follower)
+        _nm_connectivity_probe_share_leave(follower);
+    return follower;
+}
+
+/**
+ * _nm_connectivity_probe_share_hand_over:
+ * @leader: the leader
+ *
+ * The first follower of @leader becomes the leader of the other followers.
+ *
+ * Returns: the new leader, or %NULL if @leader had no followers.
+ */
+NMConnectivityProbeShare *
+_nm_connectivity_probe_share_hand_over(NMConnectivityProbeShare *leader)
+{
+    NMConnectivityProbeShare *new_leader;
+    NMConnectivityProbeShare *follower;
+
+    new_leader = _nm_connectivity_probe_share_pop(leader);
+    if (!new_leader)
+        return NULL;
+
+    while ((follower = _nm_connectivity_probe_share_pop(leader)))
+        _nm_connectivity_probe_share_follow(follower, new_leader);
+    return new_leader;
+}
+
+#if WITH_CONCHECK
+static void _probe_start(NMConnectivityCheckHandle *cb_data);
+static gboolean _idle_cb(gpointer user_data);
+
+static void
+_followers_complete(NMConnectivityCheckHandle *cb_data, NMConnectivityState state)
+{
+    NMConnectivityProbeShare  *share;
+    NMConnectivityCheckHandle *follower;
+
+    if (state == NM_CONNECTIVITY_CANCELLED) {
+        /* Only the leader was cancelled. The first follower takes over
+         * and probes anew. */
+        share = _nm_connectivity_probe_share_hand_over(&cb_data->concheck.share);
+        if (share)
+            _probe_start(c_list_entry(share, NMConnectivityCheckHandle, concheck.share));
+        return;
+    }
+
+    while ((share = _nm_connectivity_probe_share_pop(&cb_data->concheck.share))) {
+        follower                   = c_list_entry(share, NMConnectivityCheckHandle, concheck.share);
+        follower->completed_state  = state;
+        follower->completed_reason = "shared result";
+        follower->timeout_source   = nm_g_idle_add_source(_idle_cb, follower);
+    }
+}
+#endif
+
 static void
 cb_data_complete(NMConnectivityCheckHandle *cb_data,
                  NMConnectivityState        state,
@@ -219,6 +352,8 @@ cb_data_complete(NMConnectivityCheckHandle *cb_data,
     c_list_unlink_stale(&cb_data->handles_lst);
 
 #if WITH_CONCHECK
+    _nm_connectivity_probe_share_leave(&cb_data->concheck.share);
+
     if (cb_data->concheck.curl_ehandle) {
         /* Contrary to what cURL manual claim it is *not* safe to remove
          * the easy handle "at any moment"; specifically it's not safe to
@@ -232,16 +367,15 @@ cb_data_complete(NMConnectivityCheckHandle *cb_data,
         curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_HEADERFUNCTION, NULL);
         curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_HEADERDATA, NULL);
         curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_PRIVATE, NULL);
-        curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_HTTPHEADER, NULL);
 
-        curl_multi_remove_handle(cb_data->concheck.curl_mhandle, cb_data->concheck.curl_ehandle);
+        curl_multi_remove_handle(cb_data->concheck.engine->curl_mhandle,
+                                 cb_data->concheck.curl_ehandle);
         curl_easy_cleanup(cb_data->concheck.curl_ehandle);
-        curl_multi_cleanup(cb_data->concheck.curl_mhandle);
 
-        curl_slist_free_all(cb_data->concheck.request_headers);
         curl_slist_free_all(cb_data->concheck.hosts);
     }
-    nm_clear_g_source_inst(&cb_data->concheck.curl_timer);
+    if (cb_data->concheck.engine)
+        _nm_connectivity_engine_release(g_steal_pointer(&cb_data->concheck.engine));
     nm_clear_g_cancellable(&cb_data->concheck.resolve_cancellable);
 #endif
 
@@ -249,6 +383,11 @@ cb_data_complete(NMConnectivityCheckHandle *cb_data,
 
     _LOG2D("check completed: %s; %s", nm_connectivity_state_to_string(state), log_message);
 
+#if WITH_CONCHECK
+    if (!c_list_is_empty(&cb_data->concheck.share.followers_lst_head))
+        _followers_complete(cb_data, state);
+#endif
+
     cb_data->callback(self, cb_data, state, cb_data->user_data);
 
     /* Note: self might be a danling pointer at this point. It must not be used
@@ -404,29 +543,29 @@ _con_curl_check_connectivity(CURLM *mhandle, int sockfd, int ev_bitmask)
 static gboolean
 _con_curl_timeout_cb(gpointer user_data)
 {
-    NMConnectivityCheckHandle *cb_data = user_data;
+    ConEngine *engine = user_data;
 
-    nm_clear_g_source_inst(&cb_data->concheck.curl_timer);
-    _con_curl_check_connectivity(cb_data->concheck.curl_mhandle, CURL_SOCKET_TIMEOUT, 0);
-    _complete_queued(cb_data->self);
+    nm_clear_g_source_inst(&engine->curl_timer);
+    _con_curl_check_connectivity(engine->curl_mhandle, CURL_SOCKET_TIMEOUT, 0);
+    _complete_queued(engine->self);
     return G_SOURCE_CONTINUE;
 }
 
 static int
 multi_timer_cb(CURLM *multi, long timeout_msec, void *userdata)
 {
-    NMConnectivityCheckHandle *cb_data = userdata;
+    ConEngine *engine = userdata;
 
-    nm_clear_g_source_inst(&cb_data->concheck.curl_timer);
-    if (timeout_msec != -1) {
-        cb_data->concheck.curl_timer =
-            nm_g_timeout_add_source(timeout_msec, _con_curl_timeout_cb, cb_data);
+    nm_clear_g_source_inst(&engine->curl_timer);
+    if (timeout_msec != -1 && !engine->destroying) {
+        engine->curl_timer = nm_g_timeout_add_source(timeout_msec, _con_curl_timeout_cb, engine);
     }
     return 0;
 }
 
 typedef struct {
-    NMConnectivityCheckHandle *cb_data;
+    ConEngine *engine;
+    CList      socks_lst;
 
     GSource *source;
 
@@ -442,11 +581,11 @@ typedef struct {
 static gboolean
 _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
 {
-    ConCurlSockData           *fdp           = user_data;
-    NMConnectivityCheckHandle *cb_data       = fdp->cb_data;
-    int                        action        = 0;
-    gboolean                   fdp_destroyed = FALSE;
-    gboolean                   success;
+    ConCurlSockData *fdp           = user_data;
+    ConEngine       *engine        = fdp->engine;
+    int              action        = 0;
+    gboolean         fdp_destroyed = FALSE;
+    gboolean         success;
 
     if (condition & G_IO_IN)
         action |= CURL_CSELECT_IN;
@@ -458,7 +597,7 @@ _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
     nm_assert(!fdp->destroy_notify);
     fdp->destroy_notify = &fdp_destroyed;
 
-    success = _con_curl_check_connectivity(cb_data->concheck.curl_mhandle, fd, action);
+    success = _con_curl_check_connectivity(engine->curl_mhandle, fd, action);
 
     if (fdp_destroyed) {
         /* hups. fdp got invalidated during _con_curl_check_connectivity(). That's fine,
@@ -470,36 +609,48 @@ _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
             nm_clear_g_source_inst(&fdp->source);
     }
 
-    _complete_queued(cb_data->self);
+    _complete_queued(engine->self);
 
     return G_SOURCE_CONTINUE;
 }
 
+static void
+_con_curl_sock_data_free(ConCurlSockData *fdp)
+{
+    if (fdp->destroy_notify)
+        *fdp->destroy_notify = TRUE;
+    nm_clear_g_source_inst(&fdp->source);
+    c_list_unlink_stale(&fdp->socks_lst);
+    g_slice_free(ConCurlSockData, fdp);
+}
+
 static int
 multi_socket_cb(CURL *e_handle, curl_socket_t fd, int what, void *userdata, void *socketp)
 {
-    NMConnectivityCheckHandle *cb_data = userdata;
-    ConCurlSockData           *fdp     = socketp;
+    ConEngine       *engine = userdata;
+    ConCurlSockData *fdp    = socketp;
 
     (void) _NM_ENSURE_TYPE(int, fd);
 
     if (what == CURL_POLL_REMOVE) {
         if (fdp) {
-            if (fdp->destroy_notify)
-                *fdp->destroy_notify = TRUE;
-            nm_clear_g_source_inst(&fdp->source);
-            curl_multi_assign(cb_data->concheck.curl_mhandle, fd, NULL);
-            g_slice_free(ConCurlSockData, fdp);
+            if (!engine->destroying)
+                curl_multi_assign(engine->curl_mhandle, fd, NULL);
+            _con_curl_sock_data_free(fdp);
         }
     } else {
         GIOCondition condition;
 
+        if (engine->destroying)
+            return CURLM_OK;
+
         if (!fdp) {
             fdp  = g_slice_new(ConCurlSockData);
             *fdp = (ConCurlSockData){
-                .cb_data = cb_data,
+                .engine = engine,
             };
-            curl_multi_assign(cb_data->concheck.curl_mhandle, fd, fdp);
+            c_list_link_tail(&engine->socks_lst_head, &fdp->socks_lst);
+            curl_multi_assign(engine->curl_mhandle, fd, fdp);
         } else
             nm_clear_g_source_inst(&fdp->source);
 
@@ -519,6 +670,132 @@ multi_socket_cb(CURL *e_handle, curl_socket_t fd, int what, void *userdata, void
     return CURLM_OK;
 }
 
+/*****************************************************************************/
+
+void
+_nm_connectivity_engine_destroy(ConEngine *engine)
+{
+    ConCurlSockData *fdp;
+
+    nm_assert(engine->n_handles == 0);
+
+    engine->destroying = TRUE;
+    c_list_unlink_stale(&engine->engines_lst);
+    nm_clear_g_source_inst(&engine->idle_source);
+
+    /* This closes the cached connections, which might call multi_socket_cb()
+     * with CURL_POLL_REMOVE. */
+    curl_multi_cleanup(engine->curl_mhandle);
+
+    while ((fdp = c_list_first_entry(&engine->socks_lst_head, ConCurlSockData, socks_lst)))
+        _con_curl_sock_data_free(fdp);
+    nm_clear_g_source_inst(&engine->curl_timer);
+    g_free(engine->ifspec);
+    nm_g_slice_free(engine);
+}
+
+static gboolean
+_con_engine_idle_cb(gpointer user_data)
+{
+    _nm_connectivity_engine_destroy(user_data);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_con_engine_set_stale(ConEngine *engine)
+{
+    engine->stale = TRUE;
+    if (engine->n_handles > 0)
+        return;
+
+    /* Don't destroy it right away, we might be called from within a
+     * libcurl callback. */
+    nm_clear_g_source_inst(&engine->idle_source);
+    engine->idle_source = nm_g_idle_add_source(_con_engine_idle_cb, engine);
+}
+
+/**
+ * _nm_connectivity_engine_acquire:
+ * @engines_lst_head: the list of engines
+ * @self: the #NMConnectivity that owns the engines
+ * @ifspec: the interface, as for CURLOPT_INTERFACE
+ * @addr_family: the address family of the checks
+ * @gateway: the gateway of the default route on the interface
+ *
+ * Returns: the engine for @ifspec and @addr_family, which gets created if
+ *   there is none. If the engine was used with a different @gateway, its
+ *   connections don't go through the current route. It gets destroyed
+ *   once it is no longer used, and a new engine is created.
+ *   Release the engine with _nm_connectivity_engine_release().
+ */
+ConEngine *
+_nm_connectivity_engine_acquire(CList          *engines_lst_head,
+                                NMConnectivity *self,
+                                const char     *ifspec,
+                                int             addr_family,
+                                const NMIPAddr *gateway)
+{
+    ConEngine *engine;
+    CURLM     *mhandle;
+
+    c_list_for_each_entry (engine, engines_lst_head, engines_lst) {
+        if (engine->stale || engine->addr_family != addr_family
+            || !nm_streq(engine->ifspec, ifspec))
+            continue;
+        if (nm_ip_addr_equal(addr_family, &engine->gateway, gateway))
+            goto out;
+        _con_engine_set_stale(engine);
+        break;
+    }
+
+    mhandle = curl_multi_init();
+    if (!mhandle)
+        return NULL;
+
+    engine  = g_slice_new(ConEngine);
+    *engine = (ConEngine){
+        .self         = self,
+        .ifspec       = g_strdup(ifspec),
+        .addr_family  = addr_family,
+        .curl_mhandle = mhandle,
+    };
+    nm_ip_addr_set(addr_family, &engine->gateway, gateway);
+    c_list_init(&engine->socks_lst_head);
+    c_list_link_tail(engines_lst_head, &engine->engines_lst);
+
+    curl_multi_setopt(mhandle, CURLMOPT_SOCKETFUNCTION, multi_socket_cb);
+    curl_multi_setopt(mhandle, CURLMOPT_SOCKETDATA, engine);
+    curl_multi_setopt(mhandle, CURLMOPT_TIMERFUNCTION, multi_timer_cb);
+    curl_multi_setopt(mhandle, CURLMOPT_TIMERDATA, engine);
+
+out:
+    engine->n_handles++;
+    nm_clear_g_source_inst(&engine->idle_source);
+    return engine;
+}
+
+void
+_nm_connectivity_engine_release(ConEngine *engine)
+{
+    nm_assert(engine->n_handles > 0);
+
+    if (--engine->n_handles > 0)
+        return;
+
+    if (engine->stale) {
+        _con_engine_set_stale(engine);
+        return;
+    }
+
+    /* Keep the engine for a while, so that the next check can reuse
+     * the connection. This also ensures that the multi handle is never
+     * destroyed from within a libcurl callback. */
+    engine->idle_source =
+        nm_g_timeout_add_seconds_source(ENGINE_IDLE_TIMEOUT_SEC, _con_engine_idle_cb, engine);
+}
+
+/*****************************************************************************/
+
 static size_t
 easy_header_cb(char *buffer, size_t size, size_t nitems, void *userdata)
 {
@@ -714,36 +991,35 @@ _idle_cb(gpointer user_data)
 static void
 do_curl_request(NMConnectivityCheckHandle *cb_data, const char *hosts)
 {
-    CURLM *mhandle;
-    CURL  *ehandle;
-    long   resolve;
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(cb_data->self);
+    ConEngine             *engine;
+    CURL                  *ehandle;
+    long                   resolve;
 
     _LOG2T("set curl resolve list to '%s'", hosts);
 
-    mhandle = curl_multi_init();
-    if (!mhandle) {
+    engine = _nm_connectivity_engine_acquire(&priv->engines_lst_head,
+                                             cb_data->self,
+                                             cb_data->ifspec,
+                                             cb_data->addr_family,
+                                             &cb_data->concheck.gateway);
+    if (!engine) {
         cb_data_complete(cb_data, NM_CONNECTIVITY_ERROR, "curl error");
         return;
     }
 
     ehandle = curl_easy_init();
     if (!ehandle) {
-        curl_multi_cleanup(mhandle);
+        _nm_connectivity_engine_release(engine);
         cb_data_complete(cb_data, NM_CONNECTIVITY_ERROR, "curl error");
         return;
     }
 
     cb_data->concheck.hosts = curl_slist_append(NULL, hosts);
 
-    cb_data->concheck.curl_mhandle    = mhandle;
-    cb_data->concheck.curl_ehandle    = ehandle;
-    cb_data->concheck.request_headers = curl_slist_append(NULL, "Connection: close");
-    cb_data->timeout_source           = nm_g_timeout_add_seconds_source(20, _timeout_cb, cb_data);
-
-    curl_multi_setopt(mhandle, CURLMOPT_SOCKETFUNCTION, multi_socket_cb);
-    curl_multi_setopt(mhandle, CURLMOPT_SOCKETDATA, cb_data);
-    curl_multi_setopt(mhandle, CURLMOPT_TIMERFUNCTION, multi_timer_cb);
-    curl_multi_setopt(mhandle, CURLMOPT_TIMERDATA, cb_data);
+    cb_data->concheck.engine       = engine;
+    cb_data->concheck.curl_ehandle = ehandle;
+    cb_data->timeout_source        = nm_g_timeout_add_seconds_source(20, _timeout_cb, cb_data);
 
     switch (cb_data->addr_family) {
     case AF_INET:
@@ -766,7 +1042,6 @@ do_curl_request(NMConnectivityCheckHandle *cb_data, const char *hosts)
     curl_easy_setopt(ehandle, CURLOPT_HEADERFUNCTION, easy_header_cb);
     curl_easy_setopt(ehandle, CURLOPT_HEADERDATA, cb_data);
     curl_easy_setopt(ehandle, CURLOPT_PRIVATE, cb_data);
-    curl_easy_setopt(ehandle, CURLOPT_HTTPHEADER, cb_data->concheck.request_headers);
     curl_easy_setopt(ehandle, CURLOPT_INTERFACE, cb_data->ifspec);
     curl_easy_setopt(ehandle, CURLOPT_RESOLVE, cb_data->concheck.hosts);
     curl_easy_setopt(ehandle, CURLOPT_IPRESOLVE, resolve);
@@ -783,7 +1058,7 @@ do_curl_request(NMConnectivityCheckHandle *cb_data, const char *hosts)
         curl_easy_setopt(ehandle, CURLOPT_VERBOSE, 1L);
     }
 
-    curl_multi_add_handle(mhandle, ehandle);
+    curl_multi_add_handle(engine->curl_mhandle, ehandle);
 }
 
 static void
@@ -956,10 +1231,14 @@ check_platform_config(NMConnectivity *self,
                       NMPlatform     *platform,
                       int             ifindex,
                       int             addr_family,
-                      const char    **reason)
+                      const char    **reason,
+                      NMIPAddr       *out_gateway)
 {
     const NMDedupMultiHeadEntry *addresses;
     const NMDedupMultiHeadEntry *routes;
+    const NMPlatformIPRoute     *best_default = NULL;
+    NMDedupMultiIter             iter;
+    const NMPObject             *plobj;
 
     if (!nm_platform_link_is_connected(platform, ifindex)) {
         NM_SET_OUT(reason, "no carrier");
@@ -987,8 +1266,6 @@ check_platform_config(NMConnectivity *self,
     if (NM_IS_IPv4(addr_family)) {
         const NMPlatformIP4Route *route;
         gboolean                  found_global = FALSE;
-        NMDedupMultiIter          iter;
-        const NMPObject          *plobj;
 
         /* For IPv4 also require a route with global scope. */
         nmp_cache_iter_for_each (&iter, routes, &plobj) {
@@ -1007,10 +1284,115 @@ check_platform_config(NMConnectivity *self,
         /* Route scopes aren't meaningful for IPv6 so any route is fine. */
     }
 
+    /* The gateway of the default route identifies the path of the probe. */
+    nmp_cache_iter_for_each (&iter, routes, &plobj) {
+        const NMPlatformIPRoute *route = NMP_OBJECT_CAST_IP_ROUTE(plobj);
+
+        if (route->plen == 0 && (!best_default || route->metric < best_default->metric))
+            best_default = route;
+    }
+    if (best_default) {
+        nm_ip_addr_set(addr_family,
+                       out_gateway,
+                       nm_platform_ip_route_get_gateway(addr_family, best_default));
+    }
+
     NM_SET_OUT(reason, NULL);
     return NM_CONNECTIVITY_UNKNOWN;
 }
 
+#if WITH_CONCHECK
+static NMConnectivityCheckHandle *
+_probe_find(NMConnectivity *self, const NMConnectivityCheckHandle *cb_data)
+{
+    NMConnectivityPrivate     *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    NMConnectivityCheckHandle *leader;
+
+    c_list_for_each_entry (leader, &priv->handles_lst_head, handles_lst) {
+        if (leader != cb_data && !leader->concheck.share.leader
+            && leader->concheck.resolve_cancellable
+            && leader->completed_state == NM_CONNECTIVITY_UNKNOWN
+            && leader->addr_family == cb_data->addr_family
+            && leader->concheck.ifindex == cb_data->concheck.ifindex
+            && leader->concheck.con_config == cb_data->concheck.con_config
+            && nm_ip_addr_equal(cb_data->addr_family,
+                                &leader->concheck.gateway,
+                                &cb_data->concheck.gateway))
+            return leader;
+    }
+    return NULL;
+}
+
+static void
+_probe_start(NMConnectivityCheckHandle *cb_data)
+{
+    gboolean has_systemd_resolved;
+
+    nm_assert(!cb_data->concheck.resolve_cancellable);
+
+    cb_data->concheck.resolve_cancellable = g_cancellable_new();
+
+    /* note that we pick up support for systemd-resolved right away when we need it.
+     * We don't need to remember the setting, because we can (cheaply) check anew
+     * on each request.
+     *
+     * Yes, this makes NMConnectivity singleton dependent on NMDnsManager singleton.
+     * Well, not really: it makes connectivity-check-start dependent on NMDnsManager
+     * which merely means, not to start a connectivity check, late during shutdown.
+     *
+     * NMDnsSystemdResolved tries to D-Bus activate systemd-resolved only once,
+     * to not spam syslog with failures messages from dbus-daemon.
+     * Note that unless NMDnsSystemdResolved tried and failed to start systemd-resolved,
+     * it guesses that systemd-resolved is activatable and returns %TRUE here. That
+     * means, while NMDnsSystemdResolved would not try to D-Bus activate systemd-resolved
+     * more than once, NMConnectivity might -- until NMDnsSystemdResolved tried itself
+     * and noticed that systemd-resolved is not available.
+     * This is relatively cumbersome to avoid, because we would have to go through
+     * NMDnsSystemdResolved trying to asynchronously start the service, to ensure there
+     * is only one attempt to start the service. */
+    has_systemd_resolved = !!nm_dns_manager_get_systemd_resolved(nm_dns_manager_get());
+
+    if (has_systemd_resolved) {
+        GDBusConnection *dbus_connection;
+
+        dbus_connection = NM_MAIN_DBUS_CONNECTION_GET;
+        if (!dbus_connection) {
+            /* we have no D-Bus connection? That might happen in configure and quit mode.
+             *
+             * Anyway, something is very odd, just fail connectivity check. */
+            _LOG2D("start fake request (fail due to no D-Bus connection)");
+            cb_data->completed_state  = NM_CONNECTIVITY_ERROR;
+            cb_data->completed_reason = "no D-Bus connection";
+            cb_data->timeout_source   = nm_g_idle_add_source(_idle_cb, cb_data);
+            return;
+        }
+
+        g_dbus_connection_call(dbus_connection,
+                               "org.freedesktop.resolve1",
+                               "/org/freedesktop/resolve1",
+                               "org.freedesktop.resolve1.Manager",
+                               "ResolveHostname",
+                               g_variant_new("(isit)",
+                                             0,
+                                             cb_data->concheck.con_config->host,
+                                             (gint32) cb_data->addr_family,
+                                             SD_RESOLVED_DNS),
+                               G_VARIANT_TYPE("(a(iiay)st)"),
+                               G_DBUS_CALL_FLAGS_NONE,
+                               -1,
+                               cb_data->concheck.resolve_cancellable,
+                               systemd_resolved_resolve_cb,
+                               cb_data);
+        _LOG2D("start request to '%s' (try resolving '%s' using systemd-resolved)",
+               cb_data->concheck.con_config->uri,
+               cb_data->concheck.con_config->host);
+        return;
+    }
+
+    system_resolver_resolve(cb_data);
+}
+#endif
+
 NMConnectivityCheckHandle *
 nm_connectivity_check_start(NMConnectivity             *self,
                             int                         addr_family,
@@ -1044,15 +1426,22 @@ nm_connectivity_check_start(NMConnectivity             *self,
 #if WITH_CONCHECK
 
     cb_data->concheck.con_config = _con_config_ref(priv->con_config);
+    cb_data->concheck.ifindex    = ifindex;
+    _nm_connectivity_probe_share_init(&cb_data->concheck.share);
 
     if (iface && ifindex > 0 && priv->enabled && priv->uri_valid) {
-        gboolean has_systemd_resolved;
+        NMConnectivityCheckHandle *leader;
 
         if (platform) {
             const char         *reason;
             NMConnectivityState state;
 
-            state = check_platform_config(self, platform, ifindex, addr_family, &reason);
+            state = check_platform_config(self,
+                                          platform,
+                                          ifindex,
+                                          addr_family,
+                                          &reason,
+                                          &cb_data->concheck.gateway);
             nm_assert((state == NM_CONNECTIVITY_UNKNOWN) == !reason);
             if (state != NM_CONNECTIVITY_UNKNOWN) {
                 _LOG2D("skip connectivity check due to %s", reason);
@@ -1063,66 +1452,15 @@ nm_connectivity_check_start(NMConnectivity             *self,
             }
         }
 
-        cb_data->concheck.resolve_cancellable = g_cancellable_new();
-
-        /* note that we pick up support for systemd-resolved right away when we need it.
-         * We don't need to remember the setting, because we can (cheaply) check anew
-         * on each request.
-         *
-         * Yes, this makes NMConnectivity singleton dependent on NMDnsManager singleton.
-         * Well, not really: it makes connectivity-check-start dependent on NMDnsManager
-         * which merely means, not to start a connectivity check, late during shutdown.
-         *
-         * NMDnsSystemdResolved tries to D-Bus activate systemd-resolved only once,
-         * to not spam syslog with failures messages from dbus-daemon.
-         * Note that unless NMDnsSystemdResolved tried and failed to start systemd-resolved,
-         * it guesses that systemd-resolved is activatable and returns %TRUE here. That
-         * means, while NMDnsSystemdResolved would not try to D-Bus activate systemd-resolved
-         * more than once, NMConnectivity might -- until NMDnsSystemdResolved tried itself
-         * and noticed that systemd-resolved is not available.
-         * This is relatively cumbersome to avoid, because we would have to go through
-         * NMDnsSystemdResolved trying to asynchronously start the service, to ensure there
-         * is only one attempt to start the service. */
-        has_systemd_resolved = !!nm_dns_manager_get_systemd_resolved(nm_dns_manager_get());
-
-        if (has_systemd_resolved) {
-            GDBusConnection *dbus_connection;
-
-            dbus_connection = NM_MAIN_DBUS_CONNECTION_GET;
-            if (!dbus_connection) {
-                /* we have no D-Bus connection? That might happen in configure and quit mode.
-                 *
-                 * Anyway, something is very odd, just fail connectivity check. */
-                _LOG2D("start fake request (fail due to no D-Bus connection)");
-                cb_data->completed_state  = NM_CONNECTIVITY_ERROR;
-                cb_data->completed_reason = "no D-Bus connection";
-                cb_data->timeout_source   = nm_g_idle_add_source(_idle_cb, cb_data);
-                return cb_data;
-            }
-
-            g_dbus_connection_call(dbus_connection,
-                                   "org.freedesktop.resolve1",
-                                   "/org/freedesktop/resolve1",
-                                   "org.freedesktop.resolve1.Manager",
-                                   "ResolveHostname",
-                                   g_variant_new("(isit)",
-                                                 0,
-                                                 cb_data->concheck.con_config->host,
-                                                 (gint32) cb_data->addr_family,
-                                                 SD_RESOLVED_DNS),
-                                   G_VARIANT_TYPE("(a(iiay)st)"),
-                                   G_DBUS_CALL_FLAGS_NONE,
-                                   -1,
-                                   cb_data->concheck.resolve_cancellable,
-                                   systemd_resolved_resolve_cb,
-                                   cb_data);
-            _LOG2D("start request to '%s' (try resolving '%s' using systemd-resolved)",
-                   cb_data->concheck.con_config->uri,
-                   cb_data->concheck.con_config->host);
+        leader = _probe_find(self, cb_data);
+        if (leader) {
+            _LOG2D("wait for the result of request %" G_GUINT64_FORMAT, leader->request_counter);
+            _nm_connectivity_probe_share_follow(&cb_data->concheck.share,
+                                                &leader->concheck.share);
             return cb_data;
         }
 
-        system_resolver_resolve(cb_data);
+        _probe_start(cb_data);
         return cb_data;
     }
 #endif
@@ -1338,6 +1676,7 @@ nm_connectivity_init(NMConnectivity *self)
 
     c_list_init(&priv->handles_lst_head);
     c_list_init(&priv->completed_handles_lst_head);
+    c_list_init(&priv->engines_lst_head);
 
     priv->config = g_object_ref(nm_config_get());
     g_signal_connect(G_OBJECT(priv->config),
@@ -1374,6 +1713,13 @@ dispose(GObject *object)
     nm_clear_pointer(&priv->con_config, _con_config_unref);
 
 #if WITH_CONCHECK
+    {
+        ConEngine *engine;
+
+        while ((engine = c_list_first_entry(&priv->engines_lst_head, ConEngine, engines_lst)))
+            _nm_connectivity_engine_destroy(engine);
+    }
+
     curl_global_cleanup();
 #endif
 
@@ -7,6 +7,7 @@
 #ifndef __NETWORKMANAGER_CONNECTIVITY_H__
 #define __NETWORKMANAGER_CONNECTIVITY_H__
 
+#include "c-list/src/c-list.h"
 #include "nm-dbus-interface.h"
 #include "libnm-platform/nmp-base.h"
 
@@ -71,4 +72,35 @@ NMConnectivityCheckHandle *nm_connectivity_check_start(NMConnectivity
 
 void nm_connectivity_check_cancel(NMConnectivityCheckHandle *handle);
 
+/*****************************************************************************/
+
+/* Only exposed for testing. */
+
+typedef struct _NMConnectivityProbeShare NMConnectivityProbeShare;
+
+struct _NMConnectivityProbeShare {
+    NMConnectivityProbeShare *leader;
+    CList                     followers_lst_head;
+    CList                     followers_lst;
+};
+
+void _nm_connectivity_probe_share_init(NMConnectivityProbeShare *share);
+void _nm_connectivity_probe_share_follow(NMConnectivityProbeShare *share,
+                                         NMConnectivityProbeShare *leader);
+void _nm_connectivity_probe_share_leave(NMConnectivityProbeShare *share);
+NMConnectivityProbeShare *_nm_connectivity_probe_share_pop(NMConnectivityProbeShare *leader);
+NMConnectivityProbeShare *_nm_connectivity_probe_share_hand_over(NMConnectivityProbeShare *leader);
+
+#if WITH_CONCHECK
+typedef struct _NMConnectivityEngine NMConnectivityEngine;
+
+NMConnectivityEngine *_nm_connectivity_engine_acquire(CList          *engines_lst_head,
+                                                      NMConnectivity *self,
+                                                      const char     *ifspec,
+                                                      int             addr_family,
+                                                      const NMIPAddr *gateway);
+void                  _nm_connectivity_engine_release(NMConnectivityEngine *engine);
+void                  _nm_connectivity_engine_destroy(NMConnectivityEngine *engine);
+#endif
+
 #endif /* __NETWORKMANAGER_CONNECTIVITY_H__ */
@@ -24,6 +24,10 @@
 
 #define CALL_TIMEOUT (1000 * 60 * 10) /* 10 minutes for all scripts */
 
+/* Events that only report the current state (like "dhcp4-change") are
+ * delayed by this long, so that a burst of them can be merged. */
+#define COALESCE_MSEC 200
+
 #define _NMLOG_DOMAIN      LOGD_DISPATCH
 #define _NMLOG(level, ...) __NMLOG_DEFAULT(level, _NMLOG_DOMAIN, "dispatcher", __VA_ARGS__)
 
@@ -62,6 +66,8 @@ struct NMDispatcherCallId {
     const char          *log_ifname;
     const char          *log_con_uuid;
     GVariant            *action_params;
+    GVariant            *action2_params; /* floating, while the call is pending */
+    NMDispatcherPending  pending;
     gint64               start_at_msec;
     NMDispatcherAction   action;
     guint                idle_id;
@@ -83,6 +89,8 @@ struct NMDispatcherCallId {
 static struct {
     GDBusConnection *dbus_connection;
     GHashTable      *requests;
+    CList            pending_lst_head;
+    GSource         *pending_source;
     guint            request_id_counter;
 } gl;
 
@@ -108,6 +116,20 @@ action_is_device_handler(NMDispatcherAction action)
     return NM_IN_SET(action, NM_DISPATCHER_ACTION_DEVICE_ADD, NM_DISPATCHER_ACTION_DEVICE_DELETE);
 }
 
+/* Whether a later event of the same action for the same device makes
+ * the earlier one redundant. */
+gboolean
+_nm_dispatcher_action_can_coalesce(NMDispatcherAction action)
+{
+    return NM_IN_SET(action,
+                     NM_DISPATCHER_ACTION_HOSTNAME,
+                     NM_DISPATCHER_ACTION_DHCP_CHANGE_4,
+                     NM_DISPATCHER_ACTION_DHCP_CHANGE_6,
+                     NM_DISPATCHER_ACTION_CONNECTIVITY_CHANGE,
+                     NM_DISPATCHER_ACTION_REAPPLY,
+                     NM_DISPATCHER_ACTION_DNS_CHANGE);
+}
+
 static NMDispatcherCallId *
 dispatcher_call_id_new(guint32              request_id,
                        gint64               start_at_msec,
@@ -127,22 +149,29 @@ dispatcher_call_id_new(guint32              request_id,
 
     call_id = g_malloc(sizeof(NMDispatcherCallId) + l_log_ifname + l_log_con_uuid);
 
-    call_id->action        = action;
-    call_id->start_at_msec = start_at_msec;
-    call_id->request_id    = request_id;
-    call_id->callback      = callback;
-    call_id->user_data     = user_data;
-    call_id->idle_id       = 0;
-    call_id->is_action2    = TRUE;
+    call_id->action         = action;
+    call_id->start_at_msec  = start_at_msec;
+    call_id->request_id     = request_id;
+    call_id->callback       = callback;
+    call_id->user_data      = user_data;
+    call_id->idle_id        = 0;
+    call_id->is_action2     = TRUE;
+    call_id->action_params  = NULL;
+    call_id->action2_params = NULL;
+    call_id->pending.action = action;
+    c_list_init(&call_id->pending.lst);
 
     extra_strings = &call_id->extra_strings[0];
 
     if (log_ifname) {
-        call_id->log_ifname = extra_strings;
+        call_id->log_ifname     = extra_strings;
+        call_id->pending.ifname = extra_strings;
         memcpy(extra_strings, log_ifname, l_log_ifname);
         extra_strings += l_log_ifname;
-    } else
-        call_id->log_ifname = NULL;
+    } else {
+        call_id->log_ifname     = NULL;
+        call_id->pending.ifname = NULL;
+    }
 
     if (log_con_uuid) {
         call_id->log_con_uuid = extra_strings;
@@ -156,7 +185,10 @@ dispatcher_call_id_new(guint32              request_id,
 static void
 dispatcher_call_id_free(NMDispatcherCallId *call_id)
 {
+    nm_assert(c_list_is_empty(&call_id->pending.lst));
+
     nm_clear_pointer(&call_id->action_params, g_variant_unref);
+    nm_clear_pointer(&call_id->action2_params, g_variant_unref);
     nm_clear_g_source(&call_id->idle_id);
     g_free(call_id);
 }
@@ -167,7 +199,8 @@ static void
 _init_dispatcher(void)
 {
     if (G_UNLIKELY(gl.requests == NULL)) {
-        gl.requests        = g_hash_table_new(nm_direct_hash, NULL);
+        gl.requests = g_hash_table_new(nm_direct_hash, NULL);
+        c_list_init(&gl.pending_lst_head);
         gl.dbus_connection = nm_g_object_ref(NM_MAIN_DBUS_CONNECTION_GET);
 
         if (!gl.dbus_connection)
@@ -766,6 +799,85 @@ build_call_parameters(NMDispatcherAction    action,
                          nm_logging_enabled(LOGL_DEBUG, LOGD_DISPATCH));
 }
 
+static void
+_dispatcher_call_send(NMDispatcherCallId *call_id, GVariant *parameters_floating)
+{
+    g_dbus_connection_call(gl.dbus_connection,
+                           NM_DISPATCHER_DBUS_SERVICE,
+                           NM_DISPATCHER_DBUS_PATH,
+                           NM_DISPATCHER_DBUS_INTERFACE,
+                           "Action2",
+                           parameters_floating,
+                           G_VARIANT_TYPE("(a(susa{sv}))"),
+                           G_DBUS_CALL_FLAGS_NONE,
+                           CALL_TIMEOUT,
+                           NULL,
+                           dispatcher_done_cb,
+                           call_id);
+    g_hash_table_add(gl.requests, call_id);
+}
+
+/**
+ * _pending_flush:
+ * @all: whether to send all pending calls
+ * @log_ifname: otherwise, only send the pending calls for this interface
+ *
+ * Sends coalesced calls that wait for their timeout. This is done
+ * before sending another call for the same device, so that the
+ * dispatcher receives the events in order.
+ */
+static void
+_pending_flush(gboolean all, const char *log_ifname)
+{
+    NMDispatcherCallId *call_id;
+    NMDispatcherCallId *call_id_safe;
+
+    if (!gl.pending_source)
+        return;
+
+    c_list_for_each_entry_safe (call_id, call_id_safe, &gl.pending_lst_head, pending.lst) {
+        if (!all && !nm_streq0(call_id->log_ifname, log_ifname))
+            continue;
+        c_list_unlink(&call_id->pending.lst);
+        _dispatcher_call_send(call_id, g_steal_pointer(&call_id->action2_params));
+    }
+
+    if (c_list_is_empty(&gl.pending_lst_head))
+        nm_clear_g_source_inst(&gl.pending_source);
+}
+
+static gboolean
+_pending_timeout_cb(gpointer user_data)
+{
+    _pending_flush(TRUE, NULL);
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * _nm_dispatcher_pending_find:
+ * @head: the list of #NMDispatcherPending
+ * @action: the action of the new event
+ * @ifname: (allow-none): the interface of the new event
+ *
+ * Returns: the pending event that the new event can be merged into,
+ *   or %NULL.
+ */
+NMDispatcherPending *
+_nm_dispatcher_pending_find(CList *head, NMDispatcherAction action, const char *ifname)
+{
+    CList *iter;
+
+    /* Only the last pending event of the device can be merged, otherwise
+     * the events would get reordered. */
+    for (iter = head->prev; iter != head; iter = iter->prev) {
+        NMDispatcherPending *pending = c_list_entry(iter, NMDispatcherPending, lst);
+
+        if (nm_streq0(pending->ifname, ifname))
+            return pending->action == action ? pending : NULL;
+    }
+    return NULL;
+}
+
 static gboolean
 _dispatcher_call(NMDispatcherAction    action,
                  gboolean              blocking,
@@ -841,6 +953,8 @@ _dispatcher_call(NMDispatcherAction    action,
         gs_unref_variant GVariant *ret   = NULL;
         gs_free_error GError      *error = NULL;
 
+        _pending_flush(TRUE, NULL);
+
         ret = g_dbus_connection_call_sync(gl.dbus_connection,
                                           NM_DISPATCHER_DBUS_SERVICE,
                                           NM_DISPATCHER_DBUS_PATH,
@@ -930,19 +1044,36 @@ _dispatcher_call(NMDispatcherAction    action,
                                                    l3cd,
                                                    FALSE);
 
-    g_dbus_connection_call(gl.dbus_connection,
-                           NM_DISPATCHER_DBUS_SERVICE,
-                           NM_DISPATCHER_DBUS_PATH,
-                           NM_DISPATCHER_DBUS_INTERFACE,
-                           "Action2",
-                           g_steal_pointer(&parameters_floating),
-                           G_VARIANT_TYPE("(a(susa{sv}))"),
-                           G_DBUS_CALL_FLAGS_NONE,
-                           CALL_TIMEOUT,
-                           NULL,
-                           dispatcher_done_cb,
-                           call_id);
-    g_hash_table_add(gl.requests, call_id);
+    if (!callback && !out_call_id && _nm_dispatcher_action_can_coalesce(action)) {
+        NMDispatcherPending *p;
+
+        p = _nm_dispatcher_pending_find(&gl.pending_lst_head, action, log_ifname);
+        if (p) {
+            NMDispatcherCallId *pending = c_list_entry(&p->lst, NMDispatcherCallId, pending.lst);
+
+            /* The new event carries the current state. Send it instead of the
+             * pending one, which nobody waits for. */
+            _LOG2D(request_id,
+                   log_ifname,
+                   log_con_uuid,
+                   "coalesced with pending request (%u)",
+                   pending->request_id);
+            NM_SWAP(&pending->action2_params, &parameters_floating);
+            NM_SWAP(&pending->action_params, &call_id->action_params);
+            dispatcher_call_id_free(call_id);
+            return TRUE;
+        }
+
+        call_id->action2_params = g_steal_pointer(&parameters_floating);
+        c_list_link_tail(&gl.pending_lst_head, &call_id->pending.lst);
+        if (!gl.pending_source)
+            gl.pending_source = nm_g_timeout_add_source(COALESCE_MSEC, _pending_timeout_cb, NULL);
+        return TRUE;
+    }
+
+    _pending_flush(FALSE, log_ifname);
+
+    _dispatcher_call_send(call_id, g_steal_pointer(&parameters_floating));
     NM_SET_OUT(out_call_id, call_id);
     return TRUE;
 }
@@ -1240,6 +1371,24 @@ nm_dispatcher_call_dns_change(void)
                             NULL);
 }
 
+/**
+ * nm_dispatcher_flush_pending:
+ *
+ * Sends the calls that are held back to be coalesced right away. This
+ * is called on shutdown, otherwise the events would get lost.
+ */
+void
+nm_dispatcher_flush_pending(void)
+{
+    if (!gl.pending_source)
+        return;
+
+    _pending_flush(TRUE, NULL);
+
+    /* The main loop no longer runs. Make sure the messages are out. */
+    g_dbus_connection_flush_sync(gl.dbus_connection, NULL, NULL);
+}
+
 void
 nm_dispatcher_call_cancel(NMDispatcherCallId *call_id)
 {
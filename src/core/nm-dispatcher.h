@@ -7,6 +7,8 @@
 #ifndef __NM_DISPATCHER_H__
 #define __NM_DISPATCHER_H__
 
+#include "c-list/src/c-list.h"
+
 #include "nm-connection.h"
 
 typedef enum {
@@ -90,4 +92,21 @@ gboolean nm_dispatcher_call_dns_change(void);
 
 void nm_dispatcher_call_cancel(NMDispatcherCallId *call_id);
 
+void nm_dispatcher_flush_pending(void);
+
+/*****************************************************************************/
+
+/* An event that is held back, so that it can be coalesced with a later
+ * one. Only exposed for testing. */
+typedef struct {
+    CList              lst;
+    const char        *ifname;
+    NMDispatcherAction action;
+} NMDispatcherPending;
+
+gboolean _nm_dispatcher_action_can_coalesce(NMDispatcherAction action);
+
+NMDispatcherPending *
+_nm_dispatcher_pending_find(CList *head, NMDispatcherAction action, const char *ifname);
+
 #endif /* __NM_DISPATCHER_H__ */
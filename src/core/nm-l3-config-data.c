@@ -3079,7 +3079,7 @@ nm_l3_config_data_new_from_platform(NMDedupMultiIndex        *multi_idx,
 
 /*****************************************************************************/
 
-void
+gboolean
 nm_l3_config_data_hash_dns(const NML3ConfigData *l3cd,
                            GChecksum            *sum,
                            int                   addr_family,
@@ -3099,8 +3099,8 @@ nm_l3_config_data_hash_dns(const NML3ConfigData *l3cd,
     guint              num_options;
     gboolean           empty = TRUE;
 
-    g_return_if_fail(l3cd);
-    g_return_if_fail(sum);
+    g_return_val_if_fail(l3cd, FALSE);
+    g_return_val_if_fail(sum, FALSE);
 
     strarr = nm_l3_config_data_get_nameservers(l3cd, addr_family, &num_nameservers);
     for (i = 0; i < num_nameservers; i++) {
@@ -3176,6 +3176,8 @@ nm_l3_config_data_hash_dns(const NML3ConfigData *l3cd,
      * not), so it's a bit difficult to add it to checksum maintaining the
      * assumption of checksum(empty)=0
      */
+
+    return !empty;
 }
 
 /*****************************************************************************/
@@ -105,6 +105,10 @@ typedef struct {
     NML3AcdDefendType acd_defend_type_current : 3;
     bool              acd_defend_type_is_active : 1;
 
+    /* Whether one of the trackers requested NM_L3CFG_CONFIG_FLAGS_ACD_PARALLEL.
+     * Updated whenever we collect the tracks data. */
+    bool acd_parallel : 1;
+
     bool track_infos_changed : 1;
 } AcdData;
 
@@ -1667,14 +1671,15 @@ _acd_data_free(AcdData *acd_data)
 
 static guint
 _acd_data_collect_tracks_data(NML3Cfg           *self,
-                              const AcdData     *acd_data,
+                              AcdData           *acd_data,
                               NMTernary          dirty_selector,
                               guint32           *out_best_acd_timeout_msec,
                               NML3AcdDefendType *out_best_acd_defend_type)
 {
-    NML3AcdDefendType best_acd_defend_type  = _NM_L3_ACD_DEFEND_TYPE_NONE;
-    guint32           best_acd_timeout_msec = G_MAXUINT32;
-    guint             n                     = 0;
+    NML3AcdDefendType best_acd_defend_type           = _NM_L3_ACD_DEFEND_TYPE_NONE;
+    guint32           best_acd_timeout_msec          = G_MAXUINT32;
+    guint32           best_parallel_acd_timeout_msec = G_MAXUINT32;
+    guint             n                              = 0;
     guint             i;
 
     /* We do a simple search over all track-infos for the best, which determines
@@ -1698,15 +1703,26 @@ _acd_data_collect_tracks_data(NML3Cfg           *self,
             best_acd_timeout_msec = acd_track->_priv.acd_timeout_msec_track;
         if (best_acd_defend_type < acd_track->_priv.acd_defend_type_track)
             best_acd_defend_type = acd_track->_priv.acd_defend_type_track;
+        if (acd_track->_priv.acd_parallel_track && acd_track->_priv.acd_timeout_msec_track > 0
+            && best_parallel_acd_timeout_msec > acd_track->_priv.acd_timeout_msec_track)
+            best_parallel_acd_timeout_msec = acd_track->_priv.acd_timeout_msec_track;
     }
 
+    /* A tracker that probes in parallel does not delay the address. Hence, it
+     * also does not conflict with trackers that disabled ACD, and we always
+     * probe with its timeout. */
+    acd_data->acd_parallel = (best_parallel_acd_timeout_msec != G_MAXUINT32);
+    if (acd_data->acd_parallel)
+        best_acd_timeout_msec = best_parallel_acd_timeout_msec;
+
     nm_assert(n == 0 || best_acd_defend_type > _NM_L3_ACD_DEFEND_TYPE_NONE);
     nm_assert(best_acd_defend_type <= NM_L3_ACD_DEFEND_TYPE_ALWAYS);
 
     if (self->priv.ifindex == NM_LOOPBACK_IFINDEX) {
         /* On loopback interface, ACD makes no sense. We always force the
          * timeout to zero, which means no ACD. */
-        best_acd_timeout_msec = 0;
+        best_acd_timeout_msec  = 0;
+        acd_data->acd_parallel = FALSE;
     }
 
     NM_SET_OUT(out_best_acd_timeout_msec, n > 0 ? best_acd_timeout_msec : 0u);
@@ -2136,7 +2152,8 @@ _l3_acd_data_add(NML3Cfg              *self,
                  const NMPObject      *obj,
                  gconstpointer         tag,
                  NML3AcdDefendType     acd_defend_type,
-                 guint32               acd_timeout_msec)
+                 guint32               acd_timeout_msec,
+                 gboolean              acd_parallel)
 {
     in_addr_t             addr = NMP_OBJECT_CAST_IP4_ADDRESS(obj)->address;
     NML3AcdAddrTrackInfo *acd_track;
@@ -2201,15 +2218,18 @@ _l3_acd_data_add(NML3Cfg              *self,
             ._priv.acd_dirty_track        = FALSE,
             ._priv.acd_defend_type_track  = acd_defend_type,
             ._priv.acd_timeout_msec_track = acd_timeout_msec,
+            ._priv.acd_parallel_track     = acd_parallel,
         };
         track_mode = "new";
     } else {
         nm_assert(acd_track->_priv.acd_dirty_track);
         acd_track->_priv.acd_dirty_track = FALSE;
         if (acd_track->_priv.acd_timeout_msec_track != acd_timeout_msec
-            || acd_track->_priv.acd_defend_type_track != acd_defend_type) {
+            || acd_track->_priv.acd_defend_type_track != acd_defend_type
+            || acd_track->_priv.acd_parallel_track != (!!acd_parallel)) {
             acd_track->_priv.acd_defend_type_track  = acd_defend_type;
             acd_track->_priv.acd_timeout_msec_track = acd_timeout_msec;
+            acd_track->_priv.acd_parallel_track     = acd_parallel;
             track_mode                              = "update";
         } else
             return;
@@ -2217,9 +2237,10 @@ _l3_acd_data_add(NML3Cfg              *self,
 
     acd_data->track_infos_changed = TRUE;
     _LOGT_acd(acd_data,
-              "track " ACD_TRACK_FMT " with timeout %u msec, defend=%s (%s)",
+              "track " ACD_TRACK_FMT " with timeout %u msec%s, defend=%s (%s)",
               ACD_TRACK_PTR(acd_track),
               acd_timeout_msec,
+              acd_parallel ? " (parallel)" : "",
               _l3_acd_defend_type_to_string(acd_track->_priv.acd_defend_type_track,
                                             sbuf100,
                                             sizeof(sbuf100)),
@@ -2257,7 +2278,9 @@ _l3_acd_data_add_all(NML3Cfg                   *self,
                              obj,
                              info->tag_confdata,
                              info->acd_defend_type_confdata,
-                             info->acd_timeout_msec_confdata);
+                             info->acd_timeout_msec_confdata,
+                             NM_FLAGS_HAS(info->config_flags,
+                                          NM_L3CFG_CONFIG_FLAGS_ACD_PARALLEL));
         }
     }
 
@@ -2574,7 +2597,8 @@ handle_init:
 
         if (acd_timeout_msec == 0u)
             log_reason = "acd disabled by configuration";
-        else if (_l3_acd_ipv4_addresses_on_link_contains(self, acd_data->info.addr))
+        else if (!acd_data->acd_parallel
+                 && _l3_acd_ipv4_addresses_on_link_contains(self, acd_data->info.addr))
             log_reason = "address already configured";
         else {
             if (state_change_mode == ACD_STATE_CHANGE_MODE_INIT_REAPPLY) {
@@ -2602,14 +2626,6 @@ handle_init:
             _nm_l3cfg_emit_signal_notify_acd_event_queue(self, acd_data);
         }
 
-        if (_l3_acd_ipv4_addresses_on_link_contains(self, acd_data->info.addr)) {
-            log_reason = "address already configured";
-            goto handle_probing_done;
-        }
-
-        if (acd_data->info.state == NM_L3_ACD_ADDR_STATE_EXTERNAL_REMOVED)
-            return;
-
         /* we just did a commit of the IP configuration and now visit all ACD states
          * and kick off the necessary actions... */
         if (_acd_data_collect_tracks_data(self,
@@ -2620,6 +2636,18 @@ handle_init:
             <= 0)
             nm_assert_not_reached();
 
+        if (_l3_acd_ipv4_addresses_on_link_contains(self, acd_data->info.addr)
+            && !(acd_data->acd_parallel && acd_timeout_msec > 0
+                 && NM_IN_SET(acd_data->info.state,
+                              NM_L3_ACD_ADDR_STATE_INIT,
+                              NM_L3_ACD_ADDR_STATE_PROBING))) {
+            log_reason = "address already configured";
+            goto handle_probing_done;
+        }
+
+        if (acd_data->info.state == NM_L3_ACD_ADDR_STATE_EXTERNAL_REMOVED)
+            return;
+
         acd_data->acd_defend_type_desired = acd_defend_type;
 
         if (acd_timeout_msec <= 0) {
@@ -2734,7 +2762,8 @@ handle_init:
                 goto handle_probing_done;
             }
 
-            if (_l3_acd_ipv4_addresses_on_link_contains(self, acd_data->info.addr)) {
+            if (!acd_data->acd_parallel
+                && _l3_acd_ipv4_addresses_on_link_contains(self, acd_data->info.addr)) {
                 log_reason = "address already configured (restart after previous conflict)";
                 goto handle_probing_done;
             }
@@ -2900,6 +2929,12 @@ handle_init:
         case NM_L3_ACD_ADDR_STATE_DEFENDING:
             goto handle_start_defending;
         case NM_L3_ACD_ADDR_STATE_PROBING:
+            if (acd_data->acd_parallel) {
+                /* the address is expected to be configured while probing
+                 * in parallel. Let the probe finish. */
+                return;
+            }
+            /* fall-through */
         case NM_L3_ACD_ADDR_STATE_USED:
         case NM_L3_ACD_ADDR_STATE_CONFLICT:
         case NM_L3_ACD_ADDR_STATE_EXTERNAL_REMOVED:
@@ -3868,6 +3903,14 @@ _l3_hook_add_obj_cb(const NML3ConfigData      *l3cd,
             }));
         }
 
+        if (acd_data->acd_parallel
+            && NM_IN_SET(acd_data->info.state,
+                         NM_L3_ACD_ADDR_STATE_INIT,
+                         NM_L3_ACD_ADDR_STATE_PROBING)) {
+            /* With parallel ACD, the address is good until the probe says otherwise. */
+            goto out_ip4_address;
+        }
+
         if (!NM_IN_SET(acd_data->info.state,
                        NM_L3_ACD_ADDR_STATE_READY,
                        NM_L3_ACD_ADDR_STATE_DEFENDING,
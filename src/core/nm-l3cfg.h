@@ -55,11 +55,20 @@ typedef enum _nm_packed {
  *   "don't change" behavior. At least once. If the address/route
  *   is still not (no longer) configured on the subsequent
  *   commit, it's not getting added again.
+ * @NM_L3CFG_CONFIG_FLAGS_ACD_PARALLEL: by default, an IPv4 address
+ *   is only configured after ACD passed, and ACD is skipped for addresses
+ *   that are already configured or that other configurations track with
+ *   ACD disabled. With this flag, ACD for the IPv4 addresses always probes
+ *   (if the ACD timeout is non-zero), but the address counts as ready
+ *   while probing, so it gets configured right away. If the probe
+ *   finds the address in use, the address becomes not ready and gets
+ *   removed again.
  */
 typedef enum _nm_packed {
     NM_L3CFG_CONFIG_FLAGS_NONE               = 0,
     NM_L3CFG_CONFIG_FLAGS_ONLY_FOR_ACD       = (1LL << 0),
     NM_L3CFG_CONFIG_FLAGS_ASSUME_CONFIG_ONCE = (1LL << 1),
+    NM_L3CFG_CONFIG_FLAGS_ACD_PARALLEL       = (1LL << 2),
 } NML3CfgConfigFlags;
 
 typedef enum _nm_packed {
@@ -82,6 +91,7 @@ typedef struct {
         NML3AcdDefendType acd_defend_type_track;
         bool              acd_dirty_track : 1;
         bool              acd_failed_notified_track : 1;
+        bool              acd_parallel_track : 1;
     } _priv;
 
 } NML3AcdAddrTrackInfo;
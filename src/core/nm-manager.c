@@ -10,6 +10,7 @@
 
 #include <fcntl.h>
 #include <limits.h>
+#include <linux/if_infiniband.h>
 #include <stdlib.h>
 #include <sys/sendfile.h>
 #include <sys/stat.h>
@@ -98,6 +99,40 @@ typedef struct {
 
 #define DEV_CON_DATA_LOG_ARGS_DATA(data) DEV_CON_DATA_LOG_ARGS((data)->device, (data)->sett_conn)
 
+/* Indexes over devices_lst_head, so that looking up devices from platform
+ * events and during activation does not scale with the number of devices. */
+typedef enum {
+    DEVICE_IDX_TYPE_IFINDEX,
+    DEVICE_IDX_TYPE_IFACE,
+    DEVICE_IDX_TYPE_IP_IFACE,
+    DEVICE_IDX_TYPE_PERM_HW_ADDR,
+    _DEVICE_IDX_TYPE_NUM,
+} DeviceIdxType;
+
+typedef struct {
+    /* GINT_TO_POINTER(ifindex) or pointing to key_str. */
+    gconstpointer key;
+
+    /* The DeviceIdxEntry with this key, in the order they were indexed. */
+    CList lst_head;
+
+    char key_str[];
+} DeviceIdxBucket;
+
+typedef struct {
+    NMDevice        *device;
+    DeviceIdxBucket *bucket;
+    CList            bucket_lst;
+} DeviceIdxEntry;
+
+typedef struct _NMManagerDeviceIdx {
+    DeviceIdxEntry entries[_DEVICE_IDX_TYPE_NUM];
+
+    /* Linked to devices_perm_hw_addr_fallback_lst_head while the permanent
+     * address is not known or only matches loosely. */
+    CList perm_hw_addr_fallback_lst;
+} NMManagerDeviceIdx;
+
 typedef enum {
     ASYNC_OP_TYPE_AC_AUTH_ACTIVATE_INTERNAL,
     ASYNC_OP_TYPE_AC_AUTH_ACTIVATE_USER,
@@ -188,7 +223,9 @@ typedef struct {
     NMActiveConnection *activating_connection;
     NMMetered           metered;
 
-    CList devices_lst_head;
+    CList       devices_lst_head;
+    GHashTable *device_idx[_DEVICE_IDX_TYPE_NUM];
+    CList       devices_perm_hw_addr_fallback_lst_head;
 
     NMState            state;
     NMConfig          *config;
@@ -1850,37 +1887,213 @@ nm_manager_get_device_by_path(NMManager *self, const char *path)
     return device;
 }
 
-NMDevice *
-nm_manager_get_device_by_ifindex(NMManager *self, int ifindex)
+/*****************************************************************************/
+
+static gconstpointer
+_device_idx_get_key(NMDevice *device, DeviceIdxType idx_type, char **out_to_free)
+{
+    const char *str;
+    int         ifindex;
+
+    switch (idx_type) {
+    case DEVICE_IDX_TYPE_IFINDEX:
+        ifindex = nm_device_get_ifindex(device);
+        return ifindex > 0 ? GINT_TO_POINTER(ifindex) : NULL;
+    case DEVICE_IDX_TYPE_IFACE:
+        return nm_device_get_iface(device);
+    case DEVICE_IDX_TYPE_IP_IFACE:
+        return nm_device_get_ip_iface(device);
+    case DEVICE_IDX_TYPE_PERM_HW_ADDR:
+        /* Don't force reading the permanent address here. We get notified
+         * when the device determines it. */
+        str = nm_device_get_permanent_hw_address_full(device, FALSE, NULL);
+        if (!str)
+            return NULL;
+        return (*out_to_free = nm_utils_hwaddr_canonical(str, -1));
+    case _DEVICE_IDX_TYPE_NUM:
+        break;
+    }
+    return nm_assert_unreachable_val(NULL);
+}
+
+static gboolean
+_device_idx_key_equal(DeviceIdxType idx_type, gconstpointer a, gconstpointer b)
+{
+    if (idx_type == DEVICE_IDX_TYPE_IFINDEX)
+        return a == b;
+    return nm_streq0(a, b);
+}
+
+static void
+_device_idx_entry_set(NMManager *self, NMDevice *device, DeviceIdxType idx_type, gconstpointer key)
 {
     NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *device;
+    GHashTable       *idx  = priv->device_idx[idx_type];
+    DeviceIdxBucket  *bucket;
+    DeviceIdxEntry   *entry;
+    gsize             l;
 
-    if (ifindex > 0) {
-        c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
-            if (nm_device_get_ifindex(device) == ifindex)
-                return device;
+    entry = &device->manager_idx->entries[idx_type];
+
+    if (entry->bucket) {
+        if (_device_idx_key_equal(idx_type, entry->bucket->key, key))
+            return;
+
+        bucket = g_steal_pointer(&entry->bucket);
+        c_list_unlink(&entry->bucket_lst);
+        if (c_list_is_empty(&bucket->lst_head)) {
+            g_hash_table_remove(idx, bucket->key);
+            g_free(bucket);
         }
     }
 
-    return NULL;
+    if (!key)
+        return;
+
+    bucket = g_hash_table_lookup(idx, key);
+    if (!bucket) {
+        if (idx_type == DEVICE_IDX_TYPE_IFINDEX) {
+            bucket      = g_new(DeviceIdxBucket, 1);
+            bucket->key = key;
+        } else {
+            l           = strlen(key) + 1;
+            bucket      = g_malloc(sizeof(DeviceIdxBucket) + l);
+            bucket->key = memcpy(bucket->key_str, key, l);
+        }
+        c_list_init(&bucket->lst_head);
+        g_hash_table_insert(idx, (gpointer) bucket->key, bucket);
+    }
+
+    entry->bucket = bucket;
+    c_list_link_tail(&bucket->lst_head, &entry->bucket_lst);
+}
+
+void
+nm_manager_device_idx_update(NMManager *self, NMDevice *device)
+{
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+    DeviceIdxType     idx_type;
+    DeviceIdxBucket  *bucket;
+    CList            *fallback_lst;
+
+    if (!device->manager_idx) {
+        /* not (yet) added to the manager. */
+        return;
+    }
+
+    for (idx_type = 0; idx_type < _DEVICE_IDX_TYPE_NUM; idx_type++) {
+        gs_free char *to_free = NULL;
+
+        _device_idx_entry_set(self,
+                              device,
+                              idx_type,
+                              _device_idx_get_key(device, idx_type, &to_free));
+    }
+
+    /* find_device_by_permanent_hw_addr() cannot use the index for devices
+     * that did not yet determine their permanent address, and for InfiniBand
+     * addresses, which only compare their last 8 bytes. */
+    bucket       = device->manager_idx->entries[DEVICE_IDX_TYPE_PERM_HW_ADDR].bucket;
+    fallback_lst = &device->manager_idx->perm_hw_addr_fallback_lst;
+    if (!bucket || strlen(bucket->key_str) == INFINIBAND_ALEN * 3 - 1) {
+        if (c_list_is_empty(fallback_lst))
+            c_list_link_tail(&priv->devices_perm_hw_addr_fallback_lst_head, fallback_lst);
+    } else
+        c_list_unlink(fallback_lst);
+}
+
+static void
+_device_idx_add(NMManager *self, NMDevice *device)
+{
+    DeviceIdxType idx_type;
+
+    nm_assert(!device->manager_idx);
+
+    device->manager_idx = g_slice_new0(NMManagerDeviceIdx);
+    for (idx_type = 0; idx_type < _DEVICE_IDX_TYPE_NUM; idx_type++)
+        device->manager_idx->entries[idx_type].device = device;
+    c_list_init(&device->manager_idx->perm_hw_addr_fallback_lst);
+
+    nm_manager_device_idx_update(self, device);
+}
+
+static void
+_device_idx_remove(NMManager *self, NMDevice *device)
+{
+    DeviceIdxType idx_type;
+
+    if (!device->manager_idx)
+        return;
+
+    for (idx_type = 0; idx_type < _DEVICE_IDX_TYPE_NUM; idx_type++)
+        _device_idx_entry_set(self, device, idx_type, NULL);
+    c_list_unlink(&device->manager_idx->perm_hw_addr_fallback_lst);
+
+    nm_g_slice_free(g_steal_pointer(&device->manager_idx));
+}
+
+static CList *
+_device_idx_lookup(NMManager *self, DeviceIdxType idx_type, gconstpointer key)
+{
+    static CList     empty_lst = C_LIST_INIT(empty_lst);
+    DeviceIdxBucket *bucket;
+
+    /* Returns the list of DeviceIdxEntry with the key. The list is empty
+     * when there are none, and must not be modified by the caller. */
+    bucket = g_hash_table_lookup(NM_MANAGER_GET_PRIVATE(self)->device_idx[idx_type], key);
+    return bucket ? &bucket->lst_head : &empty_lst;
+}
+
+static NMDevice *
+_device_idx_lookup_first(NMManager *self, DeviceIdxType idx_type, gconstpointer key)
+{
+    DeviceIdxEntry *entry;
+
+    entry = c_list_first_entry(_device_idx_lookup(self, idx_type, key), DeviceIdxEntry, bucket_lst);
+    return entry ? entry->device : NULL;
+}
+
+/*****************************************************************************/
+
+NMDevice *
+nm_manager_get_device_by_ifindex(NMManager *self, int ifindex)
+{
+    if (ifindex <= 0)
+        return NULL;
+
+    return _device_idx_lookup_first(self, DEVICE_IDX_TYPE_IFINDEX, GINT_TO_POINTER(ifindex));
 }
 
 static NMDevice *
 find_device_by_permanent_hw_addr(NMManager *self, const char *hwaddr)
 {
-    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *device;
-    const char       *device_addr;
-    guint8            hwaddr_bin[_NM_UTILS_HWADDR_LEN_MAX];
-    gsize             hwaddr_len;
+    NMManagerPrivate   *priv             = NM_MANAGER_GET_PRIVATE(self);
+    gs_free char       *hwaddr_canonical = NULL;
+    NMManagerDeviceIdx *idx;
+    NMManagerDeviceIdx *idx_safe;
+    NMDevice           *device;
+    const char         *device_addr;
+    guint8              hwaddr_bin[_NM_UTILS_HWADDR_LEN_MAX];
+    gsize               hwaddr_len;
 
     g_return_val_if_fail(hwaddr != NULL, NULL);
 
     if (!_nm_utils_hwaddr_aton(hwaddr, hwaddr_bin, sizeof(hwaddr_bin), &hwaddr_len))
         return NULL;
 
-    c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
+    hwaddr_canonical = nm_utils_hwaddr_ntoa(hwaddr_bin, hwaddr_len);
+    device = _device_idx_lookup_first(self, DEVICE_IDX_TYPE_PERM_HW_ADDR, hwaddr_canonical);
+    if (device)
+        return device;
+
+    /* Not indexed. Compare only the devices that did not yet determine
+     * their permanent address (which the lookup forces, and which may unlink
+     * them from the list) or whose address only matches loosely. */
+    c_list_for_each_entry_safe (idx,
+                                idx_safe,
+                                &priv->devices_perm_hw_addr_fallback_lst_head,
+                                perm_hw_addr_fallback_lst) {
+        device      = idx->entries[DEVICE_IDX_TYPE_PERM_HW_ADDR].device;
         device_addr = nm_device_get_permanent_hw_address(device);
         if (device_addr && nm_utils_hwaddr_matches(hwaddr_bin, hwaddr_len, device_addr, -1))
             return device;
@@ -1891,14 +2104,15 @@ find_device_by_permanent_hw_addr(NMManager *self, const char *hwaddr)
 static NMDevice *
 find_device_by_ip_iface(NMManager *self, const char *iface)
 {
-    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *device;
+    DeviceIdxEntry *entry;
+    CList          *lst_head;
 
     g_return_val_if_fail(iface, NULL);
 
-    c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
-        if (nm_device_is_real(device) && nm_streq0(nm_device_get_ip_iface(device), iface))
-            return device;
+    lst_head = _device_idx_lookup(self, DEVICE_IDX_TYPE_IP_IFACE, iface);
+    c_list_for_each_entry (entry, lst_head, bucket_lst) {
+        if (nm_device_is_real(entry->device))
+            return entry->device;
     }
     return NULL;
 }
@@ -1926,15 +2140,17 @@ find_device_by_iface(NMManager    *self,
                      NMConnection *slave,
                      NMConnection *child)
 {
-    NMManagerPrivate *priv     = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *fallback = NULL;
-    NMDevice         *candidate;
+    NMDevice       *fallback = NULL;
+    NMDevice       *candidate;
+    DeviceIdxEntry *entry;
+    CList          *lst_head;
 
     g_return_val_if_fail(iface != NULL, NULL);
 
-    c_list_for_each_entry (candidate, &priv->devices_lst_head, devices_lst) {
-        if (!nm_streq(nm_device_get_iface(candidate), iface))
-            continue;
+    lst_head = _device_idx_lookup(self, DEVICE_IDX_TYPE_IFACE, iface);
+    c_list_for_each_entry (entry, lst_head, bucket_lst) {
+        candidate = entry->device;
+
         if (connection && !nm_device_check_connection_compatible(candidate, connection, TRUE, NULL))
             continue;
         if (slave) {
@@ -2325,6 +2541,7 @@ remove_device(NMManager *self, NMDevice *device, gboolean quitting)
     _devcon_remove_device_all(self, device);
 
     c_list_unlink(&device->devices_lst);
+    _device_idx_remove(self, device);
 
     _parent_notify_changed(self, device, TRUE);
 
@@ -2552,16 +2769,16 @@ nm_manager_iface_for_uuid(NMManager *self, const char *uuid)
 NMDevice *
 nm_manager_get_device(NMManager *self, const char *ifname, NMDeviceType device_type)
 {
-    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *device;
+    DeviceIdxEntry *entry;
+    CList          *lst_head;
 
     g_return_val_if_fail(ifname, NULL);
     g_return_val_if_fail(device_type != NM_DEVICE_TYPE_UNKNOWN, NULL);
 
-    c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
-        if (nm_device_get_device_type(device) == device_type
-            && nm_streq0(nm_device_get_iface(device), ifname))
-            return device;
+    lst_head = _device_idx_lookup(self, DEVICE_IDX_TYPE_IFACE, ifname);
+    c_list_for_each_entry (entry, lst_head, bucket_lst) {
+        if (nm_device_get_device_type(entry->device) == device_type)
+            return entry->device;
     }
 
     return NULL;
@@ -4022,6 +4239,7 @@ add_device(NMManager *self, NMDevice *device, GError **error)
 
     nm_assert(c_list_is_empty(&device->devices_lst));
     c_list_link_tail(&priv->devices_lst_head, &device->devices_lst);
+    _device_idx_add(self, device);
 
     g_signal_connect(device,
                      NM_DEVICE_STATE_CHANGED,
@@ -4157,30 +4375,33 @@ platform_link_added(NMManager                     *self,
                     gboolean                       guess_assume,
                     const NMConfigDeviceStateData *dev_state)
 {
-    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDeviceFactory  *factory;
-    NMDevice         *device = NULL;
-    NMDevice         *candidate;
+    NMDeviceFactory *factory;
+    NMDevice        *device = NULL;
+    NMDevice        *candidate;
+    DeviceIdxEntry  *entry;
+    DeviceIdxEntry  *entry_safe;
+    CList           *lst_head;
 
     g_return_if_fail(ifindex > 0);
 
     if (nm_manager_get_device_by_ifindex(self, ifindex))
         return;
 
-    /* Let unrealized devices try to realize themselves with the link */
-    c_list_for_each_entry (candidate, &priv->devices_lst_head, devices_lst) {
+    /* Let unrealized devices try to realize themselves with the link. Every
+     * candidate that is not the last one keeps the bucket alive. */
+    lst_head = _device_idx_lookup(self, DEVICE_IDX_TYPE_IFACE, plink->name);
+    c_list_for_each_entry_safe (entry, entry_safe, lst_head, bucket_lst) {
         gboolean              compatible = TRUE;
         gs_free_error GError *error      = NULL;
 
+        candidate = entry->device;
+
         if (nm_device_get_device_type(candidate) == NM_DEVICE_TYPE_GENERIC) {
             /* generic devices are compatible with all link types */
         } else if (nm_device_get_link_type(candidate) != plink->type) {
             continue;
         }
 
-        if (!nm_streq(nm_device_get_iface(candidate), plink->name))
-            continue;
-
         if (nm_device_is_real(candidate)) {
             /* There's already a realized device with the link's name
              * and a different ifindex.
@@ -8858,6 +9079,11 @@ nm_manager_init(NMManager *self)
     c_list_init(&priv->auth_lst_head);
     c_list_init(&priv->link_cb_lst);
     c_list_init(&priv->devices_lst_head);
+    c_list_init(&priv->devices_perm_hw_addr_fallback_lst_head);
+    priv->device_idx[DEVICE_IDX_TYPE_IFINDEX]      = g_hash_table_new(nm_direct_hash, NULL);
+    priv->device_idx[DEVICE_IDX_TYPE_IFACE]        = g_hash_table_new(nm_str_hash, g_str_equal);
+    priv->device_idx[DEVICE_IDX_TYPE_IP_IFACE]     = g_hash_table_new(nm_str_hash, g_str_equal);
+    priv->device_idx[DEVICE_IDX_TYPE_PERM_HW_ADDR] = g_hash_table_new(nm_str_hash, g_str_equal);
     c_list_init(&priv->active_connections_lst_head);
     c_list_init(&priv->async_op_lst_head);
     c_list_init(&priv->delete_volatile_connection_lst_head);
@@ -9226,9 +9452,15 @@ static void
 finalize(GObject *object)
 {
     NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(object);
+    guint             i;
 
     g_array_free(priv->capabilities, TRUE);
 
+    for (i = 0; i < G_N_ELEMENTS(priv->device_idx); i++) {
+        nm_assert(g_hash_table_size(priv->device_idx[i]) == 0);
+        g_hash_table_unref(priv->device_idx[i]);
+    }
+
     G_OBJECT_CLASS(nm_manager_parent_class)->finalize(object);
 
     g_object_unref(priv->platform);
@@ -191,6 +191,7 @@ gboolean nm_manager_deactivate_connection(NMManager          *manager,
 
 void nm_manager_set_capability(NMManager *self, NMCapability cap);
 void nm_manager_emit_device_ifindex_changed(NMManager *self, NMDevice *device);
+void nm_manager_device_idx_update(NMManager *self, NMDevice *device);
 
 NMDevice *nm_manager_get_device(NMManager *self, const char *ifname, NMDeviceType device_type);
 gboolean  nm_manager_remove_device(NMManager *self, const char *ifname, NMDeviceType device_type);
@@ -83,8 +83,18 @@ typedef struct {
      * by IP address. */
     GHashTable *watcher_ip_data_idx;
 
+    /* Index of PlatformSubBucket instances, by object type and ifindex. */
+    GHashTable *platform_sub_idx;
+
     CList    l3cfg_signal_pending_lst_head;
     GSource *signal_pending_idle_source;
+
+    /* The registered NMNetnsStatsHandle instances. They all share one
+     * timeout, which fires at the earliest "next_msec" of any handle. */
+    CList               stats_lst_head;
+    GSource            *stats_timeout_source;
+    NMNetnsStatsHandle *stats_current;
+    gint64              stats_timeout_msec;
 } NMNetnsPrivate;
 
 struct _NMNetns {
@@ -452,6 +462,208 @@ nm_netns_l3cfg_acquire(NMNetns *self, int ifindex)
 
 /*****************************************************************************/
 
+typedef struct {
+    NMPObjectType obj_type;
+    int           ifindex;
+    CList         sub_lst_head;
+
+    /* While we iterate over the subscriptions, the bucket must not be
+     * destroyed, even if the last subscription unsubscribes. */
+    guint dispatching;
+} PlatformSubBucket;
+
+struct _NMNetnsPlatformSubscription {
+    NMNetns                *_self;
+    PlatformSubBucket      *bucket;
+    CList                   sub_lst;
+    NMNetnsPlatformCallback callback;
+    gpointer                user_data;
+    NMPObjectType           obj_type;
+    int                     ifindex;
+};
+
+static guint
+_platform_sub_bucket_hash(gconstpointer data)
+{
+    const PlatformSubBucket *bucket = data;
+
+    return nm_hash_vals(1432297033u, bucket->obj_type, bucket->ifindex);
+}
+
+static gboolean
+_platform_sub_bucket_equal(gconstpointer a, gconstpointer b)
+{
+    const PlatformSubBucket *ba = a;
+    const PlatformSubBucket *bb = b;
+
+    return ba->obj_type == bb->obj_type && ba->ifindex == bb->ifindex;
+}
+
+static void
+_platform_sub_bucket_check_destroy(NMNetns *self, PlatformSubBucket *bucket)
+{
+    NMNetnsPrivate *priv = NM_NETNS_GET_PRIVATE(self);
+
+    if (bucket->dispatching > 0 || !c_list_is_empty(&bucket->sub_lst_head))
+        return;
+
+    if (!g_hash_table_remove(priv->platform_sub_idx, bucket))
+        nm_assert_not_reached();
+    nm_g_slice_free(bucket);
+}
+
+static void
+_platform_sub_link(NMNetnsPlatformSubscription *sub)
+{
+    NMNetnsPrivate    *priv = NM_NETNS_GET_PRIVATE(sub->_self);
+    PlatformSubBucket *bucket;
+    PlatformSubBucket  needle;
+
+    nm_assert(!sub->bucket);
+
+    if (sub->ifindex <= 0)
+        return;
+
+    needle = (PlatformSubBucket){
+        .obj_type = sub->obj_type,
+        .ifindex  = sub->ifindex,
+    };
+    bucket = g_hash_table_lookup(priv->platform_sub_idx, &needle);
+    if (!bucket) {
+        bucket  = g_slice_new(PlatformSubBucket);
+        *bucket = (PlatformSubBucket){
+            .obj_type     = sub->obj_type,
+            .ifindex      = sub->ifindex,
+            .sub_lst_head = C_LIST_INIT(bucket->sub_lst_head),
+        };
+        if (!g_hash_table_add(priv->platform_sub_idx, bucket))
+            nm_assert_not_reached();
+    }
+
+    sub->bucket = bucket;
+    c_list_link_tail(&bucket->sub_lst_head, &sub->sub_lst);
+}
+
+static void
+_platform_sub_unlink(NMNetnsPlatformSubscription *sub)
+{
+    PlatformSubBucket *bucket = g_steal_pointer(&sub->bucket);
+
+    if (!bucket)
+        return;
+
+    c_list_unlink(&sub->sub_lst);
+    _platform_sub_bucket_check_destroy(sub->_self, bucket);
+}
+
+static void
+_platform_sub_notify(NMNetns                   *self,
+                     NMPObjectType              obj_type,
+                     int                        ifindex,
+                     const NMPObject           *obj,
+                     NMPlatformSignalChangeType change_type)
+{
+    NMNetnsPrivate              *priv = NM_NETNS_GET_PRIVATE(self);
+    NMNetnsPlatformSubscription *sub;
+    NMNetnsPlatformSubscription *sub_safe;
+    PlatformSubBucket           *bucket;
+    PlatformSubBucket            needle;
+
+    needle = (PlatformSubBucket){
+        .obj_type = obj_type,
+        .ifindex  = ifindex,
+    };
+    bucket = g_hash_table_lookup(priv->platform_sub_idx, &needle);
+    if (!bucket)
+        return;
+
+    /* Like with the watcher handles, we dispatch directly from the platform
+     * signal. The callee may unsubscribe itself (or change its ifindex), but
+     * it must not unsubscribe other subscriptions of the same bucket. */
+    bucket->dispatching++;
+    c_list_for_each_entry_safe (sub, sub_safe, &bucket->sub_lst_head, sub_lst)
+        sub->callback(self, obj_type, ifindex, obj, change_type, sub->user_data);
+    bucket->dispatching--;
+
+    _platform_sub_bucket_check_destroy(self, bucket);
+}
+
+/**
+ * nm_netns_platform_subscribe:
+ * @self: the #NMNetns
+ * @obj_type: the object type to subscribe to.
+ * @ifindex: the ifindex of interest. If 0, the subscription is
+ *   inactive until nm_netns_platform_subscription_set_ifindex()
+ *   sets an ifindex.
+ * @callback: the callback invoked for platform changes.
+ * @user_data: user data for @callback.
+ *
+ * Unlike connecting to the signals of #NMPlatform, which get every
+ * change of every interface, @callback is only invoked for changes
+ * of objects of type @obj_type on @ifindex. The event is dispatched
+ * synchronously from the platform signal.
+ *
+ * Returns: the subscription. Release with nm_netns_platform_unsubscribe().
+ */
+NMNetnsPlatformSubscription *
+nm_netns_platform_subscribe(NMNetns                *self,
+                            NMPObjectType           obj_type,
+                            int                     ifindex,
+                            NMNetnsPlatformCallback callback,
+                            gpointer                user_data)
+{
+    NMNetnsPlatformSubscription *sub;
+
+    g_return_val_if_fail(NM_IS_NETNS(self), NULL);
+    g_return_val_if_fail(NM_IN_SET(obj_type,
+                                   NMP_OBJECT_TYPE_LINK,
+                                   NMP_OBJECT_TYPE_IP4_ADDRESS,
+                                   NMP_OBJECT_TYPE_IP6_ADDRESS,
+                                   NMP_OBJECT_TYPE_IP4_ROUTE,
+                                   NMP_OBJECT_TYPE_IP6_ROUTE),
+                         NULL);
+    g_return_val_if_fail(callback, NULL);
+
+    sub  = g_slice_new(NMNetnsPlatformSubscription);
+    *sub = (NMNetnsPlatformSubscription){
+        ._self     = self,
+        .callback  = callback,
+        .user_data = user_data,
+        .obj_type  = obj_type,
+        .ifindex   = NM_MAX(ifindex, 0),
+    };
+    _platform_sub_link(sub);
+    return sub;
+}
+
+void
+nm_netns_platform_unsubscribe(NMNetnsPlatformSubscription *sub)
+{
+    if (!sub)
+        return;
+
+    g_return_if_fail(NM_IS_NETNS(sub->_self));
+
+    _platform_sub_unlink(sub);
+    sub->_self = NULL;
+    nm_g_slice_free(sub);
+}
+
+void
+nm_netns_platform_subscription_set_ifindex(NMNetnsPlatformSubscription *sub, int ifindex)
+{
+    g_return_if_fail(sub);
+    g_return_if_fail(NM_IS_NETNS(sub->_self));
+
+    ifindex = NM_MAX(ifindex, 0);
+    if (sub->ifindex == ifindex)
+        return;
+
+    _platform_sub_unlink(sub);
+    sub->ifindex = ifindex;
+    _platform_sub_link(sub);
+}
+
 static gboolean
 _platform_signal_on_idle_cb(gpointer user_data)
 {
@@ -520,6 +732,12 @@ _platform_signal_cb(NMPlatform   *platform,
     _nm_l3cfg_notify_platform_change(l3cfg, change_type, NMP_OBJECT_UP_CAST(platform_object));
 
 notify_watcher:
+    _platform_sub_notify(self,
+                         obj_type,
+                         ifindex,
+                         NMP_OBJECT_UP_CAST(platform_object),
+                         change_type);
+
     switch (obj_type) {
     case NMP_OBJECT_TYPE_IP4_ADDRESS:
     case NMP_OBJECT_TYPE_IP6_ADDRESS:
@@ -675,6 +893,266 @@ nm_netns_shared_ip_release(NMNetnsSharedIPHandle *handle)
 
 /*****************************************************************************/
 
+/* Handles that become due within this many milliseconds of the current
+ * tick get refreshed together with it. That merges timers of devices with
+ * similar schedules into one wakeup. */
+#define STATS_SLACK_MSEC 50
+
+struct _NMNetnsStatsHandle {
+    NMNetns             *_self;
+    CList                stats_lst;
+    NMNetnsStatsCallback callback;
+    gpointer             user_data;
+    gint64               next_msec;
+    guint                refresh_rate_ms;
+    int                  ifindex;
+};
+
+static void _stats_reschedule(NMNetns *self);
+
+static void
+_stats_handle_notify(NMNetnsStatsHandle *handle, const NMPlatformLinkStats *stats)
+{
+    NMPlatformLinkStats stats_empty;
+
+    if (!stats) {
+        stats_empty = (NMPlatformLinkStats){
+            .ifindex = handle->ifindex,
+        };
+        stats = &stats_empty;
+    }
+
+    handle->callback(handle->_self, stats, handle->user_data);
+}
+
+static void
+_stats_refresh_one(NMNetns *self, NMNetnsStatsHandle *handle)
+{
+    NMNetnsPrivate       *priv = NM_NETNS_GET_PRIVATE(self);
+    const NMPlatformLink *pllink;
+    NMPlatformLinkStats   stats;
+
+    priv->stats_current = handle;
+
+    nm_platform_link_refresh(priv->platform, handle->ifindex);
+
+    if (priv->stats_current != handle) {
+        /* The handle was unregistered while processing the platform events. */
+        return;
+    }
+    priv->stats_current = NULL;
+
+    pllink = nm_platform_link_get(priv->platform, handle->ifindex);
+    if (!pllink) {
+        _stats_handle_notify(handle, NULL);
+        return;
+    }
+
+    stats = (NMPlatformLinkStats){
+        .ifindex    = handle->ifindex,
+        .rx_packets = pllink->rx_packets,
+        .rx_bytes   = pllink->rx_bytes,
+        .tx_packets = pllink->tx_packets,
+        .tx_bytes   = pllink->tx_bytes,
+    };
+    _stats_handle_notify(handle, &stats);
+}
+
+static gboolean
+_stats_timeout_cb(gpointer user_data)
+{
+    NMNetns               *self = user_data;
+    NMNetnsPrivate        *priv = NM_NETNS_GET_PRIVATE(self);
+    gs_unref_array GArray *stats_arr = NULL;
+    CList                  due_lst_head = C_LIST_INIT(due_lst_head);
+    NMNetnsStatsHandle    *handle;
+    NMNetnsStatsHandle    *handle_safe;
+    gint64                 now_msec;
+    guint                  n_due = 0;
+
+    nm_clear_g_source_inst(&priv->stats_timeout_source);
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    /* Move the due handles to a local list. The callbacks may unregister
+     * handles (which unlinks them from whatever list they are on) or
+     * register new ones, so we don't iterate over the main list while
+     * invoking them. Aligning "next_msec" to a multiple of the rate keeps
+     * handles with the same rate on the same tick. */
+    c_list_for_each_entry_safe (handle, handle_safe, &priv->stats_lst_head, stats_lst) {
+        gint64 base_msec;
+
+        if (handle->next_msec > now_msec + STATS_SLACK_MSEC)
+            continue;
+
+        /* A handle that is served early (within the slack) is next due one
+         * period after the tick it was scheduled for, not at that tick again. */
+        base_msec         = NM_MAX(now_msec, handle->next_msec);
+        handle->next_msec =
+            ((base_msec / handle->refresh_rate_ms) + 1) * ((gint64) handle->refresh_rate_ms);
+        if (handle->ifindex <= 0)
+            continue;
+
+        c_list_unlink_stale(&handle->stats_lst);
+        c_list_link_tail(&due_lst_head, &handle->stats_lst);
+        n_due++;
+    }
+
+    if (n_due > 1) {
+        /* Fetch the counters of all links with one RTM_GETSTATS dump instead
+         * of one RTM_GETLINK request (and cache update) per link. */
+        stats_arr = nm_platform_link_stats_dump(priv->platform);
+    }
+
+    if (n_due > 0) {
+        _LOGT("stats: refresh %u link%s%s",
+              n_due,
+              n_due == 1 ? "" : "s",
+              stats_arr ? " (dump)" : "");
+    }
+
+    g_object_ref(self);
+
+    while ((handle = c_list_first_entry(&due_lst_head, NMNetnsStatsHandle, stats_lst))) {
+        c_list_unlink_stale(&handle->stats_lst);
+        c_list_link_tail(&priv->stats_lst_head, &handle->stats_lst);
+
+        if (stats_arr) {
+            const NMPlatformLinkStats *stats;
+
+            stats = nm_platform_link_stats_find(stats_arr, handle->ifindex);
+            if (stats) {
+                _stats_handle_notify(handle, stats);
+                continue;
+            }
+        }
+
+        _stats_refresh_one(self, handle);
+    }
+
+    _stats_reschedule(self);
+
+    g_object_unref(self);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_stats_reschedule(NMNetns *self)
+{
+    NMNetnsPrivate     *priv = NM_NETNS_GET_PRIVATE(self);
+    NMNetnsStatsHandle *handle;
+    gint64              next_msec = G_MAXINT64;
+    gint64              now_msec;
+
+    c_list_for_each_entry (handle, &priv->stats_lst_head, stats_lst)
+        next_msec = NM_MIN(next_msec, handle->next_msec);
+
+    if (next_msec == G_MAXINT64) {
+        nm_clear_g_source_inst(&priv->stats_timeout_source);
+        return;
+    }
+
+    if (priv->stats_timeout_source && priv->stats_timeout_msec == next_msec)
+        return;
+
+    nm_clear_g_source_inst(&priv->stats_timeout_source);
+
+    now_msec                   = nm_utils_get_monotonic_timestamp_msec();
+    priv->stats_timeout_msec   = next_msec;
+    priv->stats_timeout_source = nm_g_timeout_add_source(NM_MAX(next_msec - now_msec, 0),
+                                                         _stats_timeout_cb,
+                                                         self);
+}
+
+/**
+ * nm_netns_stats_register:
+ * @self: the #NMNetns
+ * @ifindex: the ifindex of the link. Can be 0 and later set with
+ *   nm_netns_stats_set_ifindex().
+ * @refresh_rate_ms: the refresh rate in milliseconds. Must be positive.
+ * @callback: invoked with the latest counters of the link.
+ * @user_data: user data for @callback.
+ *
+ * Periodically fetches the statistics of a link. All handles of a
+ * namespace share one timer, and when several links are due at the
+ * same time, their counters are fetched with a single netlink dump.
+ * The first refresh happens right away.
+ *
+ * Returns: the handle. Free with nm_netns_stats_unregister().
+ */
+NMNetnsStatsHandle *
+nm_netns_stats_register(NMNetns             *self,
+                        int                  ifindex,
+                        guint                refresh_rate_ms,
+                        NMNetnsStatsCallback callback,
+                        gpointer             user_data)
+{
+    NMNetnsPrivate     *priv;
+    NMNetnsStatsHandle *handle;
+
+    g_return_val_if_fail(NM_IS_NETNS(self), NULL);
+    g_return_val_if_fail(refresh_rate_ms > 0, NULL);
+    g_return_val_if_fail(callback, NULL);
+
+    priv = NM_NETNS_GET_PRIVATE(self);
+
+    handle  = g_slice_new(NMNetnsStatsHandle);
+    *handle = (NMNetnsStatsHandle){
+        ._self           = self,
+        .callback        = callback,
+        .user_data       = user_data,
+        .next_msec       = nm_utils_get_monotonic_timestamp_msec(),
+        .refresh_rate_ms = refresh_rate_ms,
+        .ifindex         = NM_MAX(ifindex, 0),
+    };
+    c_list_link_tail(&priv->stats_lst_head, &handle->stats_lst);
+
+    _stats_reschedule(self);
+    return handle;
+}
+
+void
+nm_netns_stats_unregister(NMNetnsStatsHandle *handle)
+{
+    NMNetns        *self;
+    NMNetnsPrivate *priv;
+
+    if (!handle)
+        return;
+
+    self = handle->_self;
+
+    g_return_if_fail(NM_IS_NETNS(self));
+
+    priv = NM_NETNS_GET_PRIVATE(self);
+
+    if (priv->stats_current == handle)
+        priv->stats_current = NULL;
+
+    c_list_unlink_stale(&handle->stats_lst);
+    handle->_self = NULL;
+    nm_g_slice_free(handle);
+
+    _stats_reschedule(self);
+}
+
+void
+nm_netns_stats_set_ifindex(NMNetnsStatsHandle *handle, int ifindex)
+{
+    g_return_if_fail(handle);
+    g_return_if_fail(NM_IS_NETNS(handle->_self));
+
+    ifindex = NM_MAX(ifindex, 0);
+    if (handle->ifindex == ifindex)
+        return;
+
+    handle->ifindex   = ifindex;
+    handle->next_msec = nm_utils_get_monotonic_timestamp_msec();
+    _stats_reschedule(handle->_self);
+}
+
+/*****************************************************************************/
+
 void
 nm_netns_ip_route_ecmp_register(NMNetns *self, NML3Cfg *l3cfg, const NMPObject *obj)
 {
@@ -1452,6 +1930,7 @@ nm_netns_init(NMNetns *self)
     priv->_self_signal_user_data = self;
 
     c_list_init(&priv->l3cfg_signal_pending_lst_head);
+    c_list_init(&priv->stats_lst_head);
 
     G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(EcmpTrackObj, obj) == 0);
     priv->ecmp_track_by_obj =
@@ -1468,6 +1947,9 @@ nm_netns_init(NMNetns *self)
                                                      (GDestroyNotify) _watcher_by_tag_destroy,
                                                      NULL);
     priv->watcher_ip_data_idx = g_hash_table_new(_watcher_ip_data_hash, _watcher_ip_data_equal);
+
+    priv->platform_sub_idx =
+        g_hash_table_new(_platform_sub_bucket_hash, _platform_sub_bucket_equal);
 }
 
 static void
@@ -1549,6 +2031,8 @@ dispose(GObject *object)
     nm_assert(nm_g_hash_table_size(priv->watcher_idx) == 0);
     nm_assert(nm_g_hash_table_size(priv->watcher_by_tag_idx) == 0);
     nm_assert(nm_g_hash_table_size(priv->watcher_ip_data_idx) == 0);
+    nm_assert(nm_g_hash_table_size(priv->platform_sub_idx) == 0);
+    nm_assert(c_list_is_empty(&priv->stats_lst_head));
 
     nm_clear_pointer(&priv->ecmp_track_by_obj, g_hash_table_destroy);
     nm_clear_pointer(&priv->ecmp_track_by_ecmpid, g_hash_table_destroy);
@@ -1556,8 +2040,10 @@ dispose(GObject *object)
     nm_clear_pointer(&priv->watcher_idx, g_hash_table_destroy);
     nm_clear_pointer(&priv->watcher_by_tag_idx, g_hash_table_destroy);
     nm_clear_pointer(&priv->watcher_ip_data_idx, g_hash_table_destroy);
+    nm_clear_pointer(&priv->platform_sub_idx, g_hash_table_destroy);
 
     nm_clear_g_source_inst(&priv->signal_pending_idle_source);
+    nm_clear_g_source_inst(&priv->stats_timeout_source);
 
     if (priv->platform)
         g_signal_handlers_disconnect_by_data(priv->platform, &priv->_self_signal_user_data);
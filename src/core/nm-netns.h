@@ -101,4 +101,43 @@ void nm_netns_watcher_add(NMNetns                  *self,
 void
 nm_netns_watcher_remove_all(NMNetns *self, gconstpointer tag, gboolean all /* or only dirty */);
 
+/*****************************************************************************/
+
+typedef struct _NMNetnsPlatformSubscription NMNetnsPlatformSubscription;
+
+typedef void (*NMNetnsPlatformCallback)(NMNetns                   *self,
+                                        NMPObjectType              obj_type,
+                                        int                        ifindex,
+                                        const NMPObject           *obj,
+                                        NMPlatformSignalChangeType change_type,
+                                        gpointer                   user_data);
+
+NMNetnsPlatformSubscription *nm_netns_platform_subscribe(NMNetns                *self,
+                                                         NMPObjectType           obj_type,
+                                                         int                     ifindex,
+                                                         NMNetnsPlatformCallback callback,
+                                                         gpointer                user_data);
+
+void nm_netns_platform_unsubscribe(NMNetnsPlatformSubscription *sub);
+
+void nm_netns_platform_subscription_set_ifindex(NMNetnsPlatformSubscription *sub, int ifindex);
+
+/*****************************************************************************/
+
+typedef struct _NMNetnsStatsHandle NMNetnsStatsHandle;
+
+typedef void (*NMNetnsStatsCallback)(NMNetns                   *self,
+                                     const NMPlatformLinkStats *stats,
+                                     gpointer                   user_data);
+
+NMNetnsStatsHandle *nm_netns_stats_register(NMNetns             *self,
+                                            int                  ifindex,
+                                            guint                refresh_rate_ms,
+                                            NMNetnsStatsCallback callback,
+                                            gpointer             user_data);
+
+void nm_netns_stats_unregister(NMNetnsStatsHandle *handle);
+
+void nm_netns_stats_set_ifindex(NMNetnsStatsHandle *handle, int ifindex);
+
 #endif /* __NM_NETNS_H__ */
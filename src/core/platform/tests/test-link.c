@@ -7,8 +7,10 @@
 
 #include <sched.h>
 #include <sys/mount.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <netinet/in.h>
 #include <linux/if_tun.h>
 
 #include "libnm-glib-aux/nm-io-utils.h"
@@ -2997,6 +2999,100 @@ again:
 
 /*****************************************************************************/
 
+static void
+_link_stats_get_cached(int ifindex, NMPlatformLinkStats *out_stats)
+{
+    const NMPlatformLink *pllink;
+
+    g_assert(nm_platform_link_refresh(NM_PLATFORM_GET, ifindex));
+    pllink = nm_platform_link_get(NM_PLATFORM_GET, ifindex);
+    g_assert(pllink);
+
+    *out_stats = (NMPlatformLinkStats){
+        .ifindex    = ifindex,
+        .rx_packets = pllink->rx_packets,
+        .rx_bytes   = pllink->rx_bytes,
+        .tx_packets = pllink->tx_packets,
+        .tx_bytes   = pllink->tx_bytes,
+    };
+}
+
+#define _assert_link_stats_between(before, stats, after, field) \
+    G_STMT_START                                                \
+    {                                                           \
+        g_assert_cmpuint((before)->field, <=, (stats)->field);  \
+        g_assert_cmpuint((stats)->field, <=, (after)->field);   \
+    }                                                           \
+    G_STMT_END
+
+static void
+test_link_stats_dump(void)
+{
+    const char            *IFACE_VETH0 = "nm-test-veth0";
+    const char            *IFACE_VETH1 = "nm-test-veth1";
+    gs_unref_array GArray *stats_arr   = NULL;
+    nm_auto_close int      fd          = -1;
+    NMPlatformLinkStats    before[3];
+    NMPlatformLinkStats    after[3];
+    int                    ifindexes[3];
+    struct sockaddr_in     sin;
+    guint                  i;
+
+    ifindexes[0] = LO_INDEX;
+    ifindexes[1] = nmtstp_link_veth_add(NM_PLATFORM_GET, -1, IFACE_VETH0, IFACE_VETH1)->ifindex;
+    ifindexes[2] =
+        nmtstp_link_get_typed(NM_PLATFORM_GET, -1, IFACE_VETH1, NM_LINK_TYPE_VETH)->ifindex;
+
+    for (i = 0; i < G_N_ELEMENTS(ifindexes); i++)
+        nmtstp_link_set_updown(NULL, -1, ifindexes[i], TRUE);
+
+    /* Send a datagram over the loopback, so that there is something to count. */
+    fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    g_assert(fd >= 0);
+    sin = (struct sockaddr_in){
+        .sin_family      = AF_INET,
+        .sin_port        = htons(9),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    g_assert_cmpint(sendto(fd, "x", 1, 0, (struct sockaddr *) &sin, sizeof(sin)), ==, 1);
+
+    for (i = 0; i < G_N_ELEMENTS(ifindexes); i++)
+        _link_stats_get_cached(ifindexes[i], &before[i]);
+
+    stats_arr = nm_platform_link_stats_dump(NM_PLATFORM_GET);
+
+    for (i = 0; i < G_N_ELEMENTS(ifindexes); i++)
+        _link_stats_get_cached(ifindexes[i], &after[i]);
+
+    g_assert(stats_arr);
+    for (i = 1; i < stats_arr->len; i++) {
+        g_assert_cmpint(nm_g_array_index(stats_arr, NMPlatformLinkStats, i - 1).ifindex,
+                        <,
+                        nm_g_array_index(stats_arr, NMPlatformLinkStats, i).ifindex);
+    }
+    g_assert(!nm_platform_link_stats_find(stats_arr, BOGUS_IFINDEX));
+
+    /* The dump bypasses the cache. The counters may still grow in the
+     * meantime, so the dumped ones lie between the cached counters from
+     * before and after the dump. */
+    g_assert_cmpuint(before[0].tx_packets, >, 0);
+    for (i = 0; i < G_N_ELEMENTS(ifindexes); i++) {
+        const NMPlatformLinkStats *stats;
+
+        stats = nm_platform_link_stats_find(stats_arr, ifindexes[i]);
+        g_assert(stats);
+        g_assert_cmpint(stats->ifindex, ==, ifindexes[i]);
+        _assert_link_stats_between(&before[i], stats, &after[i], rx_packets);
+        _assert_link_stats_between(&before[i], stats, &after[i], rx_bytes);
+        _assert_link_stats_between(&before[i], stats, &after[i], tx_packets);
+        _assert_link_stats_between(&before[i], stats, &after[i], tx_bytes);
+    }
+
+    nmtstp_link_delete(NULL, -1, ifindexes[1], IFACE_VETH0, TRUE);
+}
+
+/*****************************************************************************/
+
 static void
 _test_netns_setup(gpointer fixture, gconstpointer test_data)
 {
@@ -4122,6 +4218,8 @@ _nmtstp_setup_tests(void)
         g_test_add_func("/link/nl-bugs/spurious-newlink", test_nl_bugs_spuroius_newlink);
         g_test_add_func("/link/nl-bugs/spurious-dellink", test_nl_bugs_spuroius_dellink);
 
+        g_test_add_func("/link/stats-dump", test_link_stats_dump);
+
         g_test_add_vtable("/general/netns/general",
                           0,
                           NULL,
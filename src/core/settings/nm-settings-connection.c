@@ -409,8 +409,15 @@ _nm_settings_connection_set_connection(NMSettingsConnection            *self,
         || !nm_connection_compare(priv->connection,
                                   new_connection,
                                   NM_SETTING_COMPARE_FLAG_EXACT)) {
+        /* Profiles often share identical settings (for example, the ipv4 and ipv6
+         * settings of many VLAN profiles). Use a connection that shares one sealed
+         * instance of each. This also makes nm_connection_compare() a pointer
+         * comparison for those. NMSettings already passes the interned connection
+         * of its StorageData, so this only takes another reference to it. */
         connection_old   = priv->connection;
-        priv->connection = g_object_ref(new_connection);
+        priv->connection =
+            _nm_connection_new_interned(new_connection,
+                                        _nm_settings_get_setting_intern_table(priv->settings));
         nm_assert_connection_unchanging(priv->connection);
 
         _getsettings_cached_clear(priv);
@@ -7,6 +7,7 @@
 
 #include "nm-settings-utils.h"
 
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -50,6 +51,322 @@ nm_sett_util_stat_mtime(const char *filename, gboolean do_lstat, struct timespec
 
 /*****************************************************************************/
 
+void
+nm_sett_util_file_id_from_stat(NMSettUtilFileId *file_id, const struct stat *st)
+{
+    *file_id = (NMSettUtilFileId){
+        .dev  = st->st_dev,
+        .ino  = st->st_ino,
+        .size = st->st_size,
+        .mtime_nsec =
+            (((gint64) st->st_mtim.tv_sec) * NM_UTILS_NSEC_PER_SEC) + st->st_mtim.tv_nsec,
+        .ctime_nsec =
+            (((gint64) st->st_ctim.tv_sec) * NM_UTILS_NSEC_PER_SEC) + st->st_ctim.tv_nsec,
+    };
+}
+
+gboolean
+nm_sett_util_file_id_get(const char *filename, NMSettUtilFileId *out_file_id)
+{
+    struct stat st;
+
+    if (stat(filename, &st) != 0) {
+        *out_file_id = (NMSettUtilFileId){};
+        return FALSE;
+    }
+
+    nm_sett_util_file_id_from_stat(out_file_id, &st);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+/* NMSettUtilWriteQueue collects files that should be written to disk and
+ * writes them on a worker thread, after a short delay. Several writes that
+ * happen within the delay get committed together, and the same file is only
+ * written once (with the latest content).
+ *
+ * Every file gets replaced atomically (write to a temporary file and rename).
+ * Afterwards, each affected directory is synced once, so that the renames
+ * hit the disk.
+ *
+ * At most one batch is in flight at a time, so an older content can never
+ * overwrite a newer one. All functions must be called from the main thread. */
+struct _NMSettUtilWriteQueue {
+    /* filename -> GBytes, the writes not yet handed to the worker. */
+    GHashTable   *pending;
+    GSource      *commit_source;
+    GCancellable *cancellable;
+    GMutex        lock;
+    GCond         cond;
+    guint         commit_delay_msec;
+
+    /* protected by @lock. */
+    bool in_flight;
+    bool paused;
+};
+
+typedef struct {
+    NMSettUtilWriteQueue *queue;
+    GHashTable           *files;
+    GPtrArray            *errors;
+} WriteQueueBatch;
+
+static void _write_queue_commit(NMSettUtilWriteQueue *queue);
+
+static GHashTable *
+_write_queue_pending_new(void)
+{
+    return g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, (GDestroyNotify) g_bytes_unref);
+}
+
+static void
+_write_queue_write_files(GHashTable *files, GPtrArray *errors)
+{
+    gs_unref_hashtable GHashTable *dirnames = NULL;
+    GHashTableIter                 iter;
+    const char                    *filename;
+    const char                    *dirname;
+    GBytes                        *contents;
+
+    dirnames = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+
+    g_hash_table_iter_init(&iter, files);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &filename, (gpointer *) &contents)) {
+        gs_free_error GError *error = NULL;
+        gconstpointer         data;
+        gsize                 len;
+
+        data = g_bytes_get_data(contents, &len);
+        if (!nm_utils_file_set_contents(filename, data, len, 0644, NULL, NULL, &error)) {
+            g_ptr_array_add(errors, g_strdup_printf("\"%s\": %s", filename, error->message));
+            continue;
+        }
+        g_hash_table_add(dirnames, g_path_get_dirname(filename));
+    }
+
+    g_hash_table_iter_init(&iter, dirnames);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &dirname, NULL)) {
+        nm_auto_close int fd = -1;
+
+        fd = open(dirname, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0 || fsync(fd) != 0) {
+            int errsv = errno;
+
+            g_ptr_array_add(errors,
+                            g_strdup_printf("sync directory \"%s\": %s",
+                                            dirname,
+                                            nm_strerror_native(errsv)));
+        }
+    }
+}
+
+static void
+_write_queue_log_result(guint n_files, GPtrArray *errors)
+{
+    guint i;
+
+    for (i = 0; i < errors->len; i++)
+        nm_log_dbg(LOGD_SETTINGS, "write-queue: failure to write %s", (char *) errors->pdata[i]);
+    nm_log_trace(LOGD_SETTINGS, "write-queue: committed %u files", n_files);
+}
+
+static void
+_write_queue_batch_free(gpointer user_data)
+{
+    WriteQueueBatch *batch = user_data;
+
+    g_hash_table_unref(batch->files);
+    g_ptr_array_unref(batch->errors);
+    nm_g_slice_free(batch);
+}
+
+static void
+_write_queue_thread_fcn(GTask        *task,
+                        gpointer      source_object,
+                        gpointer      task_data,
+                        GCancellable *cancellable)
+{
+    WriteQueueBatch      *batch = task_data;
+    NMSettUtilWriteQueue *queue = batch->queue;
+
+    g_mutex_lock(&queue->lock);
+    while (queue->paused)
+        g_cond_wait(&queue->cond, &queue->lock);
+    g_mutex_unlock(&queue->lock);
+
+    _write_queue_write_files(batch->files, batch->errors);
+
+    /* After signaling, the queue may be freed. Don't touch it anymore. */
+    g_mutex_lock(&queue->lock);
+    queue->in_flight = FALSE;
+    g_cond_broadcast(&queue->cond);
+    g_mutex_unlock(&queue->lock);
+
+    g_task_return_boolean(task, TRUE);
+}
+
+static void
+_write_queue_done_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    GTask                *task  = G_TASK(result);
+    WriteQueueBatch      *batch = g_task_get_task_data(task);
+    NMSettUtilWriteQueue *queue;
+
+    _write_queue_log_result(g_hash_table_size(batch->files), batch->errors);
+
+    if (g_cancellable_is_cancelled(g_task_get_cancellable(task)))
+        return;
+
+    queue = user_data;
+
+    /* More writes were added while we were busy. Commit them right away,
+     * they already waited long enough. */
+    if (!queue->commit_source && g_hash_table_size(queue->pending) > 0)
+        _write_queue_commit(queue);
+}
+
+static void
+_write_queue_commit(NMSettUtilWriteQueue *queue)
+{
+    gs_unref_object GTask *task = NULL;
+    WriteQueueBatch       *batch;
+    gboolean               in_flight;
+
+    nm_clear_g_source_inst(&queue->commit_source);
+
+    if (g_hash_table_size(queue->pending) == 0)
+        return;
+
+    g_mutex_lock(&queue->lock);
+    in_flight = queue->in_flight;
+    if (!in_flight)
+        queue->in_flight = TRUE;
+    g_mutex_unlock(&queue->lock);
+
+    if (in_flight) {
+        /* _write_queue_done_cb() will pick up the pending writes. */
+        return;
+    }
+
+    batch  = g_slice_new(WriteQueueBatch);
+    *batch = (WriteQueueBatch){
+        .queue  = queue,
+        .files  = g_steal_pointer(&queue->pending),
+        .errors = g_ptr_array_new_with_free_func(g_free),
+    };
+    queue->pending = _write_queue_pending_new();
+
+    task = g_task_new(NULL, queue->cancellable, _write_queue_done_cb, queue);
+    g_task_set_task_data(task, batch, _write_queue_batch_free);
+    g_task_run_in_thread(task, _write_queue_thread_fcn);
+}
+
+static gboolean
+_write_queue_commit_cb(gpointer user_data)
+{
+    _write_queue_commit(user_data);
+    return G_SOURCE_CONTINUE;
+}
+
+NMSettUtilWriteQueue *
+nm_sett_util_write_queue_new(guint commit_delay_msec)
+{
+    NMSettUtilWriteQueue *queue;
+
+    queue  = g_slice_new(NMSettUtilWriteQueue);
+    *queue = (NMSettUtilWriteQueue){
+        .pending           = _write_queue_pending_new(),
+        .cancellable       = g_cancellable_new(),
+        .commit_delay_msec = commit_delay_msec,
+    };
+    g_mutex_init(&queue->lock);
+    g_cond_init(&queue->cond);
+    return queue;
+}
+
+void
+nm_sett_util_write_queue_add(NMSettUtilWriteQueue *queue, const char *filename, GBytes *contents)
+{
+    nm_assert(queue);
+    nm_assert(filename);
+    nm_assert(contents);
+
+    g_hash_table_insert(queue->pending, g_strdup(filename), g_bytes_ref(contents));
+
+    if (!queue->commit_source) {
+        queue->commit_source =
+            nm_g_timeout_add_source(queue->commit_delay_msec, _write_queue_commit_cb, queue);
+    }
+}
+
+/* Synchronously write all pending files. This first waits for a write
+ * that is currently in flight. */
+void
+nm_sett_util_write_queue_flush(NMSettUtilWriteQueue *queue)
+{
+    gs_unref_ptrarray GPtrArray *errors = NULL;
+    guint                        n_files;
+
+    nm_assert(queue);
+
+    nm_clear_g_source_inst(&queue->commit_source);
+
+    g_mutex_lock(&queue->lock);
+    while (queue->in_flight)
+        g_cond_wait(&queue->cond, &queue->lock);
+    g_mutex_unlock(&queue->lock);
+
+    n_files = g_hash_table_size(queue->pending);
+    if (n_files == 0)
+        return;
+
+    errors = g_ptr_array_new_with_free_func(g_free);
+    _write_queue_write_files(queue->pending, errors);
+    g_hash_table_remove_all(queue->pending);
+    _write_queue_log_result(n_files, errors);
+}
+
+/* Hold back the worker before it writes a batch, so that tests can
+ * observe a batch in flight. */
+void
+_nm_sett_util_write_queue_set_paused(NMSettUtilWriteQueue *queue, gboolean paused)
+{
+    g_mutex_lock(&queue->lock);
+    queue->paused = paused;
+    g_cond_broadcast(&queue->cond);
+    g_mutex_unlock(&queue->lock);
+}
+
+gboolean
+_nm_sett_util_write_queue_get_in_flight(NMSettUtilWriteQueue *queue)
+{
+    gboolean in_flight;
+
+    g_mutex_lock(&queue->lock);
+    in_flight = queue->in_flight;
+    g_mutex_unlock(&queue->lock);
+    return in_flight;
+}
+
+void
+nm_sett_util_write_queue_free(NMSettUtilWriteQueue *queue)
+{
+    if (!queue)
+        return;
+
+    nm_sett_util_write_queue_flush(queue);
+
+    g_cancellable_cancel(queue->cancellable);
+    g_object_unref(queue->cancellable);
+    g_hash_table_unref(queue->pending);
+    g_mutex_clear(&queue->lock);
+    g_cond_clear(&queue->cond);
+    nm_g_slice_free(queue);
+}
+
+/*****************************************************************************/
+
 gboolean
 nm_sett_util_allow_filename_cb(const char *filename, gpointer user_data)
 {
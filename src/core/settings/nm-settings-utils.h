@@ -17,6 +17,50 @@ nm_sett_util_stat_mtime(const char *filename, gboolean do_lstat, struct timespec
 
 /*****************************************************************************/
 
+struct stat;
+
+/* Identifies the content of a file on disk, as far as stat() can tell. If
+ * a file still has the same NMSettUtilFileId, we assume that it was not
+ * modified and don't need to re-read it. A file that does not exist has
+ * an all-zero NMSettUtilFileId. */
+typedef struct {
+    guint64 dev;
+    guint64 ino;
+    gint64  size;
+    gint64  mtime_nsec;
+    gint64  ctime_nsec;
+} NMSettUtilFileId;
+
+void nm_sett_util_file_id_from_stat(NMSettUtilFileId *file_id, const struct stat *st);
+
+gboolean nm_sett_util_file_id_get(const char *filename, NMSettUtilFileId *out_file_id);
+
+static inline gboolean
+nm_sett_util_file_id_equal(const NMSettUtilFileId *a, const NMSettUtilFileId *b)
+{
+    return memcmp(a, b, sizeof(NMSettUtilFileId)) == 0;
+}
+
+/*****************************************************************************/
+
+typedef struct _NMSettUtilWriteQueue NMSettUtilWriteQueue;
+
+NMSettUtilWriteQueue *nm_sett_util_write_queue_new(guint commit_delay_msec);
+
+void nm_sett_util_write_queue_free(NMSettUtilWriteQueue *queue);
+
+void nm_sett_util_write_queue_add(NMSettUtilWriteQueue *queue,
+                                  const char           *filename,
+                                  GBytes               *contents);
+
+void nm_sett_util_write_queue_flush(NMSettUtilWriteQueue *queue);
+
+/* Only exposed for testing. */
+void     _nm_sett_util_write_queue_set_paused(NMSettUtilWriteQueue *queue, gboolean paused);
+gboolean _nm_sett_util_write_queue_get_in_flight(NMSettUtilWriteQueue *queue);
+
+/*****************************************************************************/
+
 typedef struct {
     const char *uuid;
 
@@ -53,6 +53,7 @@
 #include "devices/nm-device-ethernet.h"
 #include "nm-settings-connection.h"
 #include "nm-settings-plugin.h"
+#include "nm-settings-utils.h"
 #include "nm-dbus-manager.h"
 #include "nm-auth-utils.h"
 #include "libnm-core-aux-intern/nm-auth-subject.h"
@@ -374,8 +375,14 @@ typedef struct {
     NMKeyFileDB *kf_db_timestamps;
     NMKeyFileDB *kf_db_seen_bssids;
 
+    NMSettUtilWriteQueue *kf_db_write_queue;
+
     GHashTable *sce_idx;
 
+    /* Interned, sealed NMSetting instances, shared by the connections of
+     * the NMSettingsConnections. See _nm_connection_new_interned(). */
+    GHashTable *setting_intern_table;
+
     GCancellable *shutdown_cancellable;
 
     CList sce_dirty_lst_head;
@@ -1368,10 +1375,11 @@ _connection_changed_track(NMSettings        *self,
                           NMConnection      *connection,
                           gboolean           prioritize)
 {
-    NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE(self);
-    SettConnEntry     *sett_conn_entry;
-    StorageData       *sd;
-    const char        *uuid;
+    NMSettingsPrivate            *priv                = NM_SETTINGS_GET_PRIVATE(self);
+    gs_unref_object NMConnection *connection_interned = NULL;
+    SettConnEntry                *sett_conn_entry;
+    StorageData                  *sd;
+    const char                   *uuid;
 
     nm_assert_valid_settings_storage(NULL, storage);
 
@@ -1382,6 +1390,14 @@ _connection_changed_track(NMSettings        *self,
               || (_nm_connection_verify(connection, NULL) == NM_SETTING_VERIFY_SUCCESS));
     nm_assert(!connection || nm_streq0(uuid, nm_connection_get_uuid(connection)));
 
+    if (connection) {
+        /* The StorageData keeps the interned connection. That is also what the
+         * NMSettingsConnection ends up with, so only one copy of the profile
+         * stays alive. */
+        connection_interned = _nm_connection_new_interned(connection, priv->setting_intern_table);
+        connection = connection_interned;
+    }
+
     nm_assert_connection_unchanging(connection);
 
     sett_conn_entry =
@@ -2834,36 +2850,28 @@ impl_settings_add_connection_unsaved(NMDBusObject                      *obj,
                                    NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY);
 }
 
-static void
-impl_settings_add_connection2(NMDBusObject                      *obj,
-                              const NMDBusInterfaceInfoExtended *interface_info,
-                              const NMDBusMethodInfoExtended    *method_info,
-                              GDBusConnection                   *connection,
-                              const char                        *sender,
-                              GDBusMethodInvocation             *invocation,
-                              GVariant                          *parameters)
+static gboolean
+_add_connection2_parse_args(guint32                        flags_u,
+                            GVariant                      *args,
+                            NMSettingsAddConnection2Flags *out_flags,
+                            char                         **out_plugin,
+                            GError                       **error)
 {
-    NMSettings                   *self     = NM_SETTINGS(obj);
-    gs_unref_variant GVariant    *settings = NULL;
-    gs_unref_variant GVariant    *args     = NULL;
-    gs_free char                 *plugin   = NULL;
+    gs_free char                 *plugin = NULL;
     NMSettingsAddConnection2Flags flags;
     const char                   *args_name;
     GVariant                     *args_value;
     GVariantIter                  iter;
-    guint32                       flags_u;
-
-    g_variant_get(parameters, "(@a{sa{sv}}u@a{sv})", &settings, &flags_u, &args);
 
     if (NM_FLAGS_ANY(flags_u,
                      ~((guint32) (NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
                                   | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY
                                   | NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)))) {
-        g_dbus_method_invocation_take_error(invocation,
-                                            g_error_new_literal(NM_SETTINGS_ERROR,
-                                                                NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-                                                                "Unknown flags"));
-        return;
+        g_set_error_literal(error,
+                            NM_SETTINGS_ERROR,
+                            NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                            "Unknown flags");
+        return FALSE;
     }
 
     flags = flags_u;
@@ -2871,40 +2879,69 @@ impl_settings_add_connection2(NMDBusObject                      *obj,
     if (!NM_FLAGS_ANY(flags,
                       NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
                           | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
-        g_dbus_method_invocation_take_error(
-            invocation,
-            g_error_new_literal(NM_SETTINGS_ERROR,
-                                NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-                                "Requires either to-disk (0x1) or in-memory (0x2) flags"));
-        return;
+        g_set_error_literal(error,
+                            NM_SETTINGS_ERROR,
+                            NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                            "Requires either to-disk (0x1) or in-memory (0x2) flags");
+        return FALSE;
     }
 
     if (NM_FLAGS_ALL(flags,
                      NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
                          | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
-        g_dbus_method_invocation_take_error(
-            invocation,
-            g_error_new_literal(NM_SETTINGS_ERROR,
-                                NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-                                "Cannot set to-disk (0x1) and in-memory (0x2) flags together"));
-        return;
+        g_set_error_literal(error,
+                            NM_SETTINGS_ERROR,
+                            NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                            "Cannot set to-disk (0x1) and in-memory (0x2) flags together");
+        return FALSE;
     }
 
     nm_assert(g_variant_is_of_type(args, G_VARIANT_TYPE("a{sv}")));
 
     g_variant_iter_init(&iter, args);
     while (g_variant_iter_next(&iter, "{&sv}", &args_name, &args_value)) {
+        gs_unref_variant GVariant *args_value_free = args_value;
+
         if (plugin == NULL && nm_streq(args_name, "plugin")
             && g_variant_is_of_type(args_value, G_VARIANT_TYPE_STRING)) {
             plugin = g_variant_dup_string(args_value, NULL);
             continue;
         }
 
-        g_dbus_method_invocation_take_error(invocation,
-                                            g_error_new(NM_SETTINGS_ERROR,
-                                                        NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-                                                        "Unsupported argument '%s'",
-                                                        args_name));
+        g_set_error(error,
+                    NM_SETTINGS_ERROR,
+                    NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                    "Unsupported argument '%s'",
+                    args_name);
+        return FALSE;
+    }
+
+    *out_flags  = flags;
+    *out_plugin = g_steal_pointer(&plugin);
+    return TRUE;
+}
+
+static void
+impl_settings_add_connection2(NMDBusObject                      *obj,
+                              const NMDBusInterfaceInfoExtended *interface_info,
+                              const NMDBusMethodInfoExtended    *method_info,
+                              GDBusConnection                   *connection,
+                              const char                        *sender,
+                              GDBusMethodInvocation             *invocation,
+                              GVariant                          *parameters)
+{
+    NMSettings                   *self     = NM_SETTINGS(obj);
+    gs_unref_variant GVariant    *settings = NULL;
+    gs_unref_variant GVariant    *args     = NULL;
+    gs_free char                 *plugin   = NULL;
+    GError                       *error    = NULL;
+    NMSettingsAddConnection2Flags flags;
+    guint32                       flags_u;
+
+    g_variant_get(parameters, "(@a{sa{sv}}u@a{sv})", &settings, &flags_u, &args);
+
+    if (!_add_connection2_parse_args(flags_u, args, &flags, &plugin, &error)) {
+        g_dbus_method_invocation_take_error(invocation, error);
         return;
     }
 
@@ -2913,6 +2950,258 @@ impl_settings_add_connection2(NMDBusObject                      *obj,
 
 /*****************************************************************************/
 
+static void
+pk_add_many_cb(NMAuthChain *chain, GDBusMethodInvocation *context, gpointer user_data)
+{
+    NMSettings                     *self        = NM_SETTINGS(user_data);
+    gs_unref_ptrarray GPtrArray    *added       = NULL;
+    gs_free_error GError           *error       = NULL;
+    GPtrArray                      *connections = NULL;
+    NMAuthSubject                  *subject;
+    const char                     *perm;
+    const char                     *plugin;
+    NMSettingsConnectionPersistMode persist_mode;
+    NMSettingsConnectionAddReason   add_reason;
+    GVariantBuilder                 builder_paths;
+    GVariantBuilder                 builder_result;
+    guint                           i;
+
+    nm_assert(G_IS_DBUS_METHOD_INVOCATION(context));
+
+    c_list_unlink(nm_auth_chain_parent_lst_list(chain));
+
+    perm    = nm_auth_chain_get_data(chain, "perm");
+    subject = nm_auth_chain_get_data(chain, "subject");
+
+    if (nm_auth_chain_get_result(chain, perm) != NM_AUTH_CALL_RESULT_YES) {
+        g_dbus_method_invocation_return_error_literal(context,
+                                                      NM_SETTINGS_ERROR,
+                                                      NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_INSUFF_PRIV);
+        nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD,
+                                   NULL,
+                                   FALSE,
+                                   NULL,
+                                   subject,
+                                   NM_UTILS_ERROR_MSG_INSUFF_PRIV);
+        return;
+    }
+
+    connections  = nm_auth_chain_get_data(chain, "connections");
+    plugin       = nm_auth_chain_get_data(chain, "plugin");
+    persist_mode = GPOINTER_TO_UINT(nm_auth_chain_get_data(chain, "persist-mode"));
+    add_reason   = GPOINTER_TO_UINT(nm_auth_chain_get_data(chain, "add-reason"));
+
+    added = g_ptr_array_new_full(connections->len, g_object_unref);
+
+    /* While adding the profiles, only notify about the "Connections" property once. */
+    g_object_freeze_notify(G_OBJECT(self));
+
+    for (i = 0; i < connections->len; i++) {
+        NMConnection         *connection = connections->pdata[i];
+        NMSettingsConnection *sett_conn;
+
+        if (!nm_settings_add_connection(self,
+                                        plugin,
+                                        connection,
+                                        persist_mode,
+                                        add_reason,
+                                        NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+                                        &sett_conn,
+                                        &error)) {
+            g_prefix_error(&error,
+                           "connection #%u (%s): ",
+                           i,
+                           nm_connection_get_uuid(connection));
+            break;
+        }
+
+        g_ptr_array_add(added, g_object_ref(sett_conn));
+    }
+
+    if (error) {
+        /* Remove what this call added so far. These profiles were already
+         * announced, so this is not atomic for D-Bus clients. */
+        for (i = added->len; i > 0; i--) {
+            NMSettingsConnection *sett_conn = added->pdata[i - 1];
+
+            if (nm_settings_has_connection(self, sett_conn))
+                nm_settings_connection_delete(sett_conn, FALSE);
+        }
+        g_object_thaw_notify(G_OBJECT(self));
+
+        g_dbus_method_invocation_return_gerror(context, error);
+        nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD,
+                                   NULL,
+                                   FALSE,
+                                   NULL,
+                                   subject,
+                                   error->message);
+        return;
+    }
+
+    g_object_thaw_notify(G_OBJECT(self));
+
+    g_variant_builder_init(&builder_paths, G_VARIANT_TYPE("ao"));
+    for (i = 0; i < added->len; i++) {
+        NMSettingsConnection *sett_conn = added->pdata[i];
+
+        g_variant_builder_add(&builder_paths,
+                              "o",
+                              nm_dbus_object_get_path(NM_DBUS_OBJECT(sett_conn)));
+    }
+    g_variant_builder_init(&builder_result, G_VARIANT_TYPE_VARDICT);
+    g_dbus_method_invocation_return_value(context,
+                                          g_variant_new("(aoa{sv})",
+                                                        &builder_paths,
+                                                        &builder_result));
+
+    for (i = 0; i < added->len; i++) {
+        NMSettingsConnection *sett_conn = added->pdata[i];
+
+        nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD, sett_conn, TRUE, NULL, subject, NULL);
+
+        /* Send agent-owned secrets to the agents */
+        if (nm_settings_has_connection(self, sett_conn))
+            send_agent_owned_secrets(self, sett_conn, subject);
+    }
+}
+
+static void
+impl_settings_add_connections(NMDBusObject                      *obj,
+                              const NMDBusInterfaceInfoExtended *interface_info,
+                              const NMDBusMethodInfoExtended    *method_info,
+                              GDBusConnection                   *dbus_connection,
+                              const char                        *sender,
+                              GDBusMethodInvocation             *invocation,
+                              GVariant                          *parameters)
+{
+    NMSettings                     *self        = NM_SETTINGS(obj);
+    NMSettingsPrivate              *priv        = NM_SETTINGS_GET_PRIVATE(self);
+    gs_unref_variant GVariant      *settings    = NULL;
+    gs_unref_variant GVariant      *args        = NULL;
+    gs_free char                   *plugin      = NULL;
+    gs_unref_object NMAuthSubject  *subject     = NULL;
+    gs_unref_ptrarray GPtrArray    *connections = NULL;
+    gs_unref_hashtable GHashTable  *uuids       = NULL;
+    GError                         *error       = NULL;
+    NMSettingsAddConnection2Flags   flags;
+    NMSettingsConnectionPersistMode persist_mode;
+    NMSettingsConnectionAddReason   add_reason;
+    const char                     *perm        = NM_AUTH_PERMISSION_SETTINGS_MODIFY_OWN;
+    NMAuthChain                    *chain;
+    GVariantIter                    iter;
+    GVariant                       *setting_dict;
+    guint32                         flags_u;
+    guint                           i;
+
+    g_variant_get(parameters, "(@aa{sa{sv}}u@a{sv})", &settings, &flags_u, &args);
+
+    if (!_add_connection2_parse_args(flags_u, args, &flags, &plugin, &error))
+        goto out_error;
+
+    subject = nm_dbus_manager_new_auth_subject_from_context(invocation);
+    if (!subject) {
+        g_set_error_literal(&error,
+                            NM_SETTINGS_ERROR,
+                            NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                            NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
+        goto out_error;
+    }
+
+    /* All profiles are parsed and checked before we ask for authorization (once),
+     * so that we don't add half of them and fail on the rest. */
+    connections = g_ptr_array_new_full(g_variant_n_children(settings), g_object_unref);
+    uuids       = g_hash_table_new(nm_str_hash, g_str_equal);
+
+    i = 0;
+    g_variant_iter_init(&iter, settings);
+    while (g_variant_iter_next(&iter, "@a{sa{sv}}", &setting_dict)) {
+        gs_unref_variant GVariant    *setting_dict_free = setting_dict;
+        gs_unref_object NMConnection *connection        = NULL;
+        NMSettingConnection          *s_con;
+        const char                   *uuid;
+
+        connection =
+            _nm_simple_connection_new_from_dbus(setting_dict,
+                                                NM_SETTING_PARSE_FLAGS_STRICT
+                                                    | NM_SETTING_PARSE_FLAGS_NORMALIZE,
+                                                &error);
+        if (!connection || !nm_connection_verify_secrets(connection, &error))
+            goto out_error_connection;
+
+        if (!nm_auth_is_subject_in_acl_set_error(connection,
+                                                 subject,
+                                                 NM_SETTINGS_ERROR,
+                                                 NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                 &error))
+            goto out_error_connection;
+
+        uuid = nm_connection_get_uuid(connection);
+        if (nm_settings_get_connection_by_uuid(self, uuid)
+            || !g_hash_table_add(uuids, (char *) uuid)) {
+            g_set_error_literal(&error,
+                                NM_SETTINGS_ERROR,
+                                NM_SETTINGS_ERROR_UUID_EXISTS,
+                                "a connection with this UUID already exists");
+            goto out_error_connection;
+        }
+
+        /* If the caller is the only user in the permissions of all connections,
+         * 'modify.own' is enough. Otherwise, require 'modify.system'. */
+        s_con = nm_connection_get_setting_connection(connection);
+        if (nm_setting_connection_get_num_permissions(s_con) != 1)
+            perm = NM_AUTH_PERMISSION_SETTINGS_MODIFY_SYSTEM;
+
+        g_ptr_array_add(connections, g_steal_pointer(&connection));
+        i++;
+        continue;
+
+out_error_connection:
+        g_prefix_error(&error, "connection #%u: ", i);
+        goto out_error;
+    }
+
+    if (connections->len == 0) {
+        g_set_error_literal(&error,
+                            NM_SETTINGS_ERROR,
+                            NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                            "No connections given");
+        goto out_error;
+    }
+
+    if (NM_FLAGS_HAS(flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK))
+        persist_mode = NM_SETTINGS_CONNECTION_PERSIST_MODE_TO_DISK;
+    else
+        persist_mode = NM_SETTINGS_CONNECTION_PERSIST_MODE_IN_MEMORY_ONLY;
+
+    if (NM_FLAGS_HAS(flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT))
+        add_reason = NM_SETTINGS_CONNECTION_ADD_REASON_BLOCK_AUTOCONNECT;
+    else
+        add_reason = NM_SETTINGS_CONNECTION_ADD_REASON_NONE;
+
+    chain = nm_auth_chain_new_subject(subject, invocation, pk_add_many_cb, self);
+
+    c_list_link_tail(&priv->auth_lst_head, nm_auth_chain_parent_lst_list(chain));
+    nm_auth_chain_set_data(chain, "perm", (gpointer) perm, NULL);
+    nm_auth_chain_set_data(chain,
+                           "connections",
+                           g_steal_pointer(&connections),
+                           (GDestroyNotify) g_ptr_array_unref);
+    nm_auth_chain_set_data(chain, "subject", g_object_ref(subject), g_object_unref);
+    nm_auth_chain_set_data(chain, "persist-mode", GUINT_TO_POINTER(persist_mode), NULL);
+    nm_auth_chain_set_data(chain, "add-reason", GUINT_TO_POINTER(add_reason), NULL);
+    nm_auth_chain_set_data(chain, "plugin", g_steal_pointer(&plugin), g_free);
+    nm_auth_chain_add_call_unsafe(chain, perm, TRUE);
+    return;
+
+out_error:
+    nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD, NULL, FALSE, NULL, subject, error->message);
+    g_dbus_method_invocation_take_error(invocation, error);
+}
+
+/*****************************************************************************/
+
 static void
 impl_settings_load_connections(NMDBusObject                      *obj,
                                const NMDBusInterfaceInfoExtended *interface_info,
@@ -3050,6 +3339,12 @@ _nm_settings_notify_sorted_by_autoconnect_priority_maybe_changed(NMSettings *sel
     priv->sorted_by_autoconnect_priority_maybe_changed = TRUE;
 }
 
+GHashTable *
+_nm_settings_get_setting_intern_table(NMSettings *self)
+{
+    return NM_SETTINGS_GET_PRIVATE(self)->setting_intern_table;
+}
+
 static void
 _clear_connections_cached_list(NMSettingsPrivate *priv)
 {
@@ -3905,6 +4200,10 @@ again:
 
 /*****************************************************************************/
 
+/* Writes of the timestamps and seen-bssids files are delayed by this long,
+ * so that changes in quick succession are written together. */
+#define KF_DB_WRITE_DELAY_MSEC 1000
+
 static gboolean
 _kf_db_prune_predicate(const char *uuid, gpointer user_data)
 {
@@ -3914,9 +4213,10 @@ _kf_db_prune_predicate(const char *uuid, gpointer user_data)
 static void
 _kf_db_to_file(NMSettings *self, gboolean is_timestamps, gboolean force_write)
 {
-    NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE(self);
-    NMKeyFileDB       *kf_db;
-    bool              *p_kf_db_pruned;
+    NMSettingsPrivate     *priv  = NM_SETTINGS_GET_PRIVATE(self);
+    gs_unref_bytes GBytes *bytes = NULL;
+    NMKeyFileDB           *kf_db;
+    bool                  *p_kf_db_pruned;
 
     if (is_timestamps) {
         kf_db          = priv->kf_db_timestamps;
@@ -3937,7 +4237,17 @@ _kf_db_to_file(NMSettings *self, gboolean is_timestamps, gboolean force_write)
         nm_key_file_db_prune_tmp_files(kf_db);
     }
 
-    nm_key_file_db_to_file(kf_db, force_write);
+    /* The write happens batched and on a worker thread, so that the main
+     * loop does not wait for the disk. */
+    bytes = nm_key_file_db_to_bytes(kf_db, force_write);
+    if (bytes) {
+        _LOGT("[%s-keyfile]: queue write of \"%s\"",
+              is_timestamps ? "timestamps" : "seen-bssids",
+              nm_key_file_db_get_filename(kf_db));
+        nm_sett_util_write_queue_add(priv->kf_db_write_queue,
+                                     nm_key_file_db_get_filename(kf_db),
+                                     bytes);
+    }
 }
 
 G_GNUC_PRINTF(4, 5)
@@ -4046,6 +4356,7 @@ nm_settings_kf_db_write(NMSettings *self)
 
     _kf_db_to_file(self, TRUE, TRUE);
     _kf_db_to_file(self, FALSE, TRUE);
+    nm_sett_util_write_queue_flush(NM_SETTINGS_GET_PRIVATE(self)->kf_db_write_queue);
 }
 
 /*****************************************************************************/
@@ -4065,6 +4376,7 @@ nm_settings_start(NMSettings *self, GError **error)
 
     priv->hostname_manager = g_object_ref(nm_hostname_manager_get());
 
+    priv->kf_db_write_queue = nm_sett_util_write_queue_new(KF_DB_WRITE_DELAY_MSEC);
     priv->kf_db_timestamps  = nm_key_file_db_new(NMSTATEDIR "/timestamps",
                                                 "timestamps",
                                                 _kf_db_log_fcn,
@@ -4206,6 +4518,8 @@ nm_settings_init(NMSettings *self)
                                           NULL,
                                           (GDestroyNotify) _sett_conn_entry_free);
 
+    priv->setting_intern_table = _nm_setting_intern_table_new();
+
     priv->config = g_object_ref(nm_config_get());
 
     priv->agent_mgr = g_object_ref(nm_agent_manager_get());
@@ -4283,6 +4597,8 @@ finalize(GObject *object)
 
     nm_clear_pointer(&priv->sce_idx, g_hash_table_destroy);
 
+    nm_clear_pointer(&priv->setting_intern_table, _nm_setting_intern_table_destroy);
+
     g_slist_free_full(priv->unmanaged_specs, g_free);
     g_slist_free_full(priv->unrecognized_specs, g_free);
 
@@ -4301,6 +4617,7 @@ finalize(GObject *object)
     nm_clear_g_source_inst(&priv->kf_db_flush_idle_source_seen_bssids);
     _kf_db_to_file(self, TRUE, FALSE);
     _kf_db_to_file(self, FALSE, FALSE);
+    nm_sett_util_write_queue_free(g_steal_pointer(&priv->kf_db_write_queue));
     nm_key_file_db_destroy(priv->kf_db_timestamps);
     nm_key_file_db_destroy(priv->kf_db_seen_bssids);
 
@@ -4368,6 +4685,17 @@ static const NMDBusInterfaceInfoExtended interface_info_settings = {
                         NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("path", "o"),
                                                   NM_DEFINE_GDBUS_ARG_INFO("result", "a{sv}"), ), ),
                 .handle = impl_settings_add_connection2, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "AddConnections",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("settings", "aa{sa{sv}}"),
+                        NM_DEFINE_GDBUS_ARG_INFO("flags", "u"),
+                        NM_DEFINE_GDBUS_ARG_INFO("args", "a{sv}"), ),
+                    .out_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("paths", "ao"),
+                                                  NM_DEFINE_GDBUS_ARG_INFO("result", "a{sv}"), ), ),
+                .handle = impl_settings_add_connections, ),
             NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
                 NM_DEFINE_GDBUS_METHOD_INFO_INIT(
                     "LoadConnections",
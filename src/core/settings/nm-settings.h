@@ -137,4 +137,6 @@ void nm_settings_kf_db_write(NMSettings *settings);
 
 void _nm_settings_notify_sorted_by_autoconnect_priority_maybe_changed(NMSettings *self);
 
+GHashTable *_nm_settings_get_setting_intern_table(NMSettings *self);
+
 #endif /* __NM_SETTINGS_H__ */
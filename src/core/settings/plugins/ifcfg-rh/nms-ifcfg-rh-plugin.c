@@ -52,6 +52,10 @@ typedef struct {
 
     GHashTable *unmanaged_specs;
     GHashTable *unrecognized_specs;
+
+    /* the reader also looks at the global network file. If it changes,
+     * a reload re-reads all profiles. */
+    NMSettUtilFileId network_file_id;
 } NMSIfcfgRHPluginPrivate;
 
 struct _NMSIfcfgRHPlugin {
@@ -173,6 +177,26 @@ nm_assert_self(NMSIfcfgRHPlugin *self, gboolean unhandled_specs_consistent)
 
 /*****************************************************************************/
 
+#define NETWORK_FILE SYSCONFDIR "/sysconfig/network"
+
+static NMSIfcfgRHStorage *
+_load_file_lookup_unchanged(NMSIfcfgRHPlugin *self, const char *filename)
+{
+    NMSIfcfgRHPluginPrivate *priv = NMS_IFCFG_RH_PLUGIN_GET_PRIVATE(self);
+    NMSIfcfgRHStorage       *storage;
+    NMSettUtilFileId         file_ids[NMS_IFCFG_RH_UTILS_N_FILE_IDS];
+
+    storage = nm_sett_util_storages_lookup_by_filename(&priv->storages, filename);
+    if (!storage || storage->maybe_has_aliases)
+        return NULL;
+
+    if (!nms_ifcfg_rh_utils_file_ids_get(filename, NULL, file_ids)
+        || memcmp(file_ids, storage->file_ids, sizeof(file_ids)) != 0)
+        return NULL;
+
+    return storage;
+}
+
 static NMSIfcfgRHStorage *
 _load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
 {
@@ -182,6 +206,7 @@ _load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
     gs_free char                 *unhandled_spec = NULL;
     gboolean                      load_error_ignore;
     struct stat                   st;
+    NMSettUtilFileId              file_ids[NMS_IFCFG_RH_UTILS_N_FILE_IDS];
 
     if (stat(filename, &st) != 0) {
         int errsv = errno;
@@ -193,6 +218,10 @@ _load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
         return NULL;
     }
 
+    /* get the file-ids before reading. If a file gets modified while we read it,
+     * the next reload sees a different file-id and reads it again. */
+    nms_ifcfg_rh_utils_file_ids_get(filename, &st, file_ids);
+
     connection = connection_from_file(filename, &unhandled_spec, &load_error, &load_error_ignore);
     if (load_error) {
         if (error) {
@@ -233,16 +262,23 @@ _load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
                                                   &st.st_mtim);
     }
 
+    memcpy(ret->file_ids, file_ids, sizeof(file_ids));
+
+    /* we don't know about alias files here. _load_dir() does. */
+    ret->maybe_has_aliases = TRUE;
     return ret;
 }
 
 static void
-_load_dir(NMSIfcfgRHPlugin *self, NMSettUtilStorages *storages)
+_load_dir(NMSIfcfgRHPlugin *self, NMSettUtilStorages *storages, GHashTable *storages_unchanged)
 {
     gs_unref_hashtable GHashTable *dupl_filenames = NULL;
+    gs_unref_hashtable GHashTable *with_aliases   = NULL;
+    gs_unref_ptrarray GPtrArray   *filenames      = NULL;
     gs_free_error GError          *local          = NULL;
     const char                    *f_filename;
     GDir                          *dir;
+    guint                          i;
 
     dir = g_dir_open(IFCFG_DIR, 0, &local);
     if (!dir) {
@@ -250,28 +286,63 @@ _load_dir(NMSIfcfgRHPlugin *self, NMSettUtilStorages *storages)
         return;
     }
 
-    dupl_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, g_free);
+    /* keep the order of the directory listing, so that the profiles are always
+     * visited in the same order. */
+    filenames      = g_ptr_array_new_with_free_func(g_free);
+    dupl_filenames = g_hash_table_new(nm_str_hash, g_str_equal);
+    with_aliases   = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
 
     while ((f_filename = g_dir_read_name(dir))) {
-        gs_free char      *full_path = NULL;
-        NMSIfcfgRHStorage *storage;
-        char              *full_filename;
+        gs_free char *full_path     = NULL;
+        char         *full_filename = NULL;
+
+        if (utils_is_ifcfg_alias_file(f_filename, NULL)) {
+            /* the reader also reads the alias files of an ifcfg file. We don't
+             * track them, so always re-read such profiles. */
+            g_hash_table_add(with_aliases,
+                             g_strdup_printf("%s/%.*s",
+                                             IFCFG_DIR,
+                                             (int) (strrchr(f_filename, ':') - f_filename),
+                                             f_filename));
+        }
 
         full_path     = g_build_filename(IFCFG_DIR, f_filename, NULL);
         full_filename = utils_detect_ifcfg_path(full_path, TRUE);
         if (!full_filename)
             continue;
 
-        if (!g_hash_table_add(dupl_filenames, full_filename))
+        if (!g_hash_table_add(dupl_filenames, full_filename)) {
+            g_free(full_filename);
             continue;
+        }
+        g_ptr_array_add(filenames, full_filename);
+    }
+    g_dir_close(dir);
+
+    for (i = 0; i < filenames->len; i++) {
+        const char        *full_filename = filenames->pdata[i];
+        gboolean           has_aliases   = g_hash_table_contains(with_aliases, full_filename);
+        NMSIfcfgRHStorage *storage;
 
         nm_assert(!nm_sett_util_storages_lookup_by_filename(storages, full_filename));
 
+        /* a profile that had alias files when we read it, or has them now,
+         * is always re-read. Otherwise, a removed alias file would go
+         * unnoticed. */
+        if (storages_unchanged && !has_aliases) {
+            storage = _load_file_lookup_unchanged(self, full_filename);
+            if (storage) {
+                g_hash_table_add(storages_unchanged, storage);
+                continue;
+            }
+        }
+
         storage = _load_file(self, full_filename, NULL);
-        if (storage)
+        if (storage) {
+            storage->maybe_has_aliases = has_aliases;
             nm_sett_util_storages_add_take(storages, storage);
+        }
     }
-    g_dir_close(dir);
 }
 
 static void
@@ -279,6 +350,7 @@ _storages_consolidate(NMSIfcfgRHPlugin                      *self,
                       NMSettUtilStorages                    *storages_new,
                       gboolean                               replace_all,
                       GHashTable                            *storages_replaced,
+                      GHashTable                            *storages_unchanged,
                       NMSettingsPluginConnectionLoadCallback callback,
                       gpointer                               user_data)
 {
@@ -304,8 +376,12 @@ _storages_consolidate(NMSIfcfgRHPlugin                      *self,
     storages_modified = g_ptr_array_new_with_free_func(g_object_unref);
     c_list_init(&storages_deleted);
 
-    c_list_for_each_entry (storage_old, &priv->storages._storage_lst_head, parent._storage_lst)
-        storage_old->dirty = TRUE;
+    /* Storages in @storages_unchanged were not read again, because their files
+     * did not change. They are kept as they are and no event is raised. */
+    c_list_for_each_entry (storage_old, &priv->storages._storage_lst_head, parent._storage_lst) {
+        storage_old->dirty =
+            !storages_unchanged || !g_hash_table_contains(storages_unchanged, storage_old);
+    }
 
     c_list_for_each_entry_safe (storage_new,
                                 storage_safe,
@@ -540,7 +616,13 @@ load_connections(NMSettingsPlugin                      *plugin,
     nm_clear_pointer(&loaded_uuids, g_hash_table_destroy);
     nm_clear_pointer(&dupl_filenames, g_hash_table_destroy);
 
-    _storages_consolidate(self, &storages_new, FALSE, storages_replaced, callback, user_data);
+    _storages_consolidate(self,
+                          &storages_new,
+                          FALSE,
+                          storages_replaced,
+                          NULL,
+                          callback,
+                          user_data);
 }
 
 static void
@@ -548,15 +630,34 @@ reload_connections(NMSettingsPlugin                      *plugin,
                    NMSettingsPluginConnectionLoadCallback callback,
                    gpointer                               user_data)
 {
-    NMSIfcfgRHPlugin                                   *self = NMS_IFCFG_RH_PLUGIN(plugin);
+    NMSIfcfgRHPlugin        *self = NMS_IFCFG_RH_PLUGIN(plugin);
+    NMSIfcfgRHPluginPrivate *priv = NMS_IFCFG_RH_PLUGIN_GET_PRIVATE(self);
     nm_auto_clear_sett_util_storages NMSettUtilStorages storages_new =
         NM_SETT_UTIL_STORAGES_INIT(storages_new, nms_ifcfg_rh_storage_destroy);
+    gs_unref_hashtable GHashTable *storages_unchanged = NULL;
+    NMSettUtilFileId               network_file_id;
 
     nm_assert_self(self, TRUE);
 
-    _load_dir(self, &storages_new);
+    nm_sett_util_file_id_get(NETWORK_FILE, &network_file_id);
+    if (nm_sett_util_file_id_equal(&network_file_id, &priv->network_file_id))
+        storages_unchanged = g_hash_table_new(nm_direct_hash, NULL);
+    else
+        priv->network_file_id = network_file_id;
+
+    _load_dir(self, &storages_new, storages_unchanged);
+
+    _LOGD("reload: %u files unchanged, %u files read",
+          storages_unchanged ? g_hash_table_size(storages_unchanged) : 0u,
+          g_hash_table_size(storages_new.idx_by_filename));
 
-    _storages_consolidate(self, &storages_new, TRUE, NULL, callback, user_data);
+    _storages_consolidate(self,
+                          &storages_new,
+                          TRUE,
+                          NULL,
+                          storages_unchanged,
+                          callback,
+                          user_data);
 
     nm_assert_self(self, FALSE);
 }
@@ -634,6 +735,9 @@ add_connection(NMSettingsPlugin   *plugin,
                                             full_filename,
                                             g_steal_pointer(&reread),
                                             nm_sett_util_stat_mtime(full_filename, FALSE, &mtime));
+    nms_ifcfg_rh_utils_file_ids_get(full_filename, NULL, storage->file_ids);
+    /* the writer does not know about alias files. Check on the next reload. */
+    storage->maybe_has_aliases = TRUE;
 
     nm_sett_util_storages_add_take(&priv->storages, g_object_ref(storage));
 
@@ -706,6 +810,9 @@ update_connection(NMSettingsPlugin   *plugin,
           nm_connection_get_id(connection));
 
     storage->stat_mtime = *nm_sett_util_stat_mtime(full_filename, FALSE, &mtime);
+    nms_ifcfg_rh_utils_file_ids_get(full_filename, NULL, storage->file_ids);
+    /* the writer does not know about alias files. Check on the next reload. */
+    storage->maybe_has_aliases = TRUE;
 
     *out_storage    = NM_SETTINGS_STORAGE(g_object_ref(storage));
     *out_connection = g_steal_pointer(&reread);
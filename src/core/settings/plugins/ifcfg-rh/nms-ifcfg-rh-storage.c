@@ -50,6 +50,8 @@ nms_ifcfg_rh_storage_copy_content(NMSIfcfgRHStorage *dst, const NMSIfcfgRHStorag
     dst->unmanaged_spec    = g_strdup(src->unmanaged_spec);
     dst->unrecognized_spec = g_strdup(src->unrecognized_spec);
     dst->stat_mtime        = src->stat_mtime;
+    memcpy(dst->file_ids, src->file_ids, sizeof(dst->file_ids));
+    dst->maybe_has_aliases = src->maybe_has_aliases;
 }
 
 NMConnection *
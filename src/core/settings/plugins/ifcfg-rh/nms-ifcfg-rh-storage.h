@@ -8,6 +8,7 @@
 
 #include "c-list/src/c-list.h"
 #include "settings/nm-settings-storage.h"
+#include "nms-ifcfg-rh-utils.h"
 
 /*****************************************************************************/
 
@@ -34,8 +35,17 @@ typedef struct {
      * higher priority. */
     struct timespec stat_mtime;
 
+    /* identifies the files as we read them. On reload, a profile whose
+     * files are all unchanged is not read again. */
+    NMSettUtilFileId file_ids[NMS_IFCFG_RH_UTILS_N_FILE_IDS];
+
     bool dirty : 1;
 
+    /* whether there were alias files (ifcfg-eth0:1) when we read the profile, or
+     * we don't know. The reader merges them into the profile, but they are not
+     * part of @file_ids, so such a profile is always re-read. */
+    bool maybe_has_aliases : 1;
+
 } NMSIfcfgRHStorage;
 
 typedef struct _NMSIfcfgRHStorageClass NMSIfcfgRHStorageClass;
@@ -398,6 +398,50 @@ utils_detect_ifcfg_path(const char *path, gboolean only_ifcfg)
     return utils_get_ifcfg_path(path);
 }
 
+/**
+ * nms_ifcfg_rh_utils_file_ids_get:
+ * @filename: the ifcfg file
+ * @st: (allow-none): the stat() result of @filename, if already known.
+ * @file_ids: an array of %NMS_IFCFG_RH_UTILS_N_FILE_IDS ids to fill.
+ *
+ * Gets the ids of the ifcfg file and of its keys-, route- and route6-
+ * files. Files that don't exist get an all-zero id. If any of the ids
+ * changes, the profile must be read again.
+ *
+ * Returns: %FALSE if @filename itself could not be stat'ed.
+ */
+gboolean
+nms_ifcfg_rh_utils_file_ids_get(const char        *filename,
+                                const struct stat *st,
+                                NMSettUtilFileId  *file_ids)
+{
+    char *(*const get_path_fcns[])(const char *) = {
+        utils_get_keys_path,
+        utils_get_route_path,
+        utils_get_route6_path,
+    };
+    guint i;
+
+    G_STATIC_ASSERT(1 + G_N_ELEMENTS(get_path_fcns) == NMS_IFCFG_RH_UTILS_N_FILE_IDS);
+
+    if (st)
+        nm_sett_util_file_id_from_stat(&file_ids[0], st);
+    else if (!nm_sett_util_file_id_get(filename, &file_ids[0]))
+        return FALSE;
+
+    for (i = 0; i < G_N_ELEMENTS(get_path_fcns); i++) {
+        gs_free char *path = NULL;
+
+        path = get_path_fcns[i](filename);
+        if (path)
+            nm_sett_util_file_id_get(path, &file_ids[i + 1]);
+        else
+            file_ids[i + 1] = (NMSettUtilFileId){};
+    }
+    return TRUE;
+}
+
+
 /*****************************************************************************/
 
 const char *const _nm_ethtool_ifcfg_names[] = {
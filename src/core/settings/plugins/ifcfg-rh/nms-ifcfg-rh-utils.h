@@ -9,6 +9,7 @@
 #include "nm-connection.h"
 #include "libnm-base/nm-ethtool-base.h"
 
+#include "settings/nm-settings-utils.h"
 #include "shvar.h"
 
 /*****************************************************************************/
@@ -91,6 +92,15 @@ gboolean utils_is_ifcfg_alias_file(const char *alias, const char *ifcfg);
 
 char *utils_detect_ifcfg_path(const char *path, gboolean only_ifcfg);
 
+/* the ifcfg file itself and its keys-, route- and route6- files. */
+#define NMS_IFCFG_RH_UTILS_N_FILE_IDS 4
+
+struct stat;
+
+gboolean nms_ifcfg_rh_utils_file_ids_get(const char        *filename,
+                                         const struct stat *st,
+                                         NMSettUtilFileId  *file_ids);
+
 void     nms_ifcfg_rh_utils_user_key_encode(const char *key, GString *str_buffer);
 gboolean nms_ifcfg_rh_utils_user_key_decode(const char *name, GString *str_buffer);
 
@@ -10466,6 +10466,41 @@ test_ethtool_names(void)
 
 /*****************************************************************************/
 
+static void
+test_file_ids(void)
+{
+    nmtst_auto_unlinkfile char *filename  = g_strdup(TEST_SCRATCH_DIR_TMP "/ifcfg-file-ids");
+    nmtst_auto_unlinkfile char *routefile = g_strdup(TEST_SCRATCH_DIR_TMP "/route-file-ids");
+    NMSettUtilFileId            file_ids[NMS_IFCFG_RH_UTILS_N_FILE_IDS];
+    NMSettUtilFileId            file_ids2[NMS_IFCFG_RH_UTILS_N_FILE_IDS];
+
+    nmtst_file_unlink_if_exists(filename);
+    nmtst_file_unlink_if_exists(routefile);
+
+    g_assert(!nms_ifcfg_rh_utils_file_ids_get(filename, NULL, file_ids));
+
+    nmtst_file_set_contents(filename, "DEVICE=eth0\n");
+    g_assert(nms_ifcfg_rh_utils_file_ids_get(filename, NULL, file_ids));
+
+    /* an unchanged file keeps its ids, so a reload skips it. */
+    g_assert(nms_ifcfg_rh_utils_file_ids_get(filename, NULL, file_ids2));
+    g_assert(memcmp(file_ids, file_ids2, sizeof(file_ids)) == 0);
+
+    /* a modified file gets re-read. */
+    nmtst_file_set_contents(filename, "DEVICE=eth0\nONBOOT=no\n");
+    g_assert(nms_ifcfg_rh_utils_file_ids_get(filename, NULL, file_ids2));
+    g_assert(memcmp(file_ids, file_ids2, sizeof(file_ids)) != 0);
+    memcpy(file_ids, file_ids2, sizeof(file_ids));
+
+    /* ... and so does a profile that got a route file. */
+    nmtst_file_set_contents(routefile, "ADDRESS0=10.0.0.0\nNETMASK0=255.0.0.0\n");
+    g_assert(nms_ifcfg_rh_utils_file_ids_get(filename, NULL, file_ids2));
+    g_assert(memcmp(file_ids, file_ids2, sizeof(file_ids)) != 0);
+    g_assert(memcmp(&file_ids[0], &file_ids2[0], sizeof(file_ids[0])) == 0);
+}
+
+/*****************************************************************************/
+
 #define TPATH "/settings/plugins/ifcfg-rh/"
 
 #define TEST_IFCFG_WIFI_OPEN_SSID_LONG_QUOTED \
@@ -10962,6 +10997,7 @@ main(int argc, char **argv)
                     test_utils_has_route_file_new_syntax);
 
     g_test_add_func(TPATH "utils/test_ethtool_names", test_ethtool_names);
+    g_test_add_func(TPATH "utils/test_file_ids", test_file_ids);
 
     return g_test_run();
 }
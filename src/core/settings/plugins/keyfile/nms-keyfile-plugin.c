@@ -300,6 +300,7 @@ _load_file(NMSKeyfilePlugin     *self,
 {
     NMSKeyfilePluginPrivate      *priv;
     gs_unref_object NMConnection *connection = NULL;
+    NMSKeyfileStorage            *storage;
     NMTernary                     is_nm_generated_opt;
     NMTernary                     is_volatile_opt;
     NMTernary                     is_external_opt;
@@ -388,16 +389,21 @@ _load_file(NMSKeyfilePlugin     *self,
         return NULL;
     }
 
-    return nms_keyfile_storage_new_connection(self,
-                                              g_steal_pointer(&connection),
-                                              full_filename,
-                                              storage_type,
-                                              is_nm_generated_opt,
-                                              is_volatile_opt,
-                                              is_external_opt,
-                                              shadowed_storage,
-                                              shadowed_owned_opt,
-                                              &st.st_mtim);
+    storage = nms_keyfile_storage_new_connection(self,
+                                                 g_steal_pointer(&connection),
+                                                 full_filename,
+                                                 storage_type,
+                                                 is_nm_generated_opt,
+                                                 is_volatile_opt,
+                                                 is_external_opt,
+                                                 shadowed_storage,
+                                                 shadowed_owned_opt,
+                                                 &st.st_mtim);
+
+    /* @st is from before reading the file. If the file gets modified while we
+     * read it, the next reload sees a different file-id and reads it again. */
+    nm_sett_util_file_id_from_stat(&storage->u.conn_data.file_id, &st);
+    return storage;
 }
 
 static NMSKeyfileStorage *
@@ -418,11 +424,40 @@ _load_file_from_path(NMSKeyfilePlugin     *self,
     return _load_file(self, f_dirname, f_filename, storage_type, error);
 }
 
+static NMSKeyfileStorage *
+_load_file_lookup_unchanged(NMSKeyfilePlugin     *self,
+                            const char           *dirname,
+                            const char           *filename,
+                            NMSKeyfileStorageType storage_type)
+{
+    NMSKeyfilePluginPrivate *priv          = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+    gs_free char            *full_filename = NULL;
+    NMSKeyfileStorage       *storage;
+    NMSettUtilFileId         file_id;
+
+    /* .nmmeta files are tiny symlinks, we always re-read them. */
+    if (_ignore_filename(storage_type, filename))
+        return NULL;
+
+    full_filename = g_build_filename(dirname, filename, NULL);
+
+    storage = nm_sett_util_storages_lookup_by_filename(&priv->storages, full_filename);
+    if (!storage || storage->is_meta_data || storage->storage_type != storage_type)
+        return NULL;
+
+    if (!nm_sett_util_file_id_get(full_filename, &file_id)
+        || !nm_sett_util_file_id_equal(&file_id, &storage->u.conn_data.file_id))
+        return NULL;
+
+    return storage;
+}
+
 static void
 _load_dir(NMSKeyfilePlugin     *self,
           NMSKeyfileStorageType storage_type,
           const char           *dirname,
-          NMSettUtilStorages   *storages)
+          NMSettUtilStorages   *storages,
+          GHashTable           *storages_unchanged)
 {
     const char                    *filename;
     GDir                          *dir;
@@ -441,6 +476,16 @@ _load_dir(NMSKeyfilePlugin     *self,
         if (!g_hash_table_add(dupl_filenames, (char *) filename))
             continue;
 
+        if (storages_unchanged) {
+            NMSKeyfileStorage *storage_old;
+
+            storage_old = _load_file_lookup_unchanged(self, dirname, filename, storage_type);
+            if (storage_old) {
+                g_hash_table_add(storages_unchanged, storage_old);
+                continue;
+            }
+        }
+
         storage = _load_file(self, dirname, filename, storage_type, NULL);
         if (!storage)
             continue;
@@ -467,6 +512,7 @@ _storages_consolidate(NMSKeyfilePlugin                      *self,
                       NMSettUtilStorages                    *storages_new,
                       gboolean                               replace_all,
                       GHashTable                            *storages_replaced,
+                      GHashTable                            *storages_unchanged,
                       NMSettingsPluginConnectionLoadCallback callback,
                       gpointer                               user_data)
 {
@@ -483,8 +529,12 @@ _storages_consolidate(NMSKeyfilePlugin                      *self,
     storages_modified = g_ptr_array_new_with_free_func(g_object_unref);
     c_list_init(&storages_deleted);
 
-    c_list_for_each_entry (storage_old, &priv->storages._storage_lst_head, parent._storage_lst)
-        storage_old->is_dirty = TRUE;
+    /* Storages in @storages_unchanged were not read again, because the file
+     * did not change. They are kept as they are and no event is raised. */
+    c_list_for_each_entry (storage_old, &priv->storages._storage_lst_head, parent._storage_lst) {
+        storage_old->is_dirty =
+            !storages_unchanged || !g_hash_table_contains(storages_unchanged, storage_old);
+    }
 
     c_list_for_each_entry_safe (storage_new,
                                 storage_safe,
@@ -582,15 +632,42 @@ reload_connections(NMSettingsPlugin                      *plugin,
     NMSKeyfilePluginPrivate                            *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
     nm_auto_clear_sett_util_storages NMSettUtilStorages storages_new =
         NM_SETT_UTIL_STORAGES_INIT(storages_new, nms_keyfile_storage_destroy);
-    int i;
-
-    _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_RUN, priv->dirname_run, &storages_new);
-    if (priv->dirname_etc)
-        _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_ETC, priv->dirname_etc, &storages_new);
-    for (i = 0; priv->dirname_libs[i]; i++)
-        _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_LIB(i), priv->dirname_libs[i], &storages_new);
+    gs_unref_hashtable GHashTable *storages_unchanged = NULL;
+    int                            i;
+
+    storages_unchanged = g_hash_table_new(nm_direct_hash, NULL);
+
+    _load_dir(self,
+              NMS_KEYFILE_STORAGE_TYPE_RUN,
+              priv->dirname_run,
+              &storages_new,
+              storages_unchanged);
+    if (priv->dirname_etc) {
+        _load_dir(self,
+                  NMS_KEYFILE_STORAGE_TYPE_ETC,
+                  priv->dirname_etc,
+                  &storages_new,
+                  storages_unchanged);
+    }
+    for (i = 0; priv->dirname_libs[i]; i++) {
+        _load_dir(self,
+                  NMS_KEYFILE_STORAGE_TYPE_LIB(i),
+                  priv->dirname_libs[i],
+                  &storages_new,
+                  storages_unchanged);
+    }
 
-    _storages_consolidate(self, &storages_new, TRUE, NULL, callback, user_data);
+    _LOGD("reload: %u files unchanged, %u files read",
+          g_hash_table_size(storages_unchanged),
+          g_hash_table_size(storages_new.idx_by_filename));
+
+    _storages_consolidate(self,
+                          &storages_new,
+                          TRUE,
+                          NULL,
+                          storages_unchanged,
+                          callback,
+                          user_data);
 }
 
 static void
@@ -738,7 +815,13 @@ load_connections(NMSettingsPlugin                      *plugin,
     nm_clear_pointer(&loaded_uuids, g_hash_table_destroy);
     nm_clear_pointer(&dupl_filenames, g_hash_table_destroy);
 
-    _storages_consolidate(self, &storages_new, FALSE, storages_replaced, callback, user_data);
+    _storages_consolidate(self,
+                          &storages_new,
+                          FALSE,
+                          storages_replaced,
+                          NULL,
+                          callback,
+                          user_data);
 }
 
 gboolean
@@ -780,6 +863,10 @@ nms_keyfile_plugin_add_connection(NMSKeyfilePlugin   *self,
     storage_type = !in_memory && priv->dirname_etc ? NMS_KEYFILE_STORAGE_TYPE_ETC
                                                    : NMS_KEYFILE_STORAGE_TYPE_RUN;
 
+    /* Unlike the timestamps and seen-bssids files (see NMSettUtilWriteQueue),
+     * the profile is written synchronously. The caller gets the re-read
+     * profile and any write error right away, for example as the reply to
+     * AddConnection. The same applies to nms_keyfile_plugin_update_connection(). */
     if (!nms_keyfile_writer_connection(
             connection,
             is_nm_generated,
@@ -837,6 +924,7 @@ nms_keyfile_plugin_add_connection(NMSKeyfilePlugin   *self,
                                            shadowed_storage,
                                            shadowed_owned ? NM_TERNARY_TRUE : NM_TERNARY_FALSE,
                                            nm_sett_util_stat_mtime(full_filename, FALSE, &mtime));
+    nm_sett_util_file_id_get(full_filename, &storage->u.conn_data.file_id);
 
     nm_sett_util_storages_add_take(&priv->storages, g_object_ref(storage));
 
@@ -1001,6 +1089,8 @@ nms_keyfile_plugin_update_connection(NMSKeyfilePlugin   *self,
         storage = storage_new;
     }
 
+    nm_sett_util_file_id_get(full_filename, &storage->u.conn_data.file_id);
+
     *out_storage    = g_object_ref(NM_SETTINGS_STORAGE(storage));
     *out_connection = g_steal_pointer(&reread);
     return TRUE;
@@ -8,6 +8,7 @@
 
 #include "c-list/src/c-list.h"
 #include "settings/nm-settings-storage.h"
+#include "settings/nm-settings-utils.h"
 #include "nms-keyfile-utils.h"
 
 /*****************************************************************************/
@@ -60,6 +61,10 @@ typedef struct {
              * multiple files with the same UUID, then the newer file gets preferred. */
             struct timespec stat_mtime;
 
+            /* identifies the file as we read it. On reload, an unchanged file
+             * is not read again. */
+            NMSettUtilFileId file_id;
+
             /* these flags are only relevant for storages with %NMS_KEYFILE_STORAGE_TYPE_RUN
              * (and non-metadata). This is to persist and reload these settings flags to
              * /run.
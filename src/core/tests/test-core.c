@@ -17,7 +17,9 @@
 #include "nm-core-utils.h"
 
 #include "dns/nm-dns-manager.h"
+#include "settings/nm-settings-utils.h"
 #include "nm-connectivity.h"
+#include "nm-dispatcher.h"
 #include "nm-firewall-utils.h"
 
 #include "nm-test-utils-core.h"
@@ -2576,6 +2578,56 @@ test_kernel_cmdline_match_check(void)
 
 /*****************************************************************************/
 
+static void
+test_dispatcher_coalesce(void)
+{
+    CList               head = C_LIST_INIT(head);
+    NMDispatcherPending p[4];
+
+    g_assert(_nm_dispatcher_action_can_coalesce(NM_DISPATCHER_ACTION_DHCP_CHANGE_4));
+    g_assert(_nm_dispatcher_action_can_coalesce(NM_DISPATCHER_ACTION_DNS_CHANGE));
+    g_assert(!_nm_dispatcher_action_can_coalesce(NM_DISPATCHER_ACTION_UP));
+    g_assert(!_nm_dispatcher_action_can_coalesce(NM_DISPATCHER_ACTION_PRE_DOWN));
+    g_assert(!_nm_dispatcher_action_can_coalesce(NM_DISPATCHER_ACTION_DEVICE_ADD));
+
+    g_assert(!_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DHCP_CHANGE_4, "eth0"));
+
+    p[0] = (NMDispatcherPending){.ifname = "eth0", .action = NM_DISPATCHER_ACTION_DHCP_CHANGE_4};
+    p[1] = (NMDispatcherPending){.ifname = "eth1", .action = NM_DISPATCHER_ACTION_DHCP_CHANGE_4};
+    p[2] = (NMDispatcherPending){.ifname = NULL, .action = NM_DISPATCHER_ACTION_DNS_CHANGE};
+    c_list_link_tail(&head, &p[0].lst);
+    c_list_link_tail(&head, &p[1].lst);
+    c_list_link_tail(&head, &p[2].lst);
+
+    /* Events of other devices don't prevent merging. */
+    g_assert(_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DHCP_CHANGE_4, "eth0")
+             == &p[0]);
+    g_assert(_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DHCP_CHANGE_4, "eth1")
+             == &p[1]);
+    g_assert(_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DNS_CHANGE, NULL) == &p[2]);
+    g_assert(!_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DNS_CHANGE, "eth0"));
+    g_assert(!_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DHCP_CHANGE_6, "eth0"));
+    g_assert(!_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DHCP_CHANGE_4, "eth2"));
+
+    /* Only the last event of the device can be merged, otherwise the
+     * events of eth0 would get reordered. */
+    p[3] = (NMDispatcherPending){.ifname = "eth0", .action = NM_DISPATCHER_ACTION_REAPPLY};
+    c_list_link_tail(&head, &p[3].lst);
+    g_assert(!_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DHCP_CHANGE_4, "eth0"));
+    g_assert(_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_REAPPLY, "eth0") == &p[3]);
+    g_assert(_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DHCP_CHANGE_4, "eth1")
+             == &p[1]);
+
+    c_list_unlink(&p[3].lst);
+    g_assert(_nm_dispatcher_pending_find(&head, NM_DISPATCHER_ACTION_DHCP_CHANGE_4, "eth0")
+             == &p[0]);
+
+    while (!c_list_is_empty(&head))
+        c_list_unlink(head.next);
+}
+
+/*****************************************************************************/
+
 static void
 test_connectivity_state_cmp(void)
 {
@@ -2632,6 +2684,243 @@ test_connectivity_state_cmp(void)
 
 /*****************************************************************************/
 
+static void
+test_connectivity_probe_share(void)
+{
+    NMConnectivityProbeShare  shares[4];
+    NMConnectivityProbeShare *leader;
+    guint                     i;
+
+    for (i = 0; i < G_N_ELEMENTS(shares); i++)
+        _nm_connectivity_probe_share_init(&shares[i]);
+
+    _nm_connectivity_probe_share_follow(&shares[1], &shares[0]);
+    _nm_connectivity_probe_share_follow(&shares[2], &shares[0]);
+    _nm_connectivity_probe_share_follow(&shares[3], &shares[0]);
+    g_assert(shares[1].leader == &shares[0]);
+    g_assert_cmpint(c_list_length(&shares[0].followers_lst_head), ==, 3);
+
+    /* A cancelled follower no longer waits for the result. */
+    _nm_connectivity_probe_share_leave(&shares[2]);
+    _nm_connectivity_probe_share_leave(&shares[2]);
+    g_assert(!shares[2].leader);
+    g_assert_cmpint(c_list_length(&shares[0].followers_lst_head), ==, 2);
+
+    /* The leader got cancelled. The first follower takes over. */
+    leader = _nm_connectivity_probe_share_hand_over(&shares[0]);
+    g_assert(leader == &shares[1]);
+    g_assert(!shares[1].leader);
+    g_assert(shares[3].leader == &shares[1]);
+    g_assert(c_list_is_empty(&shares[0].followers_lst_head));
+    g_assert(!_nm_connectivity_probe_share_hand_over(&shares[0]));
+
+    /* The probe completed. The followers get the result in order. */
+    _nm_connectivity_probe_share_follow(&shares[2], &shares[1]);
+    g_assert(_nm_connectivity_probe_share_pop(&shares[1]) == &shares[3]);
+    g_assert(_nm_connectivity_probe_share_pop(&shares[1]) == &shares[2]);
+    g_assert(!_nm_connectivity_probe_share_pop(&shares[1]));
+    g_assert(!shares[2].leader);
+    g_assert(!shares[3].leader);
+}
+
+#if WITH_CONCHECK
+static void
+test_connectivity_engines(void)
+{
+    CList                 engines_lst_head = C_LIST_INIT(engines_lst_head);
+    NMIPAddr              gw1              = {};
+    NMIPAddr              gw2              = {};
+    NMConnectivityEngine *e1;
+    NMConnectivityEngine *e2;
+    NMConnectivityEngine *e3;
+    NMConnectivityEngine *e4;
+    NMConnectivityEngine *e5;
+
+    gw1.addr4 = nmtst_inet4_from_string("192.168.1.1");
+    gw2.addr4 = nmtst_inet4_from_string("192.168.1.2");
+
+    /* Checks on the same interface and address family share an engine. */
+    e1 = _nm_connectivity_engine_acquire(&engines_lst_head, NULL, "if!eth0", AF_INET, &gw1);
+    e2 = _nm_connectivity_engine_acquire(&engines_lst_head, NULL, "if!eth0", AF_INET, &gw1);
+    e3 = _nm_connectivity_engine_acquire(&engines_lst_head,
+                                         NULL,
+                                         "if!eth0",
+                                         AF_INET6,
+                                         &nm_ip_addr_zero);
+    e4 = _nm_connectivity_engine_acquire(&engines_lst_head, NULL, "if!eth1", AF_INET, &gw1);
+    g_assert(e1);
+    g_assert(e1 == e2);
+    g_assert(e3 && e3 != e1);
+    g_assert(e4 && e4 != e1 && e4 != e3);
+    g_assert_cmpint(c_list_length(&engines_lst_head), ==, 3);
+
+    /* An unused engine is kept for a while, and used again. */
+    _nm_connectivity_engine_release(e1);
+    _nm_connectivity_engine_release(e2);
+    g_assert_cmpint(c_list_length(&engines_lst_head), ==, 3);
+    g_assert(_nm_connectivity_engine_acquire(&engines_lst_head, NULL, "if!eth0", AF_INET, &gw1)
+             == e1);
+
+    /* When the gateway changes, the connections of the engine no longer
+     * use the current route. A new engine is used, and the old one goes
+     * away once it is released. */
+    e5 = _nm_connectivity_engine_acquire(&engines_lst_head, NULL, "if!eth0", AF_INET, &gw2);
+    g_assert(e5 && e5 != e1 && e5 != e3 && e5 != e4);
+    g_assert(_nm_connectivity_engine_acquire(&engines_lst_head, NULL, "if!eth0", AF_INET, &gw2)
+             == e5);
+    g_assert_cmpint(c_list_length(&engines_lst_head), ==, 4);
+    _nm_connectivity_engine_release(e1);
+    g_assert_cmpint(c_list_length(&engines_lst_head), ==, 4);
+    nmtst_main_context_iterate_until_assert(NULL,
+                                            1000,
+                                            c_list_length(&engines_lst_head) == 3);
+
+    _nm_connectivity_engine_release(e3);
+    _nm_connectivity_engine_release(e4);
+    _nm_connectivity_engine_release(e5);
+    _nm_connectivity_engine_release(e5);
+    _nm_connectivity_engine_destroy(e3);
+    _nm_connectivity_engine_destroy(e4);
+    _nm_connectivity_engine_destroy(e5);
+    g_assert(c_list_is_empty(&engines_lst_head));
+}
+#endif
+
+/*****************************************************************************/
+
+#define WRITE_QUEUE_FILE_A NM_BUILD_BUILDDIR "/src/core/tests/test-write-queue-a.tmp"
+#define WRITE_QUEUE_FILE_B NM_BUILD_BUILDDIR "/src/core/tests/test-write-queue-b.tmp"
+
+static void
+_write_queue_add(NMSettUtilWriteQueue *queue, const char *filename, const char *contents)
+{
+    gs_unref_bytes GBytes *bytes = g_bytes_new(contents, strlen(contents));
+
+    nm_sett_util_write_queue_add(queue, filename, bytes);
+}
+
+static gboolean
+_write_queue_file_equals(const char *filename, const char *contents)
+{
+    gs_free char *actual = NULL;
+
+    if (!g_file_get_contents(filename, &actual, NULL, NULL))
+        return FALSE;
+    return nm_streq(actual, contents);
+}
+
+static void
+test_sett_util_write_queue_coalesce(void)
+{
+    NMSettUtilWriteQueue *queue;
+
+    nmtst_file_unlink_if_exists(WRITE_QUEUE_FILE_A);
+    nmtst_file_unlink_if_exists(WRITE_QUEUE_FILE_B);
+
+    queue = nm_sett_util_write_queue_new(50);
+
+    /* Nothing is written before the delay passes. Then the same file is
+     * written once, with the last content. */
+    _write_queue_add(queue, WRITE_QUEUE_FILE_A, "a1");
+    _write_queue_add(queue, WRITE_QUEUE_FILE_B, "b1");
+    _write_queue_add(queue, WRITE_QUEUE_FILE_A, "a2");
+    g_assert(!g_file_test(WRITE_QUEUE_FILE_A, G_FILE_TEST_EXISTS));
+    g_assert(!g_file_test(WRITE_QUEUE_FILE_B, G_FILE_TEST_EXISTS));
+
+    nmtst_main_context_iterate_until_assert_full(
+        NULL,
+        2000,
+        10,
+        !_nm_sett_util_write_queue_get_in_flight(queue)
+            && _write_queue_file_equals(WRITE_QUEUE_FILE_A, "a2")
+            && _write_queue_file_equals(WRITE_QUEUE_FILE_B, "b1"));
+
+    nm_sett_util_write_queue_free(queue);
+
+    nmtst_file_unlink(WRITE_QUEUE_FILE_A);
+    nmtst_file_unlink(WRITE_QUEUE_FILE_B);
+}
+
+static void
+test_sett_util_write_queue_in_flight(void)
+{
+    NMSettUtilWriteQueue *queue;
+
+    nmtst_file_unlink_if_exists(WRITE_QUEUE_FILE_A);
+
+    queue = nm_sett_util_write_queue_new(0);
+    _nm_sett_util_write_queue_set_paused(queue, TRUE);
+
+    _write_queue_add(queue, WRITE_QUEUE_FILE_A, "a1");
+    nmtst_main_context_iterate_until_assert(NULL,
+                                            2000,
+                                            _nm_sett_util_write_queue_get_in_flight(queue));
+
+    /* A second batch is not started while the first one is in flight, so
+     * the older content cannot overwrite the newer one. */
+    _write_queue_add(queue, WRITE_QUEUE_FILE_A, "a2");
+    nmtst_main_context_iterate_until(NULL, 50, FALSE);
+    g_assert(_nm_sett_util_write_queue_get_in_flight(queue));
+    g_assert(!g_file_test(WRITE_QUEUE_FILE_A, G_FILE_TEST_EXISTS));
+
+    _nm_sett_util_write_queue_set_paused(queue, FALSE);
+    nmtst_main_context_iterate_until_assert_full(
+        NULL,
+        2000,
+        10,
+        !_nm_sett_util_write_queue_get_in_flight(queue)
+            && _write_queue_file_equals(WRITE_QUEUE_FILE_A, "a2"));
+
+    nm_sett_util_write_queue_free(queue);
+
+    nmtst_file_unlink(WRITE_QUEUE_FILE_A);
+}
+
+static gpointer
+_write_queue_unpause_thread_fcn(gpointer user_data)
+{
+    g_usleep(50000);
+    _nm_sett_util_write_queue_set_paused(user_data, FALSE);
+    return NULL;
+}
+
+static void
+test_sett_util_write_queue_flush(void)
+{
+    NMSettUtilWriteQueue *queue;
+    GThread              *thread;
+
+    nmtst_file_unlink_if_exists(WRITE_QUEUE_FILE_A);
+
+    queue = nm_sett_util_write_queue_new(0);
+    _nm_sett_util_write_queue_set_paused(queue, TRUE);
+
+    _write_queue_add(queue, WRITE_QUEUE_FILE_A, "a1");
+    nmtst_main_context_iterate_until_assert(NULL,
+                                            2000,
+                                            _nm_sett_util_write_queue_get_in_flight(queue));
+    _write_queue_add(queue, WRITE_QUEUE_FILE_A, "a2");
+
+    /* The flush waits for the batch in flight, and then writes the
+     * pending content synchronously. */
+    thread = g_thread_new("write-queue-unpause", _write_queue_unpause_thread_fcn, queue);
+    nm_sett_util_write_queue_flush(queue);
+    g_thread_join(thread);
+
+    g_assert(!_nm_sett_util_write_queue_get_in_flight(queue));
+    g_assert(_write_queue_file_equals(WRITE_QUEUE_FILE_A, "a2"));
+
+    nm_sett_util_write_queue_free(queue);
+
+    /* Let the cancelled task of the first batch complete. */
+    nmtst_main_context_iterate_until(NULL, 100, FALSE);
+
+    g_assert(_write_queue_file_equals(WRITE_QUEUE_FILE_A, "a2"));
+    nmtst_file_unlink(WRITE_QUEUE_FILE_A);
+}
+
+/*****************************************************************************/
+
 static void
 test_nm_firewall_nft_stdio_mlag(void)
 {
@@ -2821,7 +3110,18 @@ main(int argc, char **argv)
                          GINT_TO_POINTER(1),
                          test_nm_utils_dhcp_client_id_systemd_node_specific);
 
+    g_test_add_func("/core/general/test_dispatcher_coalesce", test_dispatcher_coalesce);
     g_test_add_func("/core/general/test_connectivity_state_cmp", test_connectivity_state_cmp);
+    g_test_add_func("/core/general/test_connectivity_probe_share", test_connectivity_probe_share);
+#if WITH_CONCHECK
+    g_test_add_func("/core/general/test_connectivity_engines", test_connectivity_engines);
+#endif
+    g_test_add_func("/core/general/test_sett_util_write_queue_coalesce",
+                    test_sett_util_write_queue_coalesce);
+    g_test_add_func("/core/general/test_sett_util_write_queue_in_flight",
+                    test_sett_util_write_queue_in_flight);
+    g_test_add_func("/core/general/test_sett_util_write_queue_flush",
+                    test_sett_util_write_queue_flush);
     g_test_add_func("/core/general/test_kernel_cmdline_match_check",
                     test_kernel_cmdline_match_check);
 
@@ -1072,6 +1072,201 @@ test_l3_ipv6ll(gconstpointer test_data)
 
 /*****************************************************************************/
 
+typedef struct {
+    NMNetnsStatsHandle  *handle;
+    NMNetnsStatsHandle **unregister_other;
+    const guint         *iteration;
+    gint64               last_msec;
+    guint                last_iteration;
+    guint                n_calls;
+    int                  ifindex;
+    bool                 unregister_self;
+} TestNetnsStatsHandleData;
+
+typedef struct {
+    const TestFixture1      *f;
+    TestNetnsStatsHandleData h[3];
+    guint                    iteration;
+} TestNetnsStatsData;
+
+static void
+_test_netns_stats_cb(NMNetns *netns, const NMPlatformLinkStats *stats, gpointer user_data)
+{
+    TestNetnsStatsHandleData *h = user_data;
+
+    g_assert(NM_IS_NETNS(netns));
+    g_assert(h->handle);
+    g_assert(stats);
+    g_assert_cmpint(stats->ifindex, ==, h->ifindex);
+
+    h->last_msec      = nm_utils_get_monotonic_timestamp_msec();
+    h->last_iteration = *h->iteration;
+    h->n_calls++;
+
+    if (h->unregister_other)
+        nm_clear_pointer(h->unregister_other, nm_netns_stats_unregister);
+    if (h->unregister_self)
+        nm_clear_pointer(&h->handle, nm_netns_stats_unregister);
+}
+
+static void
+_test_netns_stats_register(TestNetnsStatsData *tdata, guint idx, int ifindex, guint rate_msec)
+{
+    TestNetnsStatsHandleData *h = &tdata->h[idx];
+
+    g_assert(!h->handle);
+
+    h->iteration = &tdata->iteration;
+    h->ifindex   = ifindex;
+    h->handle    =
+        nm_netns_stats_register(tdata->f->netns, ifindex, rate_msec, _test_netns_stats_cb, h);
+    g_assert(h->handle);
+}
+
+static void
+_test_netns_stats_iterate_until(TestNetnsStatsData *tdata, guint idx, guint n_calls)
+{
+    const gint64 end_msec = nm_utils_get_monotonic_timestamp_msec() + 5000;
+
+    /* All handles that are served by the same tick of the timer get
+     * their callback during the same main loop iteration. Count the
+     * iterations, so that we can tell. */
+    while (tdata->h[idx].n_calls < n_calls) {
+        g_assert_cmpint(nm_utils_get_monotonic_timestamp_msec(), <, end_msec);
+        tdata->iteration++;
+        g_main_context_iteration(NULL, TRUE);
+    }
+}
+
+static void
+_test_netns_stats_cleanup(TestNetnsStatsData *tdata)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(tdata->h); i++)
+        nm_clear_pointer(&tdata->h[i].handle, nm_netns_stats_unregister);
+}
+
+static void
+test_netns_stats_slack(gconstpointer test_data)
+{
+    const int                                      TEST_IDX     = GPOINTER_TO_INT(test_data);
+    const guint                                    RATE_MSEC    = 1000;
+    nm_auto(_test_fixture_1_teardown) TestFixture1 test_fixture = {};
+    TestNetnsStatsData                             tdata_stack  = {};
+    TestNetnsStatsData                      *const tdata        = &tdata_stack;
+    gint64                                         tick_msec;
+    guint                                          n_calls;
+    guint                                          i_try;
+
+    _LOGD("test start (/netns/stats/slack/%d)", TEST_IDX);
+
+    if (nmtst_test_quick()) {
+        gs_free char *msg =
+            g_strdup_printf("Skipping test: don't run long running test %s (NMTST_DEBUG=slow)\n",
+                            g_get_prgname() ?: "test-netns-stats");
+
+        g_test_skip(msg);
+        return;
+    }
+
+    tdata->f = _test_fixture_1_setup(&test_fixture, TEST_IDX);
+
+    /* The first refresh happens right away. The next one is aligned
+     * to a multiple of the rate. */
+    _test_netns_stats_register(tdata, 0, tdata->f->ifindex0, RATE_MSEC);
+    _test_netns_stats_iterate_until(tdata, 0, 2);
+
+    /* A handle with the same rate that gets registered later joins the
+     * tick of the first one after its own first refresh. */
+    _test_netns_stats_register(tdata, 1, tdata->f->ifindex1, RATE_MSEC);
+    _test_netns_stats_iterate_until(tdata, 1, 1);
+    g_assert_cmpint(tdata->h[0].n_calls, ==, 2);
+    _test_netns_stats_iterate_until(tdata, 1, 2);
+    g_assert_cmpint(tdata->h[0].n_calls, ==, 3);
+    g_assert_cmpint(tdata->h[0].last_iteration, ==, tdata->h[1].last_iteration);
+
+    /* Register a third handle shortly before the next tick. Its first
+     * refresh also serves the other handles, as they are due within the
+     * slack. Retry if the main loop woke up too late for that. */
+    for (i_try = 0;; i_try++) {
+        g_assert_cmpint(i_try, <, 5);
+
+        tick_msec = ((tdata->h[0].last_msec / RATE_MSEC) + 1) * ((gint64) RATE_MSEC);
+        n_calls   = tdata->h[0].n_calls;
+
+        nmtst_main_context_iterate_until(NULL,
+                                         tick_msec - 40 - nm_utils_get_monotonic_timestamp_msec(),
+                                         FALSE);
+        if (tdata->h[0].n_calls != n_calls)
+            continue;
+
+        _test_netns_stats_register(tdata, 2, tdata->f->ifindex0, RATE_MSEC);
+        _test_netns_stats_iterate_until(tdata, 2, 1);
+        if (tdata->h[2].last_msec < tick_msec)
+            break;
+
+        nm_clear_pointer(&tdata->h[2].handle, nm_netns_stats_unregister);
+        tdata->h[2].n_calls = 0;
+    }
+    g_assert_cmpint(tdata->h[0].n_calls, ==, n_calls + 1);
+    g_assert_cmpint(tdata->h[0].last_iteration, ==, tdata->h[2].last_iteration);
+    g_assert_cmpint(tdata->h[1].last_iteration, ==, tdata->h[2].last_iteration);
+
+    /* The handles that were served early are not refreshed again at the
+     * tick they were due for, but one period later. */
+    _test_netns_stats_iterate_until(tdata, 0, n_calls + 2);
+    g_assert_cmpint(tdata->h[0].last_msec, >=, tick_msec + RATE_MSEC);
+    g_assert_cmpint(tdata->h[1].last_iteration, ==, tdata->h[0].last_iteration);
+
+    _test_netns_stats_cleanup(tdata);
+}
+
+static void
+test_netns_stats_unregister(gconstpointer test_data)
+{
+    const int                                      TEST_IDX     = GPOINTER_TO_INT(test_data);
+    const guint                                    RATE_MSEC    = 100;
+    nm_auto(_test_fixture_1_teardown) TestFixture1 test_fixture = {};
+    TestNetnsStatsData                             tdata_stack  = {};
+    TestNetnsStatsData                      *const tdata        = &tdata_stack;
+
+    _LOGD("test start (/netns/stats/unregister/%d)", TEST_IDX);
+
+    tdata->f = _test_fixture_1_setup(&test_fixture, TEST_IDX);
+
+    /* All three handles are due on the first tick. The callback of the
+     * first one unregisters itself and the second one, which then must
+     * not be called anymore. The third one is still served. */
+    _test_netns_stats_register(tdata, 0, tdata->f->ifindex0, RATE_MSEC);
+    _test_netns_stats_register(tdata, 1, tdata->f->ifindex1, RATE_MSEC);
+    _test_netns_stats_register(tdata, 2, tdata->f->ifindex1, RATE_MSEC);
+    tdata->h[0].unregister_other = &tdata->h[1].handle;
+    tdata->h[0].unregister_self  = TRUE;
+
+    _test_netns_stats_iterate_until(tdata, 2, 1);
+    g_assert_cmpint(tdata->h[0].n_calls, ==, 1);
+    g_assert_cmpint(tdata->h[0].last_iteration, ==, tdata->h[2].last_iteration);
+    g_assert(!tdata->h[0].handle);
+    g_assert(!tdata->h[1].handle);
+    g_assert_cmpint(tdata->h[1].n_calls, ==, 0);
+
+    _test_netns_stats_iterate_until(tdata, 2, 3);
+    g_assert_cmpint(tdata->h[0].n_calls, ==, 1);
+    g_assert_cmpint(tdata->h[1].n_calls, ==, 0);
+
+    /* With a single due link, the counters come from the platform cache
+     * instead of a dump. Unregistering from that callback works too. */
+    tdata->h[2].unregister_self = TRUE;
+    _test_netns_stats_iterate_until(tdata, 2, 4);
+    g_assert(!tdata->h[2].handle);
+
+    nmtst_main_context_iterate_until(NULL, 3 * RATE_MSEC, FALSE);
+    g_assert_cmpint(tdata->h[2].n_calls, ==, 4);
+}
+
+/*****************************************************************************/
+
 NMTstpSetupFunc const _nmtstp_setup_platform_func = nm_linux_platform_setup;
 
 void
@@ -1093,4 +1288,8 @@ _nmtstp_setup_tests(void)
     g_test_add_data_func("/l3-ipv6ll/2", GINT_TO_POINTER(2), test_l3_ipv6ll);
     g_test_add_data_func("/l3-ipv6ll/3", GINT_TO_POINTER(3), test_l3_ipv6ll);
     g_test_add_data_func("/l3-ipv6ll/4", GINT_TO_POINTER(4), test_l3_ipv6ll);
+    g_test_add_data_func("/netns/stats/slack/1", GINT_TO_POINTER(1), test_netns_stats_slack);
+    g_test_add_data_func("/netns/stats/unregister/1",
+                         GINT_TO_POINTER(1),
+                         test_netns_stats_unregister);
 }
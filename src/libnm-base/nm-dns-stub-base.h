@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#ifndef __NM_DNS_STUB_BASE_H__
+#define __NM_DNS_STUB_BASE_H__
+
+/*****************************************************************************/
+
+/* nm-dns-stub is a small caching DNS forwarder, spawned by NetworkManager
+ * for "dns=nm-stub".
+ *
+ * NetworkManager passes one end of a SOCK_SEQPACKET socketpair as file
+ * descriptor NM_DNS_STUB_CONTROL_FD. Each message is a serialized GVariant
+ * of type NM_DNS_STUB_CONFIG_TYPE and contains the full configuration.
+ * After applying a configuration, nm-dns-stub replies with a message of the
+ * same type, that contains the NM_DNS_STUB_CONFIG_GENERATION of the
+ * configuration. When the socket gets closed, nm-dns-stub exits. */
+
+#define NM_DNS_STUB_CONTROL_FD 3
+
+#define NM_DNS_STUB_LISTEN_ADDRESS "127.0.0.1"
+#define NM_DNS_STUB_LISTEN_PORT    53
+
+#define NM_DNS_STUB_CONFIG_TYPE "a{sv}"
+
+/* "u": a counter to match replies with requests. */
+#define NM_DNS_STUB_CONFIG_GENERATION "generation"
+
+/* "a(sis)": the upstream servers, as tuples of address, ifindex (for IPv6
+ * link-local addresses) and domain. The empty domain is for all names that
+ * have no more specific domain. */
+#define NM_DNS_STUB_CONFIG_SERVERS "servers"
+
+/* "u": the maximum number of entries in the cache. Zero disables caching. */
+#define NM_DNS_STUB_CONFIG_CACHE_SIZE "cache-size"
+
+#define NM_DNS_STUB_CACHE_SIZE_DEFAULT 1000u
+
+#endif /* __NM_DNS_STUB_BASE_H__ */
@@ -190,6 +190,7 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMClient,
                              PROP_DBUS_NAME_OWNER,
                              PROP_VERSION,
                              PROP_INSTANCE_FLAGS,
+                             PROP_OBJECT_TYPES,
                              PROP_STATE,
                              PROP_STARTUP,
                              PROP_NM_RUNNING,
@@ -290,6 +291,12 @@ typedef struct {
     guint dbsid_nm_vpn_connection_state_changed;
     guint dbsid_nm_check_permissions;
 
+    /* If only some object types are cached, the signal subscriptions
+     * for the ObjectManager and PropertiesChanged signals (guint). */
+    GArray *dbsids_filtered;
+
+    NMClientObjectTypes object_types;
+
     NMClientInstanceFlags instance_flags : 5;
 
     NMTernary permissions_state : 3;
@@ -1569,6 +1576,86 @@ _dbobjs_get_nmobj_unpack_visible(NMClient *self, const char *dbus_path, GType gt
 
 /*****************************************************************************/
 
+typedef struct {
+    const char         *path_prefix;
+    const char         *iface_namespaces[3];
+    NMClientObjectTypes object_type;
+} ObjectTypeInfo;
+
+/* The D-Bus objects that can be excluded via NMClient:object-types. All other
+ * objects are singletons that are always cached. */
+static const ObjectTypeInfo object_type_infos[] = {
+    {
+        .path_prefix      = NM_DBUS_PATH "/Devices/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_DEVICE},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_DEVICES,
+    },
+    {
+        .path_prefix      = NM_DBUS_PATH "/ActiveConnection/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_ACTIVE_CONNECTION,
+                             NM_DBUS_INTERFACE_VPN_CONNECTION},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_ACTIVE_CONNECTIONS,
+    },
+    {
+        .path_prefix      = NM_DBUS_PATH_SETTINGS "/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_SETTINGS_CONNECTION},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_CONNECTIONS,
+    },
+    {
+        .path_prefix      = NM_DBUS_PATH_ACCESS_POINT "/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_ACCESS_POINT},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_ACCESS_POINTS,
+    },
+    {
+        .path_prefix      = NM_DBUS_PATH_WIFI_P2P_PEER "/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_WIFI_P2P_PEER},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_WIFI_P2P_PEERS,
+    },
+    {
+        .path_prefix      = NM_DBUS_PATH "/IP4Config/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_IP4_CONFIG},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_IP_CONFIGS,
+    },
+    {
+        .path_prefix      = NM_DBUS_PATH "/IP6Config/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_IP6_CONFIG},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_IP_CONFIGS,
+    },
+    {
+        .path_prefix      = NM_DBUS_PATH "/DHCP4Config/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_DHCP4_CONFIG},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_DHCP_CONFIGS,
+    },
+    {
+        .path_prefix      = NM_DBUS_PATH "/DHCP6Config/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_DHCP6_CONFIG},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_DHCP_CONFIGS,
+    },
+    {
+        .path_prefix      = NM_DBUS_PATH "/Checkpoint/",
+        .iface_namespaces = {NM_DBUS_INTERFACE_CHECKPOINT},
+        .object_type      = NM_CLIENT_OBJECT_TYPES_CHECKPOINTS,
+    },
+};
+
+static gboolean
+_dbus_path_is_excluded(NMClient *self, const char *dbus_path)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+    guint            i;
+
+    if (priv->object_types == NM_CLIENT_OBJECT_TYPES_ALL)
+        return FALSE;
+
+    for (i = 0; i < G_N_ELEMENTS(object_type_infos); i++) {
+        if (g_str_has_prefix(dbus_path, object_type_infos[i].path_prefix))
+            return !NM_FLAGS_ANY(priv->object_types, object_type_infos[i].object_type);
+    }
+    return FALSE;
+}
+
+/*****************************************************************************/
+
 static gpointer
 _dbobjs_obj_watcher_register_o(NMClient                *self,
                                NMLDBusObject           *dbobj,
@@ -1817,6 +1904,11 @@ nml_dbus_property_o_notify(NMClient               *self,
     if (value)
         dbus_path = nm_dbus_path_not_empty(g_variant_get_string(value, NULL));
 
+    if (dbus_path && _dbus_path_is_excluded(self, dbus_path)) {
+        /* The object type is not cached. The property is always NULL. */
+        dbus_path = NULL;
+    }
+
     if (pr_o->obj_watcher
         && (!dbus_path || !nm_streq(dbus_path, pr_o->obj_watcher->dbobj->dbus_path->str))) {
         _dbobjs_obj_watcher_unregister(self, g_steal_pointer(&pr_o->obj_watcher));
@@ -2195,6 +2287,9 @@ nml_dbus_property_ao_notify(NMClient               *self,
                 continue;
             }
 
+            if (_dbus_path_is_excluded(self, path))
+                continue;
+
             dbus_path_r   = nm_ref_string_new(path);
             p_dbus_path_1 = &dbus_path_r;
             pr_ao_data    = g_hash_table_lookup(pr_ao->hash, &p_dbus_path_1);
@@ -3089,6 +3184,12 @@ _dbus_handle_interface_added(NMClient   *self,
 
     nm_assert(g_variant_is_of_type(ifaces, G_VARIANT_TYPE("a{sa{sv}}")));
 
+    if (_dbus_path_is_excluded(self, object_path)) {
+        /* GetManagedObjects() always returns all objects. The signals we don't
+         * even receive. */
+        return FALSE;
+    }
+
     g_variant_iter_init(&iter_ifaces, ifaces);
     while (g_variant_iter_next(&iter_ifaces, "{&s@a{sv}}", &interface_name, &changed_properties)) {
         _nm_unused gs_unref_variant GVariant *changed_properties_free = changed_properties;
@@ -4000,6 +4101,22 @@ nm_client_get_instance_flags(NMClient *self)
     return NM_CLIENT_GET_PRIVATE(self)->instance_flags;
 }
 
+/**
+ * nm_client_get_object_types:
+ * @self: the #NMClient instance.
+ *
+ * Returns: the #NMClientObjectTypes that the instance caches.
+ *
+ * Since: 1.48
+ */
+NMClientObjectTypes
+nm_client_get_object_types(NMClient *self)
+{
+    g_return_val_if_fail(NM_IS_CLIENT(self), NM_CLIENT_OBJECT_TYPES_ALL);
+
+    return NM_CLIENT_GET_PRIVATE(self)->object_types;
+}
+
 /**
  * nm_client_get_dbus_connection:
  * @client: a #NMClient
@@ -6939,6 +7056,74 @@ nm_client_dbus_set_property_finish(NMClient *client, GAsyncResult *result, GErro
 
 /*****************************************************************************/
 
+static void
+_init_subscribe_filtered(NMClient *self)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+    static const char *const always_ifaces[] = {
+        NM_DBUS_INTERFACE,
+        NM_DBUS_INTERFACE_SETTINGS,
+        NM_DBUS_INTERFACE_DNS_MANAGER,
+    };
+    guint id;
+    guint i;
+    guint j;
+
+    /* Instead of subscribing to all ObjectManager and PropertiesChanged signals,
+     * only subscribe to the object types that we cache. The match rules go
+     * to the D-Bus broker, so that we don't even receive the other signals.
+     *
+     * InterfacesAdded/InterfacesRemoved carry the object path as first
+     * argument, PropertiesChanged the interface name. */
+    priv->dbsids_filtered = g_array_new(FALSE, FALSE, sizeof(guint));
+
+    for (i = 0; i < G_N_ELEMENTS(always_ifaces); i++) {
+        id = nm_dbus_connection_signal_subscribe_properties_changed(priv->dbus_connection,
+                                                                    priv->name_owner,
+                                                                    NULL,
+                                                                    always_ifaces[i],
+                                                                    _dbus_properties_changed_cb,
+                                                                    self,
+                                                                    NULL);
+        g_array_append_val(priv->dbsids_filtered, id);
+    }
+
+    for (i = 0; i < G_N_ELEMENTS(object_type_infos); i++) {
+        const ObjectTypeInfo *info = &object_type_infos[i];
+
+        if (!NM_FLAGS_ANY(priv->object_types, info->object_type))
+            continue;
+
+        for (j = 0; j < 2; j++) {
+            id = g_dbus_connection_signal_subscribe(priv->dbus_connection,
+                                                    priv->name_owner,
+                                                    DBUS_INTERFACE_OBJECT_MANAGER,
+                                                    j == 0 ? "InterfacesAdded" : "InterfacesRemoved",
+                                                    "/org/freedesktop",
+                                                    info->path_prefix,
+                                                    G_DBUS_SIGNAL_FLAGS_MATCH_ARG0_PATH,
+                                                    _dbus_managed_objects_changed_cb,
+                                                    self,
+                                                    NULL);
+            g_array_append_val(priv->dbsids_filtered, id);
+        }
+
+        for (j = 0; j < G_N_ELEMENTS(info->iface_namespaces) && info->iface_namespaces[j]; j++) {
+            id = g_dbus_connection_signal_subscribe(priv->dbus_connection,
+                                                    priv->name_owner,
+                                                    DBUS_INTERFACE_PROPERTIES,
+                                                    "PropertiesChanged",
+                                                    NULL,
+                                                    info->iface_namespaces[j],
+                                                    G_DBUS_SIGNAL_FLAGS_MATCH_ARG0_NAMESPACE,
+                                                    _dbus_properties_changed_cb,
+                                                    self,
+                                                    NULL);
+            g_array_append_val(priv->dbsids_filtered, id);
+        }
+    }
+}
+
 static void
 _init_fetch_all(NMClient *self)
 {
@@ -6953,59 +7138,68 @@ _init_fetch_all(NMClient *self)
 
     priv->get_managed_objects_cancellable = g_cancellable_new();
 
-    priv->dbsid_nm_object_manager =
-        nm_dbus_connection_signal_subscribe_object_manager(priv->dbus_connection,
-                                                           priv->name_owner,
-                                                           "/org/freedesktop",
-                                                           NULL,
-                                                           _dbus_managed_objects_changed_cb,
-                                                           self,
-                                                           NULL);
-
-    priv->dbsid_dbus_properties_properties_changed =
-        nm_dbus_connection_signal_subscribe_properties_changed(priv->dbus_connection,
+    if (priv->object_types != NM_CLIENT_OBJECT_TYPES_ALL) {
+        NML_NMCLIENT_LOG_D(self, "only cache object types 0x%x", (guint) priv->object_types);
+        _init_subscribe_filtered(self);
+    } else {
+        priv->dbsid_nm_object_manager =
+            nm_dbus_connection_signal_subscribe_object_manager(priv->dbus_connection,
                                                                priv->name_owner,
+                                                               "/org/freedesktop",
                                                                NULL,
-                                                               NULL,
-                                                               _dbus_properties_changed_cb,
+                                                               _dbus_managed_objects_changed_cb,
                                                                self,
                                                                NULL);
 
-    priv->dbsid_nm_settings_connection_updated =
-        g_dbus_connection_signal_subscribe(priv->dbus_connection,
-                                           priv->name_owner,
-                                           NM_DBUS_INTERFACE_SETTINGS_CONNECTION,
-                                           "Updated",
-                                           NULL,
-                                           NULL,
-                                           G_DBUS_SIGNAL_FLAGS_NONE,
-                                           _dbus_settings_updated_cb,
-                                           self,
-                                           NULL);
-
-    priv->dbsid_nm_connection_active_state_changed =
-        g_dbus_connection_signal_subscribe(priv->dbus_connection,
-                                           priv->name_owner,
-                                           NM_DBUS_INTERFACE_ACTIVE_CONNECTION,
-                                           "StateChanged",
-                                           NULL,
-                                           NULL,
-                                           G_DBUS_SIGNAL_FLAGS_NONE,
-                                           _dbus_nm_connection_active_state_changed_cb,
-                                           self,
-                                           NULL);
+        priv->dbsid_dbus_properties_properties_changed =
+            nm_dbus_connection_signal_subscribe_properties_changed(priv->dbus_connection,
+                                                                   priv->name_owner,
+                                                                   NULL,
+                                                                   NULL,
+                                                                   _dbus_properties_changed_cb,
+                                                                   self,
+                                                                   NULL);
+    }
 
-    priv->dbsid_nm_vpn_connection_state_changed =
-        g_dbus_connection_signal_subscribe(priv->dbus_connection,
-                                           priv->name_owner,
-                                           NM_DBUS_INTERFACE_VPN_CONNECTION,
-                                           "VpnStateChanged",
-                                           NULL,
-                                           NULL,
-                                           G_DBUS_SIGNAL_FLAGS_NONE,
-                                           _dbus_nm_vpn_connection_state_changed_cb,
-                                           self,
-                                           NULL);
+    if (NM_FLAGS_HAS(priv->object_types, NM_CLIENT_OBJECT_TYPES_CONNECTIONS)) {
+        priv->dbsid_nm_settings_connection_updated =
+            g_dbus_connection_signal_subscribe(priv->dbus_connection,
+                                               priv->name_owner,
+                                               NM_DBUS_INTERFACE_SETTINGS_CONNECTION,
+                                               "Updated",
+                                               NULL,
+                                               NULL,
+                                               G_DBUS_SIGNAL_FLAGS_NONE,
+                                               _dbus_settings_updated_cb,
+                                               self,
+                                               NULL);
+    }
+
+    if (NM_FLAGS_HAS(priv->object_types, NM_CLIENT_OBJECT_TYPES_ACTIVE_CONNECTIONS)) {
+        priv->dbsid_nm_connection_active_state_changed =
+            g_dbus_connection_signal_subscribe(priv->dbus_connection,
+                                               priv->name_owner,
+                                               NM_DBUS_INTERFACE_ACTIVE_CONNECTION,
+                                               "StateChanged",
+                                               NULL,
+                                               NULL,
+                                               G_DBUS_SIGNAL_FLAGS_NONE,
+                                               _dbus_nm_connection_active_state_changed_cb,
+                                               self,
+                                               NULL);
+
+        priv->dbsid_nm_vpn_connection_state_changed =
+            g_dbus_connection_signal_subscribe(priv->dbus_connection,
+                                               priv->name_owner,
+                                               NM_DBUS_INTERFACE_VPN_CONNECTION,
+                                               "VpnStateChanged",
+                                               NULL,
+                                               NULL,
+                                               G_DBUS_SIGNAL_FLAGS_NONE,
+                                               _dbus_nm_vpn_connection_state_changed_cb,
+                                               self,
+                                               NULL);
+    }
 
     priv->dbsid_nm_check_permissions =
         g_dbus_connection_signal_subscribe(priv->dbus_connection,
@@ -7060,6 +7254,14 @@ _init_release_all(NMClient *self)
                                       &priv->dbsid_nm_vpn_connection_state_changed);
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->dbsid_nm_check_permissions);
 
+    if (priv->dbsids_filtered) {
+        for (i = 0; i < (int) priv->dbsids_filtered->len; i++) {
+            nm_clear_g_dbus_connection_signal(priv->dbus_connection,
+                                              &nm_g_array_index(priv->dbsids_filtered, guint, i));
+        }
+        nm_clear_pointer(&priv->dbsids_filtered, g_array_unref);
+    }
+
     if (priv->permissions_state != NM_TERNARY_DEFAULT) {
         priv->permissions_state   = NM_TERNARY_DEFAULT;
         permissions_state_changed = TRUE;
@@ -7521,6 +7723,9 @@ get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
     case PROP_INSTANCE_FLAGS:
         g_value_set_uint(value, priv->instance_flags);
         break;
+    case PROP_OBJECT_TYPES:
+        g_value_set_uint(value, priv->object_types);
+        break;
     case PROP_DBUS_CONNECTION:
         g_value_set_object(value, priv->dbus_connection);
         break;
@@ -7703,6 +7908,11 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
         priv->dbus_connection = g_value_dup_object(value);
         break;
 
+    case PROP_OBJECT_TYPES:
+        /* construct-only */
+        priv->object_types = g_value_get_uint(value) & ((guint) NM_CLIENT_OBJECT_TYPES_ALL);
+        break;
+
     case PROP_NETWORKING_ENABLED:
         b = g_value_get_boolean(value);
         if (priv->nm.networking_enabled != b) {
@@ -8281,6 +8491,31 @@ nm_client_class_init(NMClientClass *client_class)
         0,
         G_PARAM_READABLE | G_PARAM_WRITABLE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS);
 
+    /**
+     * NMClient:object-types:
+     *
+     * The #NMClientObjectTypes that the instance mirrors from D-Bus. By default,
+     * all objects are cached. A client that only needs some objects can save
+     * the work (and memory) for the others. The signals for excluded types
+     * are not subscribed, so the D-Bus broker does not even send them. Only
+     * the initial GetManagedObjects() call still returns all objects.
+     *
+     * Properties that reference objects of an excluded type are %NULL or empty.
+     * For example, without %NM_CLIENT_OBJECT_TYPES_ACCESS_POINTS, nm_device_wifi_get_access_points()
+     * returns an empty array and nm_client_get_connections() is empty without
+     * %NM_CLIENT_OBJECT_TYPES_CONNECTIONS.
+     *
+     * Since: 1.48
+     */
+    obj_properties[PROP_OBJECT_TYPES] = g_param_spec_uint(
+        NM_CLIENT_OBJECT_TYPES,
+        "",
+        "",
+        0,
+        G_MAXUINT32,
+        NM_CLIENT_OBJECT_TYPES_ALL,
+        G_PARAM_READABLE | G_PARAM_WRITABLE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
     /**
      * NMClient:dbus-name-owner:
      *
@@ -656,6 +656,15 @@ _nm_remote_settings_get_settings_prepare(NMRemoteConnection *self)
     return priv->get_settings_cancellable;
 }
 
+static void
+_lazy_settings_error_cb(NMConnection *connection, GError *error)
+{
+    NML_NMCLIENT_LOG_E(_nm_object_get_client(connection),
+                       "[%s] failure to update settings: %s",
+                       _nm_object_get_path(connection),
+                       error->message);
+}
+
 void
 _nm_remote_settings_get_settings_commit(NMRemoteConnection *self, GVariant *settings)
 {
@@ -672,10 +681,13 @@ _nm_remote_settings_get_settings_commit(NMRemoteConnection *self, GVariant *sett
     }
 
     if (settings) {
-        if (!_nm_connection_replace_settings((NMConnection *) self,
-                                             settings,
-                                             NM_SETTING_PARSE_FLAGS_BEST_EFFORT,
-                                             &error)) {
+        /* Most users only look at the ID, UUID and type of most profiles. Only
+         * deserialize the full settings when they get accessed. Settings that
+         * fail to deserialize then get logged by _lazy_settings_error_cb(). */
+        if (!_nm_connection_replace_settings_lazy((NMConnection *) self,
+                                                  settings,
+                                                  _lazy_settings_error_cb,
+                                                  &error)) {
             NML_NMCLIENT_LOG_E(_nm_object_get_client(self),
                                "[%s] failure to update settings: %s",
                                _nm_object_get_path(self),
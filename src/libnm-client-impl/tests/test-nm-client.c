@@ -1586,6 +1586,55 @@ test_client_wait_shutdown(void)
 
 /*****************************************************************************/
 
+static void
+test_object_types(void)
+{
+    nmtstc_auto_service_cleanup NMTstcServiceInfo *sinfo      = NULL;
+    gs_unref_object NMClient                      *client     = NULL;
+    gs_unref_object NMConnection                  *connection = NULL;
+    NMDeviceWifi                                  *wifi;
+    gs_unref_variant GVariant                     *ret   = NULL;
+    gs_free_error GError                          *error = NULL;
+
+    sinfo = nmtstc_service_init();
+    if (!nmtstc_service_available(sinfo))
+        return;
+
+    connection = nmtst_create_minimal_connection("test-object-types",
+                                                 NULL,
+                                                 NM_SETTING_WIRED_SETTING_NAME,
+                                                 NULL);
+    nmtstc_service_add_connection(sinfo, connection, TRUE, NULL);
+
+    client = nmtstc_context_object_new(NM_TYPE_CLIENT,
+                                       TRUE,
+                                       NM_CLIENT_OBJECT_TYPES,
+                                       (guint) NM_CLIENT_OBJECT_TYPES_DEVICES,
+                                       NULL);
+    g_assert_cmpint(nm_client_get_object_types(client), ==, NM_CLIENT_OBJECT_TYPES_DEVICES);
+
+    wifi = (NMDeviceWifi *) nmtstc_service_add_device(sinfo, client, "AddWifiDevice", "wlan0");
+    g_assert(NM_IS_DEVICE_WIFI(wifi));
+
+    ret = g_dbus_proxy_call_sync(sinfo->proxy,
+                                 "AddWifiAp",
+                                 g_variant_new("(sss)", "wlan0", "test-ap", expected_bssid),
+                                 G_DBUS_CALL_FLAGS_NO_AUTO_START,
+                                 3000,
+                                 NULL,
+                                 &error);
+    nmtst_assert_success(ret, error);
+
+    nmtst_main_context_iterate_until(NULL, 200, FALSE);
+
+    /* Neither the connection nor the access point are cached. */
+    g_assert_cmpint(nm_client_get_connections(client)->len, ==, 0);
+    g_assert_cmpint(nm_device_wifi_get_access_points(wifi)->len, ==, 0);
+    g_assert(nm_client_get_device_by_iface(client, "wlan0") == NM_DEVICE(wifi));
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -1613,6 +1662,7 @@ main(int argc, char **argv)
     g_test_add_func("/libnm/device-connection-compatibility", test_device_connection_compatibility);
     g_test_add_func("/libnm/connection/invalid", test_connection_invalid);
     g_test_add_func("/libnm/test_client_wait_shutdown", test_client_wait_shutdown);
+    g_test_add_func("/libnm/object-types", test_object_types);
 
     return g_test_run();
 }
@@ -60,6 +60,12 @@ test_add_connection(void)
 
     g_assert(gl.remote != NULL);
 
+    /* The connection setting is available without deserializing the rest. */
+    g_assert_cmpstr(nm_connection_get_id(NM_CONNECTION(gl.remote)), ==, TEST_CON_ID);
+    g_assert_cmpstr(nm_connection_get_connection_type(NM_CONNECTION(gl.remote)),
+                    ==,
+                    NM_SETTING_WIRED_SETTING_NAME);
+
     /* Make sure the connection is the same as what we added */
     g_assert(
         nm_connection_compare(connection, NM_CONNECTION(gl.remote), NM_SETTING_COMPARE_FLAG_EXACT)
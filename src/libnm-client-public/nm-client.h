@@ -39,6 +39,38 @@ typedef enum /*< flags >*/ {
     NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD           = 0x4,
 } NMClientInstanceFlags;
 
+/**
+ * NMClientObjectTypes:
+ * @NM_CLIENT_OBJECT_TYPES_NONE: cache none of the optional object types. The
+ *   NetworkManager, Settings and DnsManager objects are always cached.
+ * @NM_CLIENT_OBJECT_TYPES_DEVICES: cache #NMDevice objects.
+ * @NM_CLIENT_OBJECT_TYPES_ACTIVE_CONNECTIONS: cache #NMActiveConnection objects.
+ * @NM_CLIENT_OBJECT_TYPES_CONNECTIONS: cache #NMRemoteConnection objects.
+ * @NM_CLIENT_OBJECT_TYPES_ACCESS_POINTS: cache #NMAccessPoint objects.
+ * @NM_CLIENT_OBJECT_TYPES_WIFI_P2P_PEERS: cache #NMWifiP2PPeer objects.
+ * @NM_CLIENT_OBJECT_TYPES_IP_CONFIGS: cache #NMIPConfig objects.
+ * @NM_CLIENT_OBJECT_TYPES_DHCP_CONFIGS: cache #NMDhcpConfig objects.
+ * @NM_CLIENT_OBJECT_TYPES_CHECKPOINTS: cache #NMCheckpoint objects.
+ * @NM_CLIENT_OBJECT_TYPES_ALL: cache all objects. This is the default.
+ *
+ * Selects the types of objects that #NMClient mirrors from D-Bus.
+ * See #NMClient:object-types.
+ *
+ * Since: 1.48
+ */
+typedef enum /*< flags >*/ {
+    NM_CLIENT_OBJECT_TYPES_NONE               = 0,
+    NM_CLIENT_OBJECT_TYPES_DEVICES            = 0x1,
+    NM_CLIENT_OBJECT_TYPES_ACTIVE_CONNECTIONS = 0x2,
+    NM_CLIENT_OBJECT_TYPES_CONNECTIONS        = 0x4,
+    NM_CLIENT_OBJECT_TYPES_ACCESS_POINTS      = 0x8,
+    NM_CLIENT_OBJECT_TYPES_WIFI_P2P_PEERS     = 0x10,
+    NM_CLIENT_OBJECT_TYPES_IP_CONFIGS         = 0x20,
+    NM_CLIENT_OBJECT_TYPES_DHCP_CONFIGS       = 0x40,
+    NM_CLIENT_OBJECT_TYPES_CHECKPOINTS        = 0x80,
+    NM_CLIENT_OBJECT_TYPES_ALL                = 0xFF,
+} NMClientObjectTypes;
+
 #define NM_TYPE_CLIENT            (nm_client_get_type())
 #define NM_CLIENT(obj)            (G_TYPE_CHECK_INSTANCE_CAST((obj), NM_TYPE_CLIENT, NMClient))
 #define NM_CLIENT_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST((klass), NM_TYPE_CLIENT, NMClientClass))
@@ -54,6 +86,7 @@ typedef enum /*< flags >*/ {
 #define NM_CLIENT_DBUS_CONNECTION "dbus-connection"
 #define NM_CLIENT_DBUS_NAME_OWNER "dbus-name-owner"
 #define NM_CLIENT_INSTANCE_FLAGS  "instance-flags"
+#define NM_CLIENT_OBJECT_TYPES    "object-types"
 
 _NM_DEPRECATED_SYNC_WRITABLE_PROPERTY
 #define NM_CLIENT_NETWORKING_ENABLED "networking-enabled"
@@ -175,6 +208,9 @@ NMClient *nm_client_new_finish(GAsyncResult *result, GError **error);
 NM_AVAILABLE_IN_1_24
 NMClientInstanceFlags nm_client_get_instance_flags(NMClient *self);
 
+NM_AVAILABLE_IN_1_48
+NMClientObjectTypes nm_client_get_object_types(NMClient *self);
+
 NM_AVAILABLE_IN_1_22
 GDBusConnection *nm_client_get_dbus_connection(NMClient *client);
 
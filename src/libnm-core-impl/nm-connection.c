@@ -53,6 +53,8 @@ G_DEFINE_INTERFACE(NMConnection, nm_connection, G_TYPE_OBJECT)
 
 static gboolean _nm_connection_clear_settings(NMConnection *connection, NMConnectionPrivate *priv);
 
+static void _lazy_settings_load(NMConnectionPrivate *priv);
+
 /*****************************************************************************/
 
 void
@@ -61,7 +63,10 @@ _nm_connection_private_clear(NMConnectionPrivate *priv)
     if (priv->self) {
         _nm_connection_clear_settings(priv->self, priv);
         nm_clear_pointer(&priv->path, nm_ref_string_unref);
-        priv->self = NULL;
+        nm_clear_pointer(&priv->lazy_settings, g_variant_unref);
+        g_clear_error(&priv->verify_error);
+        priv->verify_cached = FALSE;
+        priv->self          = NULL;
     }
 }
 
@@ -76,7 +81,7 @@ _nm_connection_private_free(gpointer data)
 }
 
 static NMConnectionPrivate *
-_nm_connection_get_private_from_qdata(NMConnection *connection)
+_nm_connection_get_private_from_qdata(NMConnection *connection, gboolean load_lazy)
 {
     GQuark               key;
     NMConnectionPrivate *priv;
@@ -95,29 +100,50 @@ _nm_connection_get_private_from_qdata(NMConnection *connection)
         g_object_set_qdata_full((GObject *) connection, key, priv, _nm_connection_private_free);
     }
 
+    if (load_lazy && G_UNLIKELY(priv->lazy_settings))
+        _lazy_settings_load(priv);
+
     return priv;
 }
 
-#define NM_CONNECTION_GET_PRIVATE(connection)                                  \
-    ({                                                                         \
-        NMConnection        *_connection = (connection);                       \
-        NMConnectionPrivate *_priv;                                            \
-                                                                               \
-        if (G_LIKELY(NM_IS_SIMPLE_CONNECTION(_connection)))                    \
-            _priv = _NM_SIMPLE_CONNECTION_GET_CONNECTION_PRIVATE(_connection); \
-        else                                                                   \
-            _priv = _nm_connection_get_private_from_qdata(_connection);        \
-                                                                               \
-        nm_assert(_priv && _priv->self == _connection);                        \
-                                                                               \
-        _priv;                                                                 \
+#define _NM_CONNECTION_GET_PRIVATE(connection, load_lazy)                          \
+    ({                                                                             \
+        NMConnection        *_connection = (connection);                           \
+        NMConnectionPrivate *_priv;                                                \
+                                                                                   \
+        if (G_LIKELY(NM_IS_SIMPLE_CONNECTION(_connection)))                        \
+            _priv = _NM_SIMPLE_CONNECTION_GET_CONNECTION_PRIVATE(_connection);     \
+        else                                                                       \
+            _priv = _nm_connection_get_private_from_qdata(_connection, load_lazy); \
+                                                                                   \
+        nm_assert(_priv && _priv->self == _connection);                            \
+                                                                                   \
+        _priv;                                                                     \
     })
 
+#define NM_CONNECTION_GET_PRIVATE(connection)         _NM_CONNECTION_GET_PRIVATE(connection, TRUE)
+#define NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection) _NM_CONNECTION_GET_PRIVATE(connection, FALSE)
+
+/* The connection setting of lazy settings is always deserialized right away.
+ * Looking it up does not require to load the rest. */
+#define NM_CONNECTION_GET_PRIVATE_FOR_META_TYPE(connection, meta_type) \
+    ((meta_type) == NM_META_SETTING_TYPE_CONNECTION                    \
+         ? NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection)               \
+         : NM_CONNECTION_GET_PRIVATE(connection))
+
 /*****************************************************************************/
 
+static void
+_content_changed(NMConnectionPrivate *priv)
+{
+    /* invalidates the cached result of _nm_connection_verify(). */
+    priv->content_generation++;
+}
+
 static void
 _signal_emit_changed(NMConnection *self)
 {
+    _content_changed(NM_CONNECTION_GET_PRIVATE_NO_LOAD(self));
     g_signal_emit(self, signals[CHANGED], 0);
 }
 
@@ -144,6 +170,11 @@ _setting_notify_changed_cb(NMSetting *setting, GParamSpec *pspec, NMConnection *
 static void
 _setting_notify_connect(NMConnection *connection, NMSetting *setting)
 {
+    /* A sealed setting never changes, but it may be shared by many connections.
+     * Don't give it a handler for each of them. */
+    if (_nm_setting_is_sealed(setting))
+        return;
+
     g_signal_connect(setting, "notify", G_CALLBACK(_setting_notify_changed_cb), connection);
 }
 
@@ -165,6 +196,10 @@ static void
 _setting_notify_unblock(NMConnection *connection, NMSetting *setting)
 {
     g_signal_handlers_unblock_by_func(setting, G_CALLBACK(_setting_notify_changed_cb), connection);
+
+    /* While blocked, the setting may have changed without us noticing (e.g.
+     * updating or clearing secrets). Assume that it did. */
+    _content_changed(NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection));
 }
 
 /*****************************************************************************/
@@ -175,6 +210,11 @@ _nm_connection_clear_settings(NMConnection *connection, NMConnectionPrivate *pri
     gboolean changed = FALSE;
     int      i;
 
+    if (priv->lazy_settings) {
+        nm_clear_pointer(&priv->lazy_settings, g_variant_unref);
+        changed = TRUE;
+    }
+
     for (i = 0; i < (int) _NM_META_SETTING_TYPE_NUM; i++) {
         if (priv->settings[i]) {
             _setting_notify_disconnect(connection, priv->settings[i]);
@@ -293,7 +333,8 @@ _nm_connection_get_setting_by_metatype_unsafe(NMConnection *connection, NMMetaSe
 {
     g_return_val_if_fail(NM_IS_CONNECTION(connection), NULL);
 
-    return _get_setting_by_metatype(NM_CONNECTION_GET_PRIVATE(connection), meta_type);
+    return _get_setting_by_metatype(NM_CONNECTION_GET_PRIVATE_FOR_META_TYPE(connection, meta_type),
+                                    meta_type);
 }
 
 /**
@@ -320,7 +361,8 @@ nm_connection_get_setting(NMConnection *connection, GType setting_type)
     if (!setting_info)
         g_return_val_if_reached(NULL);
 
-    setting = NM_CONNECTION_GET_PRIVATE(connection)->settings[setting_info->meta_type];
+    setting = NM_CONNECTION_GET_PRIVATE_FOR_META_TYPE(connection, setting_info->meta_type)
+                  ->settings[setting_info->meta_type];
 
     nm_assert(!setting || G_TYPE_CHECK_INSTANCE_TYPE(setting, setting_type));
 
@@ -359,8 +401,9 @@ nm_connection_get_setting_by_name(NMConnection *connection, const char *name)
     g_return_val_if_fail(NM_IS_CONNECTION(connection), NULL);
 
     setting_info = nm_meta_setting_infos_by_name(name);
-    return setting_info ? _get_setting_by_metatype(NM_CONNECTION_GET_PRIVATE(connection),
-                                                   setting_info->meta_type)
+    return setting_info ? _get_setting_by_metatype(
+               NM_CONNECTION_GET_PRIVATE_FOR_META_TYPE(connection, setting_info->meta_type),
+               setting_info->meta_type)
                         : NULL;
 }
 
@@ -549,7 +592,7 @@ _nm_connection_replace_settings(NMConnection       *connection,
         n_settings++;
     }
 
-    if (_nm_connection_clear_settings(connection, NM_CONNECTION_GET_PRIVATE(connection)))
+    if (_nm_connection_clear_settings(connection, NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection)))
         changed = TRUE;
     else
         changed = (n_settings > 0);
@@ -604,6 +647,131 @@ nm_connection_replace_settings(NMConnection *connection, GVariant *new_settings,
                                            error);
 }
 
+static void
+_lazy_settings_load(NMConnectionPrivate *priv)
+{
+    gs_unref_variant GVariant *lazy_settings = g_steal_pointer(&priv->lazy_settings);
+    GVariantIter               iter;
+    const char                *setting_name;
+    GVariant                  *setting_dict;
+
+    /* This is like _nm_connection_replace_settings() with best-effort. The
+     * connection setting was already created by _nm_connection_replace_settings_lazy().
+     * Settings that fail to deserialize are skipped and reported to the
+     * lazy_error_func.
+     *
+     * The settings are not considered changed, the "changed" signal was already
+     * emitted when the lazy settings were set. */
+    g_variant_iter_init(&iter, lazy_settings);
+    while (g_variant_iter_next(&iter, "{&s@a{sv}}", &setting_name, &setting_dict)) {
+        gs_unref_variant GVariant *setting_dict_free = setting_dict;
+        gs_free_error GError      *local             = NULL;
+        const NMMetaSettingInfo   *setting_info;
+        NMSetting                 *setting;
+
+        setting_info = nm_meta_setting_infos_by_name(setting_name);
+        if (!setting_info || setting_info->meta_type == NM_META_SETTING_TYPE_CONNECTION
+            || priv->settings[setting_info->meta_type])
+            continue;
+
+        setting = _nm_setting_new_from_dbus(setting_info->get_setting_gtype(),
+                                            setting_dict,
+                                            lazy_settings,
+                                            NM_SETTING_PARSE_FLAGS_BEST_EFFORT,
+                                            &local);
+        if (!setting) {
+            if (local && priv->lazy_error_func) {
+                g_prefix_error(&local, "%s: ", setting_name);
+                priv->lazy_error_func(priv->self, local);
+            }
+            continue;
+        }
+
+        priv->settings[setting_info->meta_type] = setting;
+        _setting_notify_connect(priv->self, setting);
+    }
+
+    _content_changed(priv);
+}
+
+/**
+ * _nm_connection_replace_settings_lazy:
+ * @connection: a #NMConnection which is not a #NMSimpleConnection
+ * @new_settings: a #GVariant of type %NM_VARIANT_TYPE_CONNECTION, with the new settings
+ * @error_func: (nullable): called for each setting that fails to deserialize
+ * @error: location to store error, or %NULL
+ *
+ * Like _nm_connection_replace_settings() with %NM_SETTING_PARSE_FLAGS_BEST_EFFORT,
+ * but only the #NMSettingConnection gets deserialized right away. That is enough
+ * for nm_connection_get_id(), nm_connection_get_uuid() and similar. The other
+ * settings are deserialized when they are accessed the first time.
+ *
+ * With best-effort, individual settings that fail to deserialize are skipped.
+ * Those failures are reported to @error_func, possibly only later, when the
+ * settings get loaded.
+ *
+ * This is used by NMRemoteConnection, where most users only look at a few
+ * properties of most profiles.
+ *
+ * Returns: %TRUE if connection was updated, %FALSE if @new_settings is not
+ *   of type %NM_VARIANT_TYPE_CONNECTION (in which case @connection will be
+ *   unchanged).
+ */
+gboolean
+_nm_connection_replace_settings_lazy(NMConnection             *connection,
+                                     GVariant                 *new_settings,
+                                     NMConnectionLazyErrorFunc error_func,
+                                     GError                  **error)
+{
+    NMConnectionPrivate       *priv;
+    gs_unref_variant GVariant *s_con_dict = NULL;
+    NMSetting                 *s_con      = NULL;
+
+    g_return_val_if_fail(NM_IS_CONNECTION(connection), FALSE);
+    g_return_val_if_fail(!NM_IS_SIMPLE_CONNECTION(connection), FALSE);
+    g_return_val_if_fail(new_settings, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (!g_variant_is_of_type(new_settings, NM_VARIANT_TYPE_CONNECTION)) {
+        g_set_error(error,
+                    NM_CONNECTION_ERROR,
+                    NM_CONNECTION_ERROR_FAILED,
+                    _("invalid settings of type \"%s\""),
+                    g_variant_get_type_string(new_settings));
+        return FALSE;
+    }
+
+    s_con_dict = g_variant_lookup_value(new_settings,
+                                        NM_SETTING_CONNECTION_SETTING_NAME,
+                                        NM_VARIANT_TYPE_SETTING);
+    if (s_con_dict) {
+        gs_free_error GError *local = NULL;
+
+        s_con = _nm_setting_new_from_dbus(NM_TYPE_SETTING_CONNECTION,
+                                          s_con_dict,
+                                          new_settings,
+                                          NM_SETTING_PARSE_FLAGS_BEST_EFFORT,
+                                          &local);
+        if (!s_con && local && error_func) {
+            g_prefix_error(&local, "%s: ", NM_SETTING_CONNECTION_SETTING_NAME);
+            error_func(connection, local);
+        }
+    }
+
+    priv = NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection);
+
+    _nm_connection_clear_settings(connection, priv);
+
+    if (s_con)
+        _nm_connection_add_setting(connection, s_con);
+
+    priv->lazy_settings   = g_variant_ref_sink(new_settings);
+    priv->lazy_error_func = error_func;
+
+    _signal_emit_changed(connection);
+    return TRUE;
+}
+
 /**
  * nm_connection_replace_settings_from_connection:
  * @connection: a #NMConnection
@@ -661,6 +829,59 @@ nm_connection_replace_settings_from_connection(NMConnection *connection,
         _signal_emit_changed(connection);
 }
 
+/**
+ * _nm_connection_new_interned:
+ * @connection: the #NMConnection
+ * @intern_table: the intern table from _nm_setting_intern_table_new()
+ *
+ * Creates a new connection with the same content as @connection, but with
+ * the interned (and sealed) instance of each setting. Afterwards, identical
+ * settings of different connections are the same instance. @connection
+ * itself is not modified.
+ *
+ * If all settings of @connection already are the interned instances,
+ * @connection itself is returned. So interning a connection again
+ * does not create another copy.
+ *
+ * The settings of the returned connection must not be modified.
+ *
+ * Returns: (transfer full): the new #NMConnection, or @connection.
+ */
+NMConnection *
+_nm_connection_new_interned(NMConnection *connection, GHashTable *intern_table)
+{
+    NMConnection        *clone;
+    NMConnectionPrivate *priv;
+    NMConnectionPrivate *clone_priv;
+    int                  i;
+
+    g_return_val_if_fail(NM_IS_CONNECTION(connection), NULL);
+    g_return_val_if_fail(intern_table, NULL);
+
+    priv = NM_CONNECTION_GET_PRIVATE(connection);
+
+    for (i = 0; i < (int) _NM_META_SETTING_TYPE_NUM; i++) {
+        if (priv->settings[i]
+            && (!_nm_setting_is_sealed(priv->settings[i])
+                || g_hash_table_lookup(intern_table, priv->settings[i]) != priv->settings[i]))
+            break;
+    }
+    if (i == (int) _NM_META_SETTING_TYPE_NUM)
+        return g_object_ref(connection);
+
+    clone = nm_simple_connection_new();
+    _nm_connection_set_path_rstr(clone, _nm_connection_get_path_rstr(connection));
+
+    clone_priv = NM_CONNECTION_GET_PRIVATE(clone);
+
+    for (i = 0; i < (int) _NM_META_SETTING_TYPE_NUM; i++) {
+        if (priv->settings[i])
+            clone_priv->settings[i] = _nm_setting_intern(intern_table, priv->settings[i]);
+    }
+
+    return clone;
+}
+
 /**
  * nm_connection_clear_settings:
  * @connection: a #NMConnection
@@ -672,7 +893,7 @@ nm_connection_clear_settings(NMConnection *connection)
 {
     g_return_if_fail(NM_IS_CONNECTION(connection));
 
-    if (_nm_connection_clear_settings(connection, NM_CONNECTION_GET_PRIVATE(connection)))
+    if (_nm_connection_clear_settings(connection, NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection)))
         _signal_emit_changed(connection);
 }
 
@@ -1816,10 +2037,9 @@ nm_connection_verify(NMConnection *connection, GError **error)
     return result == NM_SETTING_VERIFY_SUCCESS || result == NM_SETTING_VERIFY_NORMALIZABLE;
 }
 
-NMSettingVerifyResult
-_nm_connection_verify(NMConnection *connection, GError **error)
+static NMSettingVerifyResult
+_connection_verify(NMConnection *connection, NMConnectionPrivate *priv, GError **error)
 {
-    NMConnectionPrivate  *priv;
     NMSettingIPConfig    *s_ip4;
     NMSettingIPConfig    *s_ip6;
     NMSettingProxy       *s_proxy;
@@ -1827,11 +2047,6 @@ _nm_connection_verify(NMConnection *connection, GError **error)
     NMSettingVerifyResult normalizable_error_type = NM_SETTING_VERIFY_SUCCESS;
     int                   i;
 
-    g_return_val_if_fail(NM_IS_CONNECTION(connection), NM_SETTING_VERIFY_ERROR);
-    g_return_val_if_fail(!error || !*error, NM_SETTING_VERIFY_ERROR);
-
-    priv = NM_CONNECTION_GET_PRIVATE(connection);
-
     if (!_get_setting_by_metatype(priv, NM_META_SETTING_TYPE_CONNECTION)) {
         g_set_error_literal(error,
                             NM_CONNECTION_ERROR,
@@ -1970,6 +2185,70 @@ _nm_connection_verify(NMConnection *connection, GError **error)
     return NM_SETTING_VERIFY_SUCCESS;
 }
 
+static gboolean
+_verify_result_cacheable(NMConnectionPrivate *priv)
+{
+    NMSetting *s;
+    int        IS_IPv4;
+
+    /* The getters of addresses, routes, qdiscs, tfilters and SR-IOV VFs
+     * return mutable objects. Modifying those in place does not notify
+     * the setting, so we would not notice that a cached result got stale. */
+    for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+        s = priv->settings[IS_IPv4 ? NM_META_SETTING_TYPE_IP4_CONFIG
+                                   : NM_META_SETTING_TYPE_IP6_CONFIG];
+        if (s
+            && (nm_setting_ip_config_get_num_addresses(NM_SETTING_IP_CONFIG(s)) > 0
+                || nm_setting_ip_config_get_num_routes(NM_SETTING_IP_CONFIG(s)) > 0))
+            return FALSE;
+    }
+
+    s = priv->settings[NM_META_SETTING_TYPE_TC_CONFIG];
+    if (s
+        && (nm_setting_tc_config_get_num_qdiscs(NM_SETTING_TC_CONFIG(s)) > 0
+            || nm_setting_tc_config_get_num_tfilters(NM_SETTING_TC_CONFIG(s)) > 0))
+        return FALSE;
+
+    s = priv->settings[NM_META_SETTING_TYPE_SRIOV];
+    if (s && nm_setting_sriov_get_num_vfs(NM_SETTING_SRIOV(s)) > 0)
+        return FALSE;
+
+    return TRUE;
+}
+
+NMSettingVerifyResult
+_nm_connection_verify(NMConnection *connection, GError **error)
+{
+    NMConnectionPrivate *priv;
+    GError              *local = NULL;
+
+    g_return_val_if_fail(NM_IS_CONNECTION(connection), NM_SETTING_VERIFY_ERROR);
+    g_return_val_if_fail(!error || !*error, NM_SETTING_VERIFY_ERROR);
+
+    priv = NM_CONNECTION_GET_PRIVATE(connection);
+
+    if (!_verify_result_cacheable(priv)) {
+        priv->verify_cached = FALSE;
+        g_clear_error(&priv->verify_error);
+        return _connection_verify(connection, priv, error);
+    }
+
+    /* The same profile gets verified over and over (when adding, updating,
+     * normalizing, reloading from disk, ...). As long as the content did not
+     * change since the last time, the result is the same. */
+    if (!priv->verify_cached || priv->verify_generation != priv->content_generation) {
+        g_clear_error(&priv->verify_error);
+        priv->verify_result     = _connection_verify(connection, priv, &local);
+        priv->verify_error      = local;
+        priv->verify_generation = priv->content_generation;
+        priv->verify_cached     = TRUE;
+    }
+
+    if (error && priv->verify_error)
+        *error = g_error_copy(priv->verify_error);
+    return priv->verify_result;
+}
+
 /**
  * nm_connection_verify_secrets:
  * @connection: the #NMConnection to verify in
@@ -2749,7 +3028,10 @@ nm_connection_to_dbus_full(NMConnection                           *connection,
             any = TRUE;
             g_variant_builder_init(&builder, NM_VARIANT_TYPE_CONNECTION);
         }
-        g_variant_builder_add(&builder, "{s@a{sv}}", nm_setting_get_name(setting), setting_dict);
+        g_variant_builder_add_value(
+            &builder,
+            g_variant_new_dict_entry(g_variant_new_string(nm_setting_get_name(setting)),
+                                     setting_dict));
     }
 
     if (!any)
@@ -2999,13 +3281,13 @@ nm_connection_set_path(NMConnection *connection, const char *path)
 {
     g_return_if_fail(NM_IS_CONNECTION(connection));
 
-    nm_ref_string_reset_str(&NM_CONNECTION_GET_PRIVATE(connection)->path, path);
+    nm_ref_string_reset_str(&NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection)->path, path);
 }
 
 void
 _nm_connection_set_path_rstr(NMConnection *connection, NMRefString *path)
 {
-    nm_ref_string_reset(&NM_CONNECTION_GET_PRIVATE(connection)->path, path);
+    nm_ref_string_reset(&NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection)->path, path);
 }
 
 /**
@@ -3022,13 +3304,13 @@ nm_connection_get_path(NMConnection *connection)
 {
     g_return_val_if_fail(NM_IS_CONNECTION(connection), NULL);
 
-    return nm_ref_string_get_str(NM_CONNECTION_GET_PRIVATE(connection)->path);
+    return nm_ref_string_get_str(NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection)->path);
 }
 
 NMRefString *
 _nm_connection_get_path_rstr(NMConnection *connection)
 {
-    return NM_CONNECTION_GET_PRIVATE(connection)->path;
+    return NM_CONNECTION_GET_PRIVATE_NO_LOAD(connection)->path;
 }
 
 /**
@@ -493,6 +493,7 @@ _cert_impl_set(NMSetting8021x         *setting,
 
     g_return_val_if_fail(NM_IS_SETTING_802_1X(setting), FALSE);
     g_return_val_if_fail(!error || !*error, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
     if (value) {
         g_return_val_if_fail(g_utf8_validate(value, -1, NULL), FALSE);
         g_return_val_if_fail(NM_IN_SET(scheme,
@@ -773,6 +774,7 @@ nm_setting_802_1x_add_eap_method(NMSetting8021x *setting, const char *eap)
 
     g_return_val_if_fail(NM_IS_SETTING_802_1X(setting), FALSE);
     g_return_val_if_fail(eap != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     for (iter = priv->eap; iter; iter = g_slist_next(iter)) {
@@ -799,6 +801,7 @@ nm_setting_802_1x_remove_eap_method(NMSetting8021x *setting, guint32 i)
     GSList                *elt;
 
     g_return_if_fail(NM_IS_SETTING_802_1X(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     elt  = g_slist_nth(priv->eap, i);
@@ -826,6 +829,7 @@ nm_setting_802_1x_remove_eap_method_by_value(NMSetting8021x *setting, const char
 
     g_return_val_if_fail(NM_IS_SETTING_802_1X(setting), FALSE);
     g_return_val_if_fail(eap != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     for (iter = priv->eap; iter; iter = g_slist_next(iter)) {
@@ -850,6 +854,7 @@ nm_setting_802_1x_clear_eap_methods(NMSetting8021x *setting)
     NMSetting8021xPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_802_1X(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     g_slist_free_full(priv->eap, g_free);
@@ -1167,6 +1172,7 @@ nm_setting_802_1x_add_altsubject_match(NMSetting8021x *setting, const char *alts
 
     g_return_val_if_fail(NM_IS_SETTING_802_1X(setting), FALSE);
     g_return_val_if_fail(altsubject_match != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     for (iter = priv->altsubject_matches; iter; iter = g_slist_next(iter)) {
@@ -1193,6 +1199,7 @@ nm_setting_802_1x_remove_altsubject_match(NMSetting8021x *setting, guint32 i)
     GSList                *elt;
 
     g_return_if_fail(NM_IS_SETTING_802_1X(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     elt  = g_slist_nth(priv->altsubject_matches, i);
@@ -1222,6 +1229,7 @@ nm_setting_802_1x_remove_altsubject_match_by_value(NMSetting8021x *setting,
 
     g_return_val_if_fail(NM_IS_SETTING_802_1X(setting), FALSE);
     g_return_val_if_fail(altsubject_match != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     for (iter = priv->altsubject_matches; iter; iter = g_slist_next(iter)) {
@@ -1246,6 +1254,7 @@ nm_setting_802_1x_clear_altsubject_matches(NMSetting8021x *setting)
     NMSetting8021xPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_802_1X(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     g_slist_free_full(priv->altsubject_matches, g_free);
@@ -1792,6 +1801,7 @@ nm_setting_802_1x_add_phase2_altsubject_match(NMSetting8021x *setting,
 
     g_return_val_if_fail(NM_IS_SETTING_802_1X(setting), FALSE);
     g_return_val_if_fail(phase2_altsubject_match != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     for (iter = priv->phase2_altsubject_matches; iter; iter = g_slist_next(iter)) {
@@ -1819,6 +1829,7 @@ nm_setting_802_1x_remove_phase2_altsubject_match(NMSetting8021x *setting, guint3
     GSList                *elt;
 
     g_return_if_fail(NM_IS_SETTING_802_1X(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     elt  = g_slist_nth(priv->phase2_altsubject_matches, i);
@@ -1848,6 +1859,7 @@ nm_setting_802_1x_remove_phase2_altsubject_match_by_value(NMSetting8021x *settin
 
     g_return_val_if_fail(NM_IS_SETTING_802_1X(setting), FALSE);
     g_return_val_if_fail(phase2_altsubject_match != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     for (iter = priv->phase2_altsubject_matches; iter; iter = g_slist_next(iter)) {
@@ -1873,6 +1885,7 @@ nm_setting_802_1x_clear_phase2_altsubject_matches(NMSetting8021x *setting)
     NMSetting8021xPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_802_1X(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_802_1X_GET_PRIVATE(setting);
     g_slist_free_full(priv->phase2_altsubject_matches, g_free);
@@ -3161,6 +3174,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     NMSetting8021x        *setting = NM_SETTING_802_1X(object);
     NMSetting8021xPrivate *priv    = NM_SETTING_802_1X_GET_PRIVATE(setting);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_EAP:
         g_slist_free_full(priv->eap, g_free);
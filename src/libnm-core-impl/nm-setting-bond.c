@@ -674,6 +674,7 @@ nm_setting_bond_add_option(NMSettingBond *setting, const char *name, const char
     NMSettingBondPrivate *priv;
 
     g_return_val_if_fail(NM_IS_SETTING_BOND(setting), FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!name)
         return FALSE;
@@ -705,6 +706,7 @@ nm_setting_bond_remove_option(NMSettingBond *setting, const char *name)
     NMSettingBondPrivate *priv;
 
     g_return_val_if_fail(NM_IS_SETTING_BOND(setting), FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_BOND_GET_PRIVATE(setting);
 
@@ -1264,6 +1266,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingBondPrivate *priv = NM_SETTING_BOND_GET_PRIVATE(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_OPTIONS:
         nm_clear_g_free(&priv->options_idx_cache);
@@ -1355,7 +1359,10 @@ nm_setting_bond_class_init(NMSettingBondClass *klass)
                                             NM_SETTING_PROPERTY_TO_DBUS_FCN_GPROP_TYPE_STRDICT,
                                         .compare_fcn   = compare_fcn_options,
                                         .from_dbus_fcn = _nm_setting_property_from_dbus_fcn_gprop,
-                                        .from_dbus_is_full = TRUE));
+                                        .from_dbus_is_full = TRUE),
+        .direct_offset =
+            NM_STRUCT_OFFSET_ENSURE_TYPE(GHashTable *, NMSettingBondPrivate, options),
+        .to_dbus_strdict_direct = TRUE);
 
     /* ---dbus---
      * property: interface-name
@@ -157,6 +157,7 @@ nm_setting_bridge_port_add_vlan(NMSettingBridgePort *setting, NMBridgeVlan *vlan
 
     g_return_if_fail(NM_IS_SETTING_BRIDGE_PORT(setting));
     g_return_if_fail(vlan);
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_BRIDGE_PORT_GET_PRIVATE(setting);
 
@@ -223,6 +224,7 @@ nm_setting_bridge_port_remove_vlan(NMSettingBridgePort *setting, guint idx)
     NMSettingBridgePortPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_BRIDGE_PORT(setting));
+    _nm_setting_return_if_sealed(setting);
     priv = NM_SETTING_BRIDGE_PORT_GET_PRIVATE(setting);
 
     g_return_if_fail(idx < priv->vlans->len);
@@ -257,6 +259,7 @@ nm_setting_bridge_port_remove_vlan_by_vid(NMSettingBridgePort *setting,
         vid_end = vid_start;
 
     g_return_val_if_fail(NM_IS_SETTING_BRIDGE_PORT(setting), FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_BRIDGE_PORT_GET_PRIVATE(setting);
 
@@ -289,6 +292,7 @@ nm_setting_bridge_port_clear_vlans(NMSettingBridgePort *setting)
     NMSettingBridgePortPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_BRIDGE_PORT(setting));
+    _nm_setting_return_if_sealed(setting);
     priv = NM_SETTING_BRIDGE_PORT_GET_PRIVATE(setting);
 
     if (priv->vlans->len != 0) {
@@ -400,6 +404,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingBridgePortPrivate *priv = NM_SETTING_BRIDGE_PORT_GET_PRIVATE(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_VLANS:
         g_ptr_array_unref(priv->vlans);
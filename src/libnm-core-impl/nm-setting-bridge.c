@@ -783,6 +783,7 @@ nm_setting_bridge_add_vlan(NMSettingBridge *setting, NMBridgeVlan *vlan)
 
     g_return_if_fail(NM_IS_SETTING_BRIDGE(setting));
     g_return_if_fail(vlan);
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_BRIDGE_GET_PRIVATE(setting);
 
@@ -849,6 +850,7 @@ nm_setting_bridge_remove_vlan(NMSettingBridge *setting, guint idx)
     NMSettingBridgePrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_BRIDGE(setting));
+    _nm_setting_return_if_sealed(setting);
     priv = NM_SETTING_BRIDGE_GET_PRIVATE(setting);
 
     g_return_if_fail(idx < priv->vlans->len);
@@ -879,6 +881,7 @@ nm_setting_bridge_remove_vlan_by_vid(NMSettingBridge *setting, guint16 vid_start
     guint                   i;
 
     g_return_val_if_fail(NM_IS_SETTING_BRIDGE(setting), FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
     priv = NM_SETTING_BRIDGE_GET_PRIVATE(setting);
 
     if (vid_end == 0)
@@ -909,6 +912,7 @@ nm_setting_bridge_clear_vlans(NMSettingBridge *setting)
     NMSettingBridgePrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_BRIDGE(setting));
+    _nm_setting_return_if_sealed(setting);
     priv = NM_SETTING_BRIDGE_GET_PRIVATE(setting);
 
     if (priv->vlans->len != 0) {
@@ -1365,6 +1369,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingBridgePrivate *priv = NM_SETTING_BRIDGE_GET_PRIVATE(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_VLANS:
         g_ptr_array_unref(priv->vlans);
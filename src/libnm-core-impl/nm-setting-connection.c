@@ -454,6 +454,7 @@ nm_setting_connection_add_permission(NMSettingConnection *setting,
     g_return_val_if_fail(NM_IS_SETTING_CONNECTION(setting), FALSE);
     g_return_val_if_fail(ptype, FALSE);
     g_return_val_if_fail(pitem, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!nm_streq0(ptype, NM_SETTINGS_CONNECTION_PERMISSION_USER))
         return FALSE;
@@ -498,6 +499,7 @@ nm_setting_connection_remove_permission(NMSettingConnection *setting, guint32 id
     NMSettingConnectionPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_CONNECTION(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_CONNECTION_GET_PRIVATE(setting);
 
@@ -533,6 +535,7 @@ nm_setting_connection_remove_permission_by_value(NMSettingConnection *setting,
     g_return_val_if_fail(NM_IS_SETTING_CONNECTION(setting), FALSE);
     g_return_val_if_fail(ptype, FALSE);
     g_return_val_if_fail(pitem, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!nm_streq0(ptype, NM_SETTINGS_CONNECTION_PERMISSION_USER))
         return FALSE;
@@ -964,6 +967,7 @@ nm_setting_connection_add_secondary(NMSettingConnection *setting, const char *se
 
     g_return_val_if_fail(NM_IS_SETTING_CONNECTION(setting), FALSE);
     g_return_val_if_fail(sec_uuid, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_CONNECTION_GET_PRIVATE(setting);
 
@@ -987,6 +991,7 @@ nm_setting_connection_remove_secondary(NMSettingConnection *setting, guint32 idx
     NMSettingConnectionPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_CONNECTION(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_CONNECTION_GET_PRIVATE(setting);
 
@@ -1012,6 +1017,7 @@ nm_setting_connection_remove_secondary_by_value(NMSettingConnection *setting, co
 
     g_return_val_if_fail(NM_IS_SETTING_CONNECTION(setting), FALSE);
     g_return_val_if_fail(sec_uuid, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_CONNECTION_GET_PRIVATE(setting);
 
@@ -1845,6 +1851,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingConnectionPrivate *priv = NM_SETTING_CONNECTION_GET_PRIVATE(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_PERMISSIONS:
     {
@@ -233,6 +233,7 @@ nm_setting_dcb_set_priority_flow_control(NMSettingDcb *setting,
 
     g_return_if_fail(NM_IS_SETTING_DCB(setting));
     g_return_if_fail(user_priority <= 7);
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_DCB_GET_PRIVATE(setting);
     if (priv->pfc[user_priority] != uint_enabled) {
@@ -291,6 +292,7 @@ nm_setting_dcb_set_priority_group_id(NMSettingDcb *setting, guint user_priority,
     g_return_if_fail(NM_IS_SETTING_DCB(setting));
     g_return_if_fail(user_priority <= 7);
     g_return_if_fail(group_id <= 7 || group_id == 15);
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_DCB_GET_PRIVATE(setting);
     if (priv->priority_group_id[user_priority] != group_id) {
@@ -336,6 +338,7 @@ nm_setting_dcb_set_priority_group_bandwidth(NMSettingDcb *setting,
     g_return_if_fail(NM_IS_SETTING_DCB(setting));
     g_return_if_fail(group_id <= 7);
     g_return_if_fail(bandwidth_percent <= 100);
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_DCB_GET_PRIVATE(setting);
     if (priv->priority_group_bandwidth[group_id] != bandwidth_percent) {
@@ -382,6 +385,7 @@ nm_setting_dcb_set_priority_bandwidth(NMSettingDcb *setting,
     g_return_if_fail(NM_IS_SETTING_DCB(setting));
     g_return_if_fail(user_priority <= 7);
     g_return_if_fail(bandwidth_percent <= 100);
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_DCB_GET_PRIVATE(setting);
     if (priv->priority_bandwidth[user_priority] != bandwidth_percent) {
@@ -428,6 +432,7 @@ nm_setting_dcb_set_priority_strict_bandwidth(NMSettingDcb *setting,
 
     g_return_if_fail(NM_IS_SETTING_DCB(setting));
     g_return_if_fail(user_priority <= 7);
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_DCB_GET_PRIVATE(setting);
     if (priv->priority_strict[user_priority] != uint_strict) {
@@ -473,6 +478,7 @@ nm_setting_dcb_set_priority_traffic_class(NMSettingDcb *setting,
     g_return_if_fail(NM_IS_SETTING_DCB(setting));
     g_return_if_fail(user_priority <= 7);
     g_return_if_fail(traffic_class <= 7);
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_DCB_GET_PRIVATE(setting);
     if (priv->priority_traffic_class[user_priority] != traffic_class) {
@@ -791,6 +797,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingDcbPrivate *priv = NM_SETTING_DCB_GET_PRIVATE(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_PRIORITY_FLOW_CONTROL:
         SET_ARRAY_FROM_GVALUE(value, priv->pfc);
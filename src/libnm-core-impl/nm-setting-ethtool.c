@@ -199,6 +199,7 @@ nm_setting_ethtool_set_feature(NMSettingEthtool *setting, const char *optname, N
     g_return_if_fail(NM_IS_SETTING_ETHTOOL(setting));
     g_return_if_fail(optname && nm_ethtool_optname_is_feature(optname));
     g_return_if_fail(NM_IN_SET(value, NM_TERNARY_DEFAULT, NM_TERNARY_FALSE, NM_TERNARY_TRUE));
+    _nm_setting_return_if_sealed(setting);
 
     if (value == NM_TERNARY_DEFAULT)
         nm_setting_option_set(NM_SETTING(setting), optname, NULL);
@@ -220,6 +221,7 @@ void
 nm_setting_ethtool_clear_features(NMSettingEthtool *setting)
 {
     g_return_if_fail(NM_IS_SETTING_ETHTOOL(setting));
+    _nm_setting_return_if_sealed(setting);
 
     nm_setting_option_clear_by_name(NM_SETTING(setting), nm_ethtool_optname_is_feature);
 }
@@ -4122,6 +4122,7 @@ nm_setting_ip_config_add_dns(NMSettingIPConfig *setting, const char *dns)
 {
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(dns, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!_ip_config_add_dns(setting, dns))
         return FALSE;
@@ -4143,6 +4144,7 @@ nm_setting_ip_config_remove_dns(NMSettingIPConfig *setting, int idx)
     NMSettingIPConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -4171,6 +4173,7 @@ nm_setting_ip_config_remove_dns_by_value(NMSettingIPConfig *setting, const char
 
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(dns, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -4207,6 +4210,7 @@ nm_setting_ip_config_clear_dns(NMSettingIPConfig *setting)
     NMSettingIPConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -4273,6 +4277,7 @@ nm_setting_ip_config_add_dns_search(NMSettingIPConfig *setting, const char *dns_
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(dns_search != NULL, FALSE);
     g_return_val_if_fail(dns_search[0] != '\0', FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -4296,6 +4301,7 @@ nm_setting_ip_config_remove_dns_search(NMSettingIPConfig *setting, int idx)
     NMSettingIPConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -4322,6 +4328,7 @@ nm_setting_ip_config_remove_dns_search_by_value(NMSettingIPConfig *setting, cons
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(dns_search != NULL, FALSE);
     g_return_val_if_fail(dns_search[0] != '\0', FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -4342,6 +4349,7 @@ void
 nm_setting_ip_config_clear_dns_searches(NMSettingIPConfig *setting)
 {
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (nm_strvarray_clear(&NM_SETTING_IP_CONFIG_GET_PRIVATE(setting)->dns_search.arr))
         _notify(setting, PROP_DNS_SEARCH);
@@ -4463,6 +4471,7 @@ nm_setting_ip_config_add_dns_option(NMSettingIPConfig *setting, const char *dns_
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(dns_option != NULL, FALSE);
     g_return_val_if_fail(dns_option[0] != '\0', FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!_nm_utils_dns_option_validate(dns_option, NULL, NULL, AF_UNSPEC, NULL))
         return FALSE;
@@ -4492,6 +4501,7 @@ nm_setting_ip_config_remove_dns_option(NMSettingIPConfig *setting, int idx)
     NMSettingIPConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -4521,6 +4531,7 @@ nm_setting_ip_config_remove_dns_option_by_value(NMSettingIPConfig *setting, cons
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(dns_option != NULL, FALSE);
     g_return_val_if_fail(dns_option[0] != '\0', FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -4549,6 +4560,7 @@ nm_setting_ip_config_clear_dns_options(NMSettingIPConfig *setting, gboolean is_s
     NMSettingIPConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
     if (!priv->dns_options.arr) {
@@ -4637,6 +4649,7 @@ nm_setting_ip_config_add_address(NMSettingIPConfig *setting, NMIPAddress *addres
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(address != NULL, FALSE);
     g_return_val_if_fail(address->family == NM_SETTING_IP_CONFIG_GET_ADDR_FAMILY(setting), FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
     for (i = 0; i < priv->addresses->len; i++) {
@@ -4663,6 +4676,7 @@ nm_setting_ip_config_remove_address(NMSettingIPConfig *setting, int idx)
     NMSettingIPConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
     g_return_if_fail(idx >= 0 && idx < priv->addresses->len);
@@ -4689,6 +4703,7 @@ nm_setting_ip_config_remove_address_by_value(NMSettingIPConfig *setting, NMIPAdd
 
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(address != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
     for (i = 0; i < priv->addresses->len; i++) {
@@ -4713,6 +4728,7 @@ nm_setting_ip_config_clear_addresses(NMSettingIPConfig *setting)
     NMSettingIPConfigPrivate *priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (priv->addresses->len != 0) {
         g_ptr_array_set_size(priv->addresses, 0);
@@ -4794,6 +4810,7 @@ nm_setting_ip_config_add_route(NMSettingIPConfig *setting, NMIPRoute *route)
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(route != NULL, FALSE);
     g_return_val_if_fail(route->family == NM_SETTING_IP_CONFIG_GET_ADDR_FAMILY(setting), FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
     for (i = 0; i < priv->routes->len; i++) {
@@ -4821,6 +4838,7 @@ nm_setting_ip_config_remove_route(NMSettingIPConfig *setting, int idx)
     NMSettingIPConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
     g_return_if_fail(idx >= 0 && idx < priv->routes->len);
@@ -4848,6 +4866,7 @@ nm_setting_ip_config_remove_route_by_value(NMSettingIPConfig *setting, NMIPRoute
 
     g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), FALSE);
     g_return_val_if_fail(route != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
     for (i = 0; i < priv->routes->len; i++) {
@@ -4874,6 +4893,7 @@ nm_setting_ip_config_clear_routes(NMSettingIPConfig *setting)
     NMSettingIPConfigPrivate *priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (priv->routes->len != 0) {
         g_ptr_array_set_size(priv->routes, 0);
@@ -4990,6 +5010,7 @@ nm_setting_ip_config_add_routing_rule(NMSettingIPConfig *setting, NMIPRoutingRul
     g_return_if_fail(NM_IS_IP_ROUTING_RULE(routing_rule, TRUE));
     g_return_if_fail(_ip_routing_rule_get_addr_family(routing_rule)
                      == NM_SETTING_IP_CONFIG_GET_ADDR_FAMILY(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -5017,6 +5038,7 @@ nm_setting_ip_config_remove_routing_rule(NMSettingIPConfig *setting, guint idx)
     NMSettingIPConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
     g_return_if_fail(priv->routing_rules && idx < priv->routing_rules->len);
@@ -5039,6 +5061,7 @@ nm_setting_ip_config_clear_routing_rules(NMSettingIPConfig *setting)
     NMSettingIPConfigPrivate *priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (priv->routing_rules && priv->routing_rules->len > 0) {
         g_ptr_array_set_size(priv->routing_rules, 0);
@@ -5385,6 +5408,7 @@ nm_setting_ip_config_add_dhcp_reject_server(NMSettingIPConfig *setting, const ch
 {
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
     g_return_if_fail(server);
+    _nm_setting_return_if_sealed(setting);
 
     nm_strvarray_ensure_and_add(&NM_SETTING_IP_CONFIG_GET_PRIVATE(setting)->dhcp_reject_servers.arr,
                                 server);
@@ -5406,6 +5430,7 @@ nm_setting_ip_config_remove_dhcp_reject_server(NMSettingIPConfig *setting, guint
     NMSettingIPConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
 
@@ -5427,6 +5452,7 @@ void
 nm_setting_ip_config_clear_dhcp_reject_servers(NMSettingIPConfig *setting)
 {
     g_return_if_fail(NM_IS_SETTING_IP_CONFIG(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (nm_strvarray_clear(&NM_SETTING_IP_CONFIG_GET_PRIVATE(setting)->dhcp_reject_servers.arr))
         _notify(setting, PROP_DHCP_REJECT_SERVERS);
@@ -6240,6 +6266,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     const char *const        *strv;
     guint                     i;
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_DNS:
     {
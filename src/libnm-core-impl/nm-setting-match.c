@@ -96,6 +96,7 @@ nm_setting_match_add_interface_name(NMSettingMatch *setting, const char *interfa
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
     g_return_if_fail(interface_name);
+    _nm_setting_return_if_sealed(setting);
 
     nm_strvarray_ensure_and_add(&setting->interface_name.arr, interface_name);
     _notify(setting, PROP_INTERFACE_NAME);
@@ -114,6 +115,7 @@ void
 nm_setting_match_remove_interface_name(NMSettingMatch *setting, int idx)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
+    _nm_setting_return_if_sealed(setting);
 
     g_return_if_fail(setting->interface_name.arr && idx >= 0
                      && idx < setting->interface_name.arr->len);
@@ -138,6 +140,7 @@ nm_setting_match_remove_interface_name_by_value(NMSettingMatch *setting, const c
 {
     g_return_val_if_fail(NM_IS_SETTING_MATCH(setting), FALSE);
     g_return_val_if_fail(interface_name, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!nm_strvarray_remove_first(setting->interface_name.arr, interface_name))
         return FALSE;
@@ -158,6 +161,7 @@ void
 nm_setting_match_clear_interface_names(NMSettingMatch *setting)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (nm_strvarray_clear(&setting->interface_name.arr))
         _notify(setting, PROP_INTERFACE_NAME);
@@ -236,6 +240,7 @@ nm_setting_match_add_kernel_command_line(NMSettingMatch *setting, const char *ke
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
     g_return_if_fail(kernel_command_line);
+    _nm_setting_return_if_sealed(setting);
 
     nm_strvarray_ensure_and_add(&setting->kernel_command_line.arr, kernel_command_line);
     _notify(setting, PROP_KERNEL_COMMAND_LINE);
@@ -254,6 +259,7 @@ void
 nm_setting_match_remove_kernel_command_line(NMSettingMatch *setting, guint idx)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
+    _nm_setting_return_if_sealed(setting);
 
     g_return_if_fail(setting->kernel_command_line.arr
                      && idx < setting->kernel_command_line.arr->len);
@@ -279,6 +285,7 @@ nm_setting_match_remove_kernel_command_line_by_value(NMSettingMatch *setting,
 {
     g_return_val_if_fail(NM_IS_SETTING_MATCH(setting), FALSE);
     g_return_val_if_fail(kernel_command_line, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!nm_strvarray_remove_first(setting->kernel_command_line.arr, kernel_command_line))
         return FALSE;
@@ -299,6 +306,7 @@ void
 nm_setting_match_clear_kernel_command_lines(NMSettingMatch *setting)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (nm_strvarray_clear(&setting->kernel_command_line.arr))
         _notify(setting, PROP_KERNEL_COMMAND_LINE);
@@ -374,6 +382,7 @@ nm_setting_match_add_driver(NMSettingMatch *setting, const char *driver)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
     g_return_if_fail(driver);
+    _nm_setting_return_if_sealed(setting);
 
     nm_strvarray_ensure_and_add(&setting->driver.arr, driver);
     _notify(setting, PROP_DRIVER);
@@ -392,6 +401,7 @@ void
 nm_setting_match_remove_driver(NMSettingMatch *setting, guint idx)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
+    _nm_setting_return_if_sealed(setting);
 
     g_return_if_fail(setting->driver.arr && idx < setting->driver.arr->len);
 
@@ -415,6 +425,7 @@ nm_setting_match_remove_driver_by_value(NMSettingMatch *setting, const char *dri
 {
     g_return_val_if_fail(NM_IS_SETTING_MATCH(setting), FALSE);
     g_return_val_if_fail(driver, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!nm_strvarray_remove_first(setting->driver.arr, driver))
         return FALSE;
@@ -435,6 +446,7 @@ void
 nm_setting_match_clear_drivers(NMSettingMatch *setting)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (nm_strvarray_clear(&setting->driver.arr))
         _notify(setting, PROP_DRIVER);
@@ -510,6 +522,7 @@ nm_setting_match_add_path(NMSettingMatch *setting, const char *path)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
     g_return_if_fail(path);
+    _nm_setting_return_if_sealed(setting);
 
     nm_strvarray_ensure_and_add(&setting->path.arr, path);
     _notify(setting, PROP_PATH);
@@ -528,6 +541,7 @@ void
 nm_setting_match_remove_path(NMSettingMatch *setting, guint idx)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
+    _nm_setting_return_if_sealed(setting);
 
     g_return_if_fail(setting->path.arr && idx < setting->path.arr->len);
 
@@ -551,6 +565,7 @@ nm_setting_match_remove_path_by_value(NMSettingMatch *setting, const char *path)
 {
     g_return_val_if_fail(NM_IS_SETTING_MATCH(setting), FALSE);
     g_return_val_if_fail(path, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!nm_strvarray_remove_first(setting->path.arr, path))
         return FALSE;
@@ -571,6 +586,7 @@ void
 nm_setting_match_clear_paths(NMSettingMatch *setting)
 {
     g_return_if_fail(NM_IS_SETTING_MATCH(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (nm_strvarray_clear(&setting->path.arr))
         _notify(setting, PROP_PATH);
@@ -310,6 +310,7 @@ nm_setting_ovs_external_ids_set_data(NMSettingOvsExternalIDs *setting,
     NMSettingOvsExternalIDsPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_OVS_EXTERNAL_IDS(self));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_OVS_EXTERNAL_IDS_GET_PRIVATE(self);
 
@@ -453,6 +454,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     NMSettingOvsExternalIDs        *self = NM_SETTING_OVS_EXTERNAL_IDS(object);
     NMSettingOvsExternalIDsPrivate *priv = NM_SETTING_OVS_EXTERNAL_IDS_GET_PRIVATE(self);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_DATA:
     {
@@ -148,6 +148,7 @@ nm_setting_ovs_other_config_set_data(NMSettingOvsOtherConfig *setting,
     NMSettingOvsOtherConfigPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_OVS_OTHER_CONFIG(self));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_OVS_OTHER_CONFIG_GET_PRIVATE(self);
 
@@ -291,6 +292,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     NMSettingOvsOtherConfig        *self = NM_SETTING_OVS_OTHER_CONFIG(object);
     NMSettingOvsOtherConfigPrivate *priv = NM_SETTING_OVS_OTHER_CONFIG_GET_PRIVATE(self);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_DATA:
     {
@@ -104,6 +104,7 @@ nm_setting_ovs_port_add_trunk(NMSettingOvsPort *self, NMRange *trunk)
 {
     g_return_if_fail(NM_IS_SETTING_OVS_PORT(self));
     g_return_if_fail(trunk);
+    _nm_setting_return_if_sealed(self);
 
     g_ptr_array_add(self->trunks, nm_range_ref(trunk));
     _notify(self, PROP_TRUNKS);
@@ -157,6 +158,7 @@ void
 nm_setting_ovs_port_remove_trunk(NMSettingOvsPort *self, guint idx)
 {
     g_return_if_fail(NM_IS_SETTING_OVS_PORT(self));
+    _nm_setting_return_if_sealed(self);
 
     g_return_if_fail(idx < self->trunks->len);
 
@@ -183,6 +185,7 @@ nm_setting_ovs_port_remove_trunk_by_value(NMSettingOvsPort *self, guint start, g
     guint    i;
 
     g_return_val_if_fail(NM_IS_SETTING_OVS_PORT(self), FALSE);
+    _nm_setting_return_val_if_sealed(self, FALSE);
 
     for (i = 0; i < self->trunks->len; i++) {
         trunk = (NMRange *) self->trunks->pdata[i];
@@ -207,6 +210,7 @@ void
 nm_setting_ovs_port_clear_trunks(NMSettingOvsPort *self)
 {
     g_return_if_fail(NM_IS_SETTING_OVS_PORT(self));
+    _nm_setting_return_if_sealed(self);
 
     if (self->trunks->len != 0) {
         g_ptr_array_set_size(self->trunks, 0);
@@ -543,6 +547,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingOvsPort *self = NM_SETTING_OVS_PORT(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_TRUNKS:
         g_ptr_array_unref(self->trunks);
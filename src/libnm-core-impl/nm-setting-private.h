@@ -37,6 +37,21 @@ typedef struct {
 
     /* D-Bus path of the connection, if any */
     struct _NMRefString *path;
+
+    /* Settings from D-Bus that are not yet deserialized. See
+     * _nm_connection_replace_settings_lazy(). */
+    GVariant                 *lazy_settings;
+    NMConnectionLazyErrorFunc lazy_error_func;
+
+    /* Bumped whenever the content of the connection changes (a setting gets
+     * added, removed or modified). The result of the last _nm_connection_verify()
+     * is only valid as long as @verify_generation matches. */
+    guint64 content_generation;
+    guint64 verify_generation;
+
+    GError               *verify_error;
+    NMSettingVerifyResult verify_result;
+    bool                  verify_cached : 1;
 } NMConnectionPrivate;
 
 extern GTypeClass *_nm_simple_connection_class_instance;
@@ -101,6 +116,15 @@ struct _NMSetting {
     struct _NMSettingPrivate *_priv;
 };
 
+/* A sealed setting may be shared by several connections (see _nm_setting_intern())
+ * and must not change. Setters that modify a setting other than through a direct
+ * property check this before touching any data. */
+#define _nm_setting_return_if_sealed(setting) \
+    g_return_if_fail(!_nm_setting_is_sealed((NMSetting *) (setting)))
+
+#define _nm_setting_return_val_if_sealed(setting, val) \
+    g_return_val_if_fail(!_nm_setting_is_sealed((NMSetting *) (setting)), (val))
+
 struct _NMSettingClass {
     GObjectClass parent;
 
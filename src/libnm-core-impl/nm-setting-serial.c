@@ -184,6 +184,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingSerialPrivate *priv = NM_SETTING_SERIAL_GET_PRIVATE(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_PARITY:
         priv->parity = g_value_get_enum(value);
@@ -755,6 +755,7 @@ nm_setting_sriov_add_vf(NMSettingSriov *setting, NMSriovVF *vf)
     g_return_if_fail(NM_IS_SETTING_SRIOV(setting));
     g_return_if_fail(vf);
     g_return_if_fail(vf->refcount > 0);
+    _nm_setting_return_if_sealed(setting);
 
     g_ptr_array_add(setting->vfs, nm_sriov_vf_dup(vf));
     _notify(setting, PROP_VFS);
@@ -774,6 +775,7 @@ nm_setting_sriov_remove_vf(NMSettingSriov *setting, guint idx)
 {
     g_return_if_fail(NM_IS_SETTING_SRIOV(setting));
     g_return_if_fail(idx < setting->vfs->len);
+    _nm_setting_return_if_sealed(setting);
 
     g_ptr_array_remove_index(setting->vfs, idx);
     _notify(setting, PROP_VFS);
@@ -796,6 +798,7 @@ nm_setting_sriov_remove_vf_by_index(NMSettingSriov *setting, guint index)
     guint i;
 
     g_return_val_if_fail(NM_IS_SETTING_SRIOV(setting), FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     for (i = 0; i < setting->vfs->len; i++) {
         if (nm_sriov_vf_get_index(setting->vfs->pdata[i]) == index) {
@@ -819,6 +822,7 @@ void
 nm_setting_sriov_clear_vfs(NMSettingSriov *setting)
 {
     g_return_if_fail(NM_IS_SETTING_SRIOV(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (setting->vfs->len != 0) {
         g_ptr_array_set_size(setting->vfs, 0);
@@ -1213,6 +1217,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingSriov *self = NM_SETTING_SRIOV(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_VFS:
         g_ptr_array_unref(self->vfs);
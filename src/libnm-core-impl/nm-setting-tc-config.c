@@ -1051,6 +1051,7 @@ nm_setting_tc_config_add_qdisc(NMSettingTCConfig *self, NMTCQdisc *qdisc)
 
     g_return_val_if_fail(NM_IS_SETTING_TC_CONFIG(self), FALSE);
     g_return_val_if_fail(qdisc != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(self, FALSE);
 
     for (i = 0; i < self->qdiscs->len; i++) {
         if (nm_tc_qdisc_equal(self->qdiscs->pdata[i], qdisc))
@@ -1075,6 +1076,7 @@ void
 nm_setting_tc_config_remove_qdisc(NMSettingTCConfig *self, guint idx)
 {
     g_return_if_fail(NM_IS_SETTING_TC_CONFIG(self));
+    _nm_setting_return_if_sealed(self);
 
     g_return_if_fail(idx < self->qdiscs->len);
 
@@ -1100,6 +1102,7 @@ nm_setting_tc_config_remove_qdisc_by_value(NMSettingTCConfig *self, NMTCQdisc *q
 
     g_return_val_if_fail(NM_IS_SETTING_TC_CONFIG(self), FALSE);
     g_return_val_if_fail(qdisc != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(self, FALSE);
 
     for (i = 0; i < self->qdiscs->len; i++) {
         if (nm_tc_qdisc_equal(self->qdiscs->pdata[i], qdisc)) {
@@ -1123,6 +1126,7 @@ void
 nm_setting_tc_config_clear_qdiscs(NMSettingTCConfig *self)
 {
     g_return_if_fail(NM_IS_SETTING_TC_CONFIG(self));
+    _nm_setting_return_if_sealed(self);
 
     if (self->qdiscs->len != 0) {
         g_ptr_array_set_size(self->qdiscs, 0);
@@ -1186,6 +1190,7 @@ nm_setting_tc_config_add_tfilter(NMSettingTCConfig *self, NMTCTfilter *tfilter)
 
     g_return_val_if_fail(NM_IS_SETTING_TC_CONFIG(self), FALSE);
     g_return_val_if_fail(tfilter != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(self, FALSE);
 
     for (i = 0; i < self->tfilters->len; i++) {
         if (nm_tc_tfilter_equal(self->tfilters->pdata[i], tfilter))
@@ -1211,6 +1216,7 @@ nm_setting_tc_config_remove_tfilter(NMSettingTCConfig *self, guint idx)
 {
     g_return_if_fail(NM_IS_SETTING_TC_CONFIG(self));
     g_return_if_fail(idx < self->tfilters->len);
+    _nm_setting_return_if_sealed(self);
 
     g_ptr_array_remove_index(self->tfilters, idx);
     _notify(self, PROP_TFILTERS);
@@ -1234,6 +1240,7 @@ nm_setting_tc_config_remove_tfilter_by_value(NMSettingTCConfig *self, NMTCTfilte
 
     g_return_val_if_fail(NM_IS_SETTING_TC_CONFIG(self), FALSE);
     g_return_val_if_fail(tfilter != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(self, FALSE);
 
     for (i = 0; i < self->tfilters->len; i++) {
         if (nm_tc_tfilter_equal(self->tfilters->pdata[i], tfilter)) {
@@ -1257,6 +1264,7 @@ void
 nm_setting_tc_config_clear_tfilters(NMSettingTCConfig *self)
 {
     g_return_if_fail(NM_IS_SETTING_TC_CONFIG(self));
+    _nm_setting_return_if_sealed(self);
 
     if (self->tfilters->len != 0) {
         g_ptr_array_set_size(self->tfilters, 0);
@@ -1710,6 +1718,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingTCConfig *self = NM_SETTING_TC_CONFIG(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_QDISCS:
         g_ptr_array_unref(self->qdiscs);
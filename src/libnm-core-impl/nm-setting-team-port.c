@@ -229,6 +229,7 @@ nm_setting_team_port_add_link_watcher(NMSettingTeamPort *setting, NMTeamLinkWatc
 {
     g_return_val_if_fail(NM_IS_SETTING_TEAM_PORT(setting), FALSE);
     g_return_val_if_fail(link_watcher != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     return _maybe_changed(setting,
                           nm_team_setting_value_link_watchers_add(
@@ -251,6 +252,7 @@ nm_setting_team_port_remove_link_watcher(NMSettingTeamPort *setting, guint idx)
     NMSettingTeamPortPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_TEAM_PORT(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_TEAM_PORT_GET_PRIVATE(setting);
 
@@ -277,6 +279,7 @@ nm_setting_team_port_remove_link_watcher_by_value(NMSettingTeamPort *setting,
 {
     g_return_val_if_fail(NM_IS_SETTING_TEAM_PORT(setting), FALSE);
     g_return_val_if_fail(link_watcher, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     return _maybe_changed(setting,
                           nm_team_setting_value_link_watchers_remove_by_value(
@@ -296,6 +299,7 @@ void
 nm_setting_team_port_clear_link_watchers(NMSettingTeamPort *setting)
 {
     g_return_if_fail(NM_IS_SETTING_TEAM_PORT(setting));
+    _nm_setting_return_if_sealed(setting);
 
     _maybe_changed(setting,
                    nm_team_setting_value_link_watchers_set_list(
@@ -460,6 +464,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     guint32                   changed;
     const GPtrArray          *v_ptrarr;
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case NM_TEAM_ATTRIBUTE_CONFIG:
         changed = nm_team_setting_config_set(priv->team_setting, g_value_get_string(value));
@@ -1025,6 +1025,7 @@ nm_setting_team_remove_runner_tx_hash_by_value(NMSettingTeam *setting, const cha
 
     g_return_val_if_fail(NM_IS_SETTING_TEAM(setting), FALSE);
     g_return_val_if_fail(txhash != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     arr = priv->team_setting->d.master.runner_tx_hash;
     if (arr) {
@@ -1098,6 +1099,7 @@ nm_setting_team_remove_runner_tx_hash(NMSettingTeam *setting, guint idx)
     NMSettingTeamPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_TEAM(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_TEAM_GET_PRIVATE(setting);
 
@@ -1126,6 +1128,7 @@ nm_setting_team_add_runner_tx_hash(NMSettingTeam *setting, const char *txhash)
 {
     g_return_val_if_fail(NM_IS_SETTING_TEAM(setting), FALSE);
     g_return_val_if_fail(txhash, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     return _maybe_changed(setting,
                           nm_team_setting_value_master_runner_tx_hash_add(
@@ -1189,6 +1192,7 @@ nm_setting_team_add_link_watcher(NMSettingTeam *setting, NMTeamLinkWatcher *link
 {
     g_return_val_if_fail(NM_IS_SETTING_TEAM(setting), FALSE);
     g_return_val_if_fail(link_watcher != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     return _maybe_changed(
         setting,
@@ -1211,6 +1215,7 @@ nm_setting_team_remove_link_watcher(NMSettingTeam *setting, guint idx)
     NMSettingTeamPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_TEAM(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_TEAM_GET_PRIVATE(setting);
 
@@ -1237,6 +1242,7 @@ nm_setting_team_remove_link_watcher_by_value(NMSettingTeam     *setting,
 {
     g_return_val_if_fail(NM_IS_SETTING_TEAM(setting), FALSE);
     g_return_val_if_fail(link_watcher, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     return _maybe_changed(setting,
                           nm_team_setting_value_link_watchers_remove_by_value(
@@ -1256,6 +1262,7 @@ void
 nm_setting_team_clear_link_watchers(NMSettingTeam *setting)
 {
     g_return_if_fail(NM_IS_SETTING_TEAM(setting));
+    _nm_setting_return_if_sealed(setting);
 
     _maybe_changed(setting,
                    nm_team_setting_value_link_watchers_set_list(
@@ -1408,6 +1415,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     guint32               changed;
     const GPtrArray      *v_ptrarr;
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case NM_TEAM_ATTRIBUTE_CONFIG:
         changed = nm_team_setting_config_set(priv->team_setting, g_value_get_string(value));
@@ -286,6 +286,7 @@ nm_setting_user_set_data(NMSettingUser *setting, const char *key, const char *va
 
     g_return_val_if_fail(NM_IS_SETTING_USER(self), FALSE);
     g_return_val_if_fail(!error || !*error, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!nm_setting_user_check_key(key, error))
         return FALSE;
@@ -451,6 +452,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     GHashTable           *data;
     const char           *key, *val;
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_DATA:
         nm_clear_g_free(&priv->keys);
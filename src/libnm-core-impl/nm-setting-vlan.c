@@ -249,6 +249,7 @@ nm_setting_vlan_add_priority_str(NMSettingVlan *setting, NMVlanPriorityMap map,
     g_return_val_if_fail(NM_IS_SETTING_VLAN(setting), FALSE);
     g_return_val_if_fail(map == NM_VLAN_INGRESS_MAP || map == NM_VLAN_EGRESS_MAP, FALSE);
     g_return_val_if_fail(str && str[0], FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     item = priority_map_new_from_str(map, str);
     if (!item)
@@ -361,6 +362,7 @@ nm_setting_vlan_add_priority(NMSettingVlan    *setting,
 
     g_return_val_if_fail(NM_IS_SETTING_VLAN(setting), FALSE);
     g_return_val_if_fail(map == NM_VLAN_INGRESS_MAP || map == NM_VLAN_EGRESS_MAP, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     list = get_map(setting, map);
     if (check_replace_duplicate_priority(list, from, to)) {
@@ -477,6 +479,7 @@ nm_setting_vlan_remove_priority(NMSettingVlan *setting, NMVlanPriorityMap map, g
 
     g_return_if_fail(NM_IS_SETTING_VLAN(setting));
     g_return_if_fail(map == NM_VLAN_INGRESS_MAP || map == NM_VLAN_EGRESS_MAP);
+    _nm_setting_return_if_sealed(setting);
 
     list = get_map(setting, map);
     g_return_if_fail(idx < g_slist_length(list));
@@ -536,6 +539,7 @@ nm_setting_vlan_remove_priority_by_value(NMSettingVlan    *setting,
 {
     g_return_val_if_fail(NM_IS_SETTING_VLAN(setting), FALSE);
     g_return_val_if_fail(map == NM_VLAN_INGRESS_MAP || map == NM_VLAN_EGRESS_MAP, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     return priority_map_remove_by_value(setting, map, from, to, FALSE);
 }
@@ -562,6 +566,7 @@ nm_setting_vlan_remove_priority_str_by_value(NMSettingVlan    *setting,
 
     g_return_val_if_fail(NM_IS_SETTING_VLAN(setting), FALSE);
     g_return_val_if_fail(map == NM_VLAN_INGRESS_MAP || map == NM_VLAN_EGRESS_MAP, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!nm_utils_vlan_priority_map_parse_str(map, str, TRUE, &from, &to, &is_wildcard_to))
         return FALSE;
@@ -583,6 +588,7 @@ nm_setting_vlan_clear_priorities(NMSettingVlan *setting, NMVlanPriorityMap map)
 
     g_return_if_fail(NM_IS_SETTING_VLAN(setting));
     g_return_if_fail(map == NM_VLAN_INGRESS_MAP || map == NM_VLAN_EGRESS_MAP);
+    _nm_setting_return_if_sealed(setting);
 
     list = get_map(setting, map);
     g_slist_free_full(list, g_free);
@@ -784,6 +790,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     NMSettingVlan        *setting = NM_SETTING_VLAN(object);
     NMSettingVlanPrivate *priv    = NM_SETTING_VLAN_GET_PRIVATE(setting);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_FLAGS:
         priv->flags = g_value_get_flags(value);
@@ -195,6 +195,7 @@ nm_setting_vpn_add_data_item(NMSettingVpn *setting, const char *key, const char
 
     g_return_if_fail(NM_IS_SETTING_VPN(setting));
     g_return_if_fail(key && key[0]);
+    _nm_setting_return_if_sealed(setting);
 
     g_hash_table_insert(_ensure_strdict(&NM_SETTING_VPN_GET_PRIVATE(setting)->data, FALSE),
                         g_strdup(key),
@@ -258,6 +259,7 @@ nm_setting_vpn_remove_data_item(NMSettingVpn *setting, const char *key)
 {
     g_return_val_if_fail(NM_IS_SETTING_VPN(setting), FALSE);
     g_return_val_if_fail(key && key[0], FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (nm_g_hash_table_remove(NM_SETTING_VPN_GET_PRIVATE(setting)->data, key)) {
         _notify(setting, PROP_DATA);
@@ -362,6 +364,7 @@ nm_setting_vpn_add_secret(NMSettingVpn *setting, const char *key, const char *se
 
     g_return_if_fail(NM_IS_SETTING_VPN(setting));
     g_return_if_fail(key && key[0]);
+    _nm_setting_return_if_sealed(setting);
 
     g_hash_table_insert(_ensure_strdict(&NM_SETTING_VPN_GET_PRIVATE(setting)->secrets, TRUE),
                         g_strdup(key),
@@ -425,6 +428,7 @@ nm_setting_vpn_remove_secret(NMSettingVpn *setting, const char *key)
 {
     g_return_val_if_fail(NM_IS_SETTING_VPN(setting), FALSE);
     g_return_val_if_fail(key && key[0], FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (nm_g_hash_table_remove(NM_SETTING_VPN_GET_PRIVATE(setting)->secrets, key)) {
         _notify(setting, PROP_SECRETS);
@@ -985,6 +989,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingVpnPrivate *priv = NM_SETTING_VPN_GET_PRIVATE(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_DATA:
     case PROP_SECRETS:
@@ -1147,9 +1153,12 @@ nm_setting_vpn_class_init(NMSettingVpnClass *klass)
                                                    "",
                                                    G_TYPE_HASH_TABLE,
                                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
-    _nm_properties_override_gobj(properties_override,
-                                 obj_properties[PROP_DATA],
-                                 &nm_sett_info_propert_type_strdict);
+    _nm_properties_override_gobj(
+        properties_override,
+        obj_properties[PROP_DATA],
+        &nm_sett_info_propert_type_strdict,
+        .direct_offset = NM_STRUCT_OFFSET_ENSURE_TYPE(GHashTable *, NMSettingVpnPrivate, data),
+        .to_dbus_strdict_direct = TRUE);
 
     /**
      * NMSettingVpn:secrets: (type GHashTable(utf8,utf8))
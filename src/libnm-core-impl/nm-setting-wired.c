@@ -354,6 +354,7 @@ nm_setting_wired_add_mac_denylist_item(NMSettingWired *setting, const char *mac)
 
     g_return_val_if_fail(NM_IS_SETTING_WIRED(setting), FALSE);
     g_return_val_if_fail(mac != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!_nm_utils_hwaddr_aton_exact(mac, mac_bin, ETH_ALEN))
         return FALSE;
@@ -387,6 +388,7 @@ nm_setting_wired_remove_mac_denylist_item(NMSettingWired *setting, guint idx)
     NMSettingWiredPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_WIRED(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_WIRED_GET_PRIVATE(setting);
     if (!priv->mac_address_denylist.arr) {
@@ -421,6 +423,7 @@ nm_setting_wired_remove_mac_denylist_item_by_value(NMSettingWired *setting, cons
 
     g_return_val_if_fail(NM_IS_SETTING_WIRED(setting), FALSE);
     g_return_val_if_fail(mac != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!_nm_utils_hwaddr_aton_exact(mac, mac_bin, ETH_ALEN))
         return FALSE;
@@ -452,6 +455,7 @@ void
 nm_setting_wired_clear_mac_denylist_items(NMSettingWired *setting)
 {
     g_return_if_fail(NM_IS_SETTING_WIRED(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (nm_strvarray_clear(&NM_SETTING_WIRED_GET_PRIVATE(setting)->mac_address_denylist.arr))
         _notify(setting, PROP_MAC_ADDRESS_DENYLIST);
@@ -790,6 +794,7 @@ nm_setting_wired_add_s390_option(NMSettingWired *setting, const char *key, const
     g_return_val_if_fail(NM_IS_SETTING_WIRED(setting), FALSE);
     g_return_val_if_fail(key, FALSE);
     g_return_val_if_fail(value, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_WIRED_GET_PRIVATE(setting);
 
@@ -844,6 +849,7 @@ nm_setting_wired_remove_s390_option(NMSettingWired *setting, const char *key)
 
     g_return_val_if_fail(NM_IS_SETTING_WIRED(setting), FALSE);
     g_return_val_if_fail(key, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_WIRED_GET_PRIVATE(setting);
 
@@ -1213,6 +1219,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 {
     NMSettingWiredPrivate *priv = NM_SETTING_WIRED_GET_PRIVATE(object);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_CLONED_MAC_ADDRESS:
         g_free(priv->cloned_mac_address);
@@ -1363,6 +1363,7 @@ nm_setting_wireguard_set_peer(NMSettingWireGuard *self, NMWireGuardPeer *peer, g
 
     g_return_if_fail(NM_IS_SETTING_WIREGUARD(self));
     g_return_if_fail(NM_IS_WIREGUARD_PEER(peer, TRUE));
+    _nm_setting_return_if_sealed(self);
 
     priv = NM_SETTING_WIREGUARD_GET_PRIVATE(self);
 
@@ -1391,6 +1392,7 @@ nm_setting_wireguard_append_peer(NMSettingWireGuard *self, NMWireGuardPeer *peer
 {
     g_return_if_fail(NM_IS_SETTING_WIREGUARD(self));
     g_return_if_fail(NM_IS_WIREGUARD_PEER(peer, TRUE));
+    _nm_setting_return_if_sealed(self);
 
     if (_peers_append(NM_SETTING_WIREGUARD_GET_PRIVATE(self), peer, TRUE))
         _peers_notify(self);
@@ -1412,6 +1414,7 @@ nm_setting_wireguard_remove_peer(NMSettingWireGuard *self, guint idx)
     NMSettingWireGuardPrivate *priv;
 
     g_return_val_if_fail(NM_IS_SETTING_WIREGUARD(self), FALSE);
+    _nm_setting_return_val_if_sealed(self, FALSE);
 
     priv = NM_SETTING_WIREGUARD_GET_PRIVATE(self);
 
@@ -1449,6 +1452,7 @@ nm_setting_wireguard_clear_peers(NMSettingWireGuard *self)
     guint l;
 
     g_return_val_if_fail(NM_IS_SETTING_WIREGUARD(self), 0);
+    _nm_setting_return_val_if_sealed(self, 0);
 
     l = _peers_clear(NM_SETTING_WIREGUARD_GET_PRIVATE(self));
     if (l > 0)
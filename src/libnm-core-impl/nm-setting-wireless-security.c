@@ -177,6 +177,7 @@ nm_setting_wireless_security_add_proto(NMSettingWirelessSecurity *setting, const
 
     g_return_val_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting), FALSE);
     g_return_val_if_fail(proto != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     for (iter = priv->proto; iter; iter = g_slist_next(iter)) {
@@ -203,6 +204,7 @@ nm_setting_wireless_security_remove_proto(NMSettingWirelessSecurity *setting, gu
     GSList                           *elt;
 
     g_return_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     elt  = g_slist_nth(priv->proto, i);
@@ -231,6 +233,7 @@ nm_setting_wireless_security_remove_proto_by_value(NMSettingWirelessSecurity *se
 
     g_return_val_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting), FALSE);
     g_return_val_if_fail(proto != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     for (iter = priv->proto; iter; iter = g_slist_next(iter)) {
@@ -256,6 +259,7 @@ nm_setting_wireless_security_clear_protos(NMSettingWirelessSecurity *setting)
     NMSettingWirelessSecurityPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     g_slist_free_full(priv->proto, g_free);
@@ -321,6 +325,7 @@ nm_setting_wireless_security_add_pairwise(NMSettingWirelessSecurity *setting, co
 
     g_return_val_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting), FALSE);
     g_return_val_if_fail(pairwise != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     for (iter = priv->pairwise; iter; iter = g_slist_next(iter)) {
@@ -348,6 +353,7 @@ nm_setting_wireless_security_remove_pairwise(NMSettingWirelessSecurity *setting,
     GSList                           *elt;
 
     g_return_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     elt  = g_slist_nth(priv->pairwise, i);
@@ -377,6 +383,7 @@ nm_setting_wireless_security_remove_pairwise_by_value(NMSettingWirelessSecurity
 
     g_return_val_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting), FALSE);
     g_return_val_if_fail(pairwise != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     for (iter = priv->pairwise; iter; iter = g_slist_next(iter)) {
@@ -402,6 +409,7 @@ nm_setting_wireless_security_clear_pairwise(NMSettingWirelessSecurity *setting)
     NMSettingWirelessSecurityPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     g_slist_free_full(priv->pairwise, g_free);
@@ -468,6 +476,7 @@ nm_setting_wireless_security_add_group(NMSettingWirelessSecurity *setting, const
 
     g_return_val_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting), FALSE);
     g_return_val_if_fail(group != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     for (iter = priv->group; iter; iter = g_slist_next(iter)) {
@@ -495,6 +504,7 @@ nm_setting_wireless_security_remove_group(NMSettingWirelessSecurity *setting, gu
     GSList                           *elt;
 
     g_return_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     elt  = g_slist_nth(priv->group, i);
@@ -525,6 +535,7 @@ nm_setting_wireless_security_remove_group_by_value(NMSettingWirelessSecurity *se
 
     g_return_val_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting), FALSE);
     g_return_val_if_fail(group != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     for (iter = priv->group; iter; iter = g_slist_next(iter)) {
@@ -550,6 +561,7 @@ nm_setting_wireless_security_clear_groups(NMSettingWirelessSecurity *setting)
     NMSettingWirelessSecurityPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     g_slist_free_full(priv->group, g_free);
@@ -693,6 +705,7 @@ nm_setting_wireless_security_set_wep_key(NMSettingWirelessSecurity *setting,
 
     g_return_if_fail(NM_IS_SETTING_WIRELESS_SECURITY(setting));
     g_return_if_fail(idx < 4);
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
     switch (idx) {
@@ -1321,6 +1334,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     NMSettingWirelessSecurity        *setting = NM_SETTING_WIRELESS_SECURITY(object);
     NMSettingWirelessSecurityPrivate *priv    = NM_SETTING_WIRELESS_SECURITY_GET_PRIVATE(setting);
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_PROTO:
         g_slist_free_full(priv->proto, g_free);
@@ -539,6 +539,7 @@ nm_setting_wireless_add_mac_denylist_item(NMSettingWireless *setting, const char
 
     g_return_val_if_fail(NM_IS_SETTING_WIRELESS(setting), FALSE);
     g_return_val_if_fail(mac != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!_nm_utils_hwaddr_aton_exact(mac, mac_bin, ETH_ALEN))
         return FALSE;
@@ -572,6 +573,7 @@ nm_setting_wireless_remove_mac_denylist_item(NMSettingWireless *setting, guint i
     NMSettingWirelessPrivate *priv;
 
     g_return_if_fail(NM_IS_SETTING_WIRELESS(setting));
+    _nm_setting_return_if_sealed(setting);
 
     priv = NM_SETTING_WIRELESS_GET_PRIVATE(setting);
     if (!priv->mac_address_denylist.arr) {
@@ -606,6 +608,7 @@ nm_setting_wireless_remove_mac_denylist_item_by_value(NMSettingWireless *setting
 
     g_return_val_if_fail(NM_IS_SETTING_WIRELESS(setting), FALSE);
     g_return_val_if_fail(mac != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     if (!_nm_utils_hwaddr_aton_exact(mac, mac_bin, ETH_ALEN))
         return FALSE;
@@ -638,6 +641,7 @@ void
 nm_setting_wireless_clear_mac_denylist_items(NMSettingWireless *setting)
 {
     g_return_if_fail(NM_IS_SETTING_WIRELESS(setting));
+    _nm_setting_return_if_sealed(setting);
 
     if (nm_strvarray_clear(&NM_SETTING_WIRELESS_GET_PRIVATE(setting)->mac_address_denylist.arr))
         _notify(setting, PROP_MAC_ADDRESS_DENYLIST);
@@ -835,6 +839,7 @@ nm_setting_wireless_add_seen_bssid(NMSettingWireless *setting, const char *bssid
 
     g_return_val_if_fail(NM_IS_SETTING_WIRELESS(setting), FALSE);
     g_return_val_if_fail(bssid != NULL, FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     priv = NM_SETTING_WIRELESS_GET_PRIVATE(setting);
 
@@ -1437,6 +1442,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     _PropertyEnums            prop1 = PROP_0;
     _PropertyEnums            prop2 = PROP_0;
 
+    _nm_setting_return_if_sealed(object);
+
     switch (prop_id) {
     case PROP_CLONED_MAC_ADDRESS:
         bool_val = !!priv->cloned_mac_address;
@@ -61,6 +61,11 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMSetting, PROP_NAME, );
 
 typedef struct _NMSettingPrivate {
     GenData *gendata;
+
+    /* Only valid if the setting is sealed. */
+    guint content_hash;
+
+    bool is_sealed : 1;
 } NMSettingPrivate;
 
 G_DEFINE_ABSTRACT_TYPE(NMSetting, nm_setting, G_TYPE_OBJECT)
@@ -203,6 +208,13 @@ _nm_properties_override_assert(const NMSettInfoProperty *prop_info)
             /* if we don't have a param_spec, we cannot have typdata_from_dbus.gprop_fcn. */
             nm_assert(property_type->from_dbus_fcn || !property_type->typdata_from_dbus.gprop_fcn);
         }
+
+        if (prop_info->to_dbus_strdict_direct) {
+            nm_assert(property_type->to_dbus_fcn == _nm_setting_property_to_dbus_fcn_gprop);
+            nm_assert(property_type->typdata_to_dbus.gprop_type
+                      == NM_SETTING_PROPERTY_TO_DBUS_FCN_GPROP_TYPE_STRDICT);
+            nm_assert(property_type->direct_type == NM_VALUE_TYPE_UNSPEC);
+        }
     }
 #endif
     return TRUE;
@@ -892,6 +904,9 @@ _nm_setting_property_set_property_direct(GObject      *object,
     sett_info = _nm_setting_class_get_sett_info(NM_SETTING_GET_CLASS(setting));
     nm_assert(sett_info);
 
+    /* Sealed settings may be shared and must not change. */
+    g_return_if_fail(!NM_SETTING_GET_PRIVATE(setting)->is_sealed);
+
     property_info = _nm_sett_info_property_lookup_by_param_spec(sett_info, pspec);
     if (!property_info)
         goto out_fail;
@@ -1391,6 +1406,17 @@ _nm_setting_property_to_dbus_fcn_gprop(_NM_SETT_INFO_PROP_TO_DBUS_FCN_ARGS _nm_n
     nm_assert(property_info->param_spec);
     nm_assert(property_info->property_type->to_dbus_fcn == _nm_setting_property_to_dbus_fcn_gprop);
 
+    if (property_info->to_dbus_strdict_direct) {
+        GHashTable *strdict;
+
+        /* The getter of these properties returns a deep copy of the hash table,
+         * which is never the (NULL) default. Read the private field instead. */
+        strdict = *((GHashTable *const *) _nm_setting_get_private(setting,
+                                                                  sett_info,
+                                                                  property_info->direct_offset));
+        return nm_strdict_to_variant_ass(strdict);
+    }
+
     g_value_init(&prop_value, property_info->param_spec->value_type);
 
     g_object_get_property(G_OBJECT(setting), property_info->param_spec->name, &prop_value);
@@ -1839,6 +1865,14 @@ _nm_setting_property_from_dbus_fcn_gprop(_NM_SETT_INFO_PROP_FROM_DBUS_FCN_ARGS _
     return TRUE;
 }
 
+static void
+_variant_builder_add_sv(GVariantBuilder *builder, const char *key, GVariant *value)
+{
+    g_variant_builder_add_value(
+        builder,
+        g_variant_new_dict_entry(g_variant_new_string(key), g_variant_new_variant(value)));
+}
+
 static GVariant *
 property_to_dbus(const NMSettInfoSetting                *sett_info,
                  const NMSettInfoProperty               *property_info,
@@ -1965,12 +1999,13 @@ _nm_setting_to_dbus(NMSetting                              *setting,
 
     g_variant_builder_init(&builder, NM_VARIANT_TYPE_SETTING);
 
+    /* Add the entries with g_variant_builder_add_value(). That avoids parsing
+     * a format string for each property. */
     n_properties = _nm_setting_option_get_all(setting, &gendata_keys, NULL);
     for (i = 0; i < n_properties; i++) {
-        g_variant_builder_add(&builder,
-                              "{sv}",
-                              gendata_keys[i],
-                              g_hash_table_lookup(priv->gendata->hash, gendata_keys[i]));
+        _variant_builder_add_sv(&builder,
+                                gendata_keys[i],
+                                g_hash_table_lookup(priv->gendata->hash, gendata_keys[i]));
     }
 
     sett_info = _nm_setting_class_get_sett_info(NM_SETTING_GET_CLASS(setting));
@@ -1980,9 +2015,8 @@ _nm_setting_to_dbus(NMSetting                              *setting,
 
         dbus_value =
             property_to_dbus(sett_info, property_info, connection, setting, flags, options, FALSE);
-        if (dbus_value) {
-            g_variant_builder_add(&builder, "{sv}", property_info->name, dbus_value);
-        }
+        if (dbus_value)
+            _variant_builder_add_sv(&builder, property_info->name, dbus_value);
     }
 
     return g_variant_builder_end(&builder);
@@ -2423,6 +2457,185 @@ nm_setting_duplicate(NMSetting *setting)
     return dst;
 }
 
+/*****************************************************************************/
+
+static guint
+_setting_hash_compute(NMSetting *setting)
+{
+    gs_unref_variant GVariant *variant = NULL;
+    gs_unref_variant GVariant *normal  = NULL;
+    NMHashState                h;
+
+    variant =
+        g_variant_ref_sink(_nm_setting_to_dbus(setting, NULL, NM_CONNECTION_SERIALIZE_ALL, NULL));
+    normal = g_variant_get_normal_form(variant);
+
+    nm_hash_init(&h, 1196396929u);
+    nm_hash_update_val(&h, G_OBJECT_TYPE(setting));
+    nm_hash_update(&h, g_variant_get_data(normal), g_variant_get_size(normal));
+    return nm_hash_complete(&h);
+}
+
+/**
+ * _nm_setting_hash:
+ * @setting: the #NMSetting
+ *
+ * Hashes the content of @setting, that is, the type and all properties
+ * (including secrets) as described by the property meta data. Two
+ * settings that are equal according to nm_setting_compare() with
+ * %NM_SETTING_COMPARE_FLAG_EXACT have the same hash.
+ *
+ * For sealed settings, the hash is cached.
+ *
+ * Returns: the hash value.
+ */
+guint
+_nm_setting_hash(NMSetting *setting)
+{
+    NMSettingPrivate *priv;
+
+    g_return_val_if_fail(NM_IS_SETTING(setting), 0);
+
+    priv = NM_SETTING_GET_PRIVATE(setting);
+
+    if (priv->is_sealed)
+        return priv->content_hash;
+
+    return _setting_hash_compute(setting);
+}
+
+/**
+ * _nm_setting_seal:
+ * @setting: the #NMSetting
+ *
+ * Marks @setting as immutable. A sealed setting may be shared by several
+ * connections, so it must not be modified anymore. Use nm_setting_duplicate()
+ * to get a modifiable copy. There is no way to unseal a setting.
+ */
+void
+_nm_setting_seal(NMSetting *setting)
+{
+    NMSettingPrivate *priv;
+
+    g_return_if_fail(NM_IS_SETTING(setting));
+
+    priv = NM_SETTING_GET_PRIVATE(setting);
+
+    if (priv->is_sealed)
+        return;
+
+    priv->content_hash = _setting_hash_compute(setting);
+    priv->is_sealed    = TRUE;
+}
+
+gboolean
+_nm_setting_is_sealed(NMSetting *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING(setting), FALSE);
+
+    return NM_SETTING_GET_PRIVATE(setting)->is_sealed;
+}
+
+static guint
+_setting_intern_hash(gconstpointer data)
+{
+    return _nm_setting_hash((NMSetting *) data);
+}
+
+static gboolean
+_setting_intern_equal(gconstpointer a, gconstpointer b)
+{
+    NMSetting *sa = (NMSetting *) a;
+    NMSetting *sb = (NMSetting *) b;
+
+    if (sa == sb)
+        return TRUE;
+
+    return _nm_setting_hash(sa) == _nm_setting_hash(sb)
+           && _nm_setting_compare(NULL, sa, NULL, sb, NM_SETTING_COMPARE_FLAG_EXACT);
+}
+
+static void
+_setting_intern_weak_notify(gpointer data, GObject *where_the_object_was)
+{
+    GHashTable *table = data;
+
+    /* The setting is still alive during dispose, so hashing and comparing
+     * it while removing it from the table is fine. */
+    if (!g_hash_table_steal(table, where_the_object_was))
+        nm_assert_not_reached();
+}
+
+/**
+ * _nm_setting_intern_table_new:
+ *
+ * Creates a table for interning settings with _nm_setting_intern().
+ * The table does not keep the settings alive. Destroy it with
+ * _nm_setting_intern_table_destroy().
+ *
+ * Returns: (transfer full): the intern table.
+ */
+GHashTable *
+_nm_setting_intern_table_new(void)
+{
+    return g_hash_table_new(_setting_intern_hash, _setting_intern_equal);
+}
+
+void
+_nm_setting_intern_table_destroy(GHashTable *table)
+{
+    GHashTableIter iter;
+    NMSetting     *setting;
+
+    if (!table)
+        return;
+
+    g_hash_table_iter_init(&iter, table);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &setting, NULL))
+        g_object_weak_unref(G_OBJECT(setting), _setting_intern_weak_notify, table);
+
+    g_hash_table_destroy(table);
+}
+
+/**
+ * _nm_setting_intern:
+ * @table: the intern table from _nm_setting_intern_table_new()
+ * @setting: the #NMSetting to intern
+ *
+ * Looks up a sealed setting in @table with the same content as @setting.
+ * If there is none, a sealed copy of @setting is added to @table. @setting
+ * itself is only added if it is already sealed, so the caller keeps owning
+ * a modifiable setting.
+ *
+ * Returns: (transfer full): the interned setting, equal to @setting.
+ */
+NMSetting *
+_nm_setting_intern(GHashTable *table, NMSetting *setting)
+{
+    NMSetting *interned;
+
+    g_return_val_if_fail(table, NULL);
+    g_return_val_if_fail(NM_IS_SETTING(setting), NULL);
+
+    interned = g_hash_table_lookup(table, setting);
+    if (interned) {
+        nm_assert(_nm_setting_is_sealed(interned));
+        return g_object_ref(interned);
+    }
+
+    if (_nm_setting_is_sealed(setting))
+        interned = g_object_ref(setting);
+    else {
+        interned = nm_setting_duplicate(setting);
+        _nm_setting_seal(interned);
+    }
+
+    if (!g_hash_table_add(table, interned))
+        nm_assert_not_reached();
+    g_object_weak_ref(G_OBJECT(interned), _setting_intern_weak_notify, table);
+    return interned;
+}
+
 /**
  * nm_setting_get_name:
  * @setting: the #NMSetting
@@ -3705,6 +3918,7 @@ nm_setting_set_secret_flags(NMSetting           *setting,
     g_return_val_if_fail(NM_IS_SETTING(setting), FALSE);
     g_return_val_if_fail(secret_name != NULL, FALSE);
     g_return_val_if_fail(_nm_setting_secret_flags_valid(flags), FALSE);
+    _nm_setting_return_val_if_sealed(setting, FALSE);
 
     return NM_SETTING_GET_CLASS(setting)->set_secret_flags(setting, secret_name, flags, error);
 }
@@ -4076,6 +4290,7 @@ nm_setting_option_clear_by_name(NMSetting *setting, NMUtilsPredicateStr predicat
     gboolean       changed = FALSE;
 
     g_return_if_fail(NM_IS_SETTING(setting));
+    _nm_setting_return_if_sealed(setting);
 
     hash = _nm_setting_option_hash(NM_SETTING(setting), FALSE);
     if (!hash)
@@ -4199,6 +4414,7 @@ nm_setting_option_set(NMSetting *setting, const char *opt_name, GVariant *varian
 
     g_return_if_fail(NM_IS_SETTING(setting));
     g_return_if_fail(opt_name);
+    _nm_setting_return_if_sealed(setting);
 
     hash = _nm_setting_option_hash(setting, variant != NULL);
 
@@ -4259,6 +4475,7 @@ nm_setting_option_set_boolean(NMSetting *setting, const char *opt_name, gboolean
 
     g_return_if_fail(NM_IS_SETTING(setting));
     g_return_if_fail(opt_name);
+    _nm_setting_return_if_sealed(setting);
 
     value = (!!value);
 
@@ -4296,6 +4513,7 @@ nm_setting_option_set_uint32(NMSetting *setting, const char *opt_name, guint32 v
 
     g_return_if_fail(NM_IS_SETTING(setting));
     g_return_if_fail(opt_name);
+    _nm_setting_return_if_sealed(setting);
 
     hash = _nm_setting_option_hash(setting, TRUE);
 
@@ -4649,6 +4867,20 @@ finalize(GObject *object)
     _finalize_direct(self);
 }
 
+static void
+dispatch_properties_changed(GObject *object, guint n_pspecs, GParamSpec **pspecs)
+{
+    /* A sealed setting may be shared by several connections. Modifying it
+     * would modify all of them. The setters already refuse that before
+     * touching any data (see _nm_setting_return_if_sealed()). Getting here
+     * means that a setter lacks that check, and the shared data may already
+     * be modified. */
+    g_return_if_fail(!NM_SETTING_GET_PRIVATE(object)->is_sealed);
+
+    G_OBJECT_CLASS(nm_setting_parent_class)
+        ->dispatch_properties_changed(object, n_pspecs, pspecs);
+}
+
 static void
 nm_setting_class_init(NMSettingClass *setting_class)
 {
@@ -4659,6 +4891,7 @@ nm_setting_class_init(NMSettingClass *setting_class)
     object_class->constructed  = constructed;
     object_class->get_property = get_property;
     object_class->finalize     = finalize;
+    object_class->dispatch_properties_changed = dispatch_properties_changed;
 
     setting_class->update_one_secret         = update_one_secret;
     setting_class->get_secret_flags          = get_secret_flags;
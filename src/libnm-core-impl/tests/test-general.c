@@ -5792,6 +5792,76 @@ test_connection_normalize_uuid(void)
                                                          NM_CONNECTION_ERROR_MISSING_PROPERTY);
 }
 
+static void
+test_connection_verify_cached(void)
+{
+    gs_unref_object NMConnection *con   = NULL;
+    gs_free_error GError         *error = NULL;
+    NMSettingConnection          *s_con;
+
+    con   = nmtst_create_minimal_connection("test1", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+    s_con = nm_connection_get_setting_connection(con);
+    nmtst_connection_normalize(con);
+
+    /* verify twice, the second result comes from the cache. */
+    nmtst_assert_connection_verifies_without_normalization(con);
+    nmtst_assert_connection_verifies_without_normalization(con);
+
+    /* modifying a setting invalidates the cached result. */
+    g_object_set(s_con, NM_SETTING_CONNECTION_ID, NULL, NULL);
+    g_assert(!nm_connection_verify(con, &error));
+    g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_MISSING_PROPERTY);
+    g_clear_error(&error);
+
+    /* the cached error is returned as copy. */
+    g_assert(!nm_connection_verify(con, &error));
+    g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_MISSING_PROPERTY);
+    g_clear_error(&error);
+    g_assert(!nm_connection_verify(con, NULL));
+
+    g_object_set(s_con, NM_SETTING_CONNECTION_ID, "test1", NULL);
+    nmtst_assert_connection_verifies_without_normalization(con);
+
+    /* so does removing and adding settings. */
+    nm_connection_remove_setting(con, NM_TYPE_SETTING_IP4_CONFIG);
+    nmtst_assert_connection_verifies_and_normalizable(con);
+    nmtst_connection_normalize(con);
+    nmtst_assert_connection_verifies_without_normalization(con);
+
+    nm_connection_remove_setting(con, NM_TYPE_SETTING_CONNECTION);
+    nmtst_assert_connection_unnormalizable(con,
+                                           NM_CONNECTION_ERROR,
+                                           NM_CONNECTION_ERROR_MISSING_SETTING);
+}
+
+static void
+test_connection_verify_cached_route(void)
+{
+    gs_unref_object NMConnection *con = NULL;
+    NMSettingIPConfig            *s_ip4;
+    NMIPRoute                    *route;
+
+    con = nmtst_create_minimal_connection("test1", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+    nmtst_connection_normalize(con);
+    s_ip4 = nm_connection_get_setting_ip4_config(con);
+
+    route = nm_ip_route_new(AF_INET, "22.33.0.0", 24, NULL, 0, NULL);
+    nm_setting_ip_config_add_route(s_ip4, route);
+    nm_ip_route_unref(route);
+    nmtst_assert_connection_verifies_without_normalization(con);
+
+    /* modifying a route in place does not notify, the result must not
+     * come from a cache. */
+    route = nm_setting_ip_config_get_route(s_ip4, 0);
+    nm_ip_route_set_attribute(route, NM_IP_ROUTE_ATTRIBUTE_TABLE, g_variant_new_string("x"));
+    nmtst_assert_connection_unnormalizable(con,
+                                           NM_CONNECTION_ERROR,
+                                           NM_CONNECTION_ERROR_INVALID_PROPERTY);
+
+    nm_ip_route_set_attribute(route, NM_IP_ROUTE_ATTRIBUTE_TABLE, NULL);
+    nmtst_assert_connection_verifies_without_normalization(con);
+}
+
 /*****************************************************************************/
 
 /*
@@ -11716,6 +11786,9 @@ main(int argc, char **argv)
     g_test_add_func("/core/general/test_connection_normalize_virtual_iface_name",
                     test_connection_normalize_virtual_iface_name);
     g_test_add_func("/core/general/test_connection_normalize_uuid", test_connection_normalize_uuid);
+    g_test_add_func("/core/general/test_connection_verify_cached", test_connection_verify_cached);
+    g_test_add_func("/core/general/test_connection_verify_cached_route",
+                    test_connection_verify_cached_route);
     g_test_add_func("/core/general/test_connection_normalize_type", test_connection_normalize_type);
     g_test_add_func("/core/general/test_connection_normalize_slave_type_1",
                     test_connection_normalize_slave_type_1);
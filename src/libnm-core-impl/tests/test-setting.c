@@ -5438,6 +5438,122 @@ test_bond_meta(void)
 
 /*****************************************************************************/
 
+static void
+test_setting_intern(void)
+{
+    GHashTable                   *table = _nm_setting_intern_table_new();
+    gs_unref_object NMConnection *con1  = NULL;
+    gs_unref_object NMConnection *con2  = NULL;
+    gs_unref_object NMConnection *con3  = NULL;
+    gs_unref_object NMConnection *int1  = NULL;
+    gs_unref_object NMConnection *int2  = NULL;
+    gs_unref_object NMConnection *int3  = NULL;
+    NMSetting                    *s_ip4_1;
+    NMSetting                    *s_ip4_3;
+    NMSetting                    *s_wired;
+    guint                         n_interned;
+    guint                         n_settings1;
+    guint                         n_settings2;
+    guint                         i;
+    gs_free NMSetting           **settings1 = NULL;
+    gs_free NMSetting           **settings2 = NULL;
+
+    con1 =
+        nmtst_create_minimal_connection("test-intern", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+    nmtst_connection_normalize(con1);
+
+    con2 = nmtst_connection_duplicate_and_normalize(con1);
+    g_object_set(nm_connection_get_setting_connection(con2),
+                 NM_SETTING_CONNECTION_ID,
+                 "test-intern-2",
+                 NULL);
+
+    con3 = nmtst_connection_duplicate_and_normalize(con1);
+    nm_setting_ip_config_add_dns(nm_connection_get_setting_ip4_config(con3), "1.2.3.4");
+
+    g_assert(nm_connection_get_setting_ip4_config(con1)
+             != nm_connection_get_setting_ip4_config(con2));
+    g_assert_cmpint(_nm_setting_hash(NM_SETTING(nm_connection_get_setting_ip4_config(con1))),
+                    ==,
+                    _nm_setting_hash(NM_SETTING(nm_connection_get_setting_ip4_config(con2))));
+
+    int1 = _nm_connection_new_interned(con1, table);
+    int2 = _nm_connection_new_interned(con2, table);
+    int3 = _nm_connection_new_interned(con3, table);
+
+    /* The source connections are not touched. */
+    g_assert(!_nm_setting_is_sealed(NM_SETTING(nm_connection_get_setting_ip4_config(con1))));
+    nmtst_assert_connection_equals(con1, FALSE, int1, FALSE);
+    nmtst_assert_connection_equals(con3, FALSE, int3, FALSE);
+
+    s_ip4_1 = NM_SETTING(nm_connection_get_setting_ip4_config(int1));
+    s_ip4_3 = NM_SETTING(nm_connection_get_setting_ip4_config(int3));
+    s_wired = NM_SETTING(nm_connection_get_setting_wired(int1));
+
+    g_assert(_nm_setting_is_sealed(s_ip4_1));
+    g_assert(s_ip4_1 == NM_SETTING(nm_connection_get_setting_ip4_config(int2)));
+    g_assert(s_ip4_1 != s_ip4_3);
+    g_assert(NM_SETTING(nm_connection_get_setting_connection(int1))
+             != NM_SETTING(nm_connection_get_setting_connection(int2)));
+    g_assert(s_wired == NM_SETTING(nm_connection_get_setting_wired(int3)));
+
+    /* Two profiles that only differ in their connection setting share all
+     * other settings. */
+    settings1 = nm_connection_get_settings(int1, &n_settings1);
+    settings2 = nm_connection_get_settings(int2, &n_settings2);
+    g_assert_cmpint(n_settings1, ==, n_settings2);
+    for (i = 0; i < n_settings1; i++) {
+        if (NM_IS_SETTING_CONNECTION(settings1[i]))
+            g_assert(settings1[i] != settings2[i]);
+        else
+            g_assert(settings1[i] == settings2[i]);
+    }
+
+    /* Interning an interned connection does not create another copy. */
+    {
+        gs_unref_object NMConnection *int1_again = _nm_connection_new_interned(int1, table);
+
+        g_assert(int1_again == int1);
+    }
+
+    /* Shared settings don't get a "notify" handler per connection. */
+    g_assert(!g_signal_has_handler_pending(s_ip4_1,
+                                           g_signal_lookup("notify", G_TYPE_OBJECT),
+                                           0,
+                                           TRUE));
+
+    /* Sealed settings refuse to change. */
+    NMTST_EXPECT_LIBNM_CRITICAL(NMTST_G_RETURN_MSG(!NM_SETTING_GET_PRIVATE(setting)->is_sealed));
+    g_object_set(s_wired, NM_SETTING_WIRED_MTU, (guint) 1400, NULL);
+    g_test_assert_expected_messages();
+    g_assert_cmpint(nm_setting_wired_get_mtu(NM_SETTING_WIRED(s_wired)), ==, 0);
+
+    /* Also the setters that are not plain property setters, before
+     * modifying anything. */
+    NMTST_EXPECT_LIBNM_CRITICAL(
+        NMTST_G_RETURN_MSG(!_nm_setting_is_sealed((NMSetting *) (setting))));
+    g_assert(!nm_setting_ip_config_add_dns(NM_SETTING_IP_CONFIG(s_ip4_1), "5.6.7.8"));
+    g_test_assert_expected_messages();
+    g_assert_cmpint(nm_setting_ip_config_get_num_dns(NM_SETTING_IP_CONFIG(s_ip4_1)), ==, 0);
+
+    /* Duplicates are not sealed and can be modified. */
+    {
+        gs_unref_object NMSetting *s_dup = nm_setting_duplicate(s_ip4_1);
+
+        g_assert(!_nm_setting_is_sealed(s_dup));
+        g_assert(nm_setting_compare(s_dup, s_ip4_1, NM_SETTING_COMPARE_FLAG_EXACT));
+    }
+
+    /* Dropping the last reference removes the setting from the table. */
+    n_interned = g_hash_table_size(table);
+    g_clear_object(&int3);
+    g_assert_cmpint(g_hash_table_size(table), ==, n_interned - 1);
+
+    _nm_setting_intern_table_destroy(table);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -5564,5 +5680,7 @@ main(int argc, char **argv)
 
     g_test_add_func("/libnm/test_bond_meta", test_bond_meta);
 
+    g_test_add_func("/libnm/test_setting_intern", test_setting_intern);
+
     return g_test_run();
 }
@@ -222,6 +222,13 @@ gboolean _nm_connection_replace_settings(NMConnection       *connection,
                                          NMSettingParseFlags parse_flags,
                                          GError            **error);
 
+typedef void (*NMConnectionLazyErrorFunc)(NMConnection *connection, GError *error);
+
+gboolean _nm_connection_replace_settings_lazy(NMConnection             *connection,
+                                              GVariant                 *new_settings,
+                                              NMConnectionLazyErrorFunc error_func,
+                                              GError                  **error);
+
 gpointer _nm_connection_check_main_setting(NMConnection *connection,
                                            const char   *setting_name,
                                            GError      **error);
@@ -304,6 +311,16 @@ NMConnection *_nm_simple_connection_new_from_dbus(GVariant           *dict,
 
 NMSettingPriority _nm_setting_get_setting_priority(NMSetting *setting);
 
+guint    _nm_setting_hash(NMSetting *setting);
+void     _nm_setting_seal(NMSetting *setting);
+gboolean _nm_setting_is_sealed(NMSetting *setting);
+
+GHashTable *_nm_setting_intern_table_new(void);
+void        _nm_setting_intern_table_destroy(GHashTable *table);
+NMSetting  *_nm_setting_intern(GHashTable *table, NMSetting *setting);
+
+NMConnection *_nm_connection_new_interned(NMConnection *connection, GHashTable *intern_table);
+
 gboolean _nm_setting_get_property(NMSetting *setting, const char *name, GValue *value);
 
 /*****************************************************************************/
@@ -891,6 +908,12 @@ struct _NMSettInfoProperty {
      * is FALSE. */
     bool to_dbus_only_in_manager_process : 1;
 
+    /* If TRUE, this is a NM_SETTING_PROPERTY_TO_DBUS_FCN_GPROP_TYPE_STRDICT property
+     * and the private data has the GHashTable at direct_offset. to_dbus_fcn()
+     * then reads the hash table directly, instead of fetching a deep copy via
+     * the GObject property getter. */
+    bool to_dbus_strdict_direct : 1;
+
     /* Whether the property is deprecated.
      *
      * Note that we have various representations of profiles, e.g. on D-Bus, keyfile,
@@ -383,6 +383,36 @@ nm_key_file_db_to_file(NMKeyFileDB *self, gboolean force)
         _LOGD("write keyfile: \"%s\"", self->filename);
 }
 
+/**
+ * nm_key_file_db_to_bytes:
+ * @self: the #NMKeyFileDB
+ * @force: if %FALSE, only serialize the content if the DB is dirty.
+ *
+ * Like nm_key_file_db_to_file(), but does not write the file. Instead,
+ * the content is returned and the caller is responsible for writing
+ * it to nm_key_file_db_get_filename(). This allows to do the (possibly
+ * slow) write at a later point, or on another thread.
+ *
+ * Returns: (transfer full): the serialized keyfile or %NULL, if
+ *   the DB is not dirty and @force is %FALSE.
+ */
+GBytes *
+nm_key_file_db_to_bytes(NMKeyFileDB *self, gboolean force)
+{
+    char *data;
+    gsize len;
+
+    g_return_val_if_fail(_IS_KEY_FILE_DB(self, TRUE, FALSE), NULL);
+
+    if (!force && !self->dirty)
+        return NULL;
+
+    self->dirty = FALSE;
+
+    data = g_key_file_to_data(self->kf, &len, NULL);
+    return g_bytes_new_take(data, len);
+}
+
 /*****************************************************************************/
 
 void
@@ -50,6 +50,8 @@ void nm_key_file_db_set_string_list(NMKeyFileDB       *self,
 
 void nm_key_file_db_to_file(NMKeyFileDB *self, gboolean force);
 
+GBytes *nm_key_file_db_to_bytes(NMKeyFileDB *self, gboolean force);
+
 void nm_key_file_db_prune_tmp_files(NMKeyFileDB *self);
 
 void nm_key_file_db_prune(NMKeyFileDB *self,
@@ -517,6 +517,7 @@ typedef struct {
 
 typedef struct {
     struct nl_sock *sk_genl_sync;
+    struct nl_sock *sk_rtnl_sync;
 
     union {
         struct {
@@ -8678,6 +8679,92 @@ link_refresh(NMPlatform *platform, int ifindex)
     return !!nm_platform_link_get_obj(platform, ifindex, TRUE);
 }
 
+static int
+_link_stats_dump_parse_cb(const struct nl_msg *msg, void *arg)
+{
+    static const struct nla_policy policy[] = {
+        [IFLA_STATS_LINK_64] = {.minlen = nm_offsetofend(struct rtnl_link_stats64, tx_bytes)},
+    };
+    struct nlattr             *tb[G_N_ELEMENTS(policy)];
+    GArray                    *stats_arr = arg;
+    const struct nlmsghdr     *nlh       = nlmsg_hdr(msg);
+    const struct if_stats_msg *ifsm;
+    const char                *stats;
+    NMPlatformLinkStats       *s;
+
+    if (nlh->nlmsg_type != RTM_NEWSTATS)
+        return NL_SKIP;
+
+    if (nlmsg_parse_arr(nlh, sizeof(struct if_stats_msg), tb, policy) < 0)
+        return NL_SKIP;
+
+    ifsm = nlmsg_data(nlh);
+    if (ifsm->ifindex <= 0 || !tb[IFLA_STATS_LINK_64])
+        return NL_SKIP;
+
+    stats = nla_data(tb[IFLA_STATS_LINK_64]);
+
+    s  = nm_g_array_append_new(stats_arr, NMPlatformLinkStats);
+    *s = (NMPlatformLinkStats){
+        .ifindex = ifsm->ifindex,
+        .rx_packets =
+            unaligned_read_ne64(&stats[G_STRUCT_OFFSET(struct rtnl_link_stats64, rx_packets)]),
+        .rx_bytes =
+            unaligned_read_ne64(&stats[G_STRUCT_OFFSET(struct rtnl_link_stats64, rx_bytes)]),
+        .tx_packets =
+            unaligned_read_ne64(&stats[G_STRUCT_OFFSET(struct rtnl_link_stats64, tx_packets)]),
+        .tx_bytes =
+            unaligned_read_ne64(&stats[G_STRUCT_OFFSET(struct rtnl_link_stats64, tx_bytes)]),
+    };
+    return NL_OK;
+}
+
+static GArray *
+link_stats_dump(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate      *priv      = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    nm_auto_nlmsg struct nl_msg *nlmsg     = NULL;
+    gs_unref_array GArray       *stats_arr = NULL;
+    struct if_stats_msg          ifsm;
+    int                          r;
+
+    ifsm = (struct if_stats_msg){
+        .family      = AF_UNSPEC,
+        .filter_mask = IFLA_STATS_FILTER_BIT(IFLA_STATS_LINK_64),
+    };
+
+    /* RTM_GETSTATS with only IFLA_STATS_LINK_64 is much cheaper than
+     * requesting each link with RTM_GETLINK. The result bypasses the
+     * cache, as it only carries the counters. */
+    nlmsg = nlmsg_alloc_new(0, RTM_GETSTATS, NLM_F_REQUEST | NLM_F_DUMP);
+    if (nlmsg_append_struct(nlmsg, &ifsm) < 0)
+        g_return_val_if_reached(NULL);
+
+    r = nl_send_auto(priv->sk_rtnl_sync, nlmsg);
+    if (r < 0) {
+        _LOGT("link-stats: failed to send dump request: %s", nm_strerror(r));
+        return NULL;
+    }
+
+    stats_arr = g_array_new(FALSE, FALSE, sizeof(NMPlatformLinkStats));
+
+    do {
+        r = nl_recvmsgs(priv->sk_rtnl_sync,
+                        &((const struct nl_cb){
+                            .valid_cb  = _link_stats_dump_parse_cb,
+                            .valid_arg = stats_arr,
+                        }));
+    } while (r == -EAGAIN);
+
+    if (r < 0) {
+        _LOGT("link-stats: dump failed: %s", nm_strerror(r));
+        return NULL;
+    }
+
+    _LOGT("link-stats: dumped counters of %u links", stats_arr->len);
+    return g_steal_pointer(&stats_arr);
+}
+
 static gboolean
 link_set_netns(NMPlatform *platform, int ifindex, int netns_fd)
 {
@@ -11533,6 +11620,13 @@ constructed(GObject *_object)
           nl_socket_get_local_port(priv->sk_genl_sync),
           nl_socket_get_fd(priv->sk_genl_sync));
 
+    nle = nl_socket_new(&priv->sk_rtnl_sync, NETLINK_ROUTE, NL_SOCKET_FLAGS_NONE, 0, 0);
+    g_assert(!nle);
+
+    _LOGD("rtnl: rtnetlink socket for sync operations created: port=%u, fd=%d",
+          nl_socket_get_local_port(priv->sk_rtnl_sync),
+          nl_socket_get_fd(priv->sk_rtnl_sync));
+
     /*************************************************************************/
 
     /* disable MSG_PEEK, we will handle lost messages ourselves. */
@@ -11722,6 +11816,7 @@ finalize(GObject *object)
     nm_clear_g_source_inst(&priv->event_source_rtnl);
 
     nl_socket_free(priv->sk_genl_sync);
+    nl_socket_free(priv->sk_rtnl_sync);
     nl_socket_free(priv->sk_genl);
     nl_socket_free(priv->sk_rtnl);
 
@@ -11764,7 +11859,8 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
 
     platform_class->link_change = link_change;
 
-    platform_class->link_refresh = link_refresh;
+    platform_class->link_refresh    = link_refresh;
+    platform_class->link_stats_dump = link_stats_dump;
 
     platform_class->link_set_netns = link_set_netns;
 
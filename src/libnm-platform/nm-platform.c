@@ -1745,6 +1745,56 @@ nm_platform_link_refresh(NMPlatform *self, int ifindex)
     return TRUE;
 }
 
+static int
+_link_stats_cmp(gconstpointer a, gconstpointer b)
+{
+    NM_CMP_FIELD((const NMPlatformLinkStats *) a, (const NMPlatformLinkStats *) b, ifindex);
+    return 0;
+}
+
+/**
+ * nm_platform_link_stats_dump:
+ * @self: platform instance
+ *
+ * Fetches the traffic counters of all links with one request. Unlike
+ * nm_platform_link_refresh(), this does not update the cache.
+ *
+ * Returns: (transfer full): a #GArray of #NMPlatformLinkStats sorted by
+ *   ifindex, or %NULL if the platform does not support that.
+ */
+GArray *
+nm_platform_link_stats_dump(NMPlatform *self)
+{
+    GArray *stats_arr;
+
+    _CHECK_SELF(self, klass, NULL);
+
+    if (!klass->link_stats_dump)
+        return NULL;
+
+    stats_arr = klass->link_stats_dump(self);
+    if (stats_arr)
+        g_array_sort(stats_arr, _link_stats_cmp);
+    return stats_arr;
+}
+
+const NMPlatformLinkStats *
+nm_platform_link_stats_find(const GArray *stats_arr, int ifindex)
+{
+    const NMPlatformLinkStats needle = {
+        .ifindex = ifindex,
+    };
+
+    if (!stats_arr || stats_arr->len == 0)
+        return NULL;
+
+    return bsearch(&needle,
+                   stats_arr->data,
+                   stats_arr->len,
+                   sizeof(NMPlatformLinkStats),
+                   _link_stats_cmp);
+}
+
 int
 nm_platform_link_get_ifi_flags(NMPlatform *self, int ifindex, guint requested_flags)
 {
@@ -251,6 +251,14 @@ struct _NMPlatformLink {
     bool initialized : 1;
 } _nm_alignas(NMPlatformObject);
 
+struct _NMPlatformLinkStats {
+    int     ifindex;
+    guint64 rx_packets;
+    guint64 rx_bytes;
+    guint64 tx_packets;
+    guint64 tx_bytes;
+};
+
 typedef enum {
     NM_PLATFORM_SIGNAL_ID_NONE,
     NM_PLATFORM_SIGNAL_ID_LINK,
@@ -1163,6 +1171,7 @@ typedef struct {
                             NMPlatformLinkChangeFlags     flags);
     gboolean (*link_delete)(NMPlatform *self, int ifindex);
     gboolean (*link_refresh)(NMPlatform *self, int ifindex);
+    GArray *(*link_stats_dump)(NMPlatform *self);
     gboolean (*link_set_netns)(NMPlatform *self, int ifindex, int netns_fd);
     int (*link_change_flags)(NMPlatform *platform,
                              int         ifindex,
@@ -1984,6 +1993,9 @@ const char  *nm_platform_link_get_type_name(NMPlatform *self, int ifindex);
 gboolean nm_platform_link_refresh(NMPlatform *self, int ifindex);
 void     nm_platform_process_events(NMPlatform *self);
 
+GArray                    *nm_platform_link_stats_dump(NMPlatform *self);
+const NMPlatformLinkStats *nm_platform_link_stats_find(const GArray *stats_arr, int ifindex);
+
 const NMPlatformLink *
 nm_platform_process_events_ensure_link(NMPlatform *self, int ifindex, const char *ifname);
 
@@ -652,6 +652,12 @@ static int n_dhcp4_c_connection_new_message(NDhcp4CConnection *connection,
  *      'xid' of the most recent DHCPDISCOVER message, the DHCPOFFER message
  *      must be silently discarded.  Any arriving DHCPACK messages must be
  *      silently discarded.
+ *
+ *      RFC4039 3.1
+ *
+ *      If the client supports and is prepared to use Rapid Commit, it
+ *      includes the Rapid Commit option in the DHCPDISCOVER message.  A
+ *      server that supports it may then reply with a DHCPACK directly.
  */
 int n_dhcp4_c_connection_discover_new(NDhcp4CConnection *connection,
                                       NDhcp4Outgoing **requestp) {
@@ -662,6 +668,12 @@ int n_dhcp4_c_connection_discover_new(NDhcp4CConnection *connection,
         if (r)
                 return r;
 
+        if (connection->probe_config->rapid_commit) {
+                r = n_dhcp4_outgoing_append(message, N_DHCP4_OPTION_RAPID_COMMIT, NULL, 0);
+                if (r)
+                        return r;
+        }
+
         *requestp = message;
         message = NULL;
         return 0;
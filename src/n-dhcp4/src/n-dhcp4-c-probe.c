@@ -116,6 +116,7 @@ int n_dhcp4_client_probe_config_dup(NDhcp4ClientProbeConfig *config,
 
         dup->inform_only = config->inform_only;
         dup->init_reboot = config->init_reboot;
+        dup->rapid_commit = config->rapid_commit;
         dup->requested_ip = config->requested_ip;
         dup->ms_start_delay = config->ms_start_delay;
         dup->dscp = config->dscp;
@@ -191,6 +192,25 @@ _c_public_ void n_dhcp4_client_probe_config_set_init_reboot(NDhcp4ClientProbeCon
         config->init_reboot = init_reboot;
 }
 
+/**
+ * n_dhcp4_client_probe_config_set_rapid_commit() - set rapid-commit property
+ * @config:                     configuration to operate on
+ * @rapid_commit:               value to set
+ *
+ * This sets the rapid-commit property of the given configuration object. If
+ * enabled, the DHCPDISCOVER message carries the Rapid Commit option, as
+ * described by RFC4039.
+ *
+ * The default is false. If set to true, a server that supports rapid commit
+ * may reply to the DHCPDISCOVER directly with a DHCPACK, and the probe moves
+ * to the GRANTED state without going through the DHCPOFFER/DHCPREQUEST
+ * exchange. Servers that do not support rapid commit ignore the option, and
+ * the probe continues with the regular four-message exchange.
+ */
+_c_public_ void n_dhcp4_client_probe_config_set_rapid_commit(NDhcp4ClientProbeConfig *config, bool rapid_commit) {
+        config->rapid_commit = rapid_commit;
+}
+
 /**
  * n_dhcp4_client_probe_config_set_dscp() - set the IP DSCP value
  * @config:                     configuration to operate on
@@ -963,6 +983,17 @@ static int n_dhcp4_client_probe_transition_ack(NDhcp4ClientProbe *probe, NDhcp4I
                 probe->ns_nak_restart_delay = 0;
                 break;
 
+        case N_DHCP4_CLIENT_PROBE_STATE_SELECTING:
+                /*
+                 * RFC4039 3.1: a DHCPACK in reply to a DHCPDISCOVER is only
+                 * valid if we asked for rapid commit, and the server
+                 * confirms it by including the option in its reply.
+                 */
+                if (!probe->config->rapid_commit ||
+                    n_dhcp4_incoming_query(message, N_DHCP4_OPTION_RAPID_COMMIT, NULL, NULL))
+                        break;
+
+                /* fall-through */
         case N_DHCP4_CLIENT_PROBE_STATE_REQUESTING:
         case N_DHCP4_CLIENT_PROBE_STATE_REBOOTING:
 
@@ -987,7 +1018,6 @@ static int n_dhcp4_client_probe_transition_ack(NDhcp4ClientProbe *probe, NDhcp4I
                 break;
 
         case N_DHCP4_CLIENT_PROBE_STATE_INIT:
-        case N_DHCP4_CLIENT_PROBE_STATE_SELECTING:
         case N_DHCP4_CLIENT_PROBE_STATE_INIT_REBOOT:
         case N_DHCP4_CLIENT_PROBE_STATE_BOUND:
         case N_DHCP4_CLIENT_PROBE_STATE_GRANTED:
@@ -75,6 +75,7 @@ enum {
         N_DHCP4_OPTION_REBINDING_T2_TIME                = 59,
         N_DHCP4_OPTION_VENDOR_CLASS_IDENTIFIER          = 60,
         N_DHCP4_OPTION_CLIENT_IDENTIFIER                = 61,
+        N_DHCP4_OPTION_RAPID_COMMIT                     = 80,
         N_DHCP4_OPTION_FQDN                             = 81,
         N_DHCP4_OPTION_NEW_POSIX_TIMEZONE               = 100,
         N_DHCP4_OPTION_NEW_TZDB_TIMEZONE                = 101,
@@ -265,6 +266,7 @@ struct NDhcp4ClientProbeOption {
 struct NDhcp4ClientProbeConfig {
         bool inform_only;
         bool init_reboot;
+        bool rapid_commit;
         uint8_t dscp;
         struct in_addr requested_ip;
         unsigned short int entropy[3];
@@ -140,6 +140,9 @@ static void test_discover(NDhcp4SConnection *connection_server,
 
         test_server_receive(connection_server, N_DHCP4_MESSAGE_DISCOVER, &request_in);
 
+        r = n_dhcp4_incoming_query(request_in, N_DHCP4_OPTION_RAPID_COMMIT, NULL, NULL);
+        c_assert(r == N_DHCP4_E_UNSET);
+
         r = n_dhcp4_s_connection_offer_new(connection_server, &reply_out, request_in, addr_server, addr_client, 60);
         c_assert(!r);
 
@@ -222,6 +225,50 @@ static void test_decline(NDhcp4SConnection *connection_server,
 }
 
 
+static void test_rapid_commit(NDhcp4SConnection *connection_server,
+                              NDhcp4CConnection *connection_client,
+                              const struct in_addr *addr_server,
+                              const struct in_addr *addr_client) {
+        _c_cleanup_(n_dhcp4_outgoing_freep) NDhcp4Outgoing *request_out = NULL;
+        _c_cleanup_(n_dhcp4_incoming_freep) NDhcp4Incoming *request_in = NULL;
+        _c_cleanup_(n_dhcp4_outgoing_freep) NDhcp4Outgoing *reply_out = NULL;
+        _c_cleanup_(n_dhcp4_incoming_freep) NDhcp4Incoming *reply_in = NULL;
+        int r;
+
+        n_dhcp4_client_probe_config_set_rapid_commit(connection_client->probe_config, true);
+
+        r = n_dhcp4_c_connection_discover_new(connection_client, &request_out);
+        c_assert(!r);
+
+        r = n_dhcp4_c_connection_start_request(connection_client, request_out, 0);
+        c_assert(!r);
+        request_out = NULL;
+
+        test_server_receive(connection_server, N_DHCP4_MESSAGE_DISCOVER, &request_in);
+
+        r = n_dhcp4_incoming_query(request_in, N_DHCP4_OPTION_RAPID_COMMIT, NULL, NULL);
+        c_assert(!r);
+
+        r = n_dhcp4_s_connection_ack_new(connection_server, &reply_out, request_in, addr_server, addr_client, 60);
+        c_assert(!r);
+
+        r = n_dhcp4_outgoing_append(reply_out, N_DHCP4_OPTION_RAPID_COMMIT, NULL, 0);
+        c_assert(!r);
+
+        r = n_dhcp4_s_connection_send_reply(connection_server, addr_server, reply_out);
+        c_assert(!r);
+
+        test_client_receive(connection_client, N_DHCP4_MESSAGE_ACK, &reply_in);
+
+        r = n_dhcp4_incoming_query(reply_in, N_DHCP4_OPTION_RAPID_COMMIT, NULL, NULL);
+        c_assert(!r);
+
+        /* the lease from a rapid-commit ACK can be declined after ACD failed */
+        test_decline(connection_server, connection_client, reply_in);
+
+        n_dhcp4_client_probe_config_set_rapid_commit(connection_client->probe_config, false);
+}
+
 static void test_renew(NDhcp4SConnection *connection_server,
                        NDhcp4CConnection *connection_client,
                        const struct in_addr *addr_server,
@@ -357,6 +404,7 @@ static void test_connection(void) {
                 c_assert(!r);
                 test_c_connection_listen(ns_client, &connection_client);
 
+                test_rapid_commit(&connection_server, &connection_client, &addr_server, &addr_client);
                 test_discover(&connection_server, &connection_client, &addr_server, &addr_client, &offer);
                 test_select(&connection_server, &connection_client, offer, &addr_server, &addr_client);
                 test_reboot(&connection_server, &connection_client, &addr_server, &addr_client, &ack);
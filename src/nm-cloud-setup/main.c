@@ -6,6 +6,7 @@
 
 #include <linux/rtnetlink.h>
 
+#include "libnm-glib-aux/nm-io-utils.h"
 #include "nm-cloud-setup-utils.h"
 #include "nmcs-provider-ec2.h"
 #include "nmcs-provider-gcp.h"
@@ -26,6 +27,7 @@ typedef struct {
     GMainLoop    *main_loop;
     GCancellable *cancellable;
     NMCSProvider *provider_result;
+    const char   *only_name;
     guint         detect_count;
     gboolean      any_provider_enabled;
 } ProviderDetectData;
@@ -64,7 +66,10 @@ _provider_detect_cb(GObject *source, GAsyncResult *result, gpointer user_data)
 
 out:
     if (dd->detect_count == 0) {
-        if (!dd->provider_result) {
+        if (!dd->provider_result && dd->only_name) {
+            /* The caller falls back to probe all providers. */
+            _LOGD("cached provider %s not detected", dd->only_name);
+        } else if (!dd->provider_result) {
             NMLogLevel level = LOGL_INFO;
 
             if (dd->any_provider_enabled && !dd->sigterm_data->signal_received)
@@ -85,16 +90,17 @@ _provider_detect_sigterm_cb(GCancellable *source, gpointer user_data)
     g_clear_object(&dd->provider_result);
 }
 
+/* If @only_name is given, only detect the provider with that name. */
 static NMCSProvider *
-_provider_detect(SigTermData *sigterm_data)
+_provider_detect(SigTermData *sigterm_data, NMHttpClient *http_client, const char *only_name)
 {
     nm_auto_unref_gmainloop GMainLoop *main_loop   = g_main_loop_new(NULL, FALSE);
     gs_unref_object GCancellable      *cancellable = g_cancellable_new();
-    gs_unref_object NMHttpClient      *http_client = NULL;
     ProviderDetectData                 dd          = {
                                  .sigterm_data         = sigterm_data,
                                  .cancellable          = cancellable,
                                  .main_loop            = main_loop,
+                                 .only_name            = only_name,
                                  .detect_count         = 0,
                                  .provider_result      = NULL,
                                  .any_provider_enabled = FALSE,
@@ -115,12 +121,14 @@ _provider_detect(SigTermData *sigterm_data)
     if (!cancellable_signal_id)
         goto out;
 
-    http_client = nmcs_wait_for_objects_register(nm_http_client_new());
-
     for (i = 0; i < G_N_ELEMENTS(gtypes); i++) {
         NMCSProvider *provider;
 
         provider = g_object_new(gtypes[i], NMCS_PROVIDER_HTTP_CLIENT, http_client, NULL);
+        if (only_name && !nm_streq(nmcs_provider_get_name(provider), only_name)) {
+            g_object_unref(provider);
+            continue;
+        }
         nmcs_wait_for_objects_register(provider);
 
         _LOGD("start detecting %s provider...", nmcs_provider_get_name(provider));
@@ -138,6 +146,51 @@ out:
 
 /*****************************************************************************/
 
+#define CACHE_FILE_PROVIDER "provider"
+#define CACHE_FILE_HTTP     "http-cache"
+
+static const char *
+_cache_dir_get(void)
+{
+    const char *dir;
+
+    /* An explicitly empty NM_CLOUD_SETUP_CACHE_DIR disables the cache. When
+     * running as systemd service, we use the RuntimeDirectory=. That means,
+     * the cache survives between runs of the timer, but not reboots. */
+    dir = g_getenv(NMCS_ENV_NM_CLOUD_SETUP_CACHE_DIR);
+    if (!dir)
+        dir = g_getenv("RUNTIME_DIRECTORY");
+    return nm_str_not_empty(dir);
+}
+
+static char *
+_cache_provider_read(const char *cache_dir)
+{
+    gs_free char *filename = g_build_filename(cache_dir, CACHE_FILE_PROVIDER, NULL);
+    gs_free char *contents = NULL;
+
+    if (!g_file_get_contents(filename, &contents, NULL, NULL))
+        return NULL;
+    return nm_strdup_not_empty(g_strstrip(contents));
+}
+
+static void
+_cache_provider_write(const char *cache_dir, const char *name)
+{
+    gs_free char         *filename = g_build_filename(cache_dir, CACHE_FILE_PROVIDER, NULL);
+    gs_free_error GError *error    = NULL;
+
+    if (!name) {
+        unlink(filename);
+        return;
+    }
+
+    if (!nm_utils_file_set_contents(filename, name, -1, 0600, NULL, NULL, &error))
+        _LOGD("cache: failure to write \"%s\": %s", filename, error->message);
+}
+
+/*****************************************************************************/
+
 static NMUtilsNamedValue *
 _map_interfaces_parse(void)
 {
@@ -749,8 +802,12 @@ main(int argc, const char *const *argv)
 {
     gs_unref_object GCancellable              *sigterm_cancellable                   = NULL;
     nm_auto_destroy_and_unref_gsource GSource *sigterm_source                        = NULL;
+    gs_unref_object NMHttpClient              *http_client                           = NULL;
     gs_unref_object NMCSProvider              *provider                              = NULL;
     gs_unref_object NMClient                  *nmc                                   = NULL;
+    gs_free char                              *cached_provider                       = NULL;
+    gs_free char                              *http_cache_file                       = NULL;
+    const char                                *cache_dir;
     nm_auto_free_nmcs_provider_get_config_result NMCSProviderGetConfigResult *result = NULL;
     gs_free_error GError                                                     *error  = NULL;
     SigTermData                                                               sigterm_data;
@@ -773,7 +830,34 @@ main(int argc, const char *const *argv)
     };
     sigterm_source = nm_g_unix_signal_add_source(SIGTERM, sigterm_handler, &sigterm_data);
 
-    provider = _provider_detect(&sigterm_data);
+    http_client = nmcs_wait_for_objects_register(nm_http_client_new());
+
+    cache_dir = _cache_dir_get();
+    if (cache_dir) {
+        gs_free_error GError *local = NULL;
+
+        http_cache_file = g_build_filename(cache_dir, CACHE_FILE_HTTP, NULL);
+        if (!nm_http_client_cache_load(http_client, http_cache_file, &local))
+            _LOGD("cache: failure to load \"%s\": %s", http_cache_file, local->message);
+        cached_provider = _cache_provider_read(cache_dir);
+    }
+
+    if (cached_provider) {
+        /* Only re-probe the provider that we found last time. If that fails
+         * (it shouldn't), fall back to probe all of them. */
+        _LOGD("try cached provider %s first", cached_provider);
+        provider = _provider_detect(&sigterm_data, http_client, cached_provider);
+    }
+    if (!provider && !sigterm_data.signal_received)
+        provider = _provider_detect(&sigterm_data, http_client, NULL);
+
+    if (cache_dir && !sigterm_data.signal_received) {
+        const char *name = provider ? nmcs_provider_get_name(provider) : NULL;
+
+        if (!nm_streq0(name, cached_provider))
+            _cache_provider_write(cache_dir, name);
+    }
+
     if (!provider)
         goto done;
 
@@ -808,9 +892,17 @@ main(int argc, const char *const *argv)
         _LOGD("no changes were applied for provider %s", nmcs_provider_get_name(provider));
 
 done:
+    if (http_cache_file) {
+        gs_free_error GError *local = NULL;
+
+        if (!nm_http_client_cache_save(http_client, http_cache_file, &local))
+            _LOGD("cache: failure to save \"%s\": %s", http_cache_file, local->message);
+    }
+
     nm_clear_pointer(&result, nmcs_provider_get_config_result_free);
     g_clear_object(&nmc);
     g_clear_object(&provider);
+    g_clear_object(&http_client);
 
     if (!nmcs_wait_for_objects_iterate_until_done(NULL, 2000)) {
         _LOGE("shutdown: timeout waiting to application to quit. This is a bug");
@@ -7,10 +7,17 @@
 #include <curl/curl.h>
 
 #include "nm-cloud-setup-utils.h"
+#include "libnm-glib-aux/nm-io-utils.h"
 #include "libnm-glib-aux/nm-str-buf.h"
 
 #define NM_CURL_DEBUG 0
 
+/* By default, don't run more than that many requests at the same time. The
+ * metadata services rate limit the clients, and on hosts with many interfaces
+ * and many secondary addresses, we would otherwise start a large number of
+ * requests all at once. The remaining requests get queued. */
+#define MAX_PARALLEL_DEFAULT 8
+
 /*****************************************************************************/
 
 typedef struct {
@@ -18,6 +25,18 @@ typedef struct {
     CURLM        *mhandle;
     GSource      *mhandle_source_timeout;
     GHashTable   *source_sockets_hashtable;
+
+    /* Requests that wait for a free slot (EHandleData.queue_lst). */
+    CList queue_lst_head;
+
+    /* A dictionary of (char *url) -> (CacheEntry *), or %NULL if
+     * the response cache is not enabled. */
+    GHashTable *cache;
+
+    guint n_running;
+    guint max_parallel;
+
+    bool cache_dirty : 1;
 } NMHttpClientPrivate;
 
 struct _NMHttpClient {
@@ -112,6 +131,25 @@ _req_result_free(gpointer data)
     nm_g_slice_free(req_result);
 }
 
+typedef struct {
+    char   *etag;
+    char   *last_modified;
+    GBytes *data;
+} CacheEntry;
+
+static void
+_cache_entry_free(gpointer data)
+{
+    CacheEntry *entry = data;
+
+    g_free(entry->etag);
+    g_free(entry->last_modified);
+    g_bytes_unref(entry->data);
+    nm_g_slice_free(entry);
+}
+
+/*****************************************************************************/
+
 typedef struct {
     GTask             *task;
     GSource           *timeout_source;
@@ -122,6 +160,13 @@ typedef struct {
     struct curl_slist *headers;
     gssize             max_data;
     gulong             cancellable_id;
+    CList              queue_lst;
+    char              *etag;
+    char              *last_modified;
+    int                timeout_msec;
+    bool               running : 1;
+    bool               cacheable : 1;
+    bool               conditional : 1;
 } EHandleData;
 
 static void
@@ -131,9 +176,15 @@ _ehandle_free_ehandle(EHandleData *edata)
         NMHttpClient        *self = g_task_get_source_object(edata->task);
         NMHttpClientPrivate *priv = NM_HTTP_CLIENT_GET_PRIVATE(self);
 
-        curl_multi_remove_handle(priv->mhandle, edata->ehandle);
+        if (edata->running) {
+            nm_assert(priv->n_running > 0);
+            edata->running = FALSE;
+            priv->n_running--;
+            curl_multi_remove_handle(priv->mhandle, edata->ehandle);
+        }
         curl_easy_cleanup(g_steal_pointer(&edata->ehandle));
     }
+    c_list_unlink(&edata->queue_lst);
 }
 
 static void
@@ -148,15 +199,148 @@ _ehandle_free(EHandleData *edata)
     if (edata->headers)
         curl_slist_free_all(edata->headers);
     g_free(edata->url);
+    g_free(edata->etag);
+    g_free(edata->last_modified);
     nm_g_slice_free(edata);
 }
 
+static gboolean _get_timeout_cb(gpointer user_data);
+
+static void
+_ehandle_start(NMHttpClient *self, EHandleData *edata)
+{
+    NMHttpClientPrivate *priv = NM_HTTP_CLIENT_GET_PRIVATE(self);
+
+    nm_assert(!edata->running);
+    nm_assert(!c_list_is_linked(&edata->queue_lst));
+
+    if (edata->timeout_msec > 0) {
+        edata->timeout_source = _source_attach(self,
+                                               nm_g_timeout_source_new(edata->timeout_msec,
+                                                                       G_PRIORITY_DEFAULT,
+                                                                       _get_timeout_cb,
+                                                                       edata,
+                                                                       NULL));
+    }
+
+    edata->running = TRUE;
+    priv->n_running++;
+    curl_multi_add_handle(priv->mhandle, edata->ehandle);
+}
+
+static void
+_queue_process(NMHttpClient *self)
+{
+    NMHttpClientPrivate *priv = NM_HTTP_CLIENT_GET_PRIVATE(self);
+    EHandleData         *edata;
+
+    while (priv->max_parallel == 0 || priv->n_running < priv->max_parallel) {
+        edata = c_list_first_entry(&priv->queue_lst_head, EHandleData, queue_lst);
+        if (!edata)
+            return;
+        c_list_unlink(&edata->queue_lst);
+        _LOG2T(edata, "dequeue");
+        _ehandle_start(self, edata);
+    }
+}
+
+static GBytes *
+_cache_lookup(NMHttpClient *self, EHandleData *edata)
+{
+    NMHttpClientPrivate *priv = NM_HTTP_CLIENT_GET_PRIVATE(self);
+    CacheEntry          *entry;
+
+    if (!edata->cacheable || !priv->cache)
+        return NULL;
+
+    entry = g_hash_table_lookup(priv->cache, edata->url);
+    return entry ? entry->data : NULL;
+}
+
+static void
+_cache_update(NMHttpClient *self, EHandleData *edata)
+{
+    NMHttpClientPrivate *priv = NM_HTTP_CLIENT_GET_PRIVATE(self);
+    CacheEntry          *entry;
+
+    if (!edata->cacheable || !priv->cache)
+        return;
+
+    if (!edata->etag && !edata->last_modified) {
+        /* The server does not support conditional requests for this
+         * resource. Caching it would be pointless. */
+        if (g_hash_table_remove(priv->cache, edata->url))
+            priv->cache_dirty = TRUE;
+        return;
+    }
+
+    entry  = g_slice_new(CacheEntry);
+    *entry = (CacheEntry){
+        .etag          = g_strdup(edata->etag),
+        .last_modified = g_strdup(edata->last_modified),
+        .data          = g_bytes_new(nm_str_buf_get_str_unsafe(&edata->recv_data),
+                                     edata->recv_data.len),
+    };
+    g_hash_table_insert(priv->cache, g_strdup(edata->url), entry);
+    priv->cache_dirty = TRUE;
+}
+
+static void
+_ehandle_restart_unconditional(NMHttpClient *self, EHandleData *edata)
+{
+    NMHttpClientPrivate *priv    = NM_HTTP_CLIENT_GET_PRIVATE(self);
+    struct curl_slist   *headers = NULL;
+    struct curl_slist   *iter;
+
+    nm_assert(edata->running);
+    nm_assert(edata->conditional);
+
+    _LOG2D(edata, "not modified, but the cached response is gone. Request again");
+
+    /* The condition is the last header. Keep the others. */
+    for (iter = edata->headers; iter && iter->next; iter = iter->next) {
+        struct curl_slist *tmp;
+
+        tmp = curl_slist_append(headers, iter->data);
+        if (!tmp) {
+            _LOGE("curl: curl_slist_append() failed adding %s", iter->data);
+            continue;
+        }
+        headers = tmp;
+    }
+    curl_slist_free_all(edata->headers);
+    edata->headers     = headers;
+    edata->conditional = FALSE;
+    curl_easy_setopt(edata->ehandle, CURLOPT_HTTPHEADER, edata->headers);
+
+    nm_str_buf_reset(&edata->recv_data);
+    nm_clear_g_free(&edata->etag);
+    nm_clear_g_free(&edata->last_modified);
+
+    /* Adding the handle again starts a new transfer. The timeout and the
+     * cancellable of the request still apply. */
+    curl_multi_remove_handle(priv->mhandle, edata->ehandle);
+    curl_multi_add_handle(priv->mhandle, edata->ehandle);
+}
+
 static void
 _ehandle_complete(EHandleData *edata, GError *error_take)
 {
-    GetResult    *req_result;
-    gs_free char *str_tmp_1     = NULL;
-    long          response_code = -1;
+    gs_unref_object NMHttpClient *self = g_object_ref(g_task_get_source_object(edata->task));
+    GetResult                    *req_result;
+    gs_free char                 *str_tmp_1     = NULL;
+    long                          response_code = -1;
+    GBytes                       *cached;
+
+    if (!error_take && edata->conditional && edata->ehandle_result == CURLE_OK
+        && curl_easy_getinfo(edata->ehandle, CURLINFO_RESPONSE_CODE, &response_code) == CURLE_OK
+        && response_code == 304 && !_cache_lookup(self, edata)) {
+        /* We made the request conditional, but meanwhile the cache entry was
+         * dropped (e.g. another response for the URL had no validator). A 304
+         * is useless without it, so fall back to a plain GET. */
+        _ehandle_restart_unconditional(self, edata);
+        return;
+    }
 
     nm_clear_pointer(&edata->timeout_source, nm_g_source_destroy_and_unref);
 
@@ -179,12 +363,27 @@ _ehandle_complete(EHandleData *edata, GError *error_take)
         _ehandle_free_ehandle(edata);
         g_task_return_error(edata->task, error_take);
         _ehandle_free(edata);
+        _queue_process(self);
         return;
     }
 
     if (curl_easy_getinfo(edata->ehandle, CURLINFO_RESPONSE_CODE, &response_code) != CURLE_OK)
         _LOG2E(edata, "failed to get response code from curl easy handle");
 
+    if (response_code == 304 && (cached = _cache_lookup(self, edata))) {
+        gsize         len;
+        gconstpointer data;
+
+        /* Pretend that we received the cached response. The caller cannot
+         * tell the difference, which is the point. */
+        _LOG2D(edata, "not modified, use cached response");
+        data = g_bytes_get_data(cached, &len);
+        nm_str_buf_reset(&edata->recv_data);
+        nm_str_buf_append_len(&edata->recv_data, data, len);
+        response_code = 200;
+    } else if (response_code == 200)
+        _cache_update(self, edata);
+
     _LOG2D(edata,
            "success getting %" G_GSIZE_FORMAT " bytes (response code %ld)",
            edata->recv_data.len,
@@ -211,6 +410,7 @@ _ehandle_complete(EHandleData *edata, GError *error_take)
     g_task_return_pointer(edata->task, req_result, _req_result_free);
 
     _ehandle_free(edata);
+    _queue_process(self);
 }
 
 /*****************************************************************************/
@@ -236,6 +436,41 @@ _get_writefunction_cb(char *ptr, size_t size, size_t nmemb, void *user_data)
     return nconsume;
 }
 
+static size_t
+_get_headerfunction_cb(char *ptr, size_t size, size_t nmemb, void *user_data)
+{
+    EHandleData  *edata = user_data;
+    gs_free char *line  = NULL;
+    char        **p_target;
+    const char   *value;
+
+    nmemb *= size;
+
+    line = g_strndup(ptr, nmemb);
+
+    if (NM_STR_HAS_PREFIX(line, "HTTP/")) {
+        /* A new response starts (e.g. after a redirect). Forget what we saw. */
+        nm_clear_g_free(&edata->etag);
+        nm_clear_g_free(&edata->last_modified);
+        return nmemb;
+    }
+
+    if (g_ascii_strncasecmp(line, "ETag:", NM_STRLEN("ETag:")) == 0) {
+        value    = &line[NM_STRLEN("ETag:")];
+        p_target = &edata->etag;
+    } else if (g_ascii_strncasecmp(line, "Last-Modified:", NM_STRLEN("Last-Modified:")) == 0) {
+        value    = &line[NM_STRLEN("Last-Modified:")];
+        p_target = &edata->last_modified;
+    } else
+        return nmemb;
+
+    g_free(*p_target);
+    *p_target = g_strstrip(g_strdup(value));
+    if (!(*p_target)[0])
+        nm_clear_g_free(p_target);
+    return nmemb;
+}
+
 static gboolean
 _get_timeout_cb(gpointer user_data)
 {
@@ -269,6 +504,7 @@ nm_http_client_req(NMHttpClient       *self,
 {
     NMHttpClientPrivate *priv;
     EHandleData         *edata;
+    CacheEntry          *entry = NULL;
     guint                i;
 
     g_return_if_fail(NM_IS_HTTP_CLIENT(self));
@@ -281,12 +517,15 @@ nm_http_client_req(NMHttpClient       *self,
 
     edata  = g_slice_new(EHandleData);
     *edata = (EHandleData){
-        .task      = nm_g_task_new(self, cancellable, nm_http_client_req, callback, user_data),
-        .recv_data = NM_STR_BUF_INIT(0, FALSE),
-        .max_data  = max_data,
-        .url       = g_strdup(url),
-        .headers   = NULL,
+        .task         = nm_g_task_new(self, cancellable, nm_http_client_req, callback, user_data),
+        .recv_data    = NM_STR_BUF_INIT(0, FALSE),
+        .max_data     = max_data,
+        .url          = g_strdup(url),
+        .headers      = NULL,
+        .timeout_msec = timeout_msec,
+        .cacheable    = !http_method,
     };
+    c_list_init(&edata->queue_lst);
 
     nmcs_wait_for_objects_register(edata->task);
 
@@ -305,6 +544,8 @@ nm_http_client_req(NMHttpClient       *self,
 
     curl_easy_setopt(edata->ehandle, CURLOPT_WRITEFUNCTION, _get_writefunction_cb);
     curl_easy_setopt(edata->ehandle, CURLOPT_WRITEDATA, edata);
+    curl_easy_setopt(edata->ehandle, CURLOPT_HEADERFUNCTION, _get_headerfunction_cb);
+    curl_easy_setopt(edata->ehandle, CURLOPT_HEADERDATA, edata);
     curl_easy_setopt(edata->ehandle, CURLOPT_PRIVATE, edata);
 
 #if LIBCURL_VERSION_NUM >= 0x075500 /* libcurl 7.85.0 */
@@ -313,8 +554,11 @@ nm_http_client_req(NMHttpClient       *self,
     curl_easy_setopt(edata->ehandle, CURLOPT_PROTOCOLS, CURLPROTO_HTTP | CURLPROTO_HTTPS);
 #endif
 
-    if (http_headers) {
-        for (i = 0; http_headers[i]; ++i) {
+    if (edata->cacheable && priv->cache)
+        entry = g_hash_table_lookup(priv->cache, url);
+
+    if (http_headers || entry) {
+        for (i = 0; http_headers && http_headers[i]; ++i) {
             struct curl_slist *tmp;
 
             tmp = curl_slist_append(edata->headers, http_headers[i]);
@@ -326,22 +570,36 @@ nm_http_client_req(NMHttpClient       *self,
             edata->headers = tmp;
         }
 
+        if (entry) {
+            gs_free char      *h_cond = NULL;
+            struct curl_slist *tmp;
+
+            /* Let the server tell us, whether our cached response is still up to date. */
+            if (entry->etag)
+                h_cond = g_strdup_printf("If-None-Match: %s", entry->etag);
+            else
+                h_cond = g_strdup_printf("If-Modified-Since: %s", entry->last_modified);
+
+            tmp = curl_slist_append(edata->headers, h_cond);
+            if (!tmp)
+                _LOGE("curl: curl_slist_append() failed adding %s", h_cond);
+            else {
+                edata->headers     = tmp;
+                edata->conditional = TRUE;
+            }
+        }
+
         curl_easy_setopt(edata->ehandle, CURLOPT_HTTPHEADER, edata->headers);
     }
 
     if (http_method)
         curl_easy_setopt(edata->ehandle, CURLOPT_CUSTOMREQUEST, http_method);
 
-    if (timeout_msec > 0) {
-        edata->timeout_source = _source_attach(self,
-                                               nm_g_timeout_source_new(timeout_msec,
-                                                                       G_PRIORITY_DEFAULT,
-                                                                       _get_timeout_cb,
-                                                                       edata,
-                                                                       NULL));
-    }
-
-    curl_multi_add_handle(priv->mhandle, edata->ehandle);
+    if (priv->max_parallel > 0 && priv->n_running >= priv->max_parallel) {
+        _LOG2T(edata, "queued (%u requests running)", priv->n_running);
+        c_list_link_tail(&priv->queue_lst_head, &edata->queue_lst);
+    } else
+        _ehandle_start(self, edata);
 
     if (cancellable) {
         gulong signal_id;
@@ -631,6 +889,170 @@ nm_http_client_poll_req_finish(NMHttpClient *self,
 
 /*****************************************************************************/
 
+/**
+ * nm_http_client_set_max_parallel:
+ * @self: the #NMHttpClient instance
+ * @max_parallel: the maximum number of requests that are in flight at
+ *   the same time, or zero for no limit.
+ *
+ * Requests exceeding the limit are queued and started in order, once
+ * another request completes.
+ */
+void
+nm_http_client_set_max_parallel(NMHttpClient *self, guint max_parallel)
+{
+    NMHttpClientPrivate *priv;
+
+    g_return_if_fail(NM_IS_HTTP_CLIENT(self));
+
+    priv               = NM_HTTP_CLIENT_GET_PRIVATE(self);
+    priv->max_parallel = max_parallel;
+    _queue_process(self);
+}
+
+/*****************************************************************************/
+
+#define CACHE_KEY_URL           "url"
+#define CACHE_KEY_ETAG          "etag"
+#define CACHE_KEY_LAST_MODIFIED "last-modified"
+#define CACHE_KEY_DATA          "data"
+
+/**
+ * nm_http_client_cache_load:
+ * @self: the #NMHttpClient instance
+ * @filename: the file to load the cache from.
+ * @error: the error
+ *
+ * Enables the response cache and populates it from @filename. GET responses
+ * which carry an "ETag" or a "Last-Modified" header are remembered. When
+ * the same URL is requested again, the request is made conditional and
+ * a "304 Not Modified" reply is completed with the cached data.
+ *
+ * The cache is enabled even if loading the file fails.
+ *
+ * Returns: %TRUE on success. A missing file is not an error.
+ */
+gboolean
+nm_http_client_cache_load(NMHttpClient *self, const char *filename, GError **error)
+{
+    NMHttpClientPrivate            *priv;
+    nm_auto_unref_keyfile GKeyFile *keyfile = NULL;
+    gs_strfreev char              **groups  = NULL;
+    gs_free_error GError           *local   = NULL;
+    gsize                           i;
+
+    g_return_val_if_fail(NM_IS_HTTP_CLIENT(self), FALSE);
+    g_return_val_if_fail(filename, FALSE);
+
+    priv = NM_HTTP_CLIENT_GET_PRIVATE(self);
+
+    if (!priv->cache)
+        priv->cache = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, _cache_entry_free);
+
+    keyfile = g_key_file_new();
+    if (!g_key_file_load_from_file(keyfile, filename, G_KEY_FILE_NONE, &local)) {
+        if (g_error_matches(local, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+            return TRUE;
+        g_propagate_error(error, g_steal_pointer(&local));
+        return FALSE;
+    }
+
+    groups = g_key_file_get_groups(keyfile, NULL);
+    for (i = 0; groups[i]; i++) {
+        gs_free char *url      = NULL;
+        gs_free char *data_b64 = NULL;
+        gs_free char *etag     = NULL;
+        gs_free char *lm       = NULL;
+        CacheEntry   *entry;
+        guchar       *data;
+        gsize         data_len;
+
+        url      = g_key_file_get_string(keyfile, groups[i], CACHE_KEY_URL, NULL);
+        etag     = g_key_file_get_string(keyfile, groups[i], CACHE_KEY_ETAG, NULL);
+        lm       = g_key_file_get_string(keyfile, groups[i], CACHE_KEY_LAST_MODIFIED, NULL);
+        data_b64 = g_key_file_get_string(keyfile, groups[i], CACHE_KEY_DATA, NULL);
+        if (!url || (!etag && !lm) || !data_b64)
+            continue;
+
+        data = g_base64_decode(data_b64, &data_len);
+
+        entry  = g_slice_new(CacheEntry);
+        *entry = (CacheEntry){
+            .etag          = g_steal_pointer(&etag),
+            .last_modified = g_steal_pointer(&lm),
+            .data          = g_bytes_new_take(data, data_len),
+        };
+        g_hash_table_insert(priv->cache, g_steal_pointer(&url), entry);
+    }
+
+    _LOGD("http-cache: loaded %u entries from \"%s\"", g_hash_table_size(priv->cache), filename);
+    priv->cache_dirty = FALSE;
+    return TRUE;
+}
+
+/**
+ * nm_http_client_cache_save:
+ * @self: the #NMHttpClient instance
+ * @filename: the file to write the cache to.
+ * @error: the error
+ *
+ * Writes the response cache to @filename, if it changed since
+ * nm_http_client_cache_load().
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+nm_http_client_cache_save(NMHttpClient *self, const char *filename, GError **error)
+{
+    NMHttpClientPrivate            *priv;
+    nm_auto_unref_keyfile GKeyFile *keyfile = NULL;
+    gs_free char                   *content = NULL;
+    gsize                           content_len;
+    GHashTableIter                  iter;
+    const char                     *url;
+    CacheEntry                     *entry;
+
+    g_return_val_if_fail(NM_IS_HTTP_CLIENT(self), FALSE);
+    g_return_val_if_fail(filename, FALSE);
+
+    priv = NM_HTTP_CLIENT_GET_PRIVATE(self);
+
+    if (!priv->cache || !priv->cache_dirty)
+        return TRUE;
+
+    keyfile = g_key_file_new();
+    g_hash_table_iter_init(&iter, priv->cache);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &url, (gpointer *) &entry)) {
+        gs_free char *group    = NULL;
+        gs_free char *data_b64 = NULL;
+        gconstpointer data;
+        gsize         data_len;
+
+        /* A URL is not a valid group name (e.g. the brackets of an IPv6
+         * address). Name the group by the hash of the URL instead. */
+        group    = g_compute_checksum_for_string(G_CHECKSUM_SHA256, url, -1);
+        data     = g_bytes_get_data(entry->data, &data_len);
+        data_b64 = g_base64_encode(data, data_len);
+
+        g_key_file_set_string(keyfile, group, CACHE_KEY_URL, url);
+        if (entry->etag)
+            g_key_file_set_string(keyfile, group, CACHE_KEY_ETAG, entry->etag);
+        if (entry->last_modified)
+            g_key_file_set_string(keyfile, group, CACHE_KEY_LAST_MODIFIED, entry->last_modified);
+        g_key_file_set_string(keyfile, group, CACHE_KEY_DATA, data_b64);
+    }
+
+    content = g_key_file_to_data(keyfile, &content_len, NULL);
+    if (!nm_utils_file_set_contents(filename, content, content_len, 0600, NULL, NULL, error))
+        return FALSE;
+
+    _LOGD("http-cache: saved %u entries to \"%s\"", g_hash_table_size(priv->cache), filename);
+    priv->cache_dirty = FALSE;
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 static void
 _mhandle_action(NMHttpClient *self, int sockfd, int ev_bitmask)
 {
@@ -753,6 +1175,9 @@ nm_http_client_init(NMHttpClient *self)
 {
     NMHttpClientPrivate *priv = NM_HTTP_CLIENT_GET_PRIVATE(self);
 
+    c_list_init(&priv->queue_lst_head);
+    priv->max_parallel = MAX_PARALLEL_DEFAULT;
+
     priv->source_sockets_hashtable =
         g_hash_table_new_full(nm_direct_hash,
                               NULL,
@@ -793,8 +1218,12 @@ dispose(GObject *object)
     NMHttpClient        *self = NM_HTTP_CLIENT(object);
     NMHttpClientPrivate *priv = NM_HTTP_CLIENT_GET_PRIVATE(self);
 
+    /* Every request keeps the client alive via its GTask. */
+    nm_assert(c_list_is_empty(&priv->queue_lst_head));
+
     nm_clear_pointer(&priv->mhandle, curl_multi_cleanup);
     nm_clear_pointer(&priv->source_sockets_hashtable, g_hash_table_unref);
+    nm_clear_pointer(&priv->cache, g_hash_table_unref);
 
     nm_clear_g_source_inst(&priv->mhandle_source_timeout);
 
@@ -26,6 +26,11 @@ NMHttpClient *nm_http_client_new(void);
 
 GMainContext *nm_http_client_get_main_context(NMHttpClient *self);
 
+void nm_http_client_set_max_parallel(NMHttpClient *self, guint max_parallel);
+
+gboolean nm_http_client_cache_load(NMHttpClient *self, const char *filename, GError **error);
+gboolean nm_http_client_cache_save(NMHttpClient *self, const char *filename, GError **error);
+
 /*****************************************************************************/
 
 typedef gboolean (*NMHttpClientPollReqCheckFcn)(long     response_code,
@@ -14,6 +14,7 @@
 #include "nm-setting-connection.h"
 
 #include "libnm-core-aux-extern/nm-dispatcher-api.h"
+#include "libnm-glib-aux/nm-str-buf.h"
 #include "nm-utils.h"
 
 /*****************************************************************************/
@@ -613,3 +614,227 @@ done:
     g_ptr_array_add(items, NULL);
     return (char **) g_ptr_array_free(g_steal_pointer(&items), FALSE);
 }
+
+/*****************************************************************************/
+
+gboolean
+nm_dispatcher_utils_is_persistent_script(const char *head, gsize len)
+{
+    const char *line = head;
+    const char *end  = head + len;
+
+    while (line < end) {
+        const char *eol = memchr(line, '\n', end - line) ?: end;
+        gsize       l   = eol - line;
+
+        while (l > 0 && g_ascii_isspace(line[l - 1]))
+            l--;
+        if (l == NM_STRLEN(NM_DISPATCHER_PERSISTENT_MARKER)
+            && memcmp(line, NM_DISPATCHER_PERSISTENT_MARKER, l) == 0)
+            return TRUE;
+
+        line = eol + 1;
+    }
+    return FALSE;
+}
+
+/**
+ * nm_dispatcher_utils_build_event:
+ * @iface: the interface name, as passed as first argument to regular scripts.
+ * @action: the action, as passed as second argument.
+ * @envp: the environment of the event.
+ * @out_len: the length of the returned buffer.
+ *
+ * Persistent scripts get each event as a sequence of NUL terminated strings:
+ * the interface, the action and the "KEY=VALUE" environment entries,
+ * followed by an empty string.
+ *
+ * Returns: the event message.
+ */
+char *
+nm_dispatcher_utils_build_event(const char        *iface,
+                                const char        *action,
+                                const char *const *envp,
+                                gsize             *out_len)
+{
+    NMStrBuf strbuf = NM_STR_BUF_INIT(1024, FALSE);
+
+    nm_str_buf_append_len(&strbuf, iface, strlen(iface) + 1);
+    nm_str_buf_append_len(&strbuf, action, strlen(action) + 1);
+    for (; envp && *envp; envp++) {
+        if ((*envp)[0] == '\0')
+            continue;
+        nm_str_buf_append_len(&strbuf, *envp, strlen(*envp) + 1);
+    }
+    nm_str_buf_append_c(&strbuf, '\0');
+
+    return nm_str_buf_finalize(&strbuf, out_len);
+}
+
+/**
+ * nm_dispatcher_utils_parse_reply:
+ * @line: a line of the output of a persistent script, without newline.
+ * @out_status: the status, like the exit code of a regular script.
+ * @out_message: (allow-none): an optional message after the status.
+ *
+ * Returns: %TRUE if the line is a valid reply.
+ */
+gboolean
+nm_dispatcher_utils_parse_reply(const char *line, int *out_status, const char **out_message)
+{
+    gs_free char *str = NULL;
+    const char   *msg;
+    gint64        status;
+
+    msg = strchr(line, ' ');
+    if (msg) {
+        str  = g_strndup(line, msg - line);
+        line = str;
+        msg  = nm_str_skip_leading_spaces(msg);
+    }
+
+    status = _nm_utils_ascii_str_to_int64(line, 10, 0, 255, -1);
+    if (status < 0)
+        return FALSE;
+
+    *out_status = status;
+    NM_SET_OUT(out_message, nm_str_not_empty(msg));
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+struct _NMDispatcherLanes {
+    GHashTable *lanes; /* iface -> NMDispatcherLane */
+};
+
+struct _NMDispatcherLane {
+    char    *iface;
+    gpointer current_request;
+    GQueue   requests_waiting;
+};
+
+static void
+_lane_free(NMDispatcherLane *lane)
+{
+    g_queue_clear(&lane->requests_waiting);
+    g_free(lane->iface);
+    nm_g_slice_free(lane);
+}
+
+NMDispatcherLanes *
+nm_dispatcher_lanes_new(void)
+{
+    NMDispatcherLanes *lanes;
+
+    lanes  = g_slice_new(NMDispatcherLanes);
+    *lanes = (NMDispatcherLanes){
+        .lanes =
+            g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, (GDestroyNotify) _lane_free),
+    };
+    return lanes;
+}
+
+void
+nm_dispatcher_lanes_free(NMDispatcherLanes *lanes)
+{
+    g_hash_table_unref(lanes->lanes);
+    nm_g_slice_free(lanes);
+}
+
+guint
+nm_dispatcher_lanes_get_n(NMDispatcherLanes *lanes)
+{
+    return g_hash_table_size(lanes->lanes);
+}
+
+/**
+ * nm_dispatcher_lanes_get:
+ * @lanes: the lanes
+ * @iface: (allow-none): the interface of the request.
+ *
+ * Requests without interface ("hostname", "connectivity-change", ...)
+ * share one lane.
+ *
+ * Returns: the lane for @iface. It is created if it doesn't exist yet.
+ */
+NMDispatcherLane *
+nm_dispatcher_lanes_get(NMDispatcherLanes *lanes, const char *iface)
+{
+    NMDispatcherLane *lane;
+
+    iface = iface ?: "";
+
+    lane = g_hash_table_lookup(lanes->lanes, iface);
+    if (!lane) {
+        lane  = g_slice_new(NMDispatcherLane);
+        *lane = (NMDispatcherLane){
+            .iface            = g_strdup(iface),
+            .requests_waiting = G_QUEUE_INIT,
+        };
+        g_hash_table_insert(lanes->lanes, lane->iface, lane);
+    }
+    return lane;
+}
+
+gpointer
+nm_dispatcher_lane_get_current(NMDispatcherLane *lane)
+{
+    return lane->current_request;
+}
+
+/**
+ * nm_dispatcher_lane_push:
+ * @lane: the lane
+ * @request: the request to add.
+ *
+ * Returns: %TRUE if the lane had no current request and @request
+ * became the current one. Otherwise, @request is queued.
+ */
+gboolean
+nm_dispatcher_lane_push(NMDispatcherLane *lane, gpointer request)
+{
+    nm_assert(request);
+
+    if (lane->current_request) {
+        g_queue_push_tail(&lane->requests_waiting, request);
+        return FALSE;
+    }
+    lane->current_request = request;
+    return TRUE;
+}
+
+/**
+ * nm_dispatcher_lane_complete:
+ * @lane: the lane
+ * @request: the request that completed.
+ *
+ * Clears the current request of @lane, if it is @request.
+ */
+void
+nm_dispatcher_lane_complete(NMDispatcherLane *lane, gpointer request)
+{
+    if (lane->current_request == request)
+        lane->current_request = NULL;
+}
+
+/**
+ * nm_dispatcher_lanes_next:
+ * @lanes: the lanes
+ * @lane: the lane of @lanes to advance.
+ *
+ * Clears the current request of @lane and makes the first waiting
+ * request the current one. If there is none, @lane is destroyed.
+ *
+ * Returns: the new current request or %NULL.
+ */
+gpointer
+nm_dispatcher_lanes_next(NMDispatcherLanes *lanes, NMDispatcherLane *lane)
+{
+    lane->current_request = g_queue_pop_head(&lane->requests_waiting);
+    if (!lane->current_request) {
+        g_hash_table_remove(lanes->lanes, lane->iface);
+        return NULL;
+    }
+    return lane->current_request;
+}
@@ -23,4 +23,35 @@ char **nm_dispatcher_utils_construct_envp(const char  *action,
                                           char       **out_iface,
                                           const char **out_error_message);
 
+/* A script that has this line near the beginning is started once and
+ * then gets the events on stdin. See nm_dispatcher_utils_build_event(). */
+#define NM_DISPATCHER_PERSISTENT_MARKER "# NetworkManager-dispatcher: persistent"
+
+gboolean nm_dispatcher_utils_is_persistent_script(const char *head, gsize len);
+
+char *nm_dispatcher_utils_build_event(const char        *iface,
+                                      const char        *action,
+                                      const char *const *envp,
+                                      gsize             *out_len);
+
+gboolean
+nm_dispatcher_utils_parse_reply(const char *line, int *out_status, const char **out_message);
+
+/*****************************************************************************/
+
+/* Requests with "wait" scripts for the same interface are run one after
+ * the other, in a lane. Different lanes run in parallel. */
+typedef struct _NMDispatcherLanes NMDispatcherLanes;
+typedef struct _NMDispatcherLane  NMDispatcherLane;
+
+NMDispatcherLanes *nm_dispatcher_lanes_new(void);
+void               nm_dispatcher_lanes_free(NMDispatcherLanes *lanes);
+guint              nm_dispatcher_lanes_get_n(NMDispatcherLanes *lanes);
+NMDispatcherLane  *nm_dispatcher_lanes_get(NMDispatcherLanes *lanes, const char *iface);
+gpointer           nm_dispatcher_lanes_next(NMDispatcherLanes *lanes, NMDispatcherLane *lane);
+
+gpointer nm_dispatcher_lane_get_current(NMDispatcherLane *lane);
+gboolean nm_dispatcher_lane_push(NMDispatcherLane *lane, gpointer request);
+void     nm_dispatcher_lane_complete(NMDispatcherLane *lane, gpointer request);
+
 #endif /* __NETWORKMANAGER_DISPATCHER_UTILS_H__ */
@@ -8,6 +8,7 @@
 #include "libnm-client-aux-extern/nm-default-client.h"
 
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -33,6 +34,7 @@
 /*****************************************************************************/
 
 typedef struct Request Request;
+typedef struct Worker  Worker;
 
 typedef struct {
     GDBusConnection *dbus_connection;
@@ -50,9 +52,13 @@ typedef struct {
 
     gboolean persist;
 
-    Request *current_request;
-    GQueue  *requests_waiting;
-    int      num_requests_pending;
+    NMDispatcherLanes *lanes;
+    int                num_requests_pending;
+
+    GHashTable *workers;         /* path -> Worker of the running persistent scripts */
+    GHashTable *workers_retired; /* Worker that were asked to exit */
+
+    GHashTable *persistent_infos; /* path -> PersistentInfo */
 
     bool exit_with_failure;
 
@@ -80,6 +86,9 @@ typedef struct {
     int      stdout_fd;
     GSource *stdout_source;
     NMStrBuf stdout_buffer;
+
+    gboolean persistent;
+    Worker  *worker; /* the worker that still owes a reply */
 } ScriptInfo;
 
 struct Request {
@@ -93,10 +102,11 @@ struct Request {
     gboolean               is_action2;
     gboolean               is_device_handler;
 
-    GPtrArray *scripts; /* list of ScriptInfo */
-    guint      idx;
-    int        num_scripts_done;
-    int        num_scripts_nowait;
+    NMDispatcherLane *lane;    /* only for requests with "wait" scripts */
+    GPtrArray        *scripts; /* list of ScriptInfo */
+    guint             idx;
+    int               num_scripts_done;
+    int               num_scripts_nowait;
 };
 
 /*****************************************************************************/
@@ -204,6 +214,7 @@ script_info_free(gpointer ptr)
     nm_assert(!info->stdout_source);
     nm_assert(!info->timeout_source);
     nm_assert(!info->watch_source);
+    nm_assert(!info->worker);
 
     g_free(info->script);
     g_free(info->error);
@@ -256,40 +267,37 @@ _idle_timeout_restart(void)
 /**
  * next_request:
  *
+ * @lane: the lane of the request
  * @request: (nullable): the request to set as next. If %NULL, dequeue the next
  * waiting request. Otherwise, try to set the given request.
  *
- * Sets the currently active request (@current_request). The current request
- * is a request that has at least on "wait" script, because requests that only
- * consist of "no-wait" scripts are handled right away and not enqueued to
+ * Sets the currently active request (@current_request) of the lane. The current
+ * request is a request that has at least on "wait" script, because requests that
+ * only consist of "no-wait" scripts are handled right away and not enqueued to
  * @requests_waiting nor set as @current_request.
  *
+ * If the lane has no more requests, it gets destroyed.
+ *
  * Returns: %TRUE, if there was currently not request in process and it set
  * a new request as current.
  */
 static gboolean
-next_request(Request *request)
+next_request(NMDispatcherLane *lane, Request *request)
 {
     if (request) {
-        if (gl.current_request) {
-            g_queue_push_tail(gl.requests_waiting, request);
+        if (!nm_dispatcher_lane_push(lane, request))
             return FALSE;
-        }
     } else {
         /* when calling next_request() without explicit @request, we always
          * forcefully clear @current_request. That one is certainly
          * handled already. */
-        gl.current_request = NULL;
-
-        request = g_queue_pop_head(gl.requests_waiting);
+        request = nm_dispatcher_lanes_next(gl.lanes, lane);
         if (!request)
             return FALSE;
     }
 
     _LOG_R_D(request, "start running ordered scripts...");
 
-    gl.current_request = request;
-
     return TRUE;
 }
 
@@ -420,23 +428,22 @@ complete_request(Request *request)
 
     _LOG_R_T(request, "completed (%u scripts)", request->scripts->len);
 
-    if (gl.current_request == request)
-        gl.current_request = NULL;
+    if (request->lane)
+        nm_dispatcher_lane_complete(request->lane, request);
 
     request_free(request);
 
     nm_assert(gl.num_requests_pending > 0);
-    if (--gl.num_requests_pending <= 0) {
-        nm_assert(!gl.current_request && !g_queue_peek_head(gl.requests_waiting));
+    if (--gl.num_requests_pending <= 0)
         _idle_timeout_restart();
-    }
 }
 
 static void
 complete_script(ScriptInfo *script)
 {
-    Request *request = script->request;
-    gboolean wait    = script->wait;
+    Request          *request = script->request;
+    NMDispatcherLane *lane    = request->lane;
+    gboolean          wait    = script->wait;
 
     if (script->pid != -1 || script->stdout_fd != -1) {
         /* Wait that process has terminated and stdout is closed */
@@ -454,7 +461,7 @@ complete_script(ScriptInfo *script)
             return;
     }
 
-    nm_assert(!wait || gl.current_request == request);
+    nm_assert(!wait || nm_dispatcher_lane_get_current(lane) == request);
 
     /* Try to complete the request. @request will be possibly free'd,
      * making @script and @request a dangling pointer. */
@@ -467,11 +474,12 @@ complete_script(ScriptInfo *script)
          * requests. However, if this was the last "no-wait" script and
          * there are "wait" scripts ready to run, launch them.
          */
-        if (gl.current_request == request && gl.current_request->num_scripts_nowait == 0) {
-            if (dispatch_one_script(gl.current_request))
+        if (lane && nm_dispatcher_lane_get_current(lane) == request
+            && request->num_scripts_nowait == 0) {
+            if (dispatch_one_script(request))
                 return;
 
-            complete_request(gl.current_request);
+            complete_request(request);
         } else
             return;
     } else {
@@ -481,14 +489,14 @@ complete_script(ScriptInfo *script)
          * with the next request...
          *
          * Also, it cannot be that there is another request currently being
-         * processed because only requests with "wait" scripts can become
-         * @current_request. As there can only be one "wait" script running
-         * at any time, it means complete_request() above completed @request. */
-        nm_assert(!gl.current_request);
+         * processed in the lane because only requests with "wait" scripts can
+         * become @current_request. As there can only be one "wait" script running
+         * per lane, it means complete_request() above completed @request. */
+        nm_assert(!nm_dispatcher_lane_get_current(lane));
     }
 
-    while (next_request(NULL)) {
-        request = gl.current_request;
+    while (next_request(lane, NULL)) {
+        request = nm_dispatcher_lane_get_current(lane);
 
         if (dispatch_one_script(request))
             return;
@@ -651,6 +659,417 @@ script_have_data(int fd, GIOCondition condition, gpointer user_data)
     return G_SOURCE_CONTINUE;
 }
 
+/*****************************************************************************/
+
+/* Persistent scripts (see NM_DISPATCHER_PERSISTENT_MARKER) are started once
+ * and kept running as a Worker. Events are written to their stdin and they
+ * reply with one line per event on stdout, in order. */
+
+struct Worker {
+    char       *path;
+    struct stat st;
+    GPid        pid;
+    int         stdin_fd;
+    int         stdout_fd;
+    GSource    *watch_source;
+    GSource    *stdin_source;
+    GSource    *stdout_source;
+    NMStrBuf    out_buffer;
+    NMStrBuf    in_buffer;
+    GQueue      scripts; /* ScriptInfo waiting for their reply */
+    bool        retired : 1;
+};
+
+static gboolean
+_stat_same_file(const struct stat *a, const struct stat *b)
+{
+    return a->st_dev == b->st_dev && a->st_ino == b->st_ino && a->st_size == b->st_size
+           && a->st_mtim.tv_sec == b->st_mtim.tv_sec && a->st_mtim.tv_nsec == b->st_mtim.tv_nsec;
+}
+
+static void
+worker_free(Worker *worker)
+{
+    nm_assert(g_queue_is_empty(&worker->scripts));
+
+    if (worker->retired)
+        g_hash_table_remove(gl.workers_retired, worker);
+    else if (g_hash_table_lookup(gl.workers, worker->path) == worker)
+        g_hash_table_remove(gl.workers, worker->path);
+
+    nm_clear_g_source_inst(&worker->watch_source);
+    nm_clear_g_source_inst(&worker->stdin_source);
+    nm_clear_g_source_inst(&worker->stdout_source);
+    nm_clear_fd(&worker->stdin_fd);
+    nm_clear_fd(&worker->stdout_fd);
+
+    if (worker->pid != -1) {
+        kill(worker->pid, SIGKILL);
+again:
+        if (waitpid(worker->pid, NULL, 0) == -1) {
+            if (errno == EINTR)
+                goto again;
+        }
+    }
+
+    nm_str_buf_destroy(&worker->out_buffer);
+    nm_str_buf_destroy(&worker->in_buffer);
+    g_free(worker->path);
+    nm_g_slice_free(worker);
+}
+
+/**
+ * worker_fail:
+ * @worker: the worker
+ * @timed_out: (nullable): the script whose event timed out
+ * @reason: why the worker is killed
+ *
+ * Kills the worker and completes all events that are waiting for a reply.
+ */
+static void
+worker_fail(Worker *worker, ScriptInfo *timed_out, const char *reason)
+{
+    GQueue      scripts = G_QUEUE_INIT;
+    ScriptInfo *script;
+
+    if (worker->retired && g_queue_is_empty(&worker->scripts))
+        _LOG_X_D("persistent script '%s' %s", worker->path, reason);
+    else
+        _LOG_X_W("persistent script '%s' %s", worker->path, reason);
+
+    NM_SWAP(&scripts, &worker->scripts);
+    worker_free(worker);
+
+    while ((script = g_queue_pop_head(&scripts))) {
+        nm_clear_g_source_inst(&script->timeout_source);
+        script->worker = NULL;
+        nm_clear_g_free(&script->error);
+        if (script == timed_out) {
+            script->error  = g_strdup_printf("Script '%s' timed out", script->script);
+            script->result = DISPATCH_RESULT_TIMEOUT;
+        } else {
+            script->error  = g_strdup_printf("Script '%s' %s", script->script, reason);
+            script->result = DISPATCH_RESULT_FAILED;
+        }
+        _LOG_S_W(script, "complete: %s", script->error);
+        complete_script(script);
+    }
+}
+
+static gboolean
+worker_timeout_cb(gpointer user_data)
+{
+    ScriptInfo *script = user_data;
+
+    nm_clear_g_source_inst(&script->timeout_source);
+    worker_fail(script->worker, script, "timed out (kill script)");
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * worker_process_replies:
+ *
+ * Returns: %FALSE if the worker failed and was destroyed.
+ */
+static gboolean
+worker_process_replies(Worker *worker)
+{
+    while (TRUE) {
+        gs_free char *line = NULL;
+        const char   *buf;
+        const char   *eol;
+        const char   *message;
+        ScriptInfo   *script;
+        int           status;
+        gsize         l;
+
+        buf = nm_str_buf_get_str_unsafe(&worker->in_buffer);
+        eol = buf ? memchr(buf, '\n', worker->in_buffer.len) : NULL;
+        if (!eol)
+            return TRUE;
+
+        l = eol - buf;
+        while (l > 0 && g_ascii_isspace(buf[l - 1]))
+            l--;
+        line = g_strndup(buf, l);
+        nm_str_buf_erase(&worker->in_buffer, 0, (eol - buf) + 1, FALSE);
+
+        script = g_queue_pop_head(&worker->scripts);
+        if (!script || !nm_dispatcher_utils_parse_reply(line, &status, &message)) {
+            if (script)
+                g_queue_push_head(&worker->scripts, script);
+            worker_fail(worker, NULL, "sent an invalid reply");
+            return FALSE;
+        }
+
+        nm_clear_g_source_inst(&script->timeout_source);
+        script->worker = NULL;
+
+        if (status == 0) {
+            script->result = DISPATCH_RESULT_SUCCESS;
+            _LOG_S_T(script, "complete: persistent script succeeded");
+        } else {
+            script->result = DISPATCH_RESULT_FAILED;
+            script->error  = g_strdup_printf("Script '%s' failed with status %d%s%s",
+                                            script->script,
+                                            status,
+                                            message ? ": " : "",
+                                            message ?: "");
+            _LOG_S_W(script, "complete: %s", script->error);
+        }
+
+        /* This might dispatch further events to this worker, but it
+         * doesn't destroy it. */
+        complete_script(script);
+    }
+}
+
+static gboolean
+worker_stdout_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    Worker *worker = user_data;
+    gssize  n_read;
+
+    n_read = nm_utils_fd_read(fd, &worker->in_buffer);
+    if (n_read == -EAGAIN)
+        return G_SOURCE_CONTINUE;
+
+    if (n_read > 0) {
+        if (!worker_process_replies(worker))
+            return G_SOURCE_CONTINUE;
+        if (worker->in_buffer.len < 8 * 1024)
+            return G_SOURCE_CONTINUE;
+    }
+
+    worker_fail(worker, NULL, n_read > 0 ? "sent a too long reply" : "closed stdout");
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+worker_stdin_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    Worker *worker = user_data;
+    gssize  n;
+
+    while (worker->out_buffer.len > 0) {
+        n = write(fd,
+                  nm_str_buf_get_str_unsafe(&worker->out_buffer),
+                  worker->out_buffer.len);
+        if (n < 0) {
+            int errsv = errno;
+
+            if (errsv == EINTR)
+                continue;
+            if (errsv == EAGAIN)
+                return G_SOURCE_CONTINUE;
+            worker_fail(worker, NULL, "does not accept events");
+            return G_SOURCE_CONTINUE;
+        }
+        nm_str_buf_erase(&worker->out_buffer, 0, n, FALSE);
+    }
+
+    nm_clear_g_source_inst(&worker->stdin_source);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+worker_watch_cb(GPid pid, int status, gpointer user_data)
+{
+    Worker       *worker      = user_data;
+    gs_free char *status_desc = NULL;
+
+    nm_assert(pid == worker->pid);
+
+    nm_clear_g_source_inst(&worker->watch_source);
+    worker->pid = -1;
+
+    /* Completing the replies below may dispatch the next event for this
+     * script. That must start a new worker instead of using this one. */
+    if (!worker->retired)
+        g_hash_table_remove(gl.workers, worker->path);
+
+    /* Process the replies it sent before exiting. */
+    if (worker->stdout_fd >= 0) {
+        while (nm_utils_fd_read(worker->stdout_fd, &worker->in_buffer) > 0) {
+            if (!worker_process_replies(worker))
+                return;
+        }
+    }
+
+    status_desc = nm_utils_get_process_exit_status_desc(status);
+    worker_fail(worker, NULL, status_desc);
+}
+
+static Worker *
+worker_start(const char *path, const struct stat *st, GError **error)
+{
+    gs_free char *env_path = NULL;
+    const char   *envp[3];
+    char         *argv[2];
+    Worker       *worker;
+    guint         i = 0;
+
+    worker  = g_slice_new(Worker);
+    *worker = (Worker){
+        .path       = g_strdup(path),
+        .st         = *st,
+        .pid        = -1,
+        .stdin_fd   = -1,
+        .stdout_fd  = -1,
+        .out_buffer = NM_STR_BUF_INIT(0, FALSE),
+        .in_buffer  = NM_STR_BUF_INIT(0, FALSE),
+        .scripts    = G_QUEUE_INIT,
+    };
+
+    argv[0] = worker->path;
+    argv[1] = NULL;
+
+    if (g_getenv("PATH"))
+        envp[i++] = (env_path = g_strconcat("PATH=", g_getenv("PATH"), NULL));
+    envp[i++] = "NM_DISPATCHER_PERSISTENT=1";
+    envp[i]   = NULL;
+
+    if (!g_spawn_async_with_pipes("/",
+                                  argv,
+                                  (char **) envp,
+                                  G_SPAWN_CLOEXEC_PIPES | G_SPAWN_DO_NOT_REAP_CHILD,
+                                  NULL,
+                                  NULL,
+                                  &worker->pid,
+                                  &worker->stdin_fd,
+                                  &worker->stdout_fd,
+                                  NULL,
+                                  error)) {
+        worker->pid = -1;
+        worker_free(worker);
+        return NULL;
+    }
+
+    _LOG_X_D("persistent script '%s' started with pid %ld", path, (long) worker->pid);
+
+    nm_io_fcntl_setfl_update_nonblock(worker->stdin_fd);
+    nm_io_fcntl_setfl_update_nonblock(worker->stdout_fd);
+
+    worker->watch_source  = nm_g_child_watch_add_source(worker->pid, worker_watch_cb, worker);
+    worker->stdout_source = nm_g_unix_fd_add_source(worker->stdout_fd,
+                                                    G_IO_IN | G_IO_ERR | G_IO_HUP,
+                                                    worker_stdout_cb,
+                                                    worker);
+
+    g_hash_table_insert(gl.workers, worker->path, worker);
+    return worker;
+}
+
+static void
+worker_retire(Worker *worker)
+{
+    nm_assert(g_queue_is_empty(&worker->scripts));
+
+    /* Closing stdin asks the script to exit. It gets freed once it does. */
+    g_hash_table_remove(gl.workers, worker->path);
+    g_hash_table_add(gl.workers_retired, worker);
+    worker->retired = TRUE;
+    nm_clear_g_source_inst(&worker->stdin_source);
+    nm_clear_fd(&worker->stdin_fd);
+    if (worker->pid != -1)
+        kill(worker->pid, SIGTERM);
+}
+
+static gboolean
+worker_dispatch(ScriptInfo *script, GError **error)
+{
+    Request      *request = script->request;
+    gs_free char *event   = NULL;
+    Worker       *worker;
+    struct stat   st;
+    gsize         len;
+
+    if (stat(script->script, &st) != 0) {
+        int errsv = errno;
+
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(errsv),
+                    "cannot stat: %s",
+                    nm_strerror_native(errsv));
+        return FALSE;
+    }
+
+    worker = g_hash_table_lookup(gl.workers, script->script);
+    if (worker && !_stat_same_file(&worker->st, &st) && g_queue_is_empty(&worker->scripts)) {
+        /* The script was updated. Restart it. */
+        _LOG_X_D("persistent script '%s' changed, restart it", worker->path);
+        worker_retire(worker);
+        worker = NULL;
+    }
+    if (!worker) {
+        worker = worker_start(script->script, &st, error);
+        if (!worker)
+            return FALSE;
+    }
+
+    event = nm_dispatcher_utils_build_event(
+        request->iface ?: (nm_streq(request->action, NMD_ACTION_HOSTNAME) ? "none" : ""),
+        request->action,
+        (const char *const *) request->envp,
+        &len);
+    nm_str_buf_append_len(&worker->out_buffer, event, len);
+    g_queue_push_tail(&worker->scripts, script);
+    script->worker = worker;
+
+    /* Writing happens from the main loop, so that a failure doesn't destroy
+     * the worker while the caller still uses it. */
+    if (!worker->stdin_source) {
+        worker->stdin_source = nm_g_unix_fd_add_source(worker->stdin_fd,
+                                                       G_IO_OUT | G_IO_ERR | G_IO_HUP,
+                                                       worker_stdin_cb,
+                                                       worker);
+    }
+
+    return TRUE;
+}
+
+typedef struct {
+    struct stat st;
+    bool        persistent;
+} PersistentInfo;
+
+static gboolean
+script_is_persistent(const char *path)
+{
+    nm_auto_close int fd = -1;
+    PersistentInfo   *info;
+    struct stat       st;
+    char              head[1024];
+    gssize            n;
+
+    if (stat(path, &st) != 0)
+        return FALSE;
+
+    /* Every event checks every script. Only read the head of the script
+     * again if it changed. */
+    info = g_hash_table_lookup(gl.persistent_infos, path);
+    if (info && _stat_same_file(&info->st, &st))
+        return info->persistent;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    n  = fd >= 0 ? nm_utils_fd_read_loop(fd, head, sizeof(head), FALSE) : -1;
+    if (n <= 0) {
+        g_hash_table_remove(gl.persistent_infos, path);
+        return FALSE;
+    }
+
+    if (!info) {
+        info = g_slice_new(PersistentInfo);
+        g_hash_table_insert(gl.persistent_infos, g_strdup(path), info);
+    }
+    info->st         = st;
+    info->persistent = nm_dispatcher_utils_is_persistent_script(head, n);
+    return info->persistent;
+}
+
+/*****************************************************************************/
+
 static gboolean
 script_dispatch(ScriptInfo *script)
 {
@@ -672,7 +1091,26 @@ script_dispatch(ScriptInfo *script)
     argv[2] = request->action;
     argv[3] = NULL;
 
-    _LOG_S_T(script, "run script%s", script->wait ? "" : " (no-wait)");
+    _LOG_S_T(script,
+             "run script%s%s",
+             script->wait ? "" : " (no-wait)",
+             script->persistent ? " (persistent)" : "");
+
+    if (script->persistent) {
+        if (!worker_dispatch(script, &error)) {
+            _LOG_S_W(script, "complete: failed to execute script: %s", error->message);
+            script->result = DISPATCH_RESULT_EXEC_FAILED;
+            script->error  = g_strdup(error->message);
+            request->num_scripts_done++;
+            return FALSE;
+        }
+
+        script->timeout_source =
+            nm_g_timeout_add_seconds_source(SCRIPT_TIMEOUT, worker_timeout_cb, script);
+        if (!script->wait)
+            request->num_scripts_nowait++;
+        return TRUE;
+    }
 
     if (!g_spawn_async_with_pipes("/",
                                   argv,
@@ -1052,6 +1490,7 @@ _handle_action(GDBusMethodInvocation *invocation, GVariant *parameters, gboolean
             s->stdout_fd     = -1;
             s->pid           = -1;
             s->stdout_buffer = NM_STR_BUF_INIT(0, FALSE);
+            s->persistent    = !request->is_device_handler && script_is_persistent(s->script);
             g_ptr_array_add(request->scripts, s);
         }
         g_slist_free(sorted_scripts);
@@ -1089,11 +1528,16 @@ _handle_action(GDBusMethodInvocation *invocation, GVariant *parameters, gboolean
     }
 
     if (num_nowait < request->scripts->len) {
+        NMDispatcherLane *lane;
+
         /* The request has at least one wait script.
          * Try next_request() to schedule the request for
-         * execution. This either enqueues the request or
-         * sets it as gl.current_request. */
-        if (next_request(request)) {
+         * execution. This either enqueues the request in the
+         * lane of the interface or sets it as the lane's
+         * current_request. */
+        lane          = nm_dispatcher_lanes_get(gl.lanes, request->iface);
+        request->lane = lane;
+        if (next_request(lane, request)) {
             /* @request is now @current_request. Go ahead and
              * schedule the first wait script. */
             if (!dispatch_one_script(request)) {
@@ -1101,7 +1545,7 @@ _handle_action(GDBusMethodInvocation *invocation, GVariant *parameters, gboolean
                  * request. Try complete_request(). */
                 complete_request(request);
 
-                if (next_request(NULL)) {
+                if (next_request(lane, NULL)) {
                     /* As @request was successfully scheduled as next_request(), there is no
                      * other request in queue that can be scheduled afterwards. Assert against
                      * that, but call next_request() to clear current_request. */
@@ -1114,7 +1558,7 @@ _handle_action(GDBusMethodInvocation *invocation, GVariant *parameters, gboolean
          * the request right away (we might have failed to schedule any
          * of the scripts). It will be either completed now, or later
          * when the pending scripts return.
-         * We don't enqueue it to gl.requests_waiting.
+         * We don't enqueue it to a lane.
          * There is no need to handle next_request(), because @request is
          * not the current request anyway and does not interfere with requests
          * that have any "wait" scripts. */
@@ -1510,7 +1954,13 @@ main(int argc, char **argv)
 
     _LOG_X_D("dbus: unique name: %s", g_dbus_connection_get_unique_name(gl.dbus_connection));
 
-    gl.requests_waiting = g_queue_new();
+    gl.lanes            = nm_dispatcher_lanes_new();
+    gl.workers          = g_hash_table_new(nm_str_hash, g_str_equal);
+    gl.workers_retired  = g_hash_table_new(nm_direct_hash, NULL);
+    gl.persistent_infos = g_hash_table_new_full(nm_str_hash,
+                                                g_str_equal,
+                                                g_free,
+                                                nm_g_slice_free_fcn(PersistentInfo));
 
     _idle_timeout_restart();
 
@@ -1551,7 +2001,38 @@ done:
                                             nm_steal_int(&gl.service_regist_id));
     }
 
-    nm_clear_pointer(&gl.requests_waiting, g_queue_free);
+    nm_assert(!gl.lanes || nm_dispatcher_lanes_get_n(gl.lanes) == 0);
+    nm_clear_pointer(&gl.lanes, nm_dispatcher_lanes_free);
+
+    if (gl.workers) {
+        GHashTableIter iter;
+        Worker        *worker;
+
+        /* Stop the persistent scripts. Events that still wait for a reply
+         * fail. Completing them might start new workers, so loop until
+         * none are left. */
+        while (g_hash_table_size(gl.workers) > 0) {
+            g_hash_table_iter_init(&iter, gl.workers);
+            g_hash_table_iter_next(&iter, NULL, (gpointer *) &worker);
+            if (g_queue_is_empty(&worker->scripts))
+                worker_retire(worker);
+            else
+                worker_fail(worker, NULL, "stopped on shutdown");
+        }
+
+        /* Retired workers are only freed when they exit. Don't wait for
+         * that, free (and kill) them now. */
+        while (g_hash_table_size(gl.workers_retired) > 0) {
+            g_hash_table_iter_init(&iter, gl.workers_retired);
+            g_hash_table_iter_next(&iter, (gpointer *) &worker, NULL);
+            nm_assert(g_queue_is_empty(&worker->scripts));
+            worker_free(worker);
+        }
+
+        nm_clear_pointer(&gl.workers, g_hash_table_unref);
+        nm_clear_pointer(&gl.workers_retired, g_hash_table_unref);
+        nm_clear_pointer(&gl.persistent_infos, g_hash_table_unref);
+    }
 
     nm_clear_g_source_inst(&gl.source_idle_timeout);
 
@@ -628,6 +628,118 @@ test_gdbus_codegen(void)
 
 /*****************************************************************************/
 
+static void
+test_persistent_script(void)
+{
+#define _check(head, expected)                                                               \
+    g_assert_cmpint(nm_dispatcher_utils_is_persistent_script("" head "", NM_STRLEN(head)), \
+                    ==,                                                                      \
+                    (expected))
+
+    _check("", FALSE);
+    _check("#!/bin/sh\n", FALSE);
+    _check("#!/bin/sh\n# NetworkManager-dispatcher: persistent\n", TRUE);
+    _check("#!/bin/sh\n# NetworkManager-dispatcher: persistent  \r\n", TRUE);
+    _check("#!/bin/sh\n# NetworkManager-dispatcher: persistent", TRUE);
+    _check("#!/bin/sh\n# NetworkManager-dispatcher: persistent!\n", FALSE);
+    _check("#!/bin/sh\n  # NetworkManager-dispatcher: persistent\n", FALSE);
+#undef _check
+}
+
+static void
+test_build_event(void)
+{
+    const char *const envp[]   = {"CONNECTION_ID=eth0", "", "DEVICE_IFACE=eth0", NULL};
+    static const char expected[] = "eth0\0up\0CONNECTION_ID=eth0\0DEVICE_IFACE=eth0\0";
+    gs_free char     *event      = NULL;
+    gsize             len;
+
+    event = nm_dispatcher_utils_build_event("eth0", "up", envp, &len);
+    g_assert_cmpmem(event, len, expected, sizeof(expected));
+
+    nm_clear_g_free(&event);
+    event = nm_dispatcher_utils_build_event("", "hostname", NULL, &len);
+    g_assert_cmpmem(event, len, "\0hostname\0", NM_STRLEN("\0hostname\0") + 1);
+}
+
+static void
+test_parse_reply(void)
+{
+    const char *message;
+    int         status;
+
+    g_assert(nm_dispatcher_utils_parse_reply("0", &status, &message));
+    g_assert_cmpint(status, ==, 0);
+    g_assert_cmpstr(message, ==, NULL);
+
+    g_assert(nm_dispatcher_utils_parse_reply("3 no carrier", &status, &message));
+    g_assert_cmpint(status, ==, 3);
+    g_assert_cmpstr(message, ==, "no carrier");
+
+    g_assert(nm_dispatcher_utils_parse_reply("1 ", &status, &message));
+    g_assert_cmpint(status, ==, 1);
+    g_assert_cmpstr(message, ==, NULL);
+
+    g_assert(!nm_dispatcher_utils_parse_reply("", &status, NULL));
+    g_assert(!nm_dispatcher_utils_parse_reply("256", &status, NULL));
+    g_assert(!nm_dispatcher_utils_parse_reply("-1", &status, NULL));
+    g_assert(!nm_dispatcher_utils_parse_reply("ok", &status, NULL));
+}
+
+static void
+test_lanes(void)
+{
+    NMDispatcherLanes *lanes;
+    NMDispatcherLane  *lane_eth0;
+    NMDispatcherLane  *lane_eth1;
+    NMDispatcherLane  *lane_none;
+    int                r[5];
+
+    lanes = nm_dispatcher_lanes_new();
+
+    lane_eth0 = nm_dispatcher_lanes_get(lanes, "eth0");
+    lane_eth1 = nm_dispatcher_lanes_get(lanes, "eth1");
+    lane_none = nm_dispatcher_lanes_get(lanes, NULL);
+    g_assert(lane_eth0 != lane_eth1);
+    g_assert(nm_dispatcher_lanes_get(lanes, "eth0") == lane_eth0);
+    g_assert(nm_dispatcher_lanes_get(lanes, "") == lane_none);
+    g_assert_cmpint(nm_dispatcher_lanes_get_n(lanes), ==, 3);
+
+    /* Different lanes run in parallel. */
+    g_assert(nm_dispatcher_lane_push(lane_eth0, &r[0]));
+    g_assert(nm_dispatcher_lane_push(lane_eth1, &r[1]));
+    g_assert(nm_dispatcher_lane_push(lane_none, &r[2]));
+
+    /* Within a lane, the requests are run in order. */
+    g_assert(!nm_dispatcher_lane_push(lane_eth0, &r[3]));
+    g_assert(!nm_dispatcher_lane_push(lane_eth0, &r[4]));
+    g_assert(nm_dispatcher_lane_get_current(lane_eth0) == &r[0]);
+
+    nm_dispatcher_lane_complete(lane_eth0, &r[3]);
+    g_assert(nm_dispatcher_lane_get_current(lane_eth0) == &r[0]);
+    nm_dispatcher_lane_complete(lane_eth0, &r[0]);
+    g_assert(!nm_dispatcher_lane_get_current(lane_eth0));
+
+    g_assert(nm_dispatcher_lanes_next(lanes, lane_eth0) == &r[3]);
+    g_assert(nm_dispatcher_lane_get_current(lane_eth0) == &r[3]);
+    g_assert(nm_dispatcher_lanes_next(lanes, lane_eth0) == &r[4]);
+    g_assert(nm_dispatcher_lane_get_current(lane_eth1) == &r[1]);
+
+    /* Empty lanes are destroyed. */
+    g_assert(!nm_dispatcher_lanes_next(lanes, lane_eth0));
+    g_assert(!nm_dispatcher_lanes_next(lanes, lane_none));
+    g_assert_cmpint(nm_dispatcher_lanes_get_n(lanes), ==, 1);
+
+    lane_eth0 = nm_dispatcher_lanes_get(lanes, "eth0");
+    g_assert(!nm_dispatcher_lane_get_current(lane_eth0));
+    g_assert(nm_dispatcher_lane_push(lane_eth0, &r[0]));
+    g_assert_cmpint(nm_dispatcher_lanes_get_n(lanes), ==, 2);
+
+    nm_dispatcher_lanes_free(lanes);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -646,5 +758,10 @@ main(int argc, char **argv)
 
     g_test_add_func("/dispatcher/gdbus-codegen", test_gdbus_codegen);
 
+    g_test_add_func("/dispatcher/persistent-script", test_persistent_script);
+    g_test_add_func("/dispatcher/build-event", test_build_event);
+    g_test_add_func("/dispatcher/parse-reply", test_parse_reply);
+    g_test_add_func("/dispatcher/lanes", test_lanes);
+
     return g_test_run();
 }
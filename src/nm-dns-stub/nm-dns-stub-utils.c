@@ -0,0 +1,759 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "libnm-glib-aux/nm-default-glib-i18n-prog.h"
+
+#include "nm-dns-stub-utils.h"
+
+#include "c-list/src/c-list.h"
+
+/*****************************************************************************/
+
+/* RFC 1035, 4.1.4: the maximum length of a name on the wire. */
+#define NAME_WIRE_LEN_MAX 255u
+
+/* Limit the number of compression pointers that we follow. */
+#define NAME_JUMPS_MAX 64u
+
+/* Limit the TTL of cache entries. For negative answers, RFC 2308 recommends
+ * 1 to 3 hours as maximum, we are more conservative. */
+#define CACHE_TTL_MAX_SEC          (24u * 3600u)
+#define CACHE_NEGATIVE_TTL_MAX_SEC (15u * 60u)
+
+/* When a cache entry is hit during the last PREFETCH_PERCENT of its lifetime,
+ * refresh it in the background. Don't bother for short TTLs. */
+#define PREFETCH_PERCENT     10u
+#define PREFETCH_TTL_MIN_SEC 10u
+
+/*****************************************************************************/
+
+static gboolean
+_read_u16(const guint8 *msg, gsize len, gsize offset, guint16 *out)
+{
+    if (offset + 2u > len)
+        return FALSE;
+    *out = (((guint16) msg[offset]) << 8) | ((guint16) msg[offset + 1u]);
+    return TRUE;
+}
+
+static gboolean
+_read_u32(const guint8 *msg, gsize len, gsize offset, guint32 *out)
+{
+    if (offset + 4u > len)
+        return FALSE;
+    *out = (((guint32) msg[offset]) << 24) | (((guint32) msg[offset + 1u]) << 16)
+           | (((guint32) msg[offset + 2u]) << 8) | ((guint32) msg[offset + 3u]);
+    return TRUE;
+}
+
+static void
+_write_u32(guint8 *msg, gsize offset, guint32 val)
+{
+    msg[offset]      = val >> 24;
+    msg[offset + 1u] = (val >> 16) & 0xFF;
+    msg[offset + 2u] = (val >> 8) & 0xFF;
+    msg[offset + 3u] = val & 0xFF;
+}
+
+/* Reads the name at @offset. If @name_buf is given, it receives the name
+ * in lower case and dotted form (without trailing dot). Characters that
+ * cannot be represented are replaced by '?'. @out_end is the offset
+ * after the name in the message (not following compression pointers). */
+static gboolean
+_read_name(const guint8 *msg,
+           gsize         len,
+           gsize         offset,
+           char         *name_buf,
+           gsize        *out_end,
+           gboolean     *out_compressed)
+{
+    gsize pos      = offset;
+    gsize end      = 0;
+    gsize buf_len  = 0;
+    gsize wire_len = 0;
+    guint n_jumps  = 0;
+
+    NM_SET_OUT(out_compressed, FALSE);
+
+    while (TRUE) {
+        guint8 c;
+        guint  i;
+
+        if (pos >= len)
+            return FALSE;
+
+        c = msg[pos];
+
+        if ((c & 0xC0) == 0xC0) {
+            gsize target;
+
+            if (pos + 2u > len)
+                return FALSE;
+            if (end == 0)
+                end = pos + 2u;
+            target = (((gsize) (c & 0x3F)) << 8) | msg[pos + 1u];
+            if (target >= pos || ++n_jumps > NAME_JUMPS_MAX)
+                return FALSE;
+            NM_SET_OUT(out_compressed, TRUE);
+            pos = target;
+            continue;
+        }
+
+        if (c & 0xC0) {
+            /* extended label types are not supported. */
+            return FALSE;
+        }
+
+        if (c == 0) {
+            if (end == 0)
+                end = pos + 1u;
+            break;
+        }
+
+        if (pos + 1u + c > len)
+            return FALSE;
+
+        wire_len += 1u + c;
+        if (wire_len > NAME_WIRE_LEN_MAX)
+            return FALSE;
+
+        if (name_buf) {
+            if (buf_len > 0)
+                name_buf[buf_len++] = '.';
+            for (i = 0; i < c; i++) {
+                char ch = msg[pos + 1u + i];
+
+                if (ch == '.' || !g_ascii_isgraph(ch))
+                    ch = '?';
+                name_buf[buf_len++] = g_ascii_tolower(ch);
+            }
+        }
+
+        pos += 1u + c;
+    }
+
+    if (name_buf) {
+        nm_assert(buf_len < NM_DNS_STUB_NAME_BUF_SIZE);
+        name_buf[buf_len] = '\0';
+    }
+
+    *out_end = end;
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+gboolean
+nm_dns_stub_msg_parse_header(const guint8 *msg, gsize len, NMDnsStubMsgHeader *out)
+{
+    if (len < NM_DNS_STUB_MSG_HEADER_SIZE)
+        return FALSE;
+
+    _read_u16(msg, len, 0, &out->id);
+    _read_u16(msg, len, 2, &out->flags);
+    _read_u16(msg, len, 4, &out->qdcount);
+    _read_u16(msg, len, 6, &out->ancount);
+    _read_u16(msg, len, 8, &out->nscount);
+    _read_u16(msg, len, 10, &out->arcount);
+    return TRUE;
+}
+
+/**
+ * nm_dns_stub_msg_parse_question:
+ * @msg: the DNS message
+ * @len: the length of @msg
+ * @name_buf: (out) (optional): a buffer of NM_DNS_STUB_NAME_BUF_SIZE bytes,
+ *   that receives the lower case name of the question.
+ * @out_qtype: (out) (optional): the QTYPE
+ * @out_qclass: (out) (optional): the QCLASS
+ * @out_end: (out) (optional): the offset after the question.
+ *
+ * Parses the first question of the message. The message must have exactly
+ * one question.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+nm_dns_stub_msg_parse_question(const guint8 *msg,
+                               gsize         len,
+                               char         *name_buf,
+                               guint16      *out_qtype,
+                               guint16      *out_qclass,
+                               gsize        *out_end)
+{
+    NMDnsStubMsgHeader header;
+    gsize              end;
+    guint16            qtype;
+    guint16            qclass;
+
+    if (!nm_dns_stub_msg_parse_header(msg, len, &header))
+        return FALSE;
+    if (header.qdcount != 1)
+        return FALSE;
+    if (!_read_name(msg, len, NM_DNS_STUB_MSG_HEADER_SIZE, name_buf, &end, NULL))
+        return FALSE;
+    if (!_read_u16(msg, len, end, &qtype) || !_read_u16(msg, len, end + 2u, &qclass))
+        return FALSE;
+
+    NM_SET_OUT(out_qtype, qtype);
+    NM_SET_OUT(out_qclass, qclass);
+    NM_SET_OUT(out_end, end + 4u);
+    return TRUE;
+}
+
+gboolean
+nm_dns_stub_msg_question_equal(const guint8 *msg_a,
+                               gsize         len_a,
+                               const guint8 *msg_b,
+                               gsize         len_b)
+{
+    char    name_a[NM_DNS_STUB_NAME_BUF_SIZE];
+    char    name_b[NM_DNS_STUB_NAME_BUF_SIZE];
+    guint16 qtype_a;
+    guint16 qtype_b;
+    guint16 qclass_a;
+    guint16 qclass_b;
+
+    if (!nm_dns_stub_msg_parse_question(msg_a, len_a, name_a, &qtype_a, &qclass_a, NULL))
+        return FALSE;
+    if (!nm_dns_stub_msg_parse_question(msg_b, len_b, name_b, &qtype_b, &qclass_b, NULL))
+        return FALSE;
+
+    return qtype_a == qtype_b && qclass_a == qclass_b && nm_streq(name_a, name_b);
+}
+
+/* Overwrites the question section of @msg with the one of @query. The
+ * questions must be equal according to nm_dns_stub_msg_question_equal(), so
+ * this only changes the case of the name. We use this to answer a request
+ * with a reply (e.g. from the cache) to a request that used a different case.
+ *
+ * Returns FALSE and leaves @msg unchanged, if the questions have a different
+ * encoding. */
+gboolean
+nm_dns_stub_msg_copy_question(guint8 *msg, gsize len, const guint8 *query, gsize query_len)
+{
+    char  name[NM_DNS_STUB_NAME_BUF_SIZE];
+    gsize end;
+    gsize query_end;
+
+    if (!nm_dns_stub_msg_question_equal(msg, len, query, query_len))
+        return FALSE;
+    if (!nm_dns_stub_msg_parse_question(msg, len, name, NULL, NULL, &end))
+        return FALSE;
+    if (!nm_dns_stub_msg_parse_question(query, query_len, name, NULL, NULL, &query_end))
+        return FALSE;
+    if (end != query_end)
+        return FALSE;
+
+    memcpy(&msg[NM_DNS_STUB_MSG_HEADER_SIZE],
+           &query[NM_DNS_STUB_MSG_HEADER_SIZE],
+           end - NM_DNS_STUB_MSG_HEADER_SIZE);
+    return TRUE;
+}
+
+/**
+ * nm_dns_stub_msg_cache_key:
+ * @msg: the DNS query
+ * @len: the length of @msg
+ *
+ * Returns: (transfer full): the key for caching the response to @msg, or
+ *   %NULL if the query is not suitable for caching. Two queries have the
+ *   same key, if they only differ in the ID and the case of the name. In
+ *   particular, the EDNS0 options are part of the key.
+ */
+GBytes *
+nm_dns_stub_msg_cache_key(const guint8 *msg, gsize len)
+{
+    NMDnsStubMsgHeader header;
+    gboolean           compressed;
+    GByteArray        *arr;
+    gsize              name_end;
+    gsize              i;
+    guint16            flags;
+
+    if (!nm_dns_stub_msg_parse_header(msg, len, &header))
+        return NULL;
+    if ((header.flags & (NM_DNS_STUB_FLAG_QR | NM_DNS_STUB_FLAG_OPCODE | NM_DNS_STUB_FLAG_TC))
+        || header.qdcount != 1 || header.ancount != 0 || header.nscount != 0)
+        return NULL;
+    if (!_read_name(msg, len, NM_DNS_STUB_MSG_HEADER_SIZE, NULL, &name_end, &compressed))
+        return NULL;
+    if (compressed || name_end + 4u > len)
+        return NULL;
+
+    flags = header.flags & (NM_DNS_STUB_FLAG_RD | NM_DNS_STUB_FLAG_AD | NM_DNS_STUB_FLAG_CD);
+
+    arr = g_byte_array_sized_new(2u + (len - NM_DNS_STUB_MSG_HEADER_SIZE));
+    g_byte_array_append(arr, (const guint8 *) &flags, sizeof(flags));
+    g_byte_array_append(arr, (const guint8 *) &header.arcount, sizeof(header.arcount));
+    g_byte_array_append(arr, &msg[NM_DNS_STUB_MSG_HEADER_SIZE], len - NM_DNS_STUB_MSG_HEADER_SIZE);
+
+    /* Names are case-insensitive. The length octets of the labels are at
+     * most 63, so lowering the ASCII letters of the entire name is fine. */
+    for (i = 4u; i < 4u + (name_end - NM_DNS_STUB_MSG_HEADER_SIZE); i++)
+        arr->data[i] = g_ascii_tolower(arr->data[i]);
+
+    return g_byte_array_free_to_bytes(arr);
+}
+
+/*****************************************************************************/
+
+typedef gboolean (*RRFunc)(const guint8 *msg,
+                           gsize         len,
+                           guint         section,
+                           guint16       rr_type,
+                           gsize         ttl_offset,
+                           gsize         rdata_offset,
+                           guint16       rdlength,
+                           gpointer      user_data);
+
+/* Calls @func for all resource records in the answer (section 1),
+ * authority (section 2) and additional (section 3) section. */
+static gboolean
+_foreach_rr(const guint8 *msg, gsize len, RRFunc func, gpointer user_data)
+{
+    NMDnsStubMsgHeader header;
+    guint16            counts[3];
+    gsize              pos;
+    guint              section;
+    guint              i;
+
+    if (!nm_dns_stub_msg_parse_header(msg, len, &header))
+        return FALSE;
+
+    pos = NM_DNS_STUB_MSG_HEADER_SIZE;
+    for (i = 0; i < header.qdcount; i++) {
+        if (!_read_name(msg, len, pos, NULL, &pos, NULL))
+            return FALSE;
+        pos += 4u;
+        if (pos > len)
+            return FALSE;
+    }
+
+    counts[0] = header.ancount;
+    counts[1] = header.nscount;
+    counts[2] = header.arcount;
+
+    for (section = 0; section < 3; section++) {
+        for (i = 0; i < counts[section]; i++) {
+            guint16 rr_type;
+            guint16 rdlength;
+
+            if (!_read_name(msg, len, pos, NULL, &pos, NULL))
+                return FALSE;
+            if (!_read_u16(msg, len, pos, &rr_type) || !_read_u16(msg, len, pos + 8u, &rdlength))
+                return FALSE;
+            if (pos + 10u + rdlength > len)
+                return FALSE;
+            if (!func(msg, len, section + 1u, rr_type, pos + 4u, pos + 10u, rdlength, user_data))
+                return FALSE;
+            pos += 10u + rdlength;
+        }
+    }
+
+    return TRUE;
+}
+
+typedef struct {
+    guint32  ttl;
+    gboolean negative;
+    gboolean has_soa;
+} GetTtlData;
+
+static gboolean
+_get_ttl_cb(const guint8 *msg,
+            gsize         len,
+            guint         section,
+            guint16       rr_type,
+            gsize         ttl_offset,
+            gsize         rdata_offset,
+            guint16       rdlength,
+            gpointer      user_data)
+{
+    GetTtlData *data = user_data;
+    guint32     ttl;
+    guint32     minimum;
+
+    if (section == 3 || rr_type == NM_DNS_STUB_TYPE_OPT)
+        return TRUE;
+
+    _read_u32(msg, len, ttl_offset, &ttl);
+
+    if (data->negative) {
+        /* RFC 2308, 5: the TTL of a negative answer is the minimum of the
+         * SOA record's TTL and its MINIMUM field. */
+        if (section != 2 || rr_type != NM_DNS_STUB_TYPE_SOA || rdlength < 22u)
+            return TRUE;
+        _read_u32(msg, len, rdata_offset + rdlength - 4u, &minimum);
+        ttl           = MIN(ttl, minimum);
+        data->has_soa = TRUE;
+    }
+
+    data->ttl = MIN(data->ttl, ttl);
+    return TRUE;
+}
+
+/**
+ * nm_dns_stub_msg_get_ttl:
+ * @msg: the DNS response
+ * @len: the length of @msg
+ * @out_ttl: (out): the time in seconds for which the response can be cached.
+ * @out_negative: (out) (optional): whether this is a negative response
+ *   (NXDOMAIN or NODATA).
+ *
+ * Returns: %TRUE if the response can be cached.
+ */
+gboolean
+nm_dns_stub_msg_get_ttl(const guint8 *msg, gsize len, guint32 *out_ttl, gboolean *out_negative)
+{
+    NMDnsStubMsgHeader header;
+    GetTtlData         data = {
+                .ttl = G_MAXUINT32,
+    };
+
+    if (!nm_dns_stub_msg_parse_header(msg, len, &header))
+        return FALSE;
+    if (!(header.flags & NM_DNS_STUB_FLAG_QR) || (header.flags & NM_DNS_STUB_FLAG_TC))
+        return FALSE;
+
+    switch (header.flags & NM_DNS_STUB_FLAG_RCODE) {
+    case NM_DNS_STUB_RCODE_NOERROR:
+        data.negative = (header.ancount == 0);
+        break;
+    case NM_DNS_STUB_RCODE_NXDOMAIN:
+        data.negative = TRUE;
+        break;
+    default:
+        return FALSE;
+    }
+
+    if (!_foreach_rr(msg, len, _get_ttl_cb, &data))
+        return FALSE;
+
+    if (data.negative && !data.has_soa) {
+        /* Without SOA record, negative answers must not be cached. */
+        return FALSE;
+    }
+    if (data.ttl == G_MAXUINT32 || data.ttl == 0)
+        return FALSE;
+
+    *out_ttl = data.ttl;
+    NM_SET_OUT(out_negative, data.negative);
+    return TRUE;
+}
+
+static gboolean
+_age_ttls_cb(const guint8 *msg,
+             gsize         len,
+             guint         section,
+             guint16       rr_type,
+             gsize         ttl_offset,
+             gsize         rdata_offset,
+             guint16       rdlength,
+             gpointer      user_data)
+{
+    const guint32 age_sec = GPOINTER_TO_UINT(user_data);
+    guint32       ttl;
+
+    if (rr_type == NM_DNS_STUB_TYPE_OPT) {
+        /* the TTL field of the OPT pseudo-RR contains flags. */
+        return TRUE;
+    }
+
+    _read_u32(msg, len, ttl_offset, &ttl);
+    _write_u32((guint8 *) msg, ttl_offset, ttl > age_sec ? ttl - age_sec : 0u);
+    return TRUE;
+}
+
+/**
+ * nm_dns_stub_msg_age_ttls:
+ * @msg: the DNS response, modified in place
+ * @len: the length of @msg
+ * @age_sec: the seconds since the response was received.
+ *
+ * Decrements the TTL of all records by @age_sec, as appropriate
+ * when answering from the cache.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+nm_dns_stub_msg_age_ttls(guint8 *msg, gsize len, guint32 age_sec)
+{
+    if (age_sec == 0)
+        return TRUE;
+    return _foreach_rr(msg, len, _age_ttls_cb, GUINT_TO_POINTER(age_sec));
+}
+
+/**
+ * nm_dns_stub_msg_new_error:
+ * @query: the DNS query
+ * @len: the length of @query
+ * @rcode: the response code
+ *
+ * Returns: (transfer full): a response to @query with @rcode and without
+ *   any records, or %NULL if @query is too short.
+ */
+GBytes *
+nm_dns_stub_msg_new_error(const guint8 *query, gsize len, NMDnsStubRcode rcode)
+{
+    NMDnsStubMsgHeader header;
+    guint8            *buf;
+    gsize              end;
+    guint16            flags;
+
+    if (!nm_dns_stub_msg_parse_header(query, len, &header))
+        return NULL;
+
+    if (!nm_dns_stub_msg_parse_question(query, len, NULL, NULL, NULL, &end))
+        end = NM_DNS_STUB_MSG_HEADER_SIZE;
+
+    buf = g_memdup(query, end);
+
+    flags = NM_DNS_STUB_FLAG_QR | NM_DNS_STUB_FLAG_RA
+            | (header.flags & (NM_DNS_STUB_FLAG_OPCODE | NM_DNS_STUB_FLAG_RD))
+            | (((guint16) rcode) & NM_DNS_STUB_FLAG_RCODE);
+    buf[2] = flags >> 8;
+    buf[3] = flags & 0xFF;
+
+    /* QDCOUNT is either 1 or, if we failed to parse the question, 0. */
+    buf[4] = 0;
+    buf[5] = end > NM_DNS_STUB_MSG_HEADER_SIZE ? 1 : 0;
+    memset(&buf[6], 0, 6);
+
+    return g_bytes_new_take(buf, end);
+}
+
+/*****************************************************************************/
+
+/**
+ * nm_dns_stub_name_in_domain:
+ * @name: the lower case name, as returned by nm_dns_stub_msg_parse_question().
+ * @domain: the lower case domain, without trailing dot.
+ *
+ * Returns: whether @name is @domain or a subdomain of it. Every name
+ *   is in the empty domain.
+ */
+gboolean
+nm_dns_stub_name_in_domain(const char *name, const char *domain)
+{
+    gsize n_len;
+    gsize d_len;
+
+    if (domain[0] == '\0')
+        return TRUE;
+
+    n_len = strlen(name);
+    d_len = strlen(domain);
+
+    if (n_len < d_len)
+        return FALSE;
+    if (!nm_streq(&name[n_len - d_len], domain))
+        return FALSE;
+    return n_len == d_len || name[n_len - d_len - 1u] == '.';
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    GBytes *key;
+    CList   lru_lst;
+
+    guint8 *response;
+    gsize   response_len;
+
+    gint64 received_msec;
+    gint64 expiry_msec;
+
+    guint32 ttl;
+
+    bool negative : 1;
+    bool prefetching : 1;
+} CacheEntry;
+
+struct _NMDnsStubCache {
+    /* GBytes* key -> CacheEntry*. */
+    GHashTable *entries;
+
+    /* The most recently used entry is first. */
+    CList lru_lst_head;
+
+    guint max_size;
+};
+
+static void
+_cache_entry_free(CacheEntry *entry)
+{
+    c_list_unlink_stale(&entry->lru_lst);
+    g_bytes_unref(entry->key);
+    g_free(entry->response);
+    nm_g_slice_free(entry);
+}
+
+static void
+_cache_evict(NMDnsStubCache *cache)
+{
+    while (g_hash_table_size(cache->entries) > cache->max_size) {
+        CacheEntry *oldest;
+
+        oldest = c_list_last_entry(&cache->lru_lst_head, CacheEntry, lru_lst);
+        g_hash_table_remove(cache->entries, oldest->key);
+    }
+}
+
+NMDnsStubCache *
+nm_dns_stub_cache_new(guint max_size)
+{
+    NMDnsStubCache *cache;
+
+    cache  = g_slice_new(NMDnsStubCache);
+    *cache = (NMDnsStubCache){
+        .entries      = g_hash_table_new_full(g_bytes_hash,
+                                         g_bytes_equal,
+                                         NULL,
+                                         (GDestroyNotify) _cache_entry_free),
+        .lru_lst_head = C_LIST_INIT(cache->lru_lst_head),
+        .max_size     = max_size,
+    };
+    return cache;
+}
+
+void
+nm_dns_stub_cache_free(NMDnsStubCache *cache)
+{
+    if (!cache)
+        return;
+
+    g_hash_table_unref(cache->entries);
+    nm_assert(c_list_is_empty(&cache->lru_lst_head));
+    nm_g_slice_free(cache);
+}
+
+guint
+nm_dns_stub_cache_get_n_entries(NMDnsStubCache *cache)
+{
+    return g_hash_table_size(cache->entries);
+}
+
+/* Returns the number of removed entries. */
+guint
+nm_dns_stub_cache_flush(NMDnsStubCache *cache)
+{
+    guint n;
+
+    n = g_hash_table_size(cache->entries);
+    g_hash_table_remove_all(cache->entries);
+    nm_assert(c_list_is_empty(&cache->lru_lst_head));
+    return n;
+}
+
+/* Zero disables the cache. If the cache is too large, the least recently
+ * used entries get dropped. */
+void
+nm_dns_stub_cache_set_max_size(NMDnsStubCache *cache, guint max_size)
+{
+    cache->max_size = max_size;
+    _cache_evict(cache);
+}
+
+/**
+ * nm_dns_stub_cache_add:
+ * @cache: the #NMDnsStubCache
+ * @key: the key, from nm_dns_stub_msg_cache_key().
+ * @response: the response from the upstream server.
+ * @len: the length of @response.
+ * @now_msec: the current time, in monotonic milliseconds.
+ *
+ * Adds @response to the cache, replacing an entry with the same key. Does
+ * nothing if the response is not cacheable (see nm_dns_stub_msg_get_ttl()).
+ *
+ * Returns: whether the response was added.
+ */
+gboolean
+nm_dns_stub_cache_add(NMDnsStubCache *cache,
+                      GBytes         *key,
+                      const guint8   *response,
+                      gsize           len,
+                      gint64          now_msec)
+{
+    CacheEntry *entry;
+    guint32     ttl;
+    gboolean    negative;
+
+    if (cache->max_size == 0)
+        return FALSE;
+
+    if (!nm_dns_stub_msg_get_ttl(response, len, &ttl, &negative))
+        return FALSE;
+
+    ttl = MIN(ttl, negative ? CACHE_NEGATIVE_TTL_MAX_SEC : CACHE_TTL_MAX_SEC);
+
+    g_hash_table_remove(cache->entries, key);
+
+    entry  = g_slice_new(CacheEntry);
+    *entry = (CacheEntry){
+        .key           = g_bytes_ref(key),
+        .response      = nm_memdup(response, len),
+        .response_len  = len,
+        .received_msec = now_msec,
+        .expiry_msec   = now_msec + (((gint64) ttl) * 1000),
+        .ttl           = ttl,
+        .negative      = negative,
+    };
+    c_list_link_front(&cache->lru_lst_head, &entry->lru_lst);
+    g_hash_table_insert(cache->entries, entry->key, entry);
+
+    _cache_evict(cache);
+    return TRUE;
+}
+
+/**
+ * nm_dns_stub_cache_lookup:
+ * @cache: the #NMDnsStubCache
+ * @key: the key, from nm_dns_stub_msg_cache_key().
+ * @now_msec: the current time, in monotonic milliseconds.
+ * @out_len: (out): the length of the returned response.
+ * @out_prefetch: (out): whether the entry is about to expire and should be
+ *   refreshed. This is only indicated once per entry.
+ *
+ * Expired entries get removed.
+ *
+ * Returns: (transfer full): a copy of the cached response with the TTLs
+ *   reduced by the time it spent in the cache, or %NULL. The caller still
+ *   needs to set the ID and question of the request.
+ */
+guint8 *
+nm_dns_stub_cache_lookup(NMDnsStubCache *cache,
+                         GBytes         *key,
+                         gint64          now_msec,
+                         gsize          *out_len,
+                         gboolean       *out_prefetch)
+{
+    CacheEntry *entry;
+    guint8     *buf;
+    gint64      remaining_msec;
+
+    entry = g_hash_table_lookup(cache->entries, key);
+    if (!entry)
+        return NULL;
+
+    if (now_msec >= entry->expiry_msec) {
+        g_hash_table_remove(cache->entries, key);
+        return NULL;
+    }
+
+    buf = nm_memdup(entry->response, entry->response_len);
+    nm_dns_stub_msg_age_ttls(buf, entry->response_len, (now_msec - entry->received_msec) / 1000);
+
+    c_list_unlink(&entry->lru_lst);
+    c_list_link_front(&cache->lru_lst_head, &entry->lru_lst);
+
+    remaining_msec = entry->expiry_msec - now_msec;
+    if (!entry->prefetching && !entry->negative && entry->ttl >= PREFETCH_TTL_MIN_SEC
+        && remaining_msec < ((gint64) entry->ttl) * (10 * PREFETCH_PERCENT)) {
+        entry->prefetching = TRUE;
+        *out_prefetch      = TRUE;
+    } else
+        *out_prefetch = FALSE;
+
+    *out_len = entry->response_len;
+    return buf;
+}
@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#ifndef __NM_DNS_STUB_UTILS_H__
+#define __NM_DNS_STUB_UTILS_H__
+
+/*****************************************************************************/
+
+#define NM_DNS_STUB_MSG_HEADER_SIZE 12u
+
+/* Large enough for the textual form of any valid domain name (as returned by
+ * nm_dns_stub_msg_parse_question()), including the trailing NUL. */
+#define NM_DNS_STUB_NAME_BUF_SIZE 256u
+
+#define NM_DNS_STUB_FLAG_QR     0x8000u
+#define NM_DNS_STUB_FLAG_OPCODE 0x7800u
+#define NM_DNS_STUB_FLAG_AA     0x0400u
+#define NM_DNS_STUB_FLAG_TC     0x0200u
+#define NM_DNS_STUB_FLAG_RD     0x0100u
+#define NM_DNS_STUB_FLAG_RA     0x0080u
+#define NM_DNS_STUB_FLAG_AD     0x0020u
+#define NM_DNS_STUB_FLAG_CD     0x0010u
+#define NM_DNS_STUB_FLAG_RCODE  0x000Fu
+
+#define NM_DNS_STUB_TYPE_SOA 6u
+#define NM_DNS_STUB_TYPE_OPT 41u
+
+typedef enum {
+    NM_DNS_STUB_RCODE_NOERROR  = 0,
+    NM_DNS_STUB_RCODE_FORMERR  = 1,
+    NM_DNS_STUB_RCODE_SERVFAIL = 2,
+    NM_DNS_STUB_RCODE_NXDOMAIN = 3,
+    NM_DNS_STUB_RCODE_NOTIMP   = 4,
+    NM_DNS_STUB_RCODE_REFUSED  = 5,
+} NMDnsStubRcode;
+
+typedef struct {
+    guint16 id;
+    guint16 flags;
+    guint16 qdcount;
+    guint16 ancount;
+    guint16 nscount;
+    guint16 arcount;
+} NMDnsStubMsgHeader;
+
+gboolean nm_dns_stub_msg_parse_header(const guint8 *msg, gsize len, NMDnsStubMsgHeader *out);
+
+static inline void
+nm_dns_stub_msg_set_id(guint8 *msg, guint16 id)
+{
+    msg[0] = id >> 8;
+    msg[1] = id & 0xFF;
+}
+
+gboolean nm_dns_stub_msg_parse_question(const guint8 *msg,
+                                        gsize         len,
+                                        char         *name_buf,
+                                        guint16      *out_qtype,
+                                        guint16      *out_qclass,
+                                        gsize        *out_end);
+
+gboolean nm_dns_stub_msg_question_equal(const guint8 *msg_a,
+                                        gsize         len_a,
+                                        const guint8 *msg_b,
+                                        gsize         len_b);
+
+gboolean
+nm_dns_stub_msg_copy_question(guint8 *msg, gsize len, const guint8 *query, gsize query_len);
+
+GBytes *nm_dns_stub_msg_cache_key(const guint8 *msg, gsize len);
+
+gboolean nm_dns_stub_msg_get_ttl(const guint8 *msg,
+                                 gsize         len,
+                                 guint32      *out_ttl,
+                                 gboolean     *out_negative);
+
+gboolean nm_dns_stub_msg_age_ttls(guint8 *msg, gsize len, guint32 age_sec);
+
+GBytes *nm_dns_stub_msg_new_error(const guint8 *query, gsize len, NMDnsStubRcode rcode);
+
+gboolean nm_dns_stub_name_in_domain(const char *name, const char *domain);
+
+/*****************************************************************************/
+
+/* A cache of responses, keyed by nm_dns_stub_msg_cache_key(). The least
+ * recently used entries get dropped, when the cache is full. */
+typedef struct _NMDnsStubCache NMDnsStubCache;
+
+NMDnsStubCache *nm_dns_stub_cache_new(guint max_size);
+void            nm_dns_stub_cache_free(NMDnsStubCache *cache);
+
+guint nm_dns_stub_cache_get_n_entries(NMDnsStubCache *cache);
+guint nm_dns_stub_cache_flush(NMDnsStubCache *cache);
+void  nm_dns_stub_cache_set_max_size(NMDnsStubCache *cache, guint max_size);
+
+gboolean nm_dns_stub_cache_add(NMDnsStubCache *cache,
+                               GBytes         *key,
+                               const guint8   *response,
+                               gsize           len,
+                               gint64          now_msec);
+
+guint8 *nm_dns_stub_cache_lookup(NMDnsStubCache *cache,
+                                 GBytes         *key,
+                                 gint64          now_msec,
+                                 gsize          *out_len,
+                                 gboolean       *out_prefetch);
+
+#endif /* __NM_DNS_STUB_UTILS_H__ */
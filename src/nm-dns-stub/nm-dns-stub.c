@@ -0,0 +1,1372 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "libnm-glib-aux/nm-default-glib-i18n-prog.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <grp.h>
+#include <netinet/in.h>
+#include <pwd.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+
+#include "c-list/src/c-list.h"
+#include "libnm-base/nm-dns-stub-base.h"
+#include "libnm-glib-aux/nm-inet-utils.h"
+#include "libnm-glib-aux/nm-io-utils.h"
+#include "libnm-glib-aux/nm-logging-base.h"
+#include "libnm-glib-aux/nm-random-utils.h"
+#include "libnm-glib-aux/nm-time-utils.h"
+#include "nm-dns-stub-utils.h"
+
+/*****************************************************************************/
+
+#define DNS_PORT 53
+
+/* the maximum size of a DNS message over UDP. */
+#define UDP_MSG_SIZE_MAX 65535u
+
+/* How long to wait for a reply from one upstream server, before trying
+ * the next one. */
+#define UPSTREAM_TIMEOUT_MSEC 2000u
+
+#define TCP_TIMEOUT_SEC 5u
+
+/* After binding the sockets, we switch to this user. */
+#define STUB_USER "nobody"
+
+/* Handle at most that many requests in one go, before returning to the
+ * mainloop. */
+#define RECV_BURST_MAX 64u
+
+/*****************************************************************************/
+
+#define _ENV(var) ("" var "")
+
+/*****************************************************************************/
+
+#define _nm_log(level, ...) _nm_log_simple_printf((level), __VA_ARGS__)
+
+#define _NMLOG(level, ...)                 \
+    G_STMT_START                           \
+    {                                      \
+        const NMLogLevel _level = (level); \
+                                           \
+        if (_nm_logging_enabled(_level)) { \
+            _nm_log(_level, __VA_ARGS__);  \
+        }                                  \
+    }                                      \
+    G_STMT_END
+
+/*****************************************************************************/
+
+typedef struct {
+    NMIPAddr addr;
+    int      addr_family;
+    int      ifindex;
+} Server;
+
+typedef struct {
+    /* lower case, without trailing dot. The empty domain is the default route. */
+    char *domain;
+
+    /* of type Server. */
+    GArray *servers;
+
+    /* the index of the server that answered last. We start with that one. */
+    guint preferred;
+} Route;
+
+typedef struct _GlobalData GlobalData;
+
+typedef struct {
+    CList                   waiter_lst;
+    struct sockaddr_storage client_addr;
+    socklen_t               client_addr_len;
+    guint16                 client_id;
+
+    /* The request of the client. Replies to other requests (from the cache or
+     * for coalesced queries) get its question, because the case of the name
+     * might differ. */
+    const guint8 *client_query;
+    gsize         client_query_len;
+} Waiter;
+
+typedef struct {
+    CList       query_lst;
+    GlobalData *gl;
+
+    /* The key for the cache and for coalescing identical queries, or NULL
+     * if the query is not cacheable. */
+    GBytes *key;
+
+    guint8 *query;
+    gsize   query_len;
+
+    /* A copy of the servers from the route, at the time we started. */
+    GArray *servers;
+    char   *route_domain;
+    guint   routes_generation;
+    guint   server_idx;
+    guint   n_tried;
+
+    int      fd;
+    GSource *fd_source;
+    GSource *timeout_source;
+
+    CList waiters_lst_head;
+
+    guint16 upstream_id;
+} Query;
+
+struct _GlobalData {
+    GSource *source_sigterm;
+    GSource *source_control;
+    GSource *source_udp;
+
+    GSocketService *tcp_service;
+
+    /* The TCP handlers run on threads of @tcp_service. @tcp_n_active counts
+     * the accepted connections whose handler did not yet finish. It is
+     * protected by @tcp_mutex and @tcp_cond gets signaled when it drops
+     * to zero. On shutdown, @tcp_cancellable aborts their blocking I/O. */
+    GMutex        tcp_mutex;
+    GCond         tcp_cond;
+    guint         tcp_n_active;
+    GCancellable *tcp_cancellable;
+
+    int control_fd;
+    int udp_fd;
+
+    /* Protects @routes, which is also accessed by the TCP threads. */
+    GMutex routes_mutex;
+
+    /* of type Route*, sorted by descending length of the domain. */
+    GPtrArray *routes;
+    guint      routes_generation;
+
+    NMDnsStubCache *cache;
+    guint           cache_size;
+
+    /* GBytes* key -> Query*, for the queries that can be coalesced. */
+    GHashTable *queries_by_key;
+    CList       queries_lst_head;
+
+    guint8 *recv_buf;
+
+    guint64 stats_hits;
+    guint64 stats_misses;
+
+    bool quitting;
+};
+
+/*****************************************************************************/
+
+static void
+_route_free(Route *route)
+{
+    g_free(route->domain);
+    g_array_unref(route->servers);
+    nm_g_slice_free(route);
+}
+
+static gboolean
+_server_equal(const Server *a, const Server *b)
+{
+    return a->addr_family == b->addr_family && a->ifindex == b->ifindex
+           && nm_ip_addr_equal(a->addr_family, &a->addr, &b->addr);
+}
+
+static const char *
+_server_to_string(const Server *server, char *buf)
+{
+    char sbuf[NM_INET_ADDRSTRLEN];
+
+    if (server->ifindex > 0) {
+        g_snprintf(buf,
+                   NM_INET_ADDRSTRLEN + 20,
+                   "%s%%%d",
+                   nm_inet_ntop(server->addr_family, &server->addr, sbuf),
+                   server->ifindex);
+    } else
+        nm_inet_ntop(server->addr_family, &server->addr, buf);
+    return buf;
+}
+
+static socklen_t
+_server_to_sockaddr(const Server *server, struct sockaddr_storage *sa)
+{
+    memset(sa, 0, sizeof(*sa));
+
+    if (server->addr_family == AF_INET) {
+        struct sockaddr_in *sin = (struct sockaddr_in *) sa;
+
+        sin->sin_family = AF_INET;
+        sin->sin_port   = htons(DNS_PORT);
+        sin->sin_addr   = server->addr.addr4_struct;
+        return sizeof(*sin);
+    } else {
+        struct sockaddr_in6 *sin6 = (struct sockaddr_in6 *) sa;
+
+        sin6->sin6_family   = AF_INET6;
+        sin6->sin6_port     = htons(DNS_PORT);
+        sin6->sin6_addr     = server->addr.addr6;
+        sin6->sin6_scope_id = server->ifindex > 0 ? server->ifindex : 0;
+        return sizeof(*sin6);
+    }
+}
+
+/* Returns the route with the longest domain that contains @name. The caller
+ * must hold the routes_mutex, or be the main thread. */
+static Route *
+_routes_lookup(GlobalData *gl, const char *name)
+{
+    guint i;
+
+    for (i = 0; i < gl->routes->len; i++) {
+        Route *route = gl->routes->pdata[i];
+
+        if (nm_dns_stub_name_in_domain(name, route->domain))
+            return route;
+    }
+    return NULL;
+}
+
+static Route *
+_routes_lookup_exact(GlobalData *gl, const char *domain)
+{
+    guint i;
+
+    for (i = 0; i < gl->routes->len; i++) {
+        Route *route = gl->routes->pdata[i];
+
+        if (nm_streq(route->domain, domain))
+            return route;
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+
+static void
+_cache_flush(GlobalData *gl)
+{
+    guint n;
+
+    n = nm_dns_stub_cache_flush(gl->cache);
+    if (n > 0)
+        _LOGD("cache: flushed %u entries", n);
+}
+
+/*****************************************************************************/
+
+static Waiter *
+_waiter_new(const Waiter *waiter_stack)
+{
+    Waiter *waiter;
+
+    waiter               = g_slice_new(Waiter);
+    *waiter              = *waiter_stack;
+    waiter->client_query = nm_memdup(waiter_stack->client_query, waiter_stack->client_query_len);
+    c_list_init(&waiter->waiter_lst);
+    return waiter;
+}
+
+static void
+_waiter_free(Waiter *waiter)
+{
+    c_list_unlink(&waiter->waiter_lst);
+    g_free((guint8 *) waiter->client_query);
+    nm_g_slice_free(waiter);
+}
+
+static void
+_udp_send(GlobalData   *gl,
+          const guint8 *msg,
+          gsize         len,
+          const Waiter *waiter,
+          const char   *what)
+{
+    gssize n;
+
+    n = sendto(gl->udp_fd,
+               msg,
+               len,
+               MSG_NOSIGNAL | MSG_DONTWAIT,
+               (const struct sockaddr *) &waiter->client_addr,
+               waiter->client_addr_len);
+    if (n < 0)
+        _LOGT("udp: failed to send %s reply: %s", what, nm_strerror_native(errno));
+}
+
+static void
+_reply_waiters(Query *query, const guint8 *response, gsize len)
+{
+    gs_free guint8 *buf = NULL;
+    Waiter         *waiter;
+
+    buf = nm_memdup(response, len);
+    while ((waiter = c_list_first_entry(&query->waiters_lst_head, Waiter, waiter_lst))) {
+        nm_dns_stub_msg_copy_question(buf, len, waiter->client_query, waiter->client_query_len);
+        nm_dns_stub_msg_set_id(buf, waiter->client_id);
+        _udp_send(query->gl, buf, len, waiter, "upstream");
+        _waiter_free(waiter);
+    }
+}
+
+static void
+_reply_error(GlobalData    *gl,
+             const guint8  *msg,
+             gsize          len,
+             const Waiter  *waiter,
+             NMDnsStubRcode rcode)
+{
+    gs_unref_bytes GBytes *response = NULL;
+    gsize                  r_len;
+    guint8                *r_buf;
+
+    response = nm_dns_stub_msg_new_error(msg, len, rcode);
+    if (!response)
+        return;
+
+    r_buf = (guint8 *) g_bytes_get_data(response, &r_len);
+    nm_dns_stub_msg_set_id(r_buf, waiter->client_id);
+    _udp_send(gl, r_buf, r_len, waiter, "error");
+}
+
+/*****************************************************************************/
+
+static void _query_send(Query *query);
+
+static void
+_query_free(Query *query)
+{
+    GlobalData *gl = query->gl;
+    Waiter     *waiter;
+
+    nm_assert(c_list_is_empty(&query->waiters_lst_head) || gl->quitting);
+
+    while ((waiter = c_list_first_entry(&query->waiters_lst_head, Waiter, waiter_lst)))
+        _waiter_free(waiter);
+
+    if (query->key)
+        g_hash_table_remove(gl->queries_by_key, query->key);
+    c_list_unlink_stale(&query->query_lst);
+
+    nm_clear_g_source_inst(&query->fd_source);
+    nm_clear_g_source_inst(&query->timeout_source);
+    nm_clear_fd(&query->fd);
+
+    nm_clear_pointer(&query->key, g_bytes_unref);
+    nm_clear_pointer(&query->servers, g_array_unref);
+    g_free(query->route_domain);
+    g_free(query->query);
+    nm_g_slice_free(query);
+}
+
+static void
+_query_complete(Query *query, const guint8 *response, gsize len)
+{
+    GlobalData *gl = query->gl;
+
+    if (!response) {
+        gs_unref_bytes GBytes *error = NULL;
+
+        error = nm_dns_stub_msg_new_error(query->query,
+                                          query->query_len,
+                                          NM_DNS_STUB_RCODE_SERVFAIL);
+        if (error)
+            _reply_waiters(query, g_bytes_get_data(error, NULL), g_bytes_get_size(error));
+    } else {
+        if (query->key)
+            nm_dns_stub_cache_add(gl->cache,
+                                  query->key,
+                                  response,
+                                  len,
+                                  nm_utils_get_monotonic_timestamp_msec());
+        _reply_waiters(query, response, len);
+    }
+
+    _query_free(query);
+}
+
+static void
+_query_next_server(Query *query)
+{
+    nm_clear_g_source_inst(&query->fd_source);
+    nm_clear_g_source_inst(&query->timeout_source);
+    nm_clear_fd(&query->fd);
+
+    if (query->n_tried >= query->servers->len) {
+        _LOGD("query: all %u servers failed", query->servers->len);
+        _query_complete(query, NULL, 0);
+        return;
+    }
+
+    query->server_idx = (query->server_idx + 1u) % query->servers->len;
+    _query_send(query);
+}
+
+static void
+_query_remember_server(Query *query)
+{
+    GlobalData *gl = query->gl;
+    Route      *route;
+
+    if (query->routes_generation != gl->routes_generation)
+        return;
+
+    route = _routes_lookup_exact(gl, query->route_domain);
+    if (!route || route->preferred == query->server_idx)
+        return;
+
+    g_mutex_lock(&gl->routes_mutex);
+    route->preferred = query->server_idx;
+    g_mutex_unlock(&gl->routes_mutex);
+}
+
+static gboolean
+_query_timeout_cb(gpointer user_data)
+{
+    Query *query = user_data;
+    char   sbuf[NM_INET_ADDRSTRLEN + 20];
+
+    _LOGD("query: timeout waiting for server %s",
+          _server_to_string(&nm_g_array_index(query->servers, Server, query->server_idx), sbuf));
+    _query_next_server(query);
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+_query_fd_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    Query              *query = user_data;
+    GlobalData         *gl    = query->gl;
+    NMDnsStubMsgHeader  header;
+    gssize              n;
+
+    n = recv(fd, gl->recv_buf, UDP_MSG_SIZE_MAX, MSG_DONTWAIT);
+    if (n < 0) {
+        if (NM_ERRNO_IS_TRANSIENT(errno))
+            return G_SOURCE_CONTINUE;
+        /* e.g. ECONNREFUSED. */
+        _LOGT("query: receive failed: %s", nm_strerror_native(errno));
+        _query_next_server(query);
+        return G_SOURCE_CONTINUE;
+    }
+
+    if (!nm_dns_stub_msg_parse_header(gl->recv_buf, n, &header)
+        || !(header.flags & NM_DNS_STUB_FLAG_QR) || header.id != query->upstream_id
+        || !nm_dns_stub_msg_question_equal(gl->recv_buf, n, query->query, query->query_len)) {
+        /* The socket is connected, so only the server can send us packets. Still,
+         * ignore everything that is not an answer to our question. */
+        _LOGT("query: ignore unexpected reply");
+        return G_SOURCE_CONTINUE;
+    }
+
+    switch (header.flags & NM_DNS_STUB_FLAG_RCODE) {
+    case NM_DNS_STUB_RCODE_SERVFAIL:
+    case NM_DNS_STUB_RCODE_REFUSED:
+        if (query->n_tried < query->servers->len) {
+            _LOGT("query: server returned rcode %u, try next server",
+                  (guint) (header.flags & NM_DNS_STUB_FLAG_RCODE));
+            _query_next_server(query);
+            return G_SOURCE_CONTINUE;
+        }
+        break;
+    default:
+        _query_remember_server(query);
+        break;
+    }
+
+    _query_complete(query, gl->recv_buf, n);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_query_send(Query *query)
+{
+    const Server           *server;
+    struct sockaddr_storage sa;
+    socklen_t               sa_len;
+    char                    sbuf[NM_INET_ADDRSTRLEN + 20];
+
+    nm_assert(query->fd < 0);
+
+    server = &nm_g_array_index(query->servers, Server, query->server_idx);
+    query->n_tried++;
+
+    query->fd = socket(server->addr_family, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (query->fd < 0) {
+        _LOGD("query: failed to create socket: %s", nm_strerror_native(errno));
+        goto fail;
+    }
+
+    sa_len = _server_to_sockaddr(server, &sa);
+    if (connect(query->fd, (struct sockaddr *) &sa, sa_len) < 0) {
+        _LOGD("query: failed to connect to %s: %s",
+              _server_to_string(server, sbuf),
+              nm_strerror_native(errno));
+        goto fail;
+    }
+
+    /* Use a fresh random ID (and with the new socket, a random source port)
+     * for each upstream query. */
+    query->upstream_id = nm_random_u32() & 0xFFFFu;
+    nm_dns_stub_msg_set_id(query->query, query->upstream_id);
+
+    if (send(query->fd, query->query, query->query_len, MSG_NOSIGNAL) < 0) {
+        _LOGD("query: failed to send to %s: %s",
+              _server_to_string(server, sbuf),
+              nm_strerror_native(errno));
+        goto fail;
+    }
+
+    _LOGT("query: sent to %s", _server_to_string(server, sbuf));
+
+    query->fd_source      = nm_g_unix_fd_add_source(query->fd, G_IO_IN, _query_fd_cb, query);
+    query->timeout_source =
+        nm_g_timeout_add_source(UPSTREAM_TIMEOUT_MSEC, _query_timeout_cb, query);
+    return;
+
+fail:
+    _query_next_server(query);
+}
+
+/* Starts a new upstream query. @waiter is linked before sending the request,
+ * because the query might fail (and complete) right away. Returns FALSE if
+ * there is no server for @name. */
+static gboolean
+_query_start(GlobalData   *gl,
+             GBytes       *key,
+             const guint8 *msg,
+             gsize         len,
+             const char   *name,
+             Waiter       *waiter)
+{
+    Route *route;
+    Query *query;
+
+    route = _routes_lookup(gl, name);
+    if (!route)
+        return FALSE;
+
+    query  = g_slice_new(Query);
+    *query = (Query){
+        .gl                = gl,
+        .key               = key ? g_bytes_ref(key) : NULL,
+        .query             = nm_memdup(msg, len),
+        .query_len         = len,
+        .servers           = g_array_ref(route->servers),
+        .route_domain      = g_strdup(route->domain),
+        .routes_generation = gl->routes_generation,
+        .server_idx        = route->preferred,
+        .fd                = -1,
+        .waiters_lst_head  = C_LIST_INIT(query->waiters_lst_head),
+    };
+    c_list_link_tail(&gl->queries_lst_head, &query->query_lst);
+    if (key)
+        g_hash_table_insert(gl->queries_by_key, query->key, query);
+    if (waiter)
+        c_list_link_tail(&query->waiters_lst_head, &waiter->waiter_lst);
+
+    _query_send(query);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+static void
+_handle_udp_request(GlobalData                    *gl,
+                    const guint8                  *msg,
+                    gsize                          len,
+                    const struct sockaddr_storage *client_addr,
+                    socklen_t                      client_addr_len)
+{
+    gs_unref_bytes GBytes *key = NULL;
+    NMDnsStubMsgHeader     header;
+    char                   name[NM_DNS_STUB_NAME_BUF_SIZE];
+    Waiter                 waiter_stack;
+    Waiter                *waiter;
+    Query                 *query;
+
+    if (!nm_dns_stub_msg_parse_header(msg, len, &header))
+        return;
+    if (header.flags & NM_DNS_STUB_FLAG_QR)
+        return;
+
+    waiter_stack = (Waiter){
+        .client_addr_len  = client_addr_len,
+        .client_id        = header.id,
+        .client_query     = msg,
+        .client_query_len = len,
+    };
+    memcpy(&waiter_stack.client_addr, client_addr, client_addr_len);
+
+    if (!nm_dns_stub_msg_parse_question(msg, len, name, NULL, NULL, NULL)) {
+        _reply_error(gl, msg, len, &waiter_stack, NM_DNS_STUB_RCODE_FORMERR);
+        return;
+    }
+
+    key = nm_dns_stub_msg_cache_key(msg, len);
+
+    if (key) {
+        gs_free guint8 *buf = NULL;
+        gsize           buf_len;
+        gboolean        prefetch;
+
+        buf = nm_dns_stub_cache_lookup(gl->cache,
+                                       key,
+                                       nm_utils_get_monotonic_timestamp_msec(),
+                                       &buf_len,
+                                       &prefetch);
+        if (buf) {
+            gl->stats_hits++;
+
+            nm_dns_stub_msg_copy_question(buf, buf_len, msg, len);
+            nm_dns_stub_msg_set_id(buf, header.id);
+            _udp_send(gl, buf, buf_len, &waiter_stack, "cached");
+
+            if (prefetch && !g_hash_table_contains(gl->queries_by_key, key)) {
+                _LOGT("cache: prefetch %s", name);
+                _query_start(gl, key, msg, len, name, NULL);
+            }
+            return;
+        }
+    }
+
+    gl->stats_misses++;
+
+    waiter = _waiter_new(&waiter_stack);
+
+    if (key && (query = g_hash_table_lookup(gl->queries_by_key, key))) {
+        _LOGT("query: coalesce request for %s", name);
+        c_list_link_tail(&query->waiters_lst_head, &waiter->waiter_lst);
+        return;
+    }
+
+    if (!_query_start(gl, key, msg, len, name, waiter)) {
+        _LOGT("query: no server for %s", name);
+        _reply_error(gl, msg, len, waiter, NM_DNS_STUB_RCODE_SERVFAIL);
+        _waiter_free(waiter);
+    }
+}
+
+static gboolean
+_udp_fd_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    GlobalData *gl = user_data;
+    guint       i;
+
+    for (i = 0; i < RECV_BURST_MAX; i++) {
+        gs_free guint8         *msg = NULL;
+        struct sockaddr_storage client_addr;
+        socklen_t               client_addr_len = sizeof(client_addr);
+        gssize                  n;
+
+        n = recvfrom(fd,
+                     gl->recv_buf,
+                     UDP_MSG_SIZE_MAX,
+                     MSG_DONTWAIT,
+                     (struct sockaddr *) &client_addr,
+                     &client_addr_len);
+        if (n < 0) {
+            if (!NM_ERRNO_IS_TRANSIENT(errno))
+                _LOGT("udp: receive failed: %s", nm_strerror_native(errno));
+            break;
+        }
+
+        /* recv_buf gets reused when receiving upstream replies. */
+        msg = nm_memdup(gl->recv_buf, n);
+        _handle_udp_request(gl, msg, n, &client_addr, client_addr_len);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+/*****************************************************************************/
+
+static gboolean
+_tcp_read_msg(GInputStream *input,
+              guint8      **out_msg,
+              gsize        *out_len,
+              GCancellable *cancellable,
+              GError      **error)
+{
+    gs_free guint8 *msg = NULL;
+    guint8          len_buf[2];
+    gsize           n;
+    gsize           len;
+
+    if (!g_input_stream_read_all(input, len_buf, 2, &n, cancellable, error))
+        return FALSE;
+    if (n != 2) {
+        /* EOF. */
+        return FALSE;
+    }
+
+    len = (((gsize) len_buf[0]) << 8) | len_buf[1];
+    msg = g_malloc(NM_MAX(len, 1u));
+    if (!g_input_stream_read_all(input, msg, len, &n, cancellable, error))
+        return FALSE;
+    if (n != len)
+        return FALSE;
+
+    *out_msg = g_steal_pointer(&msg);
+    *out_len = len;
+    return TRUE;
+}
+
+static gboolean
+_tcp_write_msg(GOutputStream *output,
+               const guint8  *msg,
+               gsize          len,
+               GCancellable  *cancellable,
+               GError       **error)
+{
+    guint8 len_buf[2] = {len >> 8, len & 0xFF};
+
+    return g_output_stream_write_all(output, len_buf, 2, NULL, cancellable, error)
+           && g_output_stream_write_all(output, msg, len, NULL, cancellable, error);
+}
+
+static gboolean
+_tcp_forward(const Server *server,
+             const guint8 *msg,
+             gsize         len,
+             GCancellable *cancellable,
+             guint8      **out_response,
+             gsize        *out_response_len)
+{
+    gs_unref_object GSocketClient     *client     = NULL;
+    gs_unref_object GSocketConnection *connection = NULL;
+    gs_unref_object GInetAddress      *inet_addr  = NULL;
+    gs_unref_object GSocketAddress    *addr       = NULL;
+    gs_free_error GError              *error      = NULL;
+    char                               sbuf[NM_INET_ADDRSTRLEN + 20];
+
+    inet_addr = g_inet_address_new_from_bytes((const guint8 *) &server->addr,
+                                              server->addr_family == AF_INET
+                                                  ? G_SOCKET_FAMILY_IPV4
+                                                  : G_SOCKET_FAMILY_IPV6);
+    addr      = g_object_new(G_TYPE_INET_SOCKET_ADDRESS,
+                        "address",
+                        inet_addr,
+                        "port",
+                        (guint) DNS_PORT,
+                        "scope-id",
+                        (guint) NM_MAX(server->ifindex, 0),
+                        NULL);
+
+    client = g_socket_client_new();
+    g_socket_client_set_timeout(client, TCP_TIMEOUT_SEC);
+    /* We talk to the configured name servers directly, never via a proxy. */
+    g_socket_client_set_enable_proxy(client, FALSE);
+
+    connection = g_socket_client_connect(client, G_SOCKET_CONNECTABLE(addr), cancellable, &error);
+    if (connection
+        && _tcp_write_msg(g_io_stream_get_output_stream(G_IO_STREAM(connection)),
+                          msg,
+                          len,
+                          cancellable,
+                          &error)
+        && _tcp_read_msg(g_io_stream_get_input_stream(G_IO_STREAM(connection)),
+                         out_response,
+                         out_response_len,
+                         cancellable,
+                         &error))
+        return TRUE;
+
+    if (g_cancellable_is_cancelled(cancellable))
+        return FALSE;
+
+    _LOGD("tcp: forwarding to %s failed: %s",
+          _server_to_string(server, sbuf),
+          error ? error->message : "unexpected EOF");
+    return FALSE;
+}
+
+/* Runs on the main thread, before the connection is handed to a thread
+ * of the GThreadedSocketService. */
+static gboolean
+_tcp_incoming_cb(GSocketService    *service,
+                 GSocketConnection *connection,
+                 GObject           *source_object,
+                 gpointer           user_data)
+{
+    GlobalData *gl = user_data;
+
+    g_mutex_lock(&gl->tcp_mutex);
+    gl->tcp_n_active++;
+    g_mutex_unlock(&gl->tcp_mutex);
+
+    /* Let the default handler of GThreadedSocketService dispatch it. */
+    return FALSE;
+}
+
+/* Runs in a thread of the GThreadedSocketService. We don't cache TCP
+ * replies, TCP is only used for truncated and large responses. */
+static gboolean
+_tcp_run_cb(GThreadedSocketService *service,
+            GSocketConnection      *connection,
+            GObject                *source_object,
+            gpointer                user_data)
+{
+    GlobalData    *gl     = user_data;
+    GInputStream  *input  = g_io_stream_get_input_stream(G_IO_STREAM(connection));
+    GOutputStream *output = g_io_stream_get_output_stream(G_IO_STREAM(connection));
+
+    g_socket_set_timeout(g_socket_connection_get_socket(connection), TCP_TIMEOUT_SEC);
+
+    while (TRUE) {
+        gs_unref_array GArray *servers  = NULL;
+        gs_free guint8        *msg      = NULL;
+        gs_free guint8        *response = NULL;
+        gs_unref_bytes GBytes *error    = NULL;
+        char                   name[NM_DNS_STUB_NAME_BUF_SIZE];
+        gsize                  len;
+        gsize                  response_len = 0;
+        guint                  preferred    = 0;
+        guint                  i;
+
+        if (!_tcp_read_msg(input, &msg, &len, gl->tcp_cancellable, NULL))
+            break;
+
+        if (nm_dns_stub_msg_parse_question(msg, len, name, NULL, NULL, NULL)) {
+            Route *route;
+
+            g_mutex_lock(&gl->routes_mutex);
+            route = _routes_lookup(gl, name);
+            if (route) {
+                servers   = g_array_ref(route->servers);
+                preferred = route->preferred;
+            }
+            g_mutex_unlock(&gl->routes_mutex);
+        }
+
+        for (i = 0; servers && i < servers->len; i++) {
+            const Server *server =
+                &nm_g_array_index(servers, Server, (preferred + i) % servers->len);
+
+            if (_tcp_forward(server, msg, len, gl->tcp_cancellable, &response, &response_len))
+                break;
+        }
+
+        if (!response) {
+            if (g_cancellable_is_cancelled(gl->tcp_cancellable))
+                break;
+            error = nm_dns_stub_msg_new_error(msg,
+                                              len,
+                                              servers ? NM_DNS_STUB_RCODE_SERVFAIL
+                                                      : NM_DNS_STUB_RCODE_FORMERR);
+            if (!error)
+                break;
+            response     = g_bytes_unref_to_data(g_steal_pointer(&error), &response_len);
+        }
+
+        if (!_tcp_write_msg(output, response, response_len, gl->tcp_cancellable, NULL))
+            break;
+    }
+
+    /* After this, the main thread may free @gl. Don't touch it anymore. */
+    g_mutex_lock(&gl->tcp_mutex);
+    if (--gl->tcp_n_active == 0)
+        g_cond_broadcast(&gl->tcp_cond);
+    g_mutex_unlock(&gl->tcp_mutex);
+
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+static gboolean
+_parse_server(const char *address, int ifindex, Server *out)
+{
+    *out = (Server){
+        .ifindex = 0,
+    };
+
+    if (!nm_inet_parse_bin(AF_UNSPEC, address, &out->addr_family, &out->addr))
+        return FALSE;
+
+    if (out->addr_family == AF_INET6 && IN6_IS_ADDR_LINKLOCAL(&out->addr.addr6)) {
+        if (ifindex <= 0)
+            return FALSE;
+        out->ifindex = ifindex;
+    }
+    return TRUE;
+}
+
+static char *
+_normalize_domain(const char *domain)
+{
+    char *s;
+    gsize l;
+
+    s = g_ascii_strdown(domain, -1);
+    l = strlen(s);
+    while (l > 0 && s[l - 1] == '.')
+        s[--l] = '\0';
+    return s;
+}
+
+static int
+_route_cmp(gconstpointer a, gconstpointer b)
+{
+    const Route *route_a = *((const Route *const *) a);
+    const Route *route_b = *((const Route *const *) b);
+
+    NM_CMP_DIRECT(strlen(route_b->domain), strlen(route_a->domain));
+    NM_CMP_DIRECT_STRCMP(route_a->domain, route_b->domain);
+    return 0;
+}
+
+static gboolean
+_routes_equal(GPtrArray *a, GPtrArray *b)
+{
+    guint i;
+    guint j;
+
+    if (a->len != b->len)
+        return FALSE;
+
+    for (i = 0; i < a->len; i++) {
+        const Route *route_a = a->pdata[i];
+        const Route *route_b = b->pdata[i];
+
+        if (!nm_streq(route_a->domain, route_b->domain))
+            return FALSE;
+        if (route_a->servers->len != route_b->servers->len)
+            return FALSE;
+        for (j = 0; j < route_a->servers->len; j++) {
+            if (!_server_equal(&nm_g_array_index(route_a->servers, Server, j),
+                               &nm_g_array_index(route_b->servers, Server, j)))
+                return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void
+_control_apply(GlobalData *gl, GVariant *config)
+{
+    gs_unref_ptrarray GPtrArray *routes        = NULL;
+    gs_unref_variant GVariant   *reply         = NULL;
+    gs_unref_variant GVariant   *servers       = NULL;
+    GVariantBuilder              builder;
+    GVariantIter                 iter;
+    const char                  *address;
+    const char                  *domain;
+    guint32                      generation = 0;
+    guint32                      cache_size = NM_DNS_STUB_CACHE_SIZE_DEFAULT;
+    int                          ifindex;
+    gsize                        reply_len;
+
+    g_variant_lookup(config, NM_DNS_STUB_CONFIG_GENERATION, "u", &generation);
+    g_variant_lookup(config, NM_DNS_STUB_CONFIG_CACHE_SIZE, "u", &cache_size);
+
+    routes = g_ptr_array_new_with_free_func((GDestroyNotify) _route_free);
+
+    servers = g_variant_lookup_value(config, NM_DNS_STUB_CONFIG_SERVERS, G_VARIANT_TYPE("a(sis)"));
+    if (servers) {
+        g_variant_iter_init(&iter, servers);
+        while (g_variant_iter_next(&iter, "(&si&s)", &address, &ifindex, &domain)) {
+            gs_free char *domain_norm = NULL;
+            Server        server;
+            Route        *route = NULL;
+            guint         i;
+
+            if (!_parse_server(address, ifindex, &server)) {
+                _LOGW("config: ignore invalid server \"%s\"", address);
+                continue;
+            }
+
+            domain_norm = _normalize_domain(domain);
+
+            for (i = 0; i < routes->len; i++) {
+                if (nm_streq(((Route *) routes->pdata[i])->domain, domain_norm)) {
+                    route = routes->pdata[i];
+                    break;
+                }
+            }
+            if (!route) {
+                route  = g_slice_new(Route);
+                *route = (Route){
+                    .domain  = g_steal_pointer(&domain_norm),
+                    .servers = g_array_new(FALSE, FALSE, sizeof(Server)),
+                };
+                g_ptr_array_add(routes, route);
+            }
+
+            for (i = 0; i < route->servers->len; i++) {
+                if (_server_equal(&nm_g_array_index(route->servers, Server, i), &server))
+                    break;
+            }
+            if (i == route->servers->len)
+                g_array_append_val(route->servers, server);
+        }
+    }
+
+    g_ptr_array_sort(routes, _route_cmp);
+
+    if (!_routes_equal(routes, gl->routes)) {
+        guint i;
+
+        if (_nm_logging_enabled(LOGL_DEBUG)) {
+            for (i = 0; i < routes->len; i++) {
+                const Route *route = routes->pdata[i];
+                guint        j;
+
+                for (j = 0; j < route->servers->len; j++) {
+                    char sbuf[NM_INET_ADDRSTRLEN + 20];
+
+                    _LOGD("config: server %s for %s%s%s",
+                          _server_to_string(&nm_g_array_index(route->servers, Server, j), sbuf),
+                          NM_PRINT_FMT_QUOTED(route->domain[0],
+                                              "domain \"",
+                                              route->domain,
+                                              "\"",
+                                              "the default domain"));
+                }
+            }
+        }
+
+        g_mutex_lock(&gl->routes_mutex);
+        NM_SWAP(&gl->routes, &routes);
+        gl->routes_generation++;
+        g_mutex_unlock(&gl->routes_mutex);
+
+        /* The new servers might give different answers (e.g. after connecting
+         * to a VPN). */
+        _cache_flush(gl);
+    }
+
+    if (gl->cache_size != cache_size) {
+        _LOGD("config: cache size %u", cache_size);
+        gl->cache_size = cache_size;
+        nm_dns_stub_cache_set_max_size(gl->cache, cache_size);
+    }
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE(NM_DNS_STUB_CONFIG_TYPE));
+    g_variant_builder_add(&builder,
+                          "{sv}",
+                          NM_DNS_STUB_CONFIG_GENERATION,
+                          g_variant_new_uint32(generation));
+    reply     = g_variant_ref_sink(g_variant_builder_end(&builder));
+    reply_len = g_variant_get_size(reply);
+
+    if (send(gl->control_fd, g_variant_get_data(reply), reply_len, MSG_NOSIGNAL) < 0)
+        _LOGW("control: failed to send reply: %s", nm_strerror_native(errno));
+}
+
+static gboolean
+_control_fd_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    GlobalData *gl = user_data;
+
+    while (TRUE) {
+        gs_unref_variant GVariant *config = NULL;
+        gs_free guint8            *buf    = NULL;
+        gssize                     size;
+        gssize                     n;
+
+        size = nm_fd_next_datagram_size(fd);
+        if (size == -EAGAIN)
+            break;
+        if (size < 0) {
+            _LOGW("control: failed to receive: %s", nm_strerror_native(-size));
+            gl->quitting = TRUE;
+            break;
+        }
+
+        buf = g_malloc(NM_MAX(size, 1));
+        n   = recv(fd, buf, size, MSG_DONTWAIT);
+        if (n < 0) {
+            if (NM_ERRNO_IS_TRANSIENT(errno))
+                break;
+            _LOGW("control: failed to receive: %s", nm_strerror_native(errno));
+            gl->quitting = TRUE;
+            break;
+        }
+        if (n == 0) {
+            /* With SOCK_SEQPACKET, a zero length read means EOF. */
+            _LOGD("control: socket closed");
+            gl->quitting = TRUE;
+            break;
+        }
+
+        config = g_variant_ref_sink(g_variant_new_from_data(G_VARIANT_TYPE(NM_DNS_STUB_CONFIG_TYPE),
+                                                            g_steal_pointer(&buf),
+                                                            n,
+                                                            FALSE,
+                                                            g_free,
+                                                            NULL));
+        if (!g_variant_is_normal_form(config)) {
+            _LOGW("control: ignore invalid message");
+            continue;
+        }
+
+        _control_apply(gl, config);
+    }
+
+    if (condition & (G_IO_HUP | G_IO_ERR))
+        gl->quitting = TRUE;
+
+    return G_SOURCE_CONTINUE;
+}
+
+/*****************************************************************************/
+
+static gboolean
+_signal_callback_term(gpointer user_data)
+{
+    GlobalData *gl = user_data;
+
+    _LOGD("sigterm received");
+    gl->quitting = TRUE;
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+_listen_udp(GlobalData *gl, GError **error)
+{
+    struct sockaddr_in sin = {
+        .sin_family = AF_INET,
+        .sin_port   = htons(NM_DNS_STUB_LISTEN_PORT),
+    };
+    int errsv;
+
+    inet_pton(AF_INET, NM_DNS_STUB_LISTEN_ADDRESS, &sin.sin_addr);
+
+    gl->udp_fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (gl->udp_fd < 0) {
+        errsv = errno;
+        g_set_error(error,
+                    G_IO_ERROR,
+                    g_io_error_from_errno(errsv),
+                    "failed to create UDP socket: %s",
+                    nm_strerror_native(errsv));
+        return FALSE;
+    }
+
+    if (bind(gl->udp_fd, (struct sockaddr *) &sin, sizeof(sin)) < 0) {
+        errsv = errno;
+        g_set_error(error,
+                    G_IO_ERROR,
+                    g_io_error_from_errno(errsv),
+                    "failed to bind UDP socket to %s:%d: %s",
+                    NM_DNS_STUB_LISTEN_ADDRESS,
+                    NM_DNS_STUB_LISTEN_PORT,
+                    nm_strerror_native(errsv));
+        return FALSE;
+    }
+
+    gl->source_udp = nm_g_unix_fd_add_source(gl->udp_fd, G_IO_IN, _udp_fd_cb, gl);
+    return TRUE;
+}
+
+static gboolean
+_listen_tcp(GlobalData *gl, GError **error)
+{
+    gs_unref_object GInetAddress   *inet_addr = NULL;
+    gs_unref_object GSocketAddress *addr      = NULL;
+
+    inet_addr = g_inet_address_new_from_string(NM_DNS_STUB_LISTEN_ADDRESS);
+    addr      = g_inet_socket_address_new(inet_addr, NM_DNS_STUB_LISTEN_PORT);
+
+    gl->tcp_service = g_threaded_socket_service_new(4);
+    if (!g_socket_listener_add_address(G_SOCKET_LISTENER(gl->tcp_service),
+                                       addr,
+                                       G_SOCKET_TYPE_STREAM,
+                                       G_SOCKET_PROTOCOL_TCP,
+                                       NULL,
+                                       NULL,
+                                       error))
+        return FALSE;
+
+    g_signal_connect(gl->tcp_service, "incoming", G_CALLBACK(_tcp_incoming_cb), gl);
+    g_signal_connect(gl->tcp_service, "run", G_CALLBACK(_tcp_run_cb), gl);
+    g_socket_service_start(gl->tcp_service);
+    return TRUE;
+}
+
+/* nm-dns-stub parses untrusted replies from the network. We only need root
+ * to bind the privileged port. Afterwards, switch to an unprivileged user
+ * (like dnsmasq does) and drop all capabilities. */
+static gboolean
+_drop_privileges(GError **error)
+{
+    struct passwd *pw;
+    int            errsv;
+    int            cap;
+
+    if (geteuid() != 0) {
+        /* Not started as root, e.g. by hand for testing. */
+        return TRUE;
+    }
+
+    errno = 0;
+    pw    = getpwnam(STUB_USER);
+    if (!pw) {
+        errsv = errno;
+        g_set_error(error,
+                    G_IO_ERROR,
+                    G_IO_ERROR_NOT_FOUND,
+                    "failed to look up user \"%s\"%s%s",
+                    STUB_USER,
+                    errsv != 0 ? ": " : "",
+                    errsv != 0 ? nm_strerror_native(errsv) : "");
+        return FALSE;
+    }
+    if (pw->pw_uid == 0) {
+        g_set_error(error,
+                    G_IO_ERROR,
+                    G_IO_ERROR_FAILED,
+                    "user \"%s\" is root, refuse to run with it",
+                    STUB_USER);
+        return FALSE;
+    }
+
+    /* Clear the bounding set, so that the capabilities cannot be regained
+     * (e.g. via a set-uid binary). We drop capabilities until the kernel
+     * tells us that there are no more. */
+    for (cap = 0; prctl(PR_CAPBSET_DROP, cap, 0, 0, 0) == 0; cap++)
+        ;
+    errsv = errno;
+    if (errsv != EINVAL)
+        goto fail;
+
+    if (setgroups(0, NULL) != 0 || setresgid(pw->pw_gid, pw->pw_gid, pw->pw_gid) != 0
+        || setresuid(pw->pw_uid, pw->pw_uid, pw->pw_uid) != 0) {
+        errsv = errno;
+        goto fail;
+    }
+
+    /* Changing all user IDs away from zero cleared the permitted, effective
+     * and ambient capabilities. Make sure we cannot get any of them back. */
+    if (prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) != 0) {
+        errsv = errno;
+        goto fail;
+    }
+    if (setuid(0) == 0) {
+        g_set_error(error,
+                    G_IO_ERROR,
+                    G_IO_ERROR_FAILED,
+                    "failed to drop privileges: still able to regain root");
+        return FALSE;
+    }
+
+    _LOGD("dropped privileges to user \"%s\" (%u:%u)",
+          STUB_USER,
+          (guint) pw->pw_uid,
+          (guint) pw->pw_gid);
+    return TRUE;
+
+fail:
+    g_set_error(error,
+                G_IO_ERROR,
+                g_io_error_from_errno(errsv),
+                "failed to drop privileges: %s",
+                nm_strerror_native(errsv));
+    return FALSE;
+}
+
+int
+main(int argc, char **argv)
+{
+    GlobalData _gl = {
+        .control_fd       = NM_DNS_STUB_CONTROL_FD,
+        .udp_fd           = -1,
+        .cache_size       = NM_DNS_STUB_CACHE_SIZE_DEFAULT,
+        .queries_lst_head = C_LIST_INIT(_gl.queries_lst_head),
+    };
+    GlobalData *const    gl    = &_gl;
+    gs_free_error GError *error = NULL;
+    int                  exit_code;
+    Query               *query;
+
+    _nm_logging_enabled_init(g_getenv(_ENV("NM_DNS_STUB_LOG")));
+
+    _LOGD("starting nm-dns-stub (%s)", NM_DIST_VERSION);
+
+    signal(SIGPIPE, SIG_IGN);
+
+    g_mutex_init(&gl->routes_mutex);
+    g_mutex_init(&gl->tcp_mutex);
+    g_cond_init(&gl->tcp_cond);
+    gl->tcp_cancellable = g_cancellable_new();
+    gl->routes          = g_ptr_array_new_with_free_func((GDestroyNotify) _route_free);
+    gl->recv_buf        = g_malloc(UDP_MSG_SIZE_MAX);
+    gl->cache           = nm_dns_stub_cache_new(gl->cache_size);
+    gl->queries_by_key  = g_hash_table_new(g_bytes_hash, g_bytes_equal);
+
+    if (fcntl(gl->control_fd, F_GETFD) < 0) {
+        _LOGE("control socket (fd %d) not open", NM_DNS_STUB_CONTROL_FD);
+        exit_code = EXIT_FAILURE;
+        goto done;
+    }
+    nm_io_fcntl_setfl_update_nonblock(gl->control_fd);
+
+    if (!_listen_udp(gl, &error) || !_listen_tcp(gl, &error) || !_drop_privileges(&error)) {
+        _LOGE("%s", error->message);
+        exit_code = EXIT_FAILURE;
+        goto done;
+    }
+
+    gl->source_sigterm = nm_g_unix_signal_add_source(SIGTERM, _signal_callback_term, gl);
+    gl->source_control = nm_g_unix_fd_add_source(gl->control_fd,
+                                                 G_IO_IN | G_IO_HUP | G_IO_ERR,
+                                                 _control_fd_cb,
+                                                 gl);
+
+    _LOGD("listening on %s:%d", NM_DNS_STUB_LISTEN_ADDRESS, NM_DNS_STUB_LISTEN_PORT);
+
+    while (!gl->quitting)
+        g_main_context_iteration(NULL, TRUE);
+
+    exit_code = EXIT_SUCCESS;
+
+done:
+    _LOGD("shutdown: cleanup (cache hits: %" G_GUINT64_FORMAT ", misses: %" G_GUINT64_FORMAT
+          ")",
+          gl->stats_hits,
+          gl->stats_misses);
+
+    gl->quitting = TRUE;
+
+    while ((query = c_list_first_entry(&gl->queries_lst_head, Query, query_lst)))
+        _query_free(query);
+
+    if (gl->tcp_service) {
+        g_socket_service_stop(gl->tcp_service);
+        g_socket_listener_close(G_SOCKET_LISTENER(gl->tcp_service));
+
+        /* g_socket_service_stop() does not wait for the handlers that are
+         * still running on the threads of the service. Abort their I/O and
+         * wait for them, because they use @gl. */
+        g_cancellable_cancel(gl->tcp_cancellable);
+        g_mutex_lock(&gl->tcp_mutex);
+        while (gl->tcp_n_active > 0)
+            g_cond_wait(&gl->tcp_cond, &gl->tcp_mutex);
+        g_mutex_unlock(&gl->tcp_mutex);
+
+        g_clear_object(&gl->tcp_service);
+    }
+
+    nm_clear_g_source_inst(&gl->source_sigterm);
+    nm_clear_g_source_inst(&gl->source_control);
+    nm_clear_g_source_inst(&gl->source_udp);
+    nm_clear_fd(&gl->udp_fd);
+
+    nm_clear_pointer(&gl->queries_by_key, g_hash_table_unref);
+    nm_clear_pointer(&gl->cache, nm_dns_stub_cache_free);
+    nm_clear_pointer(&gl->routes, g_ptr_array_unref);
+    nm_clear_g_free(&gl->recv_buf);
+    g_clear_object(&gl->tcp_cancellable);
+    g_mutex_clear(&gl->tcp_mutex);
+    g_cond_clear(&gl->tcp_cond);
+    g_mutex_clear(&gl->routes_mutex);
+
+    _LOGD("exit (%d)", exit_code);
+    return exit_code;
+}
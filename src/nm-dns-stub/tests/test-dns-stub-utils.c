@@ -0,0 +1,401 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "libnm-glib-aux/nm-default-glib-i18n-prog.h"
+
+#include "nm-dns-stub/nm-dns-stub-utils.h"
+
+#include "libnm-glib-aux/nm-test-utils.h"
+
+/*****************************************************************************/
+
+/* id 0x1234, RD, one question "www.Example.COM" IN A. */
+static const guint8 query_a[] = {
+    0x12, 0x34, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 'w',
+    'w',  'w',  0x07, 'E',  'x',  'a',  'm',  'p',  'l',  'e',  0x03, 'C',  'O',  'M',
+    0x00, 0x00, 0x01, 0x00, 0x01,
+};
+
+/* the reply to query_a, with two A records (TTL 300 and 120). The
+ * names are compressed. */
+static const guint8 reply_a[] = {
+    0x12, 0x34, 0x81, 0x80, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x03, 'w',
+    'w',  'w',  0x07, 'e',  'x',  'a',  'm',  'p',  'l',  'e',  0x03, 'c',  'o',  'm',
+    0x00, 0x00, 0x01, 0x00, 0x01,
+
+    0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x01, 0x2C, 0x00, 0x04, 192,  0,
+    2,    1,
+
+    0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x78, 0x00, 0x04, 192,  0,
+    2,    2,
+};
+
+/* NXDOMAIN reply to query_a, with a SOA record in the authority section:
+ * TTL 3600, MINIMUM 60. */
+static const guint8 reply_nxdomain[] = {
+    0x12, 0x34, 0x81, 0x83, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x03, 'w',
+    'w',  'w',  0x07, 'e',  'x',  'a',  'm',  'p',  'l',  'e',  0x03, 'c',  'o',  'm',
+    0x00, 0x00, 0x01, 0x00, 0x01,
+
+    0xC0, 0x10, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x0E, 0x10, 0x00, 0x1C,
+
+    /* mname, rname */
+    0x01, 'a',  0xC0, 0x10, 0x01, 'b',  0xC0, 0x10,
+    /* serial, refresh, retry, expire, minimum */
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x0E, 0x10, 0x00, 0x00, 0x02, 0x58, 0x00, 0x01,
+    0x51, 0x80, 0x00, 0x00, 0x00, 0x3C,
+};
+
+/*****************************************************************************/
+
+static void
+test_parse_question(void)
+{
+    char               name[NM_DNS_STUB_NAME_BUF_SIZE];
+    NMDnsStubMsgHeader header;
+    guint16            qtype;
+    guint16            qclass;
+    gsize              end;
+
+    g_assert(nm_dns_stub_msg_parse_header(query_a, sizeof(query_a), &header));
+    g_assert_cmpint(header.id, ==, 0x1234);
+    g_assert_cmpint(header.flags, ==, NM_DNS_STUB_FLAG_RD);
+    g_assert_cmpint(header.qdcount, ==, 1);
+
+    g_assert(nm_dns_stub_msg_parse_question(query_a,
+                                            sizeof(query_a),
+                                            name,
+                                            &qtype,
+                                            &qclass,
+                                            &end));
+    g_assert_cmpstr(name, ==, "www.example.com");
+    g_assert_cmpint(qtype, ==, 1);
+    g_assert_cmpint(qclass, ==, 1);
+    g_assert_cmpint(end, ==, sizeof(query_a));
+
+    g_assert(!nm_dns_stub_msg_parse_question(query_a, sizeof(query_a) - 1, name, NULL, NULL, NULL));
+    g_assert(!nm_dns_stub_msg_parse_header(query_a, 11, &header));
+
+    g_assert(nm_dns_stub_msg_question_equal(query_a, sizeof(query_a), reply_a, sizeof(reply_a)));
+}
+
+static void
+test_parse_name_loop(void)
+{
+    /* A compression pointer that points to itself. */
+    static const guint8 msg[] = {
+        0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01,
+    };
+    char name[NM_DNS_STUB_NAME_BUF_SIZE];
+
+    g_assert(!nm_dns_stub_msg_parse_question(msg, sizeof(msg), name, NULL, NULL, NULL));
+}
+
+static void
+test_cache_key(void)
+{
+    gs_unref_bytes GBytes *key1 = NULL;
+    gs_unref_bytes GBytes *key2 = NULL;
+    gs_unref_bytes GBytes *key3 = NULL;
+    guint8                 query[sizeof(query_a)];
+
+    key1 = nm_dns_stub_msg_cache_key(query_a, sizeof(query_a));
+    g_assert(key1);
+
+    /* A different ID and different case give the same key. */
+    memcpy(query, query_a, sizeof(query));
+    nm_dns_stub_msg_set_id(query, 0x4321);
+    query[13] = 'W';
+    key2      = nm_dns_stub_msg_cache_key(query, sizeof(query));
+    g_assert(key2);
+    g_assert(g_bytes_equal(key1, key2));
+
+    /* A different QTYPE does not. */
+    query[sizeof(query) - 3] = 28;
+    key3                     = nm_dns_stub_msg_cache_key(query, sizeof(query));
+    g_assert(key3);
+    g_assert(!g_bytes_equal(key1, key3));
+
+    /* Responses are not queries. */
+    g_assert(!nm_dns_stub_msg_cache_key(reply_a, sizeof(reply_a)));
+}
+
+static void
+test_get_ttl(void)
+{
+    guint32  ttl;
+    gboolean negative;
+    guint8   reply[sizeof(reply_a)];
+
+    g_assert(nm_dns_stub_msg_get_ttl(reply_a, sizeof(reply_a), &ttl, &negative));
+    g_assert_cmpint(ttl, ==, 120);
+    g_assert(!negative);
+
+    g_assert(nm_dns_stub_msg_get_ttl(reply_nxdomain, sizeof(reply_nxdomain), &ttl, &negative));
+    g_assert_cmpint(ttl, ==, 60);
+    g_assert(negative);
+
+    /* Queries and truncated replies are not cacheable. */
+    g_assert(!nm_dns_stub_msg_get_ttl(query_a, sizeof(query_a), &ttl, NULL));
+    memcpy(reply, reply_a, sizeof(reply));
+    reply[2] |= (NM_DNS_STUB_FLAG_TC >> 8);
+    g_assert(!nm_dns_stub_msg_get_ttl(reply, sizeof(reply), &ttl, NULL));
+
+    /* Neither is SERVFAIL. */
+    memcpy(reply, reply_a, sizeof(reply));
+    reply[3] = (reply[3] & 0xF0) | NM_DNS_STUB_RCODE_SERVFAIL;
+    g_assert(!nm_dns_stub_msg_get_ttl(reply, sizeof(reply), &ttl, NULL));
+
+    /* A record that exceeds the message. */
+    g_assert(!nm_dns_stub_msg_get_ttl(reply_a, sizeof(reply_a) - 1, &ttl, NULL));
+}
+
+static void
+test_age_ttls(void)
+{
+    guint8  reply[sizeof(reply_a)];
+    guint32 ttl;
+
+    memcpy(reply, reply_a, sizeof(reply));
+    g_assert(nm_dns_stub_msg_age_ttls(reply, sizeof(reply), 100));
+    g_assert(nm_dns_stub_msg_get_ttl(reply, sizeof(reply), &ttl, NULL));
+    g_assert_cmpint(ttl, ==, 20);
+
+    /* TTLs don't wrap around. */
+    g_assert(nm_dns_stub_msg_age_ttls(reply, sizeof(reply), 1000));
+    g_assert(!nm_dns_stub_msg_get_ttl(reply, sizeof(reply), &ttl, NULL));
+}
+
+static void
+test_new_error(void)
+{
+    gs_unref_bytes GBytes *response = NULL;
+    NMDnsStubMsgHeader     header;
+    const guint8          *data;
+    gsize                  len;
+
+    response = nm_dns_stub_msg_new_error(query_a, sizeof(query_a), NM_DNS_STUB_RCODE_SERVFAIL);
+    g_assert(response);
+    data = g_bytes_get_data(response, &len);
+    g_assert_cmpint(len, ==, sizeof(query_a));
+
+    g_assert(nm_dns_stub_msg_parse_header(data, len, &header));
+    g_assert_cmpint(header.id, ==, 0x1234);
+    g_assert_cmpint(header.flags,
+                    ==,
+                    NM_DNS_STUB_FLAG_QR | NM_DNS_STUB_FLAG_RD | NM_DNS_STUB_FLAG_RA
+                        | NM_DNS_STUB_RCODE_SERVFAIL);
+    g_assert_cmpint(header.qdcount, ==, 1);
+    g_assert(nm_dns_stub_msg_question_equal(data, len, query_a, sizeof(query_a)));
+
+    g_assert(!nm_dns_stub_msg_new_error(query_a, 5, NM_DNS_STUB_RCODE_FORMERR));
+}
+
+static void
+test_name_in_domain(void)
+{
+    g_assert(nm_dns_stub_name_in_domain("www.example.com", ""));
+    g_assert(nm_dns_stub_name_in_domain("www.example.com", "com"));
+    g_assert(nm_dns_stub_name_in_domain("www.example.com", "example.com"));
+    g_assert(nm_dns_stub_name_in_domain("example.com", "example.com"));
+    g_assert(!nm_dns_stub_name_in_domain("www.myexample.com", "example.com"));
+    g_assert(!nm_dns_stub_name_in_domain("com", "example.com"));
+}
+
+static void
+test_copy_question(void)
+{
+    guint8 reply[sizeof(reply_a)];
+    guint8 query[sizeof(query_a)];
+
+    /* The reply has the question in lower case, the query in mixed case. */
+    memcpy(reply, reply_a, sizeof(reply));
+    g_assert(nm_dns_stub_msg_copy_question(reply, sizeof(reply), query_a, sizeof(query_a)));
+    g_assert(memcmp(&reply[NM_DNS_STUB_MSG_HEADER_SIZE],
+                    &query_a[NM_DNS_STUB_MSG_HEADER_SIZE],
+                    sizeof(query_a) - NM_DNS_STUB_MSG_HEADER_SIZE)
+             == 0);
+    /* The rest is unchanged. */
+    g_assert(memcmp(reply, reply_a, NM_DNS_STUB_MSG_HEADER_SIZE) == 0);
+    g_assert(memcmp(&reply[sizeof(query_a)],
+                    &reply_a[sizeof(query_a)],
+                    sizeof(reply) - sizeof(query_a))
+             == 0);
+
+    /* A different question is not copied. */
+    memcpy(reply, reply_a, sizeof(reply));
+    memcpy(query, query_a, sizeof(query));
+    query[sizeof(query) - 3] = 28;
+    g_assert(!nm_dns_stub_msg_copy_question(reply, sizeof(reply), query, sizeof(query)));
+    g_assert(memcmp(reply, reply_a, sizeof(reply)) == 0);
+}
+
+static void
+test_cache(void)
+{
+    NMDnsStubCache        *cache;
+    gs_unref_bytes GBytes *key_a    = NULL;
+    gs_unref_bytes GBytes *key_aaaa = NULL;
+    guint8                 query[sizeof(query_a)];
+    const gint64           now_msec = 1000;
+    gboolean               prefetch;
+    guint32                ttl;
+    guint8                *buf;
+    gsize                  len;
+
+    key_a = nm_dns_stub_msg_cache_key(query_a, sizeof(query_a));
+    memcpy(query, query_a, sizeof(query));
+    query[sizeof(query) - 3] = 28;
+    key_aaaa                 = nm_dns_stub_msg_cache_key(query, sizeof(query));
+
+    cache = nm_dns_stub_cache_new(10);
+
+    g_assert(!nm_dns_stub_cache_lookup(cache, key_a, now_msec, &len, &prefetch));
+
+    /* Queries and SERVFAIL are not cacheable. */
+    g_assert(!nm_dns_stub_cache_add(cache, key_a, query_a, sizeof(query_a), now_msec));
+    g_assert_cmpint(nm_dns_stub_cache_get_n_entries(cache), ==, 0);
+
+    g_assert(nm_dns_stub_cache_add(cache, key_a, reply_a, sizeof(reply_a), now_msec));
+    g_assert_cmpint(nm_dns_stub_cache_get_n_entries(cache), ==, 1);
+
+    /* The TTLs are reduced by the age of the entry. */
+    buf = nm_dns_stub_cache_lookup(cache, key_a, now_msec + 50000, &len, &prefetch);
+    g_assert(buf);
+    g_assert_cmpint(len, ==, sizeof(reply_a));
+    g_assert(!prefetch);
+    g_assert(nm_dns_stub_msg_get_ttl(buf, len, &ttl, NULL));
+    g_assert_cmpint(ttl, ==, 70);
+    g_free(buf);
+
+    /* Shortly before expiry, prefetch is requested once. */
+    buf = nm_dns_stub_cache_lookup(cache, key_a, now_msec + 110000, &len, &prefetch);
+    g_assert(buf);
+    g_assert(prefetch);
+    g_free(buf);
+    buf = nm_dns_stub_cache_lookup(cache, key_a, now_msec + 111000, &len, &prefetch);
+    g_assert(buf);
+    g_assert(!prefetch);
+    g_free(buf);
+
+    /* The entry expires with the smallest TTL. */
+    g_assert(!nm_dns_stub_cache_lookup(cache, key_a, now_msec + 120000, &len, &prefetch));
+    g_assert_cmpint(nm_dns_stub_cache_get_n_entries(cache), ==, 0);
+
+    /* Negative entries use the SOA minimum and are never prefetched. */
+    g_assert(nm_dns_stub_cache_add(cache, key_a, reply_nxdomain, sizeof(reply_nxdomain), now_msec));
+    buf = nm_dns_stub_cache_lookup(cache, key_a, now_msec + 59000, &len, &prefetch);
+    g_assert(buf);
+    g_assert(!prefetch);
+    g_free(buf);
+    g_assert(!nm_dns_stub_cache_lookup(cache, key_a, now_msec + 60000, &len, &prefetch));
+
+    /* The least recently used entry gets dropped. */
+    nm_dns_stub_cache_set_max_size(cache, 1);
+    g_assert(nm_dns_stub_cache_add(cache, key_a, reply_a, sizeof(reply_a), now_msec));
+    g_assert(nm_dns_stub_cache_add(cache, key_aaaa, reply_a, sizeof(reply_a), now_msec));
+    g_assert_cmpint(nm_dns_stub_cache_get_n_entries(cache), ==, 1);
+    g_assert(!nm_dns_stub_cache_lookup(cache, key_a, now_msec, &len, &prefetch));
+    buf = nm_dns_stub_cache_lookup(cache, key_aaaa, now_msec, &len, &prefetch);
+    g_assert(buf);
+    g_free(buf);
+
+    /* Size zero disables the cache. */
+    nm_dns_stub_cache_set_max_size(cache, 0);
+    g_assert_cmpint(nm_dns_stub_cache_get_n_entries(cache), ==, 0);
+    g_assert(!nm_dns_stub_cache_add(cache, key_a, reply_a, sizeof(reply_a), now_msec));
+
+    nm_dns_stub_cache_set_max_size(cache, 10);
+    g_assert(nm_dns_stub_cache_add(cache, key_a, reply_a, sizeof(reply_a), now_msec));
+    g_assert_cmpint(nm_dns_stub_cache_flush(cache), ==, 1);
+    g_assert_cmpint(nm_dns_stub_cache_get_n_entries(cache), ==, 0);
+
+    nm_dns_stub_cache_free(cache);
+}
+
+/* Feed randomly corrupted and truncated messages to everything that parses
+ * replies from upstream servers. This must not crash or read out of bounds
+ * (run with valgrind or ASan). */
+static void
+test_fuzz_reply(void)
+{
+    static const struct {
+        const guint8 *msg;
+        gsize         len;
+    } seeds[] = {
+        {query_a, sizeof(query_a)},
+        {reply_a, sizeof(reply_a)},
+        {reply_nxdomain, sizeof(reply_nxdomain)},
+    };
+    NMDnsStubCache        *cache;
+    gs_unref_bytes GBytes *key_a = NULL;
+    guint                  i;
+
+    key_a = nm_dns_stub_msg_cache_key(query_a, sizeof(query_a));
+    cache = nm_dns_stub_cache_new(5);
+
+    for (i = 0; i < 20000; i++) {
+        gs_unref_bytes GBytes *key      = NULL;
+        gs_unref_bytes GBytes *error    = NULL;
+        gs_free guint8        *msg      = NULL;
+        gs_free guint8        *cached   = NULL;
+        const guint            seed_idx = nmtst_get_rand_uint32() % G_N_ELEMENTS(seeds);
+        char                   name[NM_DNS_STUB_NAME_BUF_SIZE];
+        NMDnsStubMsgHeader     header;
+        guint32                ttl;
+        gboolean               negative;
+        gboolean               prefetch;
+        gsize                  len;
+        gsize                  cached_len;
+        guint                  n_mutations;
+        guint                  j;
+
+        len = seeds[seed_idx].len;
+        msg = nm_memdup(seeds[seed_idx].msg, len);
+
+        n_mutations = nmtst_get_rand_uint32() % 4u;
+        for (j = 0; j < n_mutations; j++)
+            msg[nmtst_get_rand_uint32() % len] = nmtst_get_rand_uint32() & 0xFF;
+        if (nmtst_get_rand_uint32() % 4u == 0)
+            len = nmtst_get_rand_uint32() % (len + 1u);
+
+        nm_dns_stub_msg_parse_header(msg, len, &header);
+        nm_dns_stub_msg_parse_question(msg, len, name, NULL, NULL, NULL);
+        nm_dns_stub_msg_question_equal(msg, len, query_a, sizeof(query_a));
+        nm_dns_stub_msg_get_ttl(msg, len, &ttl, &negative);
+        nm_dns_stub_msg_age_ttls(msg, len, nmtst_get_rand_uint32() % 1000u);
+        nm_dns_stub_msg_copy_question(msg, len, query_a, sizeof(query_a));
+        error = nm_dns_stub_msg_new_error(msg, len, NM_DNS_STUB_RCODE_SERVFAIL);
+
+        key = nm_dns_stub_msg_cache_key(msg, len);
+        nm_dns_stub_cache_add(cache, key ?: key_a, msg, len, i);
+        cached = nm_dns_stub_cache_lookup(cache, key ?: key_a, i, &cached_len, &prefetch);
+        if (cached)
+            nm_dns_stub_msg_copy_question(cached, cached_len, query_a, sizeof(query_a));
+    }
+
+    nm_dns_stub_cache_free(cache);
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE();
+
+int
+main(int argc, char **argv)
+{
+    nmtst_init(&argc, &argv, TRUE);
+
+    g_test_add_func("/dns-stub/parse-question", test_parse_question);
+    g_test_add_func("/dns-stub/parse-name-loop", test_parse_name_loop);
+    g_test_add_func("/dns-stub/cache-key", test_cache_key);
+    g_test_add_func("/dns-stub/get-ttl", test_get_ttl);
+    g_test_add_func("/dns-stub/age-ttls", test_age_ttls);
+    g_test_add_func("/dns-stub/new-error", test_new_error);
+    g_test_add_func("/dns-stub/name-in-domain", test_name_in_domain);
+    g_test_add_func("/dns-stub/copy-question", test_copy_question);
+    g_test_add_func("/dns-stub/cache", test_cache);
+    g_test_add_func("/dns-stub/fuzz-reply", test_fuzz_reply);
+
+    return g_test_run();
+}
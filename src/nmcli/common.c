@@ -7,8 +7,10 @@
 
 #include "common.h"
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include <sys/ioctl.h>
 #if HAVE_EDITLINE_READLINE
 #include <editline/readline.h>
@@ -23,6 +25,7 @@
 #include "libnmc-base/nm-vpn-helpers.h"
 #include "libnmc-base/nm-client-utils.h"
 #include "libnm-glib-aux/nm-secret-utils.h"
+#include "libnm-glib-aux/nm-json-aux.h"
 
 #include "utils.h"
 
@@ -1426,8 +1429,13 @@ call_cmd(NmCli *nmc, GTask *task, const NMCCommand *cmd, int argc, const char *c
 
         g_object_unref(task);
     } else {
+        NMClientObjectTypes object_types = NM_CLIENT_OBJECT_TYPES_ALL;
+
         nm_assert(nmc->client == NULL);
 
+        if (cmd->get_object_types)
+            object_types = cmd->get_object_types(nmc, argc, argv);
+
         nmc->should_wait++;
         call  = g_slice_new(CmdCall);
         *call = (CmdCall){
@@ -1441,6 +1449,8 @@ call_cmd(NmCli *nmc, GTask *task, const NMCCommand *cmd, int argc, const char *c
                              call,
                              NM_CLIENT_INSTANCE_FLAGS,
                              (guint) NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS,
+                             NM_CLIENT_OBJECT_TYPES,
+                             (guint) object_types,
                              NULL);
     }
 }
@@ -1614,3 +1624,213 @@ NM_UTILS_LOOKUP_STR_DEFINE(nm_connectivity_to_string,
                            NM_UTILS_LOOKUP_ITEM(NM_CONNECTIVITY_LIMITED, N_("limited")),
                            NM_UTILS_LOOKUP_ITEM(NM_CONNECTIVITY_FULL, N_("full")),
                            NM_UTILS_LOOKUP_ITEM_IGNORE(NM_CONNECTIVITY_UNKNOWN), );
+
+/*****************************************************************************/
+
+/* Upper bound for the events that are queued for stdout but not yet written.
+ * A consumer that does not keep up must not make nmcli grow without limit,
+ * so events beyond this are dropped and reported with a "dropped" event
+ * once there is room again. */
+#define MONITOR_JSON_BUF_MAX (256u * 1024u)
+
+typedef struct _NmcMonitorJson {
+    GString *buf;
+    GSource *out_source;
+    gsize    buf_pos;
+    guint64  n_dropped;
+} NmcMonitorJson;
+
+static void
+_monitor_json_buf_consume(NmcMonitorJson *mj, gsize n)
+{
+    mj->buf_pos += n;
+    if (mj->buf_pos >= mj->buf->len) {
+        g_string_truncate(mj->buf, 0);
+        mj->buf_pos = 0;
+    } else if (mj->buf_pos > MONITOR_JSON_BUF_MAX / 2) {
+        g_string_erase(mj->buf, 0, mj->buf_pos);
+        mj->buf_pos = 0;
+    }
+}
+
+static gboolean
+_monitor_json_write_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    NmcMonitorJson *mj = user_data;
+    gssize          n;
+
+    /* Write at most PIPE_BUF bytes per wakeup. POLLOUT guarantees that much
+     * space on a pipe, so this does not block even though stdout is left in
+     * blocking mode (it may be shared with other processes). */
+    n = write(STDOUT_FILENO,
+              &mj->buf->str[mj->buf_pos],
+              NM_MIN((gsize) PIPE_BUF, mj->buf->len - mj->buf_pos));
+    if (n < 0) {
+        if (NM_IN_SET(errno, EAGAIN, EINTR))
+            return G_SOURCE_CONTINUE;
+        /* The reader is gone. Discard the pending output. */
+        n = mj->buf->len - mj->buf_pos;
+    }
+
+    _monitor_json_buf_consume(mj, n);
+
+    if (mj->buf->len == 0)
+        nm_clear_g_source_inst(&mj->out_source);
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * nmc_monitor_json_start:
+ * @nmc: the #NmCli instance
+ *
+ * Switches the monitor commands to print one JSON object per line
+ * for each event instead of human readable text.
+ */
+void
+nmc_monitor_json_start(NmCli *nmc)
+{
+    NmcMonitorJson *mj;
+
+    if (nmc->monitor_json)
+        return;
+
+    /* Anything printed with stdio so far must come before our events. */
+    fflush(stdout);
+
+    mj  = g_slice_new0(NmcMonitorJson);
+    *mj = (NmcMonitorJson){
+        .buf = g_string_sized_new(4096),
+    };
+    nmc->monitor_json = mj;
+}
+
+void
+nmc_monitor_json_stop(NmCli *nmc)
+{
+    NmcMonitorJson *mj = g_steal_pointer(&nmc->monitor_json);
+
+    if (!mj)
+        return;
+
+    nm_clear_g_source_inst(&mj->out_source);
+
+    /* We are about to exit. Flush what is left, blocking if need be. */
+    while (mj->buf_pos < mj->buf->len) {
+        gssize n;
+
+        n = write(STDOUT_FILENO, &mj->buf->str[mj->buf_pos], mj->buf->len - mj->buf_pos);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        mj->buf_pos += n;
+    }
+
+    g_string_free(mj->buf, TRUE);
+    nm_g_slice_free(mj);
+}
+
+GString *
+nmc_monitor_json_event_new(const char *event)
+{
+    GString *gstr;
+
+    gstr = g_string_sized_new(256);
+    g_string_append(gstr, "{\"event\":");
+    nm_json_gstr_append_string(gstr, event);
+    g_string_append(gstr, ",\"timestamp\":");
+    nm_json_gstr_append_int64(gstr, g_get_real_time() / 1000);
+    return gstr;
+}
+
+static void
+_monitor_json_append_key(GString *gstr, const char *key)
+{
+    g_string_append_c(gstr, ',');
+    nm_json_gstr_append_string(gstr, key);
+    g_string_append_c(gstr, ':');
+}
+
+void
+nmc_monitor_json_add_str(GString *gstr, const char *key, const char *value)
+{
+    _monitor_json_append_key(gstr, key);
+    nm_json_gstr_append_string(gstr, value);
+}
+
+void
+nmc_monitor_json_add_int(GString *gstr, const char *key, gint64 value)
+{
+    _monitor_json_append_key(gstr, key);
+    nm_json_gstr_append_int64(gstr, value);
+}
+
+void
+nmc_monitor_json_add_bool(GString *gstr, const char *key, gboolean value)
+{
+    _monitor_json_append_key(gstr, key);
+    nm_json_gstr_append_bool(gstr, value);
+}
+
+void
+nmc_monitor_json_add_strv(GString *gstr, const char *key, const char *const *strv, gssize len)
+{
+    gsize i;
+
+    if (len < 0)
+        len = NM_PTRARRAY_LEN(strv);
+
+    _monitor_json_append_key(gstr, key);
+    g_string_append_c(gstr, '[');
+    for (i = 0; i < (gsize) len; i++) {
+        if (i > 0)
+            g_string_append_c(gstr, ',');
+        nm_json_gstr_append_string(gstr, strv[i]);
+    }
+    g_string_append_c(gstr, ']');
+}
+
+/**
+ * nmc_monitor_json_emit:
+ * @nmc: the #NmCli instance in JSON mode
+ * @gstr: (transfer full): the event, as returned by nmc_monitor_json_event_new()
+ *
+ * Terminates the event and queues it for writing to stdout. The write
+ * happens from the main loop when stdout is writable, so a slow reader
+ * never stalls processing of further D-Bus signals.
+ */
+void
+nmc_monitor_json_emit(NmCli *nmc, GString *gstr)
+{
+    NmcMonitorJson *mj = nmc->monitor_json;
+    gsize           queued;
+
+    nm_assert(mj);
+
+    g_string_append(gstr, "}\n");
+
+    queued = mj->buf->len - mj->buf_pos;
+    if (queued + gstr->len > MONITOR_JSON_BUF_MAX) {
+        mj->n_dropped++;
+        g_string_free(gstr, TRUE);
+        return;
+    }
+
+    if (mj->n_dropped > 0) {
+        nm_auto_free_gstring GString *gstr_dropped = NULL;
+
+        gstr_dropped = nmc_monitor_json_event_new("dropped");
+        nmc_monitor_json_add_int(gstr_dropped, "count", nm_steal_int(&mj->n_dropped));
+        g_string_append(gstr_dropped, "}\n");
+        g_string_append_len(mj->buf, gstr_dropped->str, gstr_dropped->len);
+    }
+
+    g_string_append_len(mj->buf, gstr->str, gstr->len);
+    g_string_free(gstr, TRUE);
+
+    if (!mj->out_source) {
+        mj->out_source =
+            nm_g_unix_fd_add_source(STDOUT_FILENO, G_IO_OUT, _monitor_json_write_cb, mj);
+    }
+}
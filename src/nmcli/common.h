@@ -81,4 +81,14 @@ extern const NmcMetaGenericInfo *const metagen_ip6_config[];
 extern const NmcMetaGenericInfo *const metagen_dhcp_config[];
 
 const char *nm_connectivity_to_string(NMConnectivityState connectivity);
+
+void     nmc_monitor_json_start(NmCli *nmc);
+void     nmc_monitor_json_stop(NmCli *nmc);
+GString *nmc_monitor_json_event_new(const char *event);
+void     nmc_monitor_json_add_str(GString *gstr, const char *key, const char *value);
+void     nmc_monitor_json_add_int(GString *gstr, const char *key, gint64 value);
+void     nmc_monitor_json_add_bool(GString *gstr, const char *key, gboolean value);
+void nmc_monitor_json_add_strv(GString *gstr, const char *key, const char *const *strv, gssize len);
+void nmc_monitor_json_emit(NmCli *nmc, GString *gstr);
+
 #endif /* NMC_COMMON_H */
@@ -1394,11 +1394,12 @@ usage_connection_monitor(void)
 {
     nmc_printerr(_("Usage: nmcli connection monitor { ARGUMENTS | help }\n"
                    "\n"
-                   "ARGUMENTS := [id | uuid | path] <ID> ...\n"
+                   "ARGUMENTS := [--json] [id | uuid | path] <ID> ...\n"
                    "\n"
                    "Monitor connection profile activity.\n"
                    "This command prints a line whenever the specified connection changes.\n"
-                   "Monitors all connection profiles in case none is specified.\n\n"));
+                   "Monitors all connection profiles in case none is specified.\n"
+                   "With --json, each change is printed as one JSON object per line.\n\n"));
 }
 
 static void
@@ -2317,6 +2318,71 @@ get_connection(NmCli              *nmc,
     return connection;
 }
 
+static const char *
+_con_show_fields_str(const NmCli *nmc)
+{
+    if (!nmc->required_fields || g_ascii_strcasecmp(nmc->required_fields, "common") == 0)
+        return NMC_FIELDS_CON_SHOW_COMMON;
+    if (g_ascii_strcasecmp(nmc->required_fields, "all") == 0)
+        return NULL;
+    return nmc->required_fields;
+}
+
+static gboolean
+_con_show_fields_have_active(const char *fields_str)
+{
+    gs_free NMMetaSelectionResultList *selection = NULL;
+    guint                              i;
+
+    selection = nm_meta_selection_create_parse_list(
+        (const NMMetaAbstractInfo *const *) metagen_con_show,
+        fields_str,
+        FALSE,
+        NULL);
+    if (!selection || selection->num == 0)
+        return TRUE;
+
+    for (i = 0; i < selection->num; i++) {
+        const NmcMetaGenericInfo *info = (const NmcMetaGenericInfo *) selection->items[i].info;
+
+        if (NM_IN_SET(info->info_type,
+                      NMC_GENERIC_INFO_TYPE_CON_SHOW_DEVICE,
+                      NMC_GENERIC_INFO_TYPE_CON_SHOW_STATE,
+                      NMC_GENERIC_INFO_TYPE_CON_SHOW_ACTIVE,
+                      NMC_GENERIC_INFO_TYPE_CON_SHOW_ACTIVE_PATH))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static NMClientObjectTypes
+_con_show_get_object_types(const NmCli *nmc, int argc, const char *const *argv)
+{
+    NMClientObjectTypes object_types;
+    int                 i;
+
+    if (nmc->complete)
+        return NM_CLIENT_OBJECT_TYPES_ALL;
+
+    for (i = 1; i < argc; i++) {
+        if (argv[i][0] == '-') {
+            if (nmc_arg_is_option(argv[i], "order"))
+                i++;
+            continue;
+        }
+        /* "connection show <ID>" prints the details. */
+        return NM_CLIENT_OBJECT_TYPES_ALL;
+    }
+
+    /* The list is sorted by the active connections, which looks at their profile
+     * and IP configuration. The devices are only needed for the "DEVICE" column. */
+    object_types = NM_CLIENT_OBJECT_TYPES_CONNECTIONS | NM_CLIENT_OBJECT_TYPES_ACTIVE_CONNECTIONS
+                   | NM_CLIENT_OBJECT_TYPES_IP_CONFIGS;
+    if (_con_show_fields_have_active(_con_show_fields_str(nmc)))
+        object_types |= NM_CLIENT_OBJECT_TYPES_DEVICES;
+    return object_types;
+}
+
 static void
 do_connections_show(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
@@ -2352,20 +2418,14 @@ do_connections_show(const NMCCommand *cmd, NmCli *nmc, int argc, const char *con
     }
 
     if (argc == 0) {
-        const char                        *fields_str         = NULL;
-        gs_unref_ptrarray GPtrArray       *items              = NULL;
-        gs_free NMMetaSelectionResultList *selection          = NULL;
-        gboolean                           show_active_fields = TRUE;
+        const char                  *fields_str;
+        gs_unref_ptrarray GPtrArray *items = NULL;
+        gboolean                     show_active_fields;
 
         if (nmc->complete)
             goto finish;
 
-        if (!nmc->required_fields || g_ascii_strcasecmp(nmc->required_fields, "common") == 0)
-            fields_str = NMC_FIELDS_CON_SHOW_COMMON;
-        else if (!nmc->required_fields || g_ascii_strcasecmp(nmc->required_fields, "all") == 0) {
-            /* pass */
-        } else
-            fields_str = nmc->required_fields;
+        fields_str = _con_show_fields_str(nmc);
 
         /* determine whether the user wants to see any fields that are related to active-connections
          * (e.g. the apath, the current state, or the device where the profile is active).
@@ -2373,27 +2433,7 @@ do_connections_show(const NMCCommand *cmd, NmCli *nmc, int argc, const char *con
          * If that's the case, then we will show one line for each active connection. In case
          * a profile has multiple active connections, it will be listed multiple times.
          * If that's not the case, we filter out these duplicate lines. */
-        selection = nm_meta_selection_create_parse_list(
-            (const NMMetaAbstractInfo *const *) metagen_con_show,
-            fields_str,
-            FALSE,
-            NULL);
-        if (selection && selection->num > 0) {
-            show_active_fields = FALSE;
-            for (i = 0; i < selection->num; i++) {
-                const NmcMetaGenericInfo *info =
-                    (const NmcMetaGenericInfo *) selection->items[i].info;
-
-                if (NM_IN_SET(info->info_type,
-                              NMC_GENERIC_INFO_TYPE_CON_SHOW_DEVICE,
-                              NMC_GENERIC_INFO_TYPE_CON_SHOW_STATE,
-                              NMC_GENERIC_INFO_TYPE_CON_SHOW_ACTIVE,
-                              NMC_GENERIC_INFO_TYPE_CON_SHOW_ACTIVE_PATH)) {
-                    show_active_fields = TRUE;
-                    break;
-                }
-            }
-        }
+        show_active_fields = _con_show_fields_have_active(fields_str);
 
         nm_cli_spawn_pager(&nmc->nmc_config, &nmc->pager_data);
 
@@ -9464,9 +9504,26 @@ finish:
     }
 }
 
+static void
+connection_json_emit(NmCli *nmc, const char *event, NMConnection *connection)
+{
+    GString *gstr;
+
+    gstr = nmc_monitor_json_event_new(event);
+    nmc_monitor_json_add_str(gstr, "id", nm_connection_get_id(connection));
+    nmc_monitor_json_add_str(gstr, "uuid", nm_connection_get_uuid(connection));
+    nmc_monitor_json_add_str(gstr, "path", nm_connection_get_path(connection));
+    nmc_monitor_json_emit(nmc, gstr);
+}
+
 static void
 connection_changed(NMConnection *connection, NmCli *nmc)
 {
+    if (nmc->monitor_json) {
+        connection_json_emit(nmc, "connection-changed", connection);
+        return;
+    }
+
     nmc_print(_("%s: connection profile changed\n"), nm_connection_get_id(connection));
 }
 
@@ -9493,7 +9550,10 @@ connection_added(NMClient *client, NMRemoteConnection *con, NmCli *nmc)
 {
     NMConnection *connection = NM_CONNECTION(con);
 
-    nmc_print(_("%s: connection profile created\n"), nm_connection_get_id(connection));
+    if (nmc->monitor_json)
+        connection_json_emit(nmc, "connection-added", connection);
+    else
+        nmc_print(_("%s: connection profile created\n"), nm_connection_get_id(connection));
     connection_watch(nmc, connection);
 }
 
@@ -9502,7 +9562,10 @@ connection_removed(NMClient *client, NMRemoteConnection *con, NmCli *nmc)
 {
     NMConnection *connection = NM_CONNECTION(con);
 
-    nmc_print(_("%s: connection profile removed\n"), nm_connection_get_id(connection));
+    if (nmc->monitor_json)
+        connection_json_emit(nmc, "connection-removed", connection);
+    else
+        nmc_print(_("%s: connection profile removed\n"), nm_connection_get_id(connection));
     connection_unwatch(nmc, connection);
 }
 
@@ -9514,7 +9577,9 @@ do_connection_monitor(const NMCCommand *cmd, NmCli *nmc, int argc, const char *c
     gs_unref_ptrarray GPtrArray *found_cons  = NULL;
     const GPtrArray             *connections = NULL;
 
-    next_arg(nmc, &argc, &argv, NULL);
+    while (next_arg(nmc, &argc, &argv, "--json", NULL) > 0)
+        nmc_monitor_json_start(nmc);
+
     if (argc == 0) {
         /* No connections specified. Monitor all. */
 
@@ -10151,7 +10216,12 @@ void
 nmc_command_func_connection(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
     static const NMCCommand cmds[] = {
-        {"show", do_connections_show, usage_connection_show, TRUE, TRUE},
+        {"show",
+         do_connections_show,
+         usage_connection_show,
+         TRUE,
+         TRUE,
+         .get_object_types = _con_show_get_object_types},
         {"up", do_connection_up, usage_connection_up, TRUE, TRUE},
         {"down", do_connection_down, usage_connection_down, TRUE, TRUE},
         {"add", do_connection_add, usage_connection_add, TRUE, TRUE, TRUE},
@@ -10165,7 +10235,12 @@ nmc_command_func_connection(const NMCCommand *cmd, NmCli *nmc, int argc, const c
         {"export", do_connection_export, usage_connection_export, TRUE, TRUE},
         {"migrate", do_connection_migrate, usage_connection_migrate, TRUE, TRUE},
         {"monitor", do_connection_monitor, usage_connection_monitor, TRUE, TRUE},
-        {NULL, do_connections_show, usage, TRUE, TRUE},
+        {NULL,
+         do_connections_show,
+         usage,
+         TRUE,
+         TRUE,
+         .get_object_types = _con_show_get_object_types},
     };
 
     next_arg(nmc, &argc, &argv, NULL);
@@ -987,11 +987,13 @@ usage_device_monitor(void)
 {
     nmc_printerr(_("Usage: nmcli device monitor { ARGUMENTS | help }\n"
                    "\n"
-                   "ARGUMENTS := [<ifname>] ...\n"
+                   "ARGUMENTS := [--json] [<ifname>] ...\n"
                    "\n"
                    "Monitor device activity.\n"
                    "This command prints a line whenever the specified devices change state.\n"
-                   "Monitors all devices in case no interface is specified.\n\n"));
+                   "Monitors all devices in case no interface is specified.\n"
+                   "With --json, each change is printed as one JSON object per line,\n"
+                   "including changes of the IP configuration.\n\n"));
 }
 
 static void
@@ -2884,12 +2886,191 @@ do_device_set(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *ar
         nm_device_set_managed(device, values[DEV_SET_MANAGED].value);
 }
 
+typedef struct {
+    NmCli      *nmc;
+    NMDevice   *device;
+    NMIPConfig *ip_configs[2];
+    GSource    *idle_source;
+    bool        pending[2];
+} DeviceIPWatch;
+
+static NM_CACHED_QUARK_FCN("nmcli-device-ip-watch", _device_ip_watch_quark);
+
+static GString *
+_device_json_event_new(const char *event, NMDevice *device)
+{
+    GString *gstr;
+
+    gstr = nmc_monitor_json_event_new(event);
+    nmc_monitor_json_add_str(gstr, "device", nm_device_get_iface(device));
+    return gstr;
+}
+
+static void
+device_ip_config_emit(DeviceIPWatch *watch, int addr_family)
+{
+    const int                    IS_IPv4 = NM_IS_IPv4(addr_family);
+    NMIPConfig                  *cfg     = watch->ip_configs[IS_IPv4];
+    gs_unref_ptrarray GPtrArray *addrs   = g_ptr_array_new_with_free_func(g_free);
+    GPtrArray                   *ptr_array;
+    GString                     *gstr;
+    guint                        i;
+
+    ptr_array = cfg ? nm_ip_config_get_addresses(cfg) : NULL;
+    for (i = 0; ptr_array && i < ptr_array->len; i++) {
+        NMIPAddress *a = ptr_array->pdata[i];
+
+        g_ptr_array_add(addrs,
+                        g_strdup_printf("%s/%u",
+                                        nm_ip_address_get_address(a),
+                                        nm_ip_address_get_prefix(a)));
+    }
+
+    gstr = _device_json_event_new("device-ip-config", watch->device);
+    nmc_monitor_json_add_str(gstr, "family", IS_IPv4 ? "ipv4" : "ipv6");
+    nmc_monitor_json_add_strv(gstr,
+                              "addresses",
+                              (const char *const *) addrs->pdata,
+                              addrs->len);
+    nmc_monitor_json_add_str(gstr, "gateway", cfg ? nm_ip_config_get_gateway(cfg) : NULL);
+    nmc_monitor_json_add_strv(gstr,
+                              "dns",
+                              cfg ? nm_ip_config_get_nameservers(cfg) : NULL,
+                              -1);
+    nmc_monitor_json_emit(watch->nmc, gstr);
+}
+
+static gboolean
+device_ip_config_idle_cb(gpointer user_data)
+{
+    DeviceIPWatch *watch = user_data;
+    int            IS_IPv4;
+
+    nm_clear_g_source_inst(&watch->idle_source);
+
+    for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+        if (nm_steal_int(&watch->pending[IS_IPv4]))
+            device_ip_config_emit(watch, IS_IPv4 ? AF_INET : AF_INET6);
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+device_ip_config_schedule(DeviceIPWatch *watch, int addr_family)
+{
+    /* A single D-Bus update usually notifies several properties
+     * at once. Coalesce them into one event. */
+    watch->pending[NM_IS_IPv4(addr_family)] = TRUE;
+    if (!watch->idle_source)
+        watch->idle_source = nm_g_idle_add_source(device_ip_config_idle_cb, watch);
+}
+
+static void
+device_ip_config_notify(NMIPConfig *cfg, GParamSpec *pspec, DeviceIPWatch *watch)
+{
+    if (NM_IN_STRSET(pspec->name,
+                     NM_IP_CONFIG_ADDRESSES,
+                     NM_IP_CONFIG_GATEWAY,
+                     NM_IP_CONFIG_NAMESERVERS))
+        device_ip_config_schedule(watch, nm_ip_config_get_family(cfg));
+}
+
+static void
+device_ip_config_update(DeviceIPWatch *watch, gboolean emit)
+{
+    int IS_IPv4;
+
+    for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+        NMIPConfig *cfg;
+
+        cfg = IS_IPv4 ? nm_device_get_ip4_config(watch->device)
+                      : nm_device_get_ip6_config(watch->device);
+        if (cfg == watch->ip_configs[IS_IPv4])
+            continue;
+
+        if (watch->ip_configs[IS_IPv4]) {
+            g_signal_handlers_disconnect_by_data(watch->ip_configs[IS_IPv4], watch);
+            g_clear_object(&watch->ip_configs[IS_IPv4]);
+        }
+        if (cfg) {
+            watch->ip_configs[IS_IPv4] = g_object_ref(cfg);
+            g_signal_connect(cfg, "notify", G_CALLBACK(device_ip_config_notify), watch);
+        }
+        if (emit)
+            device_ip_config_schedule(watch, IS_IPv4 ? AF_INET : AF_INET6);
+    }
+}
+
+static void
+device_ip_config_changed(NMDevice *device, GParamSpec *pspec, DeviceIPWatch *watch)
+{
+    device_ip_config_update(watch, TRUE);
+}
+
+static void
+device_ip_watch_free(gpointer user_data)
+{
+    DeviceIPWatch *watch = user_data;
+    int            IS_IPv4;
+
+    g_signal_handlers_disconnect_by_data(watch->device, watch);
+    for (IS_IPv4 = 0; IS_IPv4 < 2; IS_IPv4++) {
+        if (watch->ip_configs[IS_IPv4]) {
+            g_signal_handlers_disconnect_by_data(watch->ip_configs[IS_IPv4], watch);
+            g_object_unref(watch->ip_configs[IS_IPv4]);
+        }
+    }
+    nm_clear_g_source_inst(&watch->idle_source);
+    nm_g_slice_free(watch);
+}
+
+static void
+device_ip_watch(NmCli *nmc, NMDevice *device)
+{
+    DeviceIPWatch *watch;
+
+    watch  = g_slice_new(DeviceIPWatch);
+    *watch = (DeviceIPWatch){
+        .nmc    = nmc,
+        .device = device,
+    };
+    g_object_set_qdata_full(G_OBJECT(device),
+                            _device_ip_watch_quark(),
+                            watch,
+                            device_ip_watch_free);
+
+    g_signal_connect(device,
+                     "notify::" NM_DEVICE_IP4_CONFIG,
+                     G_CALLBACK(device_ip_config_changed),
+                     watch);
+    g_signal_connect(device,
+                     "notify::" NM_DEVICE_IP6_CONFIG,
+                     G_CALLBACK(device_ip_config_changed),
+                     watch);
+    device_ip_config_update(watch, FALSE);
+}
+
 static void
 device_state(NMDevice *device, GParamSpec *pspec, NmCli *nmc)
 {
     gs_free char *str = NULL;
     NMMetaColor   color;
 
+    if (nmc->monitor_json) {
+        NMDeviceState state = nm_device_get_state(device);
+        GString      *gstr;
+
+        gstr = _device_json_event_new("device-state", device);
+        nmc_monitor_json_add_str(gstr, "state", nmc_device_state_to_string(state));
+        nmc_monitor_json_add_int(gstr, "state-code", state);
+        nmc_monitor_json_add_str(gstr,
+                                 "reason",
+                                 nmc_device_reason_to_string(nm_device_get_state_reason(device)));
+        nmc_monitor_json_add_int(gstr, "reason-code", nm_device_get_state_reason(device));
+        nmc_monitor_json_emit(nmc, gstr);
+        return;
+    }
+
     color = nmc_device_state_to_color(device);
     str   = nmc_colorize(&nmc->nmc_config,
                        color,
@@ -2906,6 +3087,16 @@ device_ac(NMDevice *device, GParamSpec *pspec, NmCli *nmc)
     NMActiveConnection *ac = nm_device_get_active_connection(device);
     const char         *id = ac ? nm_active_connection_get_id(ac) : NULL;
 
+    if (nmc->monitor_json) {
+        GString *gstr;
+
+        gstr = _device_json_event_new("device-active-connection", device);
+        nmc_monitor_json_add_str(gstr, "id", id);
+        nmc_monitor_json_add_str(gstr, "uuid", ac ? nm_active_connection_get_uuid(ac) : NULL);
+        nmc_monitor_json_emit(nmc, gstr);
+        return;
+    }
+
     if (!id)
         return;
 
@@ -2918,12 +3109,15 @@ device_watch(NmCli *nmc, NMDevice *device)
     nmc->should_wait++;
     g_signal_connect(device, "notify::" NM_DEVICE_STATE, G_CALLBACK(device_state), nmc);
     g_signal_connect(device, "notify::" NM_DEVICE_ACTIVE_CONNECTION, G_CALLBACK(device_ac), nmc);
+    if (nmc->monitor_json)
+        device_ip_watch(nmc, device);
 }
 
 static void
 device_unwatch(NmCli *nmc, NMDevice *device)
 {
     g_signal_handlers_disconnect_by_func(device, device_state, nmc);
+    g_object_set_qdata(G_OBJECT(device), _device_ip_watch_quark(), NULL);
     if (g_signal_handlers_disconnect_by_func(device, device_ac, nmc))
         nmc->should_wait--;
 
@@ -2935,14 +3129,24 @@ device_unwatch(NmCli *nmc, NMDevice *device)
 static void
 device_added(NMClient *client, NMDevice *device, NmCli *nmc)
 {
-    nmc_print(_("%s: device created\n"), nm_device_get_iface(device));
+    if (nmc->monitor_json) {
+        GString *gstr;
+
+        gstr = _device_json_event_new("device-added", device);
+        nmc_monitor_json_add_str(gstr, "type", nm_device_get_type_description(device));
+        nmc_monitor_json_emit(nmc, gstr);
+    } else
+        nmc_print(_("%s: device created\n"), nm_device_get_iface(device));
     device_watch(nmc, NM_DEVICE(device));
 }
 
 static void
 device_removed(NMClient *client, NMDevice *device, NmCli *nmc)
 {
-    nmc_print(_("%s: device removed\n"), nm_device_get_iface(device));
+    if (nmc->monitor_json)
+        nmc_monitor_json_emit(nmc, _device_json_event_new("device-removed", device));
+    else
+        nmc_print(_("%s: device removed\n"), nm_device_get_iface(device));
     device_unwatch(nmc, device);
 }
 
@@ -2956,7 +3160,9 @@ do_devices_monitor(const NMCCommand *cmd, NmCli *nmc, int argc, const char *cons
     if (nmc->complete)
         return;
 
-    next_arg(nmc, &argc, &argv, NULL);
+    while (next_arg(nmc, &argc, &argv, "--json", NULL) > 0)
+        nmc_monitor_json_start(nmc);
+
     if (argc > 0) {
         devices = devices_free = get_device_list(nmc, &argc, &argv);
         if (argc) {
@@ -5319,6 +5525,67 @@ nmcli_device_tab_completion(const char *text, int start, int end)
     return match_array;
 }
 
+static NMClientObjectTypes
+_devices_status_get_object_types(const NmCli *nmc, int argc, const char *const *argv)
+{
+    if (nmc->complete)
+        return NM_CLIENT_OBJECT_TYPES_ALL;
+
+    /* nmc_get_devices_sorted() compares the active connections, which looks at
+     * their profile and IP configuration. */
+    return NM_CLIENT_OBJECT_TYPES_DEVICES | NM_CLIENT_OBJECT_TYPES_ACTIVE_CONNECTIONS
+           | NM_CLIENT_OBJECT_TYPES_CONNECTIONS | NM_CLIENT_OBJECT_TYPES_IP_CONFIGS;
+}
+
+static NMClientObjectTypes
+_device_show_get_object_types(const NmCli *nmc, int argc, const char *const *argv)
+{
+    gs_unref_array GArray       *sections_array    = NULL;
+    gs_unref_ptrarray GPtrArray *fields_in_section = NULL;
+    NMClientObjectTypes          object_types;
+    const char                  *fields_str;
+    guint                        i;
+
+    /* Without an interface name, all devices are shown, sorted by
+     * nmc_get_devices_sorted(). Only optimize "device show <IFNAME>". */
+    if (nmc->complete || argc != 2)
+        return NM_CLIENT_OBJECT_TYPES_ALL;
+
+    if (!nmc->required_fields || g_ascii_strcasecmp(nmc->required_fields, "common") == 0)
+        fields_str = NMC_FIELDS_DEV_SHOW_SECTIONS_COMMON;
+    else if (g_ascii_strcasecmp(nmc->required_fields, "all") == 0)
+        return NM_CLIENT_OBJECT_TYPES_ALL;
+    else
+        fields_str = nmc->required_fields;
+
+    sections_array =
+        parse_output_fields(fields_str,
+                            (const NMMetaAbstractInfo *const *) nmc_fields_dev_show_sections,
+                            TRUE,
+                            &fields_in_section,
+                            NULL);
+    if (!sections_array)
+        return NM_CLIENT_OBJECT_TYPES_ALL;
+
+    /* get_device() still sorts the devices, in case several have the same name. */
+    object_types = NM_CLIENT_OBJECT_TYPES_DEVICES | NM_CLIENT_OBJECT_TYPES_ACTIVE_CONNECTIONS
+                   | NM_CLIENT_OBJECT_TYPES_IP_CONFIGS;
+
+    for (i = 0; i < sections_array->len; i++) {
+        const NmcMetaGenericInfo *const *nested =
+            nmc_fields_dev_show_sections[nm_g_array_index(sections_array, int, i)]->nested;
+
+        if (nested == nmc_fields_dev_wifi_list + 1)
+            object_types |= NM_CLIENT_OBJECT_TYPES_ACCESS_POINTS;
+        else if (nested == metagen_dhcp_config)
+            object_types |= NM_CLIENT_OBJECT_TYPES_DHCP_CONFIGS;
+        else if (nested == metagen_device_detail_connections)
+            object_types |= NM_CLIENT_OBJECT_TYPES_CONNECTIONS;
+    }
+
+    return object_types;
+}
+
 void
 nmc_command_func_device(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
@@ -5332,12 +5599,27 @@ nmc_command_func_device(const NMCCommand *cmd, NmCli *nmc, int argc, const char
         {"monitor", do_devices_monitor, usage_device_monitor, TRUE, TRUE},
         {"modify", do_device_modify, usage_device_modify, TRUE, TRUE},
         {"reapply", do_device_reapply, usage_device_reapply, TRUE, TRUE},
-        {"status", do_devices_status, usage_device_status, TRUE, TRUE},
+        {"status",
+         do_devices_status,
+         usage_device_status,
+         TRUE,
+         TRUE,
+         .get_object_types = _devices_status_get_object_types},
         {"set", do_device_set, usage_device_set, TRUE, TRUE},
-        {"show", do_device_show, usage_device_show, TRUE, TRUE},
+        {"show",
+         do_device_show,
+         usage_device_show,
+         TRUE,
+         TRUE,
+         .get_object_types = _device_show_get_object_types},
         {"up", do_device_connect, usage_device_connect, TRUE, TRUE},
         {"wifi", do_device_wifi, usage_device_wifi, FALSE, FALSE},
-        {NULL, do_devices_status, usage, TRUE, TRUE},
+        {NULL,
+         do_devices_status,
+         usage,
+         TRUE,
+         TRUE,
+         .get_object_types = _devices_status_get_object_types},
     };
 
     next_arg(nmc, &argc, &argv, NULL);
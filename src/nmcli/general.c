@@ -472,10 +472,11 @@ usage_radio_wwan(void)
 static void
 usage_monitor(void)
 {
-    nmc_printerr(_("Usage: nmcli monitor\n"
+    nmc_printerr(_("Usage: nmcli monitor [--json]\n"
                    "\n"
                    "Monitor NetworkManager changes.\n"
-                   "Prints a line whenever a change occurs in NetworkManager\n\n"));
+                   "Prints a line whenever a change occurs in NetworkManager.\n"
+                   "With --json, each change is printed as one JSON object per line.\n\n"));
 }
 
 static void
@@ -1239,7 +1240,16 @@ networkmanager_running(NMClient *client, GParamSpec *param, NmCli *nmc)
     char    *str;
 
     running = nm_client_get_nm_running(client);
-    str     = nmc_colorize(&nmc->nmc_config,
+
+    if (nmc->monitor_json) {
+        GString *gstr = nmc_monitor_json_event_new("nm-running");
+
+        nmc_monitor_json_add_bool(gstr, "running", running);
+        nmc_monitor_json_emit(nmc, gstr);
+        return;
+    }
+
+    str = nmc_colorize(&nmc->nmc_config,
                        running ? NM_META_COLOR_MANAGER_RUNNING : NM_META_COLOR_MANAGER_STOPPED,
                        running ? _("NetworkManager is running") : _("NetworkManager is stopped"));
     nmc_print("%s\n", str);
@@ -1252,6 +1262,15 @@ client_hostname(NMClient *client, GParamSpec *param, NmCli *nmc)
     const char *hostname;
 
     g_object_get(client, NM_CLIENT_HOSTNAME, &hostname, NULL);
+
+    if (nmc->monitor_json) {
+        GString *gstr = nmc_monitor_json_event_new("hostname");
+
+        nmc_monitor_json_add_str(gstr, "hostname", hostname);
+        nmc_monitor_json_emit(nmc, gstr);
+        return;
+    }
+
     nmc_print(_("Hostname set to '%s'\n"), hostname);
 }
 
@@ -1262,6 +1281,18 @@ client_primary_connection(NMClient *client, GParamSpec *param, NmCli *nmc)
     const char         *id;
 
     primary = nm_client_get_primary_connection(client);
+
+    if (nmc->monitor_json) {
+        GString *gstr = nmc_monitor_json_event_new("primary-connection");
+
+        nmc_monitor_json_add_str(gstr, "id", primary ? nm_active_connection_get_id(primary) : NULL);
+        nmc_monitor_json_add_str(gstr,
+                                 "uuid",
+                                 primary ? nm_active_connection_get_uuid(primary) : NULL);
+        nmc_monitor_json_emit(nmc, gstr);
+        return;
+    }
+
     if (primary) {
         id = nm_active_connection_get_id(primary);
         if (!id)
@@ -1280,6 +1311,15 @@ client_connectivity(NMClient *client, GParamSpec *param, NmCli *nmc)
     char               *str;
 
     g_object_get(client, NM_CLIENT_CONNECTIVITY, &connectivity, NULL);
+
+    if (nmc->monitor_json) {
+        GString *gstr = nmc_monitor_json_event_new("connectivity");
+
+        nmc_monitor_json_add_str(gstr, "connectivity", nm_connectivity_to_string(connectivity));
+        nmc_monitor_json_emit(nmc, gstr);
+        return;
+    }
+
     str = nmc_colorize(&nmc->nmc_config,
                        connectivity_to_color(connectivity),
                        _("Connectivity is now '%s'\n"),
@@ -1295,6 +1335,15 @@ client_state(NMClient *client, GParamSpec *param, NmCli *nmc)
     char   *str;
 
     g_object_get(client, NM_CLIENT_STATE, &state, NULL);
+
+    if (nmc->monitor_json) {
+        GString *gstr = nmc_monitor_json_event_new("state");
+
+        nmc_monitor_json_add_str(gstr, "state", nm_state_to_string(state));
+        nmc_monitor_json_emit(nmc, gstr);
+        return;
+    }
+
     str = nmc_colorize(&nmc->nmc_config,
                        state_to_color(state),
                        _("Networkmanager is now in the '%s' state\n"),
@@ -1607,7 +1656,8 @@ nmc_command_func_overview(const NMCCommand *cmd, NmCli *nmc, int argc, const cha
 void
 nmc_command_func_monitor(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
-    next_arg(nmc, &argc, &argv, NULL);
+    while (next_arg(nmc, &argc, &argv, "--json", NULL) > 0)
+        nmc_monitor_json_start(nmc);
 
     if (nmc->complete)
         return;
@@ -990,6 +990,8 @@ nmc_cleanup(NmCli *nmc)
 {
     pid_t ret;
 
+    nmc_monitor_json_stop(nmc);
+
     g_clear_object(&nmc->client);
 
     if (nmc->return_text)
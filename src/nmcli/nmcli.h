@@ -172,6 +172,9 @@ typedef struct _NmCli {
     /* polkit agent listener */
     struct _NMPolkitListener *pk_listener;
 
+    /* Event queue of the 'monitor' commands in JSON mode: option '--json' */
+    struct _NmcMonitorJson *monitor_json;
+
     /* Semaphore indicating whether nmcli should not end or not yet */
     int should_wait;
 
@@ -250,6 +253,11 @@ typedef struct _NMCCommand {
 
     /* With --online, read in a keyfile from standard input before dispatching the handler. */
     bool needs_offline_conn : 1;
+
+    /* Optional. Returns the object types that the client instance needs to cache for
+     * the command. Read-only commands use that to avoid fetching objects that they
+     * don't print. If unset, the client caches all objects. */
+    NMClientObjectTypes (*get_object_types)(const NmCli *nmc, int argc, const char *const *argv);
 } NMCCommand;
 
 void nmc_command_func_agent(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv);
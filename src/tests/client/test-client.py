@@ -942,6 +942,20 @@ class NMStubServer:
     def addConnection(self, connection, do_verify_strict=True):
         return self.op_AddConnection(connection, do_verify_strict)
 
+    def addConnections(self, connections, flags=0x2, args=None):
+        settings_iface = dbus.Interface(
+            self._conn.get_object(
+                "org.freedesktop.NetworkManager",
+                "/org/freedesktop/NetworkManager/Settings",
+            ),
+            "org.freedesktop.NetworkManager.Settings",
+        )
+        if args is None:
+            args = dbus.Dictionary({}, "sv")
+        return self.op_AddConnections(
+            connections, flags, args, dbus_iface=settings_iface
+        )
+
     def findConnections(self, **kwargs):
         if kwargs:
             lst = self.op_FindConnections(**kwargs)
@@ -2293,6 +2307,59 @@ class TestNmcli(unittest.TestCase):
         nmc.pexp.expect("NetworkManager is stopped")
         end_mon(self, nmc)
 
+    @nm_test
+    def test_add_connections(self):
+        self.ctx.srv.addConnection(
+            {"connection": {"type": "802-3-ethernet", "id": "con-1"}}
+        )
+        uuid_1 = self.ctx.srv.findConnectionUuid("con-1")
+
+        paths, result = self.ctx.srv.addConnections(
+            [
+                {"connection": {"type": "802-3-ethernet", "id": "con-bulk-1"}},
+                {"connection": {"type": "802-3-ethernet", "id": "con-bulk-2"}},
+            ]
+        )
+        self.assertEqual(len(paths), 2)
+        self.assertEqual(len(result), 0)
+        for path, con_id in zip(paths, ["con-bulk-1", "con-bulk-2"]):
+            self.assertEqual(
+                [c[0] for c in self.ctx.srv.findConnections(con_id=con_id)],
+                [str(path)],
+            )
+
+        # A profile with an existing UUID fails the call, and none of the
+        # profiles get added.
+        with self.assertRaises(dbus.exceptions.DBusException) as ctx:
+            self.ctx.srv.addConnections(
+                [
+                    {"connection": {"type": "802-3-ethernet", "id": "con-bulk-3"}},
+                    {
+                        "connection": {
+                            "type": "802-3-ethernet",
+                            "id": "con-bulk-4",
+                            "uuid": uuid_1,
+                        }
+                    },
+                ]
+            )
+        self.assertEqual(
+            ctx.exception.get_dbus_name(),
+            "org.freedesktop.NetworkManager.Settings.UuidExists",
+        )
+        self.assertIsNone(self.ctx.srv.findConnectionUuid("con-bulk-3", required=False))
+        self.assertEqual(len(self.ctx.srv.findConnections()), 3)
+
+        with self.assertRaises(dbus.exceptions.DBusException) as ctx:
+            self.ctx.srv.addConnections(
+                [{"connection": {"type": "802-3-ethernet", "id": "con-bulk-5"}}],
+                flags=0x1 | 0x2,
+            )
+        self.assertEqual(
+            ctx.exception.get_dbus_name(),
+            "org.freedesktop.NetworkManager.Settings.InvalidArguments",
+        )
+
     @nm_test_no_dbus  # we need dbus, but we need to pass arguments to srv_start
     def test_version_warn(self):
         self.ctx.srv_start(srv_version="A.B.C")
@@ -2655,6 +2722,59 @@ class TestNmCloudSetup(unittest.TestCase):
 
         Util.valgrind_check_log(nmc.valgrind_log, "test_ec2")
 
+    @cloud_setup_test
+    def test_ec2_cache(self):
+        self._mock_devices()
+
+        _ec2_macs = "/2018-09-24/meta-data/network/interfaces/macs/"
+        self._mock_path("/latest/meta-data/", "ami-id\n")
+        self._mock_path(
+            _ec2_macs, TestNmCloudSetup._mac2 + "\n" + TestNmCloudSetup._mac1
+        )
+        self._mock_path(
+            _ec2_macs + TestNmCloudSetup._mac2 + "/subnet-ipv4-cidr-block",
+            "172.31.16.0/20",
+        )
+        self._mock_path(
+            _ec2_macs + TestNmCloudSetup._mac2 + "/local-ipv4s", TestNmCloudSetup._ip1
+        )
+        self._mock_path(
+            _ec2_macs + TestNmCloudSetup._mac1 + "/subnet-ipv4-cidr-block",
+            "172.31.166.0/20",
+        )
+        self._mock_path(
+            _ec2_macs + TestNmCloudSetup._mac1 + "/local-ipv4s", TestNmCloudSetup._ip2
+        )
+
+        with tempfile.TemporaryDirectory() as cache_dir:
+            env = {
+                "NM_CLOUD_SETUP_EC2_HOST": self.md_url,
+                "NM_CLOUD_SETUP_LOG": "trace",
+                "NM_CLOUD_SETUP_EC2": "yes",
+                "NM_CLOUD_SETUP_CACHE_DIR": cache_dir,
+            }
+
+            # Run nm-cloud-setup for the first time, this fills the cache.
+            nmc = Util.cmd_call_pexpect(ENV_NM_TEST_CLIENT_CLOUD_SETUP_PATH, [], env)
+            nmc.pexp.expect("provider ec2 detected")
+            nmc.pexp.expect("get-config: success")
+            nmc.pexp.expect("some changes were applied for provider ec2")
+            nmc.pexp.expect("http-cache: saved")
+            nmc.pexp.expect(pexpect.EOF)
+
+            # The second time, only the cached provider is probed, and all
+            # meta data is answered with "304 Not Modified".
+            nmc = Util.cmd_call_pexpect(ENV_NM_TEST_CLIENT_CLOUD_SETUP_PATH, [], env)
+            nmc.pexp.expect("try cached provider ec2 first")
+            nmc.pexp.expect("provider ec2 detected")
+            nmc.pexp.expect("get-config: starting")
+            nmc.pexp.expect("not modified, use cached response")
+            nmc.pexp.expect("get-config: success")
+            nmc.pexp.expect("no changes were applied for provider ec2")
+            nmc.pexp.expect(pexpect.EOF)
+
+            Util.valgrind_check_log(nmc.valgrind_log, "test_ec2_cache")
+
     @cloud_setup_test
     def test_gcp(self):
         self._mock_devices()
@@ -15,6 +15,7 @@
 # providers, for convenience. The tests start this with "--empty" argument,
 # which starts with no resources.
 
+import hashlib
 import os
 import socket
 import sys
@@ -65,8 +66,10 @@ class MockCloudMDRequestHandler(BaseHTTPRequestHandler):
     def log_message(self, format, *args):
         pass
 
-    def _response_and_end(self, code, write=None):
+    def _response_and_end(self, code, write=None, etag=None):
         self.send_response(code)
+        if etag is not None:
+            self.send_header("ETag", etag)
         self.end_headers()
         if write is None:
             dbg("response %s" % (code,))
@@ -96,7 +99,13 @@ class MockCloudMDRequestHandler(BaseHTTPRequestHandler):
         if r is None:
             self._response_and_end(404)
             return
-        self._response_and_end(200, write=r)
+        if isinstance(r, str):
+            r = r.encode("utf-8")
+        etag = '"%s"' % (hashlib.sha1(r).hexdigest(),)
+        if self.headers.get("If-None-Match", None) == etag:
+            self._response_and_end(304, etag=etag)
+            return
+        self._response_and_end(200, write=r, etag=etag)
 
     def do_PUT(self):
         path = self.path.encode("ascii")
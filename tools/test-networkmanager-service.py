@@ -502,6 +502,16 @@ class BusErr:
             self._dbus_error_name = "{}.InvalidHostname".format(IFACE_SETTINGS)
             dbus.DBusException.__init__(self, *args, **kwargs)
 
+    class InvalidArgumentsException(dbus.DBusException):
+        def __init__(self, *args, **kwargs):
+            self._dbus_error_name = "{}.InvalidArguments".format(IFACE_SETTINGS)
+            dbus.DBusException.__init__(self, *args, **kwargs)
+
+    class UuidExistsException(dbus.DBusException):
+        def __init__(self, *args, **kwargs):
+            self._dbus_error_name = "{}.UuidExists".format(IFACE_SETTINGS)
+            dbus.DBusException.__init__(self, *args, **kwargs)
+
     class NoSecretsException(dbus.DBusException):
         def __init__(self, *args, **kwargs):
             self._dbus_error_name = "{}.NoSecrets".format(IFACE_AGENT_MANAGER)
@@ -2234,6 +2244,43 @@ class Settings(ExportedObj):
     def AddConnection(self, con_hash):
         return self.add_connection(con_hash)
 
+    @dbus.service.method(
+        dbus_interface=IFACE_SETTINGS,
+        in_signature="aa{sa{sv}}ua{sv}",
+        out_signature="aoa{sv}",
+    )
+    def AddConnections(self, con_hashes, flags, args):
+        if flags & ~(0x1 | 0x2 | 0x20):
+            raise BusErr.InvalidArgumentsException("Unknown flags")
+        if (flags & 0x3) not in (0x1, 0x2):
+            raise BusErr.InvalidArgumentsException(
+                "Requires either to-disk (0x1) or in-memory (0x2) flags"
+            )
+        for k in args:
+            if k != "plugin":
+                raise BusErr.InvalidArgumentsException(
+                    "Unsupported argument '%s'" % (k)
+                )
+        if not con_hashes:
+            raise BusErr.InvalidArgumentsException("No connections given")
+
+        # Like NetworkManager, check all profiles before adding any of them.
+        uuids = set([c.get_uuid() for c in self.get_connections(stable_order=False)])
+        con_insts = []
+        for i, con_hash in enumerate(con_hashes):
+            self.c_counter += 1
+            con_inst = Connection(self.c_counter, con_hash)
+            uuid = con_inst.get_uuid()
+            if uuid in uuids:
+                raise BusErr.UuidExistsException(
+                    "connection #%s: a connection with this UUID already exists" % (i)
+                )
+            uuids.add(uuid)
+            con_insts.append(con_inst)
+
+        paths = [self._add_connection_inst(con_inst) for con_inst in con_insts]
+        return (dbus.Array(paths, "o"), dbus.Dictionary({}, "sv"))
+
     @dbus.service.method(
         dbus_interface=IFACE_SETTINGS, in_signature="", out_signature="b"
     )
@@ -2250,6 +2297,9 @@ class Settings(ExportedObj):
                 "cannot add duplicate connection with uuid %s" % (uuid)
             )
 
+        return self._add_connection_inst(con_inst)
+
+    def _add_connection_inst(self, con_inst):
         con_inst.export()
         self.connections[con_inst.path] = con_inst
         self.NewConnection(con_inst.path)